@@ -45,6 +45,7 @@
 #include <fcntl.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 #include <unistd.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -182,6 +183,46 @@
 
 #define MAXCOLS 256 //!< Maximum number of columns indexable
 
+// Select the SIMD instruction set available at compile time
+
+//!< \cond
+
+#if !defined(BINSEARCH_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#if defined(__AVX512F__)
+#define BINSEARCH_AVX512 1
+#endif
+#if defined(__AVX2__)
+#define BINSEARCH_AVX2 1
+#endif
+#if defined(__SSE2__)
+#define BINSEARCH_SSE2 1
+#endif
+#endif
+
+#if defined(BINSEARCH_AVX512) || defined(BINSEARCH_AVX2) || defined(BINSEARCH_SSE2)
+#include <immintrin.h>
+#endif
+
+// When BINSEARCH_DISPATCH is defined, the SIMD search kernels are only declared here
+// and provided by the binsearch library (CMake option BINSEARCH_DISPATCH), that selects
+// at load time the best implementation for the running CPU.
+// The compile-time version remains available with the "_inline" suffix.
+#if defined(BINSEARCH_DISPATCH)
+#ifdef __cplusplus
+#define BINSEARCH_EXTERN extern "C"
+#else
+#define BINSEARCH_EXTERN extern
+#endif
+#define BINSEARCH_KERNEL(F, A) BINSEARCH_EXTERN uint64_t F A; static inline uint64_t F##_inline A
+#define BINSEARCH_KERNEL_VOID(F, A) BINSEARCH_EXTERN void F A; static inline void F##_inline A
+BINSEARCH_EXTERN const char *binsearch_dispatch_isa(void); // Returns the selected instruction set: "inline", "sse2", "avx2" or "avx512".
+#else
+#define BINSEARCH_KERNEL(F, A) static inline uint64_t F A
+#define BINSEARCH_KERNEL_VOID(F, A) static inline void F A
+#endif
+
+//!< \endcond
+
 /**
  * Returns the absolute file address position of the specified item (binary block).
  *
@@ -228,8 +269,35 @@ typedef struct mmfile_t
     uint8_t  ncols;             //!< Number of columns - THIS MUST BE MANUALLY SET EXCEPT FOR THE "BINSRC1" FORMAT.
     uint8_t  ctbytes[MAXCOLS];  //!< Number of bytes per column type (i.e. 1 for uint8_t, 2 for uint16_t, 4 for uint32_t, 8 for uint64_t). - THIS MUST BE MANUALLY SET EXCEPT FOR THE "BINSRC1" FORMAT.
     uint64_t index[MAXCOLS];    //!< Index of the offsets to the beginning of each column.
+    uint64_t mapsize;           //!< Length of the memory map if different from the file size (0 = size).
 } mmfile_t;
 
+#define MMAP_OPT_POPULATE 0x01 //!< Prefault the pages of the whole file at mapping time (MAP_POPULATE).
+#define MMAP_OPT_HUGEPAGE 0x02 //!< Ask for transparent huge pages on the file mapping (MADV_HUGEPAGE).
+#define MMAP_OPT_HUGETLB  0x04 //!< Copy the file in anonymous huge pages of MMAP_HUGETLB_SIZE bytes (MAP_HUGETLB), or in transparent huge pages if none is available.
+#define MMAP_OPT_LOCK     0x08 //!< Lock the whole file in memory (mlock).
+
+#define MMAP_ADVICE_NORMAL     0 //!< Default access pattern.
+#define MMAP_ADVICE_RANDOM     1 //!< Random access: disable the readahead (MADV_RANDOM).
+#define MMAP_ADVICE_SEQUENTIAL 2 //!< Sequential access: aggressive readahead (MADV_SEQUENTIAL).
+#define MMAP_ADVICE_WILLNEED   3 //!< Read the pages in advance (MADV_WILLNEED).
+
+#ifndef MMAP_HUGETLB_SIZE
+#define MMAP_HUGETLB_SIZE ((uint64_t)1 << 21) //!< Size of the huge pages requested by MMAP_OPT_HUGETLB (a power of two supported by the kernel, e.g. 2 MiB or 1 GiB on x86-64).
+#endif
+
+/**
+ * Options for the memory mapping of a file (see mmap_binfile_ex).
+ * A zero-initialized structure maps the file like mmap_binfile.
+ */
+typedef struct mmap_opts_t
+{
+    uint32_t flags;                 //!< Combination of the MMAP_OPT_* flags.
+    uint8_t advice;                 //!< Access advice for the whole file (MMAP_ADVICE_*).
+    uint8_t col_advice[MAXCOLS];    //!< Access advice for each column (MMAP_ADVICE_*), overriding the file advice on the column pages.
+    bool col_lock[MAXCOLS];         //!< Lock the pages of each column in memory (mlock).
+} mmap_opts_t;
+
 /**
  * Convert bytes to the specified type.
  *
@@ -279,12 +347,18 @@ define_get_src_offset(uint64_t)
 
 #define GET_MIDDLE_BLOCK(O, T) order_##O##_##T(*(get_src_offset(T, src, get_address(blklen, blkpos, middle))))
 
-#define FIND_START_LOOP_BLOCK(T) \
+#define FIND_START_BLOCK(T) \
     uint64_t middle, notfound = *last; \
-    T x; \
+    T x;
+
+#define FIND_LOOP_BLOCK \
     while (*first < *last) \
     { \
-        middle = get_middle_point(*first, *last); \
+        middle = get_middle_point(*first, *last);
+
+#define FIND_START_LOOP_BLOCK(T) \
+FIND_START_BLOCK(T) \
+FIND_LOOP_BLOCK
 
 #define FIND_END_LOOP_BLOCK \
     if (x == search) \
@@ -339,6 +413,48 @@ define_get_src_offset(uint64_t)
     middle = *first; \
     --middle;
 
+// The branchless blocks always halve the remaining length, so the number of
+// iterations only depends on (last - first) and the position update can be
+// compiled to a conditional move instead of a data-dependent branch.
+
+#define FIND_BRANCHLESS_LOOP_BLOCK \
+    if (*first < *last) \
+    { \
+        uint64_t base = *first, len = (*last - *first), half; \
+        while (len > 1) \
+        { \
+            half = (len >> 1); \
+            middle = (base + half);
+
+#define FIND_BRANCHLESS_START_BLOCK(T) \
+FIND_START_BLOCK(T) \
+FIND_BRANCHLESS_LOOP_BLOCK
+
+#define FIND_FIRST_BRANCHLESS_INNER_CHECK \
+            base = (x < search) ? middle : base; \
+            len -= half; \
+        } \
+        middle = base;
+
+#define FIND_FIRST_BRANCHLESS_END_CHECK \
+        *first = (base + (uint64_t)(x < search)); \
+        *last = *first; \
+    } \
+    middle = *first;
+
+#define FIND_LAST_BRANCHLESS_INNER_CHECK \
+            base = (x > search) ? base : middle; \
+            len -= half; \
+        } \
+        middle = base;
+
+#define FIND_LAST_BRANCHLESS_END_CHECK \
+        *first = (base + (uint64_t)(x <= search)); \
+        *last = *first; \
+    } \
+    middle = *first; \
+    --middle;
+
 #define HAS_NEXT_START_BLOCK \
     if (*pos >= (last - 1)) \
     { \
@@ -912,133 +1028,6573 @@ define_col_has_prev_sub(uint16_t)
 define_col_has_prev_sub(uint32_t)
 define_col_has_prev_sub(uint64_t)
 
-// --- FILE ---
+// --- BRANCHLESS ---
 
-static inline void parse_col_offset(mmfile_t *mf)
-{
-    uint8_t i = 0;
-    uint64_t b = 0;
-    mf->index[0] = mf->doffset;
-    for (i = 0; i < mf->ncols; i++)
-    {
-        b += mf->ctbytes[i];
-    }
-    if (b == 0)
-    {
-        return;
-    }
-    mf->nrows = (mf->dlength / b);
-    for (i = 1; i < mf->ncols; i++)
-    {
-        b = (mf->nrows * mf->ctbytes[(i - 1)]);
-        mf->index[i] = mf->index[(i - 1)] + b + ((8 - (b & 7)) & 7); // account for 8-byte padding
-    }
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using a branchless loop.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_first_branchless(O, T) \
+/** Search for the first occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+This is a branchless version of find_first_##O##_##T that returns the same results.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t find_first_branchless_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_BRANCHLESS_START_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+FIND_FIRST_BRANCHLESS_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_FIRST_BRANCHLESS_END_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
 }
 
-static inline void parse_info_binsrc(mmfile_t *mf)
-{
-    const uint8_t *tp = (const uint8_t *)(mf->src + 8);
-    mf->ncols = *tp++;
-    mf->doffset = (uint64_t)9 + mf->ncols + ((8 - ((mf->ncols + 1) & 7)) & 7); // account for 8-byte padding
-    const uint64_t *op = (const uint64_t *)(mf->src + mf->doffset);
-    mf->nrows = *op++;
-    uint8_t i = 0;
-    for (i = 0; i < mf->ncols; i++)
-    {
-        mf->ctbytes[i] = *tp++;
-        mf->index[i] = *op++;
-    }
-    mf->doffset += ((uint64_t)(mf->ncols + 1) * 8); // skip column offsets section
-    mf->dlength -= mf->doffset;
-}
+define_find_first_branchless(be, uint8_t)
+define_find_first_branchless(be, uint16_t)
+define_find_first_branchless(be, uint32_t)
+define_find_first_branchless(be, uint64_t)
+define_find_first_branchless(le, uint8_t)
+define_find_first_branchless(le, uint16_t)
+define_find_first_branchless(le, uint32_t)
+define_find_first_branchless(le, uint64_t)
 
-static inline void parse_info_arrow(mmfile_t *mf)
-{
-    mf->doffset = (uint64_t)(*((const uint32_t *)(mf->src + 9))) + 13; // skip metadata
-    mf->doffset += (uint64_t)(*((const uint32_t *)(mf->src + mf->doffset)) + 4); // skip dictionary
-    mf->dlength -= mf->doffset;
-    uint64_t type = (*((const uint64_t *)(mf->src + mf->size - 8)));
-    if ((type & 0xffffffffffff0000) == 0x31574f5252410000) // magic number "ARROW1" in LE
-    {
-        mf->dlength -= (uint64_t)(*((const uint32_t *)(mf->src + mf->size - 10))) + 10; // remove footer
-    }
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using a branchless loop.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t
+ */
+#define define_find_first_sub_branchless(O, T) \
+/** Search for the first occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+This is a branchless version of find_first_sub_##O##_##T that returns the same results.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param bitstart  First bit position to consider (usually 0).
+@param bitend    Last bit position to consider (usually the last bit, e.g. 7 for uint8_t, 15 for uint16_t, etc).
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t find_first_sub_branchless_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint8_t bitstart, uint8_t bitend, uint64_t *first, uint64_t *last, T search) \
+{ \
+SUB_ITEM_VARS(T) \
+FIND_BRANCHLESS_START_BLOCK(T) \
+GET_SUB_ITEM_TASK(O, T) \
+FIND_FIRST_BRANCHLESS_INNER_CHECK \
+GET_SUB_ITEM_TASK(O, T) \
+FIND_FIRST_BRANCHLESS_END_CHECK \
+GET_SUB_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
 }
 
-static inline void parse_info_feather(mmfile_t *mf)
-{
-    mf->doffset = 8;
-    mf->dlength -= mf->doffset;
-    uint32_t type = (*((const uint32_t *)(mf->src + mf->size - 4)));
-    if (type == 0x31414546) // magic number "FEA1" in LE
-    {
-        mf->dlength -= (uint64_t)(*((const uint32_t *)(mf->src + mf->size - 8))) + 8; // remove metadata
-    }
-}
+define_find_first_sub_branchless(be, uint8_t)
+define_find_first_sub_branchless(be, uint16_t)
+define_find_first_sub_branchless(be, uint32_t)
+define_find_first_sub_branchless(be, uint64_t)
+define_find_first_sub_branchless(le, uint8_t)
+define_find_first_sub_branchless(le, uint16_t)
+define_find_first_sub_branchless(le, uint32_t)
+define_find_first_sub_branchless(le, uint64_t)
 
 /**
- * Memory map the specified file.
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using a branchless loop.
  *
- * @param file  Path to the file to map.
- * @param mf    Structure containing the memory mapped file.
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t
  */
-static inline void mmap_binfile(const char *file, mmfile_t *mf)
-{
-    mf->src = (uint8_t*)MAP_FAILED; // NOLINT
-    mf->fd = -1;
-    mf->size = 0;
-    mf->doffset = 0;
-    mf->dlength = 0;
-    mf->nrows = 0;
-    struct stat statbuf;
-    mf->fd = open(file, O_RDONLY);
-    if ((mf->fd < 0) || (fstat(mf->fd, &statbuf) < 0))
-    {
-        return;
-    }
-    mf->size = (uint64_t)statbuf.st_size;
-    mf->src = (uint8_t*)mmap(0, mf->size, PROT_READ, MAP_PRIVATE, mf->fd, 0);
-    mf->dlength = mf->size;
-    if (mf->size < 28)
-    {
-        return;
-    }
-    uint64_t type = (*((const uint64_t *)(mf->src)));
-    switch (type)
-    {
-    // Custom binsearch format
-    case 0x00314352534e4942: // magic number "BINSRC1" in LE
-        parse_info_binsrc(mf);
-        return;
-    // Basic support for Apache Arrow File format with a single RecordBatch.
-    case 0x000031574f525241: // magic number "ARROW1" in LE
-        parse_info_arrow(mf);
-        break;
-    // Basic support for Feather File format.
-    case 0x0000000031414546: // magic number "FEA1" in LE
-        parse_info_feather(mf);
-        break;
-    default:
-        break;
-    }
-    parse_col_offset(mf);
+#define define_find_last_branchless(O, T) \
+/** Search for the last occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+This is a branchless version of find_last_##O##_##T that returns the same results.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t find_last_branchless_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_BRANCHLESS_START_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+FIND_LAST_BRANCHLESS_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_LAST_BRANCHLESS_END_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
 }
 
+define_find_last_branchless(be, uint8_t)
+define_find_last_branchless(be, uint16_t)
+define_find_last_branchless(be, uint32_t)
+define_find_last_branchless(be, uint64_t)
+define_find_last_branchless(le, uint8_t)
+define_find_last_branchless(le, uint16_t)
+define_find_last_branchless(le, uint32_t)
+define_find_last_branchless(le, uint64_t)
+
 /**
- * Unmap and close the memory-mapped file.
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using a branchless loop.
  *
- * @param mf Descriptor of memory-mapped file.
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t
+ */
+#define define_find_last_sub_branchless(O, T) \
+/** Search for the last occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+This is a branchless version of find_last_sub_##O##_##T that returns the same results.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param bitstart  First bit position to consider (usually 0).
+@param bitend    Last bit position to consider (usually the last bit, e.g. 7 for uint8_t, 15 for uint16_t, etc).
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t find_last_sub_branchless_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint8_t bitstart, uint8_t bitend, uint64_t *first, uint64_t *last, T search) \
+{ \
+SUB_ITEM_VARS(T) \
+FIND_BRANCHLESS_START_BLOCK(T) \
+GET_SUB_ITEM_TASK(O, T) \
+FIND_LAST_BRANCHLESS_INNER_CHECK \
+GET_SUB_ITEM_TASK(O, T) \
+FIND_LAST_BRANCHLESS_END_CHECK \
+GET_SUB_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_last_sub_branchless(be, uint8_t)
+define_find_last_sub_branchless(be, uint16_t)
+define_find_last_sub_branchless(be, uint32_t)
+define_find_last_sub_branchless(be, uint64_t)
+define_find_last_sub_branchless(le, uint8_t)
+define_find_last_sub_branchless(le, uint16_t)
+define_find_last_sub_branchless(le, uint32_t)
+define_find_last_sub_branchless(le, uint64_t)
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using a branchless loop.
  *
- * @return On success, munmap() returns 0,
- *         on failure -1, and errno is set (probably to EINVAL).
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
  */
-static inline int munmap_binfile(mmfile_t mf)
-{
-    int err = munmap(mf.src, mf.size);
-    if (err != 0)
-    {
-        return err;
-    }
-    return close(mf.fd);
+#define define_col_find_first_branchless(T) \
+/** Search for the first occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+This is a branchless version of col_find_first_##T that returns the same results.
+@param src       Memory mapped file address.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t col_find_first_branchless_##T(const T *src, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_BRANCHLESS_START_BLOCK(T) \
+COL_GET_ITEM_TASK \
+FIND_FIRST_BRANCHLESS_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_FIRST_BRANCHLESS_END_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_first_branchless(uint8_t)
+define_col_find_first_branchless(uint16_t)
+define_col_find_first_branchless(uint32_t)
+define_col_find_first_branchless(uint64_t)
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using a branchless loop.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t
+ */
+#define define_col_find_first_sub_branchless(T) \
+/** Search for the first occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+This is a branchless version of col_find_first_sub_##T that returns the same results.
+@param src       Memory mapped file address.
+@param bitstart  First bit position to consider (usually 0).
+@param bitend    Last bit position to consider (usually the last bit, e.g. 7 for uint8_t, 15 for uint16_t, etc).
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t col_find_first_sub_branchless_##T(const T *src, uint8_t bitstart, uint8_t bitend, uint64_t *first, uint64_t *last, T search) \
+{ \
+SUB_ITEM_VARS(T) \
+FIND_BRANCHLESS_START_BLOCK(T) \
+COL_GET_SUB_ITEM_TASK \
+FIND_FIRST_BRANCHLESS_INNER_CHECK \
+COL_GET_SUB_ITEM_TASK \
+FIND_FIRST_BRANCHLESS_END_CHECK \
+COL_GET_SUB_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_first_sub_branchless(uint8_t)
+define_col_find_first_sub_branchless(uint16_t)
+define_col_find_first_sub_branchless(uint32_t)
+define_col_find_first_sub_branchless(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using a branchless loop.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t
+ */
+#define define_col_find_last_branchless(T) \
+/** Search for the last occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+This is a branchless version of col_find_last_##T that returns the same results.
+@param src       Memory mapped file address.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t col_find_last_branchless_##T(const T *src, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_BRANCHLESS_START_BLOCK(T) \
+COL_GET_ITEM_TASK \
+FIND_LAST_BRANCHLESS_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_LAST_BRANCHLESS_END_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_last_branchless(uint8_t)
+define_col_find_last_branchless(uint16_t)
+define_col_find_last_branchless(uint32_t)
+define_col_find_last_branchless(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using a branchless loop.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t
+ */
+#define define_col_find_last_sub_branchless(T) \
+/** Search for the last occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+This is a branchless version of col_find_last_sub_##T that returns the same results.
+@param src       Memory mapped file address.
+@param bitstart  First bit position to consider (usually 0).
+@param bitend    Last bit position to consider (usually the last bit, e.g. 7 for uint8_t, 15 for uint16_t, etc).
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t col_find_last_sub_branchless_##T(const T *src, uint8_t bitstart, uint8_t bitend, uint64_t *first, uint64_t *last, T search) \
+{ \
+SUB_ITEM_VARS(T) \
+FIND_BRANCHLESS_START_BLOCK(T) \
+COL_GET_SUB_ITEM_TASK \
+FIND_LAST_BRANCHLESS_INNER_CHECK \
+COL_GET_SUB_ITEM_TASK \
+FIND_LAST_BRANCHLESS_END_CHECK \
+COL_GET_SUB_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_last_sub_branchless(uint8_t)
+define_col_find_last_sub_branchless(uint16_t)
+define_col_find_last_sub_branchless(uint32_t)
+define_col_find_last_sub_branchless(uint64_t)
+
+// --- K-ARY SEARCH ---
+
+#define KARY_PIVOTS_uint32_t 16 //!< Number of pivots compared at each k-ary step for uint32_t columns
+#define KARY_PIVOTS_uint64_t 8  //!< Number of pivots compared at each k-ary step for uint64_t columns
+
+#ifndef KARY_MIN_RANGE_uint32_t
+#define KARY_MIN_RANGE_uint32_t ((KARY_PIVOTS_uint32_t + 1) * 4) //!< Below this range size the k-ary search continues as a binary search (uint32_t)
+#endif
+
+#ifndef KARY_MIN_RANGE_uint64_t
+#define KARY_MIN_RANGE_uint64_t ((KARY_PIVOTS_uint64_t + 1) * 4) //!< Below this range size the k-ary search continues as a binary search (uint64_t)
+#endif
+
+/**
+ * Count the number of pivots src[base + (i * step)], with i = 1..16, that are less than the search value.
+ *
+ * @param src       Memory buffer containing contiguos sorted uint32_t values.
+ * @param base      Position of the element before the first pivot.
+ * @param step      Distance between two consecutive pivots.
+ * @param search    Unsigned number to search.
+ *
+ * @return Number of pivots less than the search value.
+ */
+static inline uint64_t kary_count_lt_uint32_t(const uint32_t *src, uint64_t base, uint64_t step, uint32_t search)
+{
+    const uint32_t *p = (src + base);
+#if defined(BINSEARCH_AVX512)
+    __m512i v = _mm512_set_epi32((int)p[16 * step], (int)p[15 * step], (int)p[14 * step], (int)p[13 * step], (int)p[12 * step], (int)p[11 * step], (int)p[10 * step], (int)p[9 * step], (int)p[8 * step], (int)p[7 * step], (int)p[6 * step], (int)p[5 * step], (int)p[4 * step], (int)p[3 * step], (int)p[2 * step], (int)p[step]);
+    return (uint64_t)__builtin_popcount((unsigned int)_mm512_cmplt_epu32_mask(v, _mm512_set1_epi32((int)search)));
+#elif defined(BINSEARCH_AVX2)
+    const __m256i bias = _mm256_set1_epi32((int)0x80000000);
+    const __m256i s = _mm256_xor_si256(_mm256_set1_epi32((int)search), bias);
+    __m256i v0 = _mm256_xor_si256(_mm256_set_epi32((int)p[8 * step], (int)p[7 * step], (int)p[6 * step], (int)p[5 * step], (int)p[4 * step], (int)p[3 * step], (int)p[2 * step], (int)p[step]), bias);
+    __m256i v1 = _mm256_xor_si256(_mm256_set_epi32((int)p[16 * step], (int)p[15 * step], (int)p[14 * step], (int)p[13 * step], (int)p[12 * step], (int)p[11 * step], (int)p[10 * step], (int)p[9 * step]), bias);
+    int m0 = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(s, v0)));
+    int m1 = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(s, v1)));
+    return (uint64_t)__builtin_popcount((unsigned int)(m0 | (m1 << 8)));
+#elif defined(BINSEARCH_SSE2)
+    const __m128i bias = _mm_set1_epi32((int)0x80000000);
+    const __m128i s = _mm_xor_si128(_mm_set1_epi32((int)search), bias);
+    __m128i v0 = _mm_xor_si128(_mm_set_epi32((int)p[4 * step], (int)p[3 * step], (int)p[2 * step], (int)p[step]), bias);
+    __m128i v1 = _mm_xor_si128(_mm_set_epi32((int)p[8 * step], (int)p[7 * step], (int)p[6 * step], (int)p[5 * step]), bias);
+    __m128i v2 = _mm_xor_si128(_mm_set_epi32((int)p[12 * step], (int)p[11 * step], (int)p[10 * step], (int)p[9 * step]), bias);
+    __m128i v3 = _mm_xor_si128(_mm_set_epi32((int)p[16 * step], (int)p[15 * step], (int)p[14 * step], (int)p[13 * step]), bias);
+    int m = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(s, v0)));
+    m |= (_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(s, v1))) << 4);
+    m |= (_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(s, v2))) << 8);
+    m |= (_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(s, v3))) << 12);
+    return (uint64_t)__builtin_popcount((unsigned int)m);
+#else
+    uint64_t i, cnt = 0;
+    for (i = 1; i <= KARY_PIVOTS_uint32_t; i++)
+    {
+        cnt += (uint64_t)(p[i * step] < search);
+    }
+    return cnt;
+#endif
+}
+
+//!< \cond
+
+#if defined(BINSEARCH_SSE2) && !defined(BINSEARCH_AVX2) && !defined(BINSEARCH_AVX512)
+// Emulate the SSE4.2 signed 64 bit "greater than" comparison using SSE2 instructions.
+static inline __m128i sse2_cmpgt_epi64(__m128i a, __m128i b)
+{
+    __m128i r = _mm_and_si128(_mm_cmpeq_epi32(a, b), _mm_sub_epi64(b, a));
+    r = _mm_or_si128(r, _mm_cmpgt_epi32(a, b));
+    return _mm_shuffle_epi32(r, _MM_SHUFFLE(3, 3, 1, 1));
+}
+#endif
+
+//!< \endcond
+
+/**
+ * Count the number of pivots src[base + (i * step)], with i = 1..8, that are less than the search value.
+ *
+ * @param src       Memory buffer containing contiguos sorted uint64_t values.
+ * @param base      Position of the element before the first pivot.
+ * @param step      Distance between two consecutive pivots.
+ * @param search    Unsigned number to search.
+ *
+ * @return Number of pivots less than the search value.
+ */
+static inline uint64_t kary_count_lt_uint64_t(const uint64_t *src, uint64_t base, uint64_t step, uint64_t search)
+{
+    const uint64_t *p = (src + base);
+#if defined(BINSEARCH_AVX512)
+    __m512i v = _mm512_set_epi64((long long)p[8 * step], (long long)p[7 * step], (long long)p[6 * step], (long long)p[5 * step], (long long)p[4 * step], (long long)p[3 * step], (long long)p[2 * step], (long long)p[step]);
+    return (uint64_t)__builtin_popcount((unsigned int)_mm512_cmplt_epu64_mask(v, _mm512_set1_epi64((long long)search)));
+#elif defined(BINSEARCH_AVX2)
+    const __m256i bias = _mm256_set1_epi64x((long long)0x8000000000000000);
+    const __m256i s = _mm256_xor_si256(_mm256_set1_epi64x((long long)search), bias);
+    __m256i v0 = _mm256_xor_si256(_mm256_set_epi64x((long long)p[4 * step], (long long)p[3 * step], (long long)p[2 * step], (long long)p[step]), bias);
+    __m256i v1 = _mm256_xor_si256(_mm256_set_epi64x((long long)p[8 * step], (long long)p[7 * step], (long long)p[6 * step], (long long)p[5 * step]), bias);
+    int m0 = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(s, v0)));
+    int m1 = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(s, v1)));
+    return (uint64_t)__builtin_popcount((unsigned int)(m0 | (m1 << 4)));
+#elif defined(BINSEARCH_SSE2)
+    const __m128i bias = _mm_set1_epi64x((long long)0x8000000000000000);
+    const __m128i s = _mm_xor_si128(_mm_set1_epi64x((long long)search), bias);
+    __m128i v0 = _mm_xor_si128(_mm_set_epi64x((long long)p[2 * step], (long long)p[step]), bias);
+    __m128i v1 = _mm_xor_si128(_mm_set_epi64x((long long)p[4 * step], (long long)p[3 * step]), bias);
+    __m128i v2 = _mm_xor_si128(_mm_set_epi64x((long long)p[6 * step], (long long)p[5 * step]), bias);
+    __m128i v3 = _mm_xor_si128(_mm_set_epi64x((long long)p[8 * step], (long long)p[7 * step]), bias);
+    int m = _mm_movemask_pd(_mm_castsi128_pd(sse2_cmpgt_epi64(s, v0)));
+    m |= (_mm_movemask_pd(_mm_castsi128_pd(sse2_cmpgt_epi64(s, v1))) << 2);
+    m |= (_mm_movemask_pd(_mm_castsi128_pd(sse2_cmpgt_epi64(s, v2))) << 4);
+    m |= (_mm_movemask_pd(_mm_castsi128_pd(sse2_cmpgt_epi64(s, v3))) << 6);
+    return (uint64_t)__builtin_popcount((unsigned int)m);
+#else
+    uint64_t i, cnt = 0;
+    for (i = 1; i <= KARY_PIVOTS_uint64_t; i++)
+    {
+        cnt += (uint64_t)(p[i * step] < search);
+    }
+    return cnt;
+#endif
+}
+
+/**
+ * Count the number of pivots src[base + (i * step)] that are less or equal than the search value.
+ *
+ * @param T Unsigned integer type, one of: uint32_t, uint64_t.
+ * @param M Maximum value for the type T.
+ */
+#define define_kary_count_le(T, M) \
+/** Count the number of pivots src[base + (i * step)], with i = 1..KARY_PIVOTS_##T, that are less or equal than the search value.
+@param src       Memory buffer containing contiguos sorted values.
+@param base      Position of the element before the first pivot.
+@param step      Distance between two consecutive pivots.
+@param search    Unsigned number to search (type T).
+@return Number of pivots less or equal than the search value.
+*/ \
+static inline uint64_t kary_count_le_##T(const T *src, uint64_t base, uint64_t step, T search) \
+{ \
+    if (search == (M)) \
+    { \
+        return KARY_PIVOTS_##T; \
+    } \
+    return kary_count_lt_##T(src, base, step, (T)(search + 1)); \
+}
+
+define_kary_count_le(uint32_t, UINT32_MAX)
+define_kary_count_le(uint64_t, UINT64_MAX)
+
+// Each k-ary step splits the [first, last) range in (KARY_PIVOTS + 1) segments
+// and selects the one containing the searched position, so the final binary
+// search loop returns the same results of the non k-ary functions.
+
+#define COL_KARY_NARROW_BLOCK(T, C) \
+    while ((*first < *last) && ((*last - *first) > KARY_MIN_RANGE_##T)) \
+    { \
+        uint64_t step = ((*last - *first) / (KARY_PIVOTS_##T + 1)); \
+        uint64_t cnt = kary_count_##C##_##T(src, *first, step, search); \
+        *last = (cnt == KARY_PIVOTS_##T) ? *last : (*first + ((cnt + 1) * step)); \
+        *first += ((cnt * step) + (uint64_t)(cnt != 0)); \
+    }
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using a SIMD k-ary search.
+ *
+ * @param T Unsigned integer type, one of: uint32_t, uint64_t.
+ */
+#define define_col_find_first_kary(T) \
+/** Search for the first occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+At each step the search value is compared with KARY_PIVOTS_##T pivots at once,
+until the range is smaller than KARY_MIN_RANGE_##T, then continues with a branchless binary search.
+This returns the same results of col_find_first_##T.
+@param src       Memory mapped file address.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+BINSEARCH_KERNEL(col_find_first_kary_##T, (const T *src, uint64_t *first, uint64_t *last, T search)) \
+{ \
+FIND_START_BLOCK(T) \
+COL_KARY_NARROW_BLOCK(T, lt) \
+FIND_BRANCHLESS_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_FIRST_BRANCHLESS_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_FIRST_BRANCHLESS_END_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_first_kary(uint32_t)
+define_col_find_first_kary(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using a SIMD k-ary search.
+ *
+ * @param T Unsigned integer type, one of: uint32_t, uint64_t.
+ */
+#define define_col_find_last_kary(T) \
+/** Search for the last occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+At each step the search value is compared with KARY_PIVOTS_##T pivots at once,
+until the range is smaller than KARY_MIN_RANGE_##T, then continues with a branchless binary search.
+This returns the same results of col_find_last_##T.
+@param src       Memory mapped file address.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+BINSEARCH_KERNEL(col_find_last_kary_##T, (const T *src, uint64_t *first, uint64_t *last, T search)) \
+{ \
+FIND_START_BLOCK(T) \
+COL_KARY_NARROW_BLOCK(T, le) \
+FIND_BRANCHLESS_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_LAST_BRANCHLESS_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_LAST_BRANCHLESS_END_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_last_kary(uint32_t)
+define_col_find_last_kary(uint64_t)
+
+// --- HYBRID SEARCH ---
+
+// The hybrid searches halve the [first, last) range as the normal binary search
+// until it contains no more than "scan" items, then count the items less than
+// (or less or equal to) the search value with a linear scan.
+// A scan of a few cache lines has no data-dependent branches and is faster than
+// the last halving steps. The best threshold depends on the CPU and the type
+// width, and can be measured with the calibration in test/bench/bench.c.
+
+#ifndef HYBRID_SCAN_uint8_t
+#define HYBRID_SCAN_uint8_t 128 //!< Default hybrid search scan threshold for uint8_t (two cache lines)
+#endif
+
+#ifndef HYBRID_SCAN_uint16_t
+#define HYBRID_SCAN_uint16_t 64 //!< Default hybrid search scan threshold for uint16_t (two cache lines)
+#endif
+
+#ifndef HYBRID_SCAN_uint32_t
+#define HYBRID_SCAN_uint32_t 32 //!< Default hybrid search scan threshold for uint32_t (two cache lines)
+#endif
+
+#ifndef HYBRID_SCAN_uint64_t
+#define HYBRID_SCAN_uint64_t 16 //!< Default hybrid search scan threshold for uint64_t (two cache lines)
+#endif
+
+/**
+ * Count the number of items src[first..last) that are less than the search value.
+ *
+ * @param src       Memory buffer containing contiguos uint8_t values.
+ * @param first     First element to scan.
+ * @param last      Element (up to but not including) where to end the scan.
+ * @param search    Unsigned number to compare.
+ *
+ * @return Number of items less than the search value.
+ */
+BINSEARCH_KERNEL(col_scan_count_lt_uint8_t, (const uint8_t *src, uint64_t first, uint64_t last, uint8_t search))
+{
+    uint64_t i = first, cnt = 0;
+#if defined(BINSEARCH_AVX2)
+    const __m256i bias = _mm256_set1_epi8((char)0x80);
+    const __m256i s = _mm256_xor_si256(_mm256_set1_epi8((char)search), bias);
+    for (; (i + 32) <= last; i += 32)
+    {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(const void *)(src + i)), bias);
+        cnt += (uint64_t)__builtin_popcount((unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(s, v)));
+    }
+#elif defined(BINSEARCH_SSE2)
+    const __m128i bias = _mm_set1_epi8((char)0x80);
+    const __m128i s = _mm_xor_si128(_mm_set1_epi8((char)search), bias);
+    for (; (i + 16) <= last; i += 16)
+    {
+        __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(const void *)(src + i)), bias);
+        cnt += (uint64_t)__builtin_popcount((unsigned int)_mm_movemask_epi8(_mm_cmpgt_epi8(s, v)));
+    }
+#endif
+    for (; i < last; i++)
+    {
+        cnt += (uint64_t)(src[i] < search);
+    }
+    return cnt;
+}
+
+/**
+ * Count the number of items src[first..last) that are less than the search value.
+ *
+ * @param src       Memory buffer containing contiguos uint16_t values.
+ * @param first     First element to scan.
+ * @param last      Element (up to but not including) where to end the scan.
+ * @param search    Unsigned number to compare.
+ *
+ * @return Number of items less than the search value.
+ */
+BINSEARCH_KERNEL(col_scan_count_lt_uint16_t, (const uint16_t *src, uint64_t first, uint64_t last, uint16_t search))
+{
+    uint64_t i = first, cnt = 0;
+#if defined(BINSEARCH_AVX2)
+    const __m256i bias = _mm256_set1_epi16((short)0x8000);
+    const __m256i s = _mm256_xor_si256(_mm256_set1_epi16((short)search), bias);
+    for (; (i + 16) <= last; i += 16)
+    {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(const void *)(src + i)), bias);
+        cnt += (uint64_t)(__builtin_popcount((unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi16(s, v))) >> 1);
+    }
+#elif defined(BINSEARCH_SSE2)
+    const __m128i bias = _mm_set1_epi16((short)0x8000);
+    const __m128i s = _mm_xor_si128(_mm_set1_epi16((short)search), bias);
+    for (; (i + 8) <= last; i += 8)
+    {
+        __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(const void *)(src + i)), bias);
+        cnt += (uint64_t)(__builtin_popcount((unsigned int)_mm_movemask_epi8(_mm_cmpgt_epi16(s, v))) >> 1);
+    }
+#endif
+    for (; i < last; i++)
+    {
+        cnt += (uint64_t)(src[i] < search);
+    }
+    return cnt;
+}
+
+/**
+ * Count the number of items src[first..last) that are less than the search value.
+ *
+ * @param src       Memory buffer containing contiguos uint32_t values.
+ * @param first     First element to scan.
+ * @param last      Element (up to but not including) where to end the scan.
+ * @param search    Unsigned number to compare.
+ *
+ * @return Number of items less than the search value.
+ */
+BINSEARCH_KERNEL(col_scan_count_lt_uint32_t, (const uint32_t *src, uint64_t first, uint64_t last, uint32_t search))
+{
+    uint64_t i = first, cnt = 0;
+#if defined(BINSEARCH_AVX512)
+    const __m512i s = _mm512_set1_epi32((int)search);
+    for (; (i + 16) <= last; i += 16)
+    {
+        __m512i v = _mm512_loadu_si512((const void *)(src + i));
+        cnt += (uint64_t)__builtin_popcount((unsigned int)_mm512_cmplt_epu32_mask(v, s));
+    }
+#elif defined(BINSEARCH_AVX2)
+    const __m256i bias = _mm256_set1_epi32((int)0x80000000);
+    const __m256i s = _mm256_xor_si256(_mm256_set1_epi32((int)search), bias);
+    for (; (i + 8) <= last; i += 8)
+    {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(const void *)(src + i)), bias);
+        cnt += (uint64_t)__builtin_popcount((unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(s, v))));
+    }
+#elif defined(BINSEARCH_SSE2)
+    const __m128i bias = _mm_set1_epi32((int)0x80000000);
+    const __m128i s = _mm_xor_si128(_mm_set1_epi32((int)search), bias);
+    for (; (i + 4) <= last; i += 4)
+    {
+        __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(const void *)(src + i)), bias);
+        cnt += (uint64_t)__builtin_popcount((unsigned int)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(s, v))));
+    }
+#endif
+    for (; i < last; i++)
+    {
+        cnt += (uint64_t)(src[i] < search);
+    }
+    return cnt;
+}
+
+/**
+ * Count the number of items src[first..last) that are less than the search value.
+ *
+ * @param src       Memory buffer containing contiguos uint64_t values.
+ * @param first     First element to scan.
+ * @param last      Element (up to but not including) where to end the scan.
+ * @param search    Unsigned number to compare.
+ *
+ * @return Number of items less than the search value.
+ */
+BINSEARCH_KERNEL(col_scan_count_lt_uint64_t, (const uint64_t *src, uint64_t first, uint64_t last, uint64_t search))
+{
+    uint64_t i = first, cnt = 0;
+#if defined(BINSEARCH_AVX512)
+    const __m512i s = _mm512_set1_epi64((long long)search);
+    for (; (i + 8) <= last; i += 8)
+    {
+        __m512i v = _mm512_loadu_si512((const void *)(src + i));
+        cnt += (uint64_t)__builtin_popcount((unsigned int)_mm512_cmplt_epu64_mask(v, s));
+    }
+#elif defined(BINSEARCH_AVX2)
+    const __m256i bias = _mm256_set1_epi64x((long long)0x8000000000000000);
+    const __m256i s = _mm256_xor_si256(_mm256_set1_epi64x((long long)search), bias);
+    for (; (i + 4) <= last; i += 4)
+    {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(const void *)(src + i)), bias);
+        cnt += (uint64_t)__builtin_popcount((unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(s, v))));
+    }
+#elif defined(BINSEARCH_SSE2)
+    const __m128i bias = _mm_set1_epi64x((long long)0x8000000000000000);
+    const __m128i s = _mm_xor_si128(_mm_set1_epi64x((long long)search), bias);
+    for (; (i + 2) <= last; i += 2)
+    {
+        __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(const void *)(src + i)), bias);
+        cnt += (uint64_t)__builtin_popcount((unsigned int)_mm_movemask_pd(_mm_castsi128_pd(sse2_cmpgt_epi64(s, v))));
+    }
+#endif
+    for (; i < last; i++)
+    {
+        cnt += (uint64_t)(src[i] < search);
+    }
+    return cnt;
+}
+
+/**
+ * Count the number of items src[first..last) that are less or equal than the search value.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ * @param M Maximum value for the type T.
+ */
+#define define_col_scan_count_le(T, M) \
+/** Count the number of items src[first..last) that are less or equal than the search value.
+@param src       Memory buffer containing contiguos values.
+@param first     First element to scan.
+@param last      Element (up to but not including) where to end the scan.
+@param search    Unsigned number to compare (type T).
+@return Number of items less or equal than the search value.
+*/ \
+static inline uint64_t col_scan_count_le_##T(const T *src, uint64_t first, uint64_t last, T search) \
+{ \
+    if (search == (M)) \
+    { \
+        return (last - first); \
+    } \
+    return col_scan_count_lt_##T(src, first, last, (T)(search + 1)); \
+}
+
+define_col_scan_count_le(uint8_t, UINT8_MAX)
+define_col_scan_count_le(uint16_t, UINT16_MAX)
+define_col_scan_count_le(uint32_t, UINT32_MAX)
+define_col_scan_count_le(uint64_t, UINT64_MAX)
+
+#ifndef SCAN_GATHER_MAX_BLKLEN
+#define SCAN_GATHER_MAX_BLKLEN ((uint64_t)1 << 27) //!< Maximum block length for the SIMD gather of the strided items (the offsets of 8 items must fit in 32 bits)
+#endif
+
+//!< \cond
+
+#if defined(BINSEARCH_AVX2)
+#define GATHER_BSWAP_uint32_t _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3)
+#define GATHER_BSWAP_uint64_t _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7)
+#define gather_order_le_m128i(T, v) (v)
+#define gather_order_be_m128i(T, v) _mm_shuffle_epi8((v), GATHER_BSWAP_##T)
+#define gather_order_le_m256i(T, v) (v)
+#define gather_order_be_m256i(T, v) _mm256_shuffle_epi8((v), _mm256_broadcastsi128_si256(GATHER_BSWAP_##T))
+
+#define SCAN_COUNT_GATHER_BLOCK_uint32_t(O) \
+    if (blklen <= SCAN_GATHER_MAX_BLKLEN) \
+    { \
+        const __m256i bias = _mm256_set1_epi32((int)0x80000000); \
+        const __m256i s = _mm256_xor_si256(_mm256_set1_epi32((int)search), bias); \
+        const __m256i idx = _mm256_mullo_epi32(_mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0), _mm256_set1_epi32((int)blklen)); \
+        for (; (i + 8) <= last; i += 8) \
+        { \
+            __m256i v = _mm256_xor_si256(gather_order_##O##_m256i(uint32_t, _mm256_i32gather_epi32((const int *)(const void *)(src + get_address(blklen, blkpos, i)), idx, 1)), bias); \
+            cnt += (uint64_t)__builtin_popcount((unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(s, v)))); \
+        } \
+    }
+#define SCAN_COUNT_GATHER_BLOCK_uint64_t(O) \
+    if (blklen <= SCAN_GATHER_MAX_BLKLEN) \
+    { \
+        const __m256i bias = _mm256_set1_epi64x((long long)0x8000000000000000); \
+        const __m256i s = _mm256_xor_si256(_mm256_set1_epi64x((long long)search), bias); \
+        const __m128i idx = _mm_mullo_epi32(_mm_set_epi32(3, 2, 1, 0), _mm_set1_epi32((int)blklen)); \
+        for (; (i + 4) <= last; i += 4) \
+        { \
+            __m256i v = _mm256_xor_si256(gather_order_##O##_m256i(uint64_t, _mm256_i32gather_epi64((const long long *)(const void *)(src + get_address(blklen, blkpos, i)), idx, 1)), bias); \
+            cnt += (uint64_t)__builtin_popcount((unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(s, v)))); \
+        } \
+    }
+#else
+#define SCAN_COUNT_GATHER_BLOCK_uint32_t(O)
+#define SCAN_COUNT_GATHER_BLOCK_uint64_t(O)
+#endif
+
+#define SCAN_COUNT_GATHER_BLOCK_uint8_t(O)
+#define SCAN_COUNT_GATHER_BLOCK_uint16_t(O)
+
+//!< \endcond
+
+/**
+ * Count the number of items in the [first, last) range of a memory mapped binary file
+ * containing adjacent blocks of data, that are less than the search value.
+ * The strided uint32_t and uint64_t items are compared 8 or 4 at a time with the AVX2 gather instructions.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_scan_count_lt(O, T) \
+/** Count the number of items in the [first, last) range that are less than the search value.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to compare inside a binary block.
+@param first     First element to scan.
+@param last      Element (up to but not including) where to end the scan.
+@param search    Unsigned number to compare (type T).
+@return Number of items less than the search value.
+*/ \
+BINSEARCH_KERNEL(scan_count_lt_##O##_##T, (const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, T search)) \
+{ \
+    uint64_t i = first, cnt = 0; \
+    SCAN_COUNT_GATHER_BLOCK_##T(O) \
+    for (; i < last; i++) \
+    { \
+        cnt += (uint64_t)(order_##O##_##T(*(get_src_offset(T, src, get_address(blklen, blkpos, i)))) < search); \
+    } \
+    return cnt; \
+}
+
+define_scan_count_lt(be, uint8_t)
+define_scan_count_lt(be, uint16_t)
+define_scan_count_lt(be, uint32_t)
+define_scan_count_lt(be, uint64_t)
+define_scan_count_lt(le, uint8_t)
+define_scan_count_lt(le, uint16_t)
+define_scan_count_lt(le, uint32_t)
+define_scan_count_lt(le, uint64_t)
+
+/**
+ * Count the number of items in the [first, last) range of a memory mapped binary file
+ * containing adjacent blocks of data, that are less or equal than the search value.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ * @param M Maximum value for the type T.
+ */
+#define define_scan_count_le(O, T, M) \
+/** Count the number of items in the [first, last) range that are less or equal than the search value.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to compare inside a binary block.
+@param first     First element to scan.
+@param last      Element (up to but not including) where to end the scan.
+@param search    Unsigned number to compare (type T).
+@return Number of items less or equal than the search value.
+*/ \
+static inline uint64_t scan_count_le_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, T search) \
+{ \
+    if (search == (M)) \
+    { \
+        return (last > first) ? (last - first) : 0; \
+    } \
+    return scan_count_lt_##O##_##T(src, blklen, blkpos, first, last, (T)(search + 1)); \
+}
+
+define_scan_count_le(be, uint8_t, UINT8_MAX)
+define_scan_count_le(be, uint16_t, UINT16_MAX)
+define_scan_count_le(be, uint32_t, UINT32_MAX)
+define_scan_count_le(be, uint64_t, UINT64_MAX)
+define_scan_count_le(le, uint8_t, UINT8_MAX)
+define_scan_count_le(le, uint16_t, UINT16_MAX)
+define_scan_count_le(le, uint32_t, UINT32_MAX)
+define_scan_count_le(le, uint64_t, UINT64_MAX)
+
+#define FIND_HYBRID_LOOP_BLOCK \
+    while ((*first < *last) && ((*last - *first) > scan)) \
+    { \
+        middle = get_middle_point(*first, *last);
+
+#define FIND_HYBRID_START_LOOP_BLOCK(T) \
+FIND_START_BLOCK(T) \
+FIND_HYBRID_LOOP_BLOCK
+
+#define FIND_FIRST_HYBRID_SCAN_BLOCK(COUNT) \
+    *first += (COUNT); \
+    *last = *first; \
+    middle = *first;
+
+#define FIND_LAST_HYBRID_SCAN_BLOCK(COUNT) \
+    *first += (COUNT); \
+    *last = *first; \
+    middle = *first; \
+    --middle;
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * finishing the small ranges with a linear scan.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_first_hybrid(O, T) \
+/** Search for the first occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+The binary search continues until the range contains no more than "scan" items,
+then the position is found with a linear scan.
+This returns the same results of find_first_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param scan      Maximum number of items to scan linearly (e.g. HYBRID_SCAN_##T).
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t find_first_hybrid_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t scan, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_HYBRID_START_LOOP_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+FIND_FIRST_INNER_CHECK \
+FIND_FIRST_HYBRID_SCAN_BLOCK(scan_count_lt_##O##_##T(src, blklen, blkpos, *first, *last, search)) \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_first_hybrid(be, uint8_t)
+define_find_first_hybrid(be, uint16_t)
+define_find_first_hybrid(be, uint32_t)
+define_find_first_hybrid(be, uint64_t)
+define_find_first_hybrid(le, uint8_t)
+define_find_first_hybrid(le, uint16_t)
+define_find_first_hybrid(le, uint32_t)
+define_find_first_hybrid(le, uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * finishing the small ranges with a linear scan.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_last_hybrid(O, T) \
+/** Search for the last occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+The binary search continues until the range contains no more than "scan" items,
+then the position is found with a linear scan.
+This returns the same results of find_last_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param scan      Maximum number of items to scan linearly (e.g. HYBRID_SCAN_##T).
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t find_last_hybrid_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t scan, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_HYBRID_START_LOOP_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+FIND_LAST_INNER_CHECK \
+FIND_LAST_HYBRID_SCAN_BLOCK(scan_count_le_##O##_##T(src, blklen, blkpos, *first, *last, search)) \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_last_hybrid(be, uint8_t)
+define_find_last_hybrid(be, uint16_t)
+define_find_last_hybrid(be, uint32_t)
+define_find_last_hybrid(be, uint64_t)
+define_find_last_hybrid(le, uint8_t)
+define_find_last_hybrid(le, uint16_t)
+define_find_last_hybrid(le, uint32_t)
+define_find_last_hybrid(le, uint64_t)
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * finishing the small ranges with a SIMD linear scan.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_first_hybrid(T) \
+/** Search for the first occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The binary search continues until the range contains no more than "scan" items,
+then the position is found with a SIMD linear scan.
+This returns the same results of col_find_first_##T.
+@param src       Memory mapped file address.
+@param scan      Maximum number of items to scan linearly (e.g. HYBRID_SCAN_##T).
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t col_find_first_hybrid_##T(const T *src, uint64_t scan, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_HYBRID_START_LOOP_BLOCK(T) \
+COL_GET_ITEM_TASK \
+FIND_FIRST_INNER_CHECK \
+FIND_FIRST_HYBRID_SCAN_BLOCK(col_scan_count_lt_##T(src, *first, *last, search)) \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_first_hybrid(uint8_t)
+define_col_find_first_hybrid(uint16_t)
+define_col_find_first_hybrid(uint32_t)
+define_col_find_first_hybrid(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * finishing the small ranges with a SIMD linear scan.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_last_hybrid(T) \
+/** Search for the last occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The binary search continues until the range contains no more than "scan" items,
+then the position is found with a SIMD linear scan.
+This returns the same results of col_find_last_##T.
+@param src       Memory mapped file address.
+@param scan      Maximum number of items to scan linearly (e.g. HYBRID_SCAN_##T).
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t col_find_last_hybrid_##T(const T *src, uint64_t scan, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_HYBRID_START_LOOP_BLOCK(T) \
+COL_GET_ITEM_TASK \
+FIND_LAST_INNER_CHECK \
+FIND_LAST_HYBRID_SCAN_BLOCK(col_scan_count_le_##T(src, *first, *last, search)) \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_last_hybrid(uint8_t)
+define_col_find_last_hybrid(uint16_t)
+define_col_find_last_hybrid(uint32_t)
+define_col_find_last_hybrid(uint64_t)
+
+// --- EQUAL RUN ---
+
+// The equal run functions return in one call the number of consecutive items,
+// starting from a position, that are equal to the search value, replacing a loop
+// of has_next calls. The items are compared in the file byte order against the
+// search value (and bit mask) converted once, so no per-item byte swap is needed
+// and several items can be compared at once with SIMD instructions.
+
+//!< \cond
+
+#define SCAN_EQUAL_RUN_SIMD_BLOCK(W, FULL, EQMASK, SHIFT) \
+    for (; (i + (W)) <= last; i += (W)) \
+    { \
+        unsigned int eq = (unsigned int)(EQMASK); \
+        if (eq != (FULL)) \
+        { \
+            return ((i - pos) + ((uint64_t)__builtin_ctz(~eq) >> (SHIFT))); \
+        } \
+    }
+
+#define SCAN_EQUAL_RUN_END_BLOCK(ITEM) \
+    while ((i < last) && (((ITEM) & mask) == value)) \
+    { \
+        ++i; \
+    } \
+    return (i - pos);
+
+#if defined(BINSEARCH_SSE2)
+// Emulate the SSE4.1 64 bit equality comparison using SSE2 instructions.
+static inline __m128i sse2_cmpeq_epi64(__m128i a, __m128i b)
+{
+    __m128i r = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(r, _mm_shuffle_epi32(r, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+#endif
+
+//!< \endcond
+
+/**
+ * Returns the number of consecutive uint8_t items src[pos..last) where (item & mask) == value.
+ *
+ * @param src       Memory buffer containing contiguos uint8_t values.
+ * @param pos       Position of the first item to compare.
+ * @param last      Element (up to but not including) where to end the scan.
+ * @param mask      Bit mask applied to each item.
+ * @param value     Value to compare with the masked items.
+ *
+ * @return Length of the run of matching items starting at pos.
+ */
+BINSEARCH_KERNEL(col_scan_equal_run_mask_uint8_t, (const uint8_t *src, uint64_t pos, uint64_t last, uint8_t mask, uint8_t value))
+{
+    uint64_t i = pos;
+#if defined(BINSEARCH_AVX2)
+    const __m256i m = _mm256_set1_epi8((char)mask);
+    const __m256i v = _mm256_set1_epi8((char)value);
+    SCAN_EQUAL_RUN_SIMD_BLOCK(32, 0xFFFFFFFFU, _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(_mm256_loadu_si256((const __m256i *)(const void *)(src + i)), m), v)), 0)
+#elif defined(BINSEARCH_SSE2)
+    const __m128i m = _mm_set1_epi8((char)mask);
+    const __m128i v = _mm_set1_epi8((char)value);
+    SCAN_EQUAL_RUN_SIMD_BLOCK(16, 0xFFFFU, _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128((const __m128i *)(const void *)(src + i)), m), v)), 0)
+#endif
+    SCAN_EQUAL_RUN_END_BLOCK(src[i])
+}
+
+/**
+ * Returns the number of consecutive uint16_t items src[pos..last) where (item & mask) == value.
+ *
+ * @param src       Memory buffer containing contiguos uint16_t values.
+ * @param pos       Position of the first item to compare.
+ * @param last      Element (up to but not including) where to end the scan.
+ * @param mask      Bit mask applied to each item.
+ * @param value     Value to compare with the masked items.
+ *
+ * @return Length of the run of matching items starting at pos.
+ */
+BINSEARCH_KERNEL(col_scan_equal_run_mask_uint16_t, (const uint16_t *src, uint64_t pos, uint64_t last, uint16_t mask, uint16_t value))
+{
+    uint64_t i = pos;
+#if defined(BINSEARCH_AVX2)
+    const __m256i m = _mm256_set1_epi16((short)mask);
+    const __m256i v = _mm256_set1_epi16((short)value);
+    SCAN_EQUAL_RUN_SIMD_BLOCK(16, 0xFFFFFFFFU, _mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(_mm256_loadu_si256((const __m256i *)(const void *)(src + i)), m), v)), 1)
+#elif defined(BINSEARCH_SSE2)
+    const __m128i m = _mm_set1_epi16((short)mask);
+    const __m128i v = _mm_set1_epi16((short)value);
+    SCAN_EQUAL_RUN_SIMD_BLOCK(8, 0xFFFFU, _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_loadu_si128((const __m128i *)(const void *)(src + i)), m), v)), 1)
+#endif
+    SCAN_EQUAL_RUN_END_BLOCK(src[i])
+}
+
+/**
+ * Returns the number of consecutive uint32_t items src[pos..last) where (item & mask) == value.
+ *
+ * @param src       Memory buffer containing contiguos uint32_t values.
+ * @param pos       Position of the first item to compare.
+ * @param last      Element (up to but not including) where to end the scan.
+ * @param mask      Bit mask applied to each item.
+ * @param value     Value to compare with the masked items.
+ *
+ * @return Length of the run of matching items starting at pos.
+ */
+BINSEARCH_KERNEL(col_scan_equal_run_mask_uint32_t, (const uint32_t *src, uint64_t pos, uint64_t last, uint32_t mask, uint32_t value))
+{
+    uint64_t i = pos;
+#if defined(BINSEARCH_AVX512)
+    const __m512i m = _mm512_set1_epi32((int)mask);
+    const __m512i v = _mm512_set1_epi32((int)value);
+    SCAN_EQUAL_RUN_SIMD_BLOCK(16, 0xFFFFU, _mm512_cmpeq_epu32_mask(_mm512_and_si512(_mm512_loadu_si512((const void *)(src + i)), m), v), 0)
+#elif defined(BINSEARCH_AVX2)
+    const __m256i m = _mm256_set1_epi32((int)mask);
+    const __m256i v = _mm256_set1_epi32((int)value);
+    SCAN_EQUAL_RUN_SIMD_BLOCK(8, 0xFFU, _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_loadu_si256((const __m256i *)(const void *)(src + i)), m), v))), 0)
+#elif defined(BINSEARCH_SSE2)
+    const __m128i m = _mm_set1_epi32((int)mask);
+    const __m128i v = _mm_set1_epi32((int)value);
+    SCAN_EQUAL_RUN_SIMD_BLOCK(4, 0xFU, _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i *)(const void *)(src + i)), m), v))), 0)
+#endif
+    SCAN_EQUAL_RUN_END_BLOCK(src[i])
+}
+
+/**
+ * Returns the number of consecutive uint64_t items src[pos..last) where (item & mask) == value.
+ *
+ * @param src       Memory buffer containing contiguos uint64_t values.
+ * @param pos       Position of the first item to compare.
+ * @param last      Element (up to but not including) where to end the scan.
+ * @param mask      Bit mask applied to each item.
+ * @param value     Value to compare with the masked items.
+ *
+ * @return Length of the run of matching items starting at pos.
+ */
+BINSEARCH_KERNEL(col_scan_equal_run_mask_uint64_t, (const uint64_t *src, uint64_t pos, uint64_t last, uint64_t mask, uint64_t value))
+{
+    uint64_t i = pos;
+#if defined(BINSEARCH_AVX512)
+    const __m512i m = _mm512_set1_epi64((long long)mask);
+    const __m512i v = _mm512_set1_epi64((long long)value);
+    SCAN_EQUAL_RUN_SIMD_BLOCK(8, 0xFFU, _mm512_cmpeq_epu64_mask(_mm512_and_si512(_mm512_loadu_si512((const void *)(src + i)), m), v), 0)
+#elif defined(BINSEARCH_AVX2)
+    const __m256i m = _mm256_set1_epi64x((long long)mask);
+    const __m256i v = _mm256_set1_epi64x((long long)value);
+    SCAN_EQUAL_RUN_SIMD_BLOCK(4, 0xFU, _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(_mm256_loadu_si256((const __m256i *)(const void *)(src + i)), m), v))), 0)
+#elif defined(BINSEARCH_SSE2)
+    const __m128i m = _mm_set1_epi64x((long long)mask);
+    const __m128i v = _mm_set1_epi64x((long long)value);
+    SCAN_EQUAL_RUN_SIMD_BLOCK(2, 0x3U, _mm_movemask_pd(_mm_castsi128_pd(sse2_cmpeq_epi64(_mm_and_si128(_mm_loadu_si128((const __m128i *)(const void *)(src + i)), m), v))), 0)
+#endif
+    SCAN_EQUAL_RUN_END_BLOCK(src[i])
+}
+
+//!< \cond
+
+#define SCAN_EQUAL_RUN_GATHER_BLOCK_uint8_t
+#define SCAN_EQUAL_RUN_GATHER_BLOCK_uint16_t
+
+#if defined(BINSEARCH_AVX2)
+#define SCAN_EQUAL_RUN_GATHER_BLOCK_uint32_t \
+    if (blklen <= SCAN_GATHER_MAX_BLKLEN) \
+    { \
+        const __m256i m = _mm256_set1_epi32((int)mask); \
+        const __m256i v = _mm256_set1_epi32((int)value); \
+        const __m256i idx = _mm256_mullo_epi32(_mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0), _mm256_set1_epi32((int)blklen)); \
+        SCAN_EQUAL_RUN_SIMD_BLOCK(8, 0xFFU, _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_i32gather_epi32((const int *)(const void *)(src + get_address(blklen, blkpos, i)), idx, 1), m), v))), 0) \
+    }
+#define SCAN_EQUAL_RUN_GATHER_BLOCK_uint64_t \
+    if (blklen <= SCAN_GATHER_MAX_BLKLEN) \
+    { \
+        const __m256i m = _mm256_set1_epi64x((long long)mask); \
+        const __m256i v = _mm256_set1_epi64x((long long)value); \
+        const __m128i idx = _mm_mullo_epi32(_mm_set_epi32(3, 2, 1, 0), _mm_set1_epi32((int)blklen)); \
+        SCAN_EQUAL_RUN_SIMD_BLOCK(4, 0xFU, _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(_mm256_i32gather_epi64((const long long *)(const void *)(src + get_address(blklen, blkpos, i)), idx, 1), m), v))), 0) \
+    }
+#else
+#define SCAN_EQUAL_RUN_GATHER_BLOCK_uint32_t
+#define SCAN_EQUAL_RUN_GATHER_BLOCK_uint64_t
+#endif
+
+//!< \endcond
+
+/**
+ * Generic function to return the number of consecutive items of a memory mapped binary file
+ * containing adjacent blocks of data, where (item & mask) == value, comparing the raw file bytes.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_scan_equal_run_mask(T) \
+/** Returns the number of consecutive items [pos..last), where (item & mask) == value.
+The items, mask and value are compared in the file byte order.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to compare inside a binary block.
+@param pos       Position of the first item to compare.
+@param last      Element (up to but not including) where to end the scan.
+@param mask      Bit mask applied to each item (file byte order).
+@param value     Value to compare with the masked items (file byte order).
+@return Length of the run of matching items starting at pos.
+*/ \
+BINSEARCH_KERNEL(scan_equal_run_mask_##T, (const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t pos, uint64_t last, T mask, T value)) \
+{ \
+    uint64_t i = pos; \
+    SCAN_EQUAL_RUN_GATHER_BLOCK_##T \
+    SCAN_EQUAL_RUN_END_BLOCK(*(get_src_offset(T, src, get_address(blklen, blkpos, i)))) \
+}
+
+define_scan_equal_run_mask(uint8_t)
+define_scan_equal_run_mask(uint16_t)
+define_scan_equal_run_mask(uint32_t)
+define_scan_equal_run_mask(uint64_t)
+
+/**
+ * Generic function to return the length of the run of items equal to the search value,
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_scan_equal_run(O, T) \
+/** Returns the number of consecutive items, starting at pos, that are equal to the search value.
+This replaces a loop of has_next_##O##_##T calls:
+the run returned for the item found by find_first_##O##_##T ends at (pos + length).
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param pos       Position of the first item to compare.
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Length of the run of items equal to the search value, starting at pos (0 if the item at pos is different).
+*/ \
+static inline uint64_t scan_equal_run_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t pos, uint64_t last, T search) \
+{ \
+    return scan_equal_run_mask_##T(src, blklen, blkpos, pos, last, (T)~(T)0, (T)order_##O##_##T(search)); \
+}
+
+define_scan_equal_run(be, uint8_t)
+define_scan_equal_run(be, uint16_t)
+define_scan_equal_run(be, uint32_t)
+define_scan_equal_run(be, uint64_t)
+define_scan_equal_run(le, uint8_t)
+define_scan_equal_run(le, uint16_t)
+define_scan_equal_run(le, uint32_t)
+define_scan_equal_run(le, uint64_t)
+
+/**
+ * Generic function to return the length of the run of items with the bits between
+ * bitstart and bitend equal to the search value, on a memory mapped binary file
+ * containing adjacent blocks of sorted binary data.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_scan_equal_run_sub(O, T) \
+/** Returns the number of consecutive items, starting at pos, where the bits between bitstart and bitend are equal to the search value.
+This replaces a loop of has_next_sub_##O##_##T calls:
+the run returned for the item found by find_first_sub_##O##_##T ends at (pos + length).
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param bitstart  First bit position to consider (usually 0).
+@param bitend    Last bit position to consider (usually the last bit, e.g. 7 for uint8_t, 15 for uint16_t, etc).
+@param pos       Position of the first item to compare.
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Length of the run of items matching the search value, starting at pos (0 if the item at pos is different).
+*/ \
+static inline uint64_t scan_equal_run_sub_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint8_t bitstart, uint8_t bitend, uint64_t pos, uint64_t last, T search) \
+{ \
+    SUB_ITEM_VARS(T) \
+    if ((search & bitmask) != search) \
+    { \
+        return 0; \
+    } \
+    return scan_equal_run_mask_##T(src, blklen, blkpos, pos, last, (T)order_##O##_##T((T)(bitmask << rshift)), (T)order_##O##_##T((T)(search << rshift))); \
+}
+
+define_scan_equal_run_sub(be, uint8_t)
+define_scan_equal_run_sub(be, uint16_t)
+define_scan_equal_run_sub(be, uint32_t)
+define_scan_equal_run_sub(be, uint64_t)
+define_scan_equal_run_sub(le, uint8_t)
+define_scan_equal_run_sub(le, uint16_t)
+define_scan_equal_run_sub(le, uint32_t)
+define_scan_equal_run_sub(le, uint64_t)
+
+/**
+ * Generic function to return the length of the run of items equal to the search value,
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_scan_equal_run(T) \
+/** Returns the number of consecutive items, starting at pos, that are equal to the search value.
+This replaces a loop of col_has_next_##T calls:
+the run returned for the item found by col_find_first_##T ends at (pos + length).
+@param src       Memory mapped file address.
+@param pos       Position of the first item to compare.
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Length of the run of items equal to the search value, starting at pos (0 if the item at pos is different).
+*/ \
+static inline uint64_t col_scan_equal_run_##T(const T *src, uint64_t pos, uint64_t last, T search) \
+{ \
+    return col_scan_equal_run_mask_##T(src, pos, last, (T)~(T)0, search); \
+}
+
+define_col_scan_equal_run(uint8_t)
+define_col_scan_equal_run(uint16_t)
+define_col_scan_equal_run(uint32_t)
+define_col_scan_equal_run(uint64_t)
+
+/**
+ * Generic function to return the length of the run of items with the bits between
+ * bitstart and bitend equal to the search value, on a memory buffer containing
+ * contiguos blocks of unsigned integers of the same type.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_scan_equal_run_sub(T) \
+/** Returns the number of consecutive items, starting at pos, where the bits between bitstart and bitend are equal to the search value.
+This replaces a loop of col_has_next_sub_##T calls:
+the run returned for the item found by col_find_first_sub_##T ends at (pos + length).
+@param src       Memory mapped file address.
+@param bitstart  First bit position to consider (usually 0).
+@param bitend    Last bit position to consider (usually the last bit, e.g. 7 for uint8_t, 15 for uint16_t, etc).
+@param pos       Position of the first item to compare.
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Length of the run of items matching the search value, starting at pos (0 if the item at pos is different).
+*/ \
+static inline uint64_t col_scan_equal_run_sub_##T(const T *src, uint8_t bitstart, uint8_t bitend, uint64_t pos, uint64_t last, T search) \
+{ \
+    SUB_ITEM_VARS(T) \
+    if ((search & bitmask) != search) \
+    { \
+        return 0; \
+    } \
+    return col_scan_equal_run_mask_##T(src, pos, last, (T)(bitmask << rshift), (T)(search << rshift)); \
+}
+
+define_col_scan_equal_run_sub(uint8_t)
+define_col_scan_equal_run_sub(uint16_t)
+define_col_scan_equal_run_sub(uint32_t)
+define_col_scan_equal_run_sub(uint64_t)
+
+// --- INTERPOLATION ---
+
+#ifndef INTERP_MIN_RANGE
+#define INTERP_MIN_RANGE 16 //!< Below this range size the interpolation search continues as a binary search
+#endif
+
+#ifndef INTERP_SEQ_MAX_STEPS
+#define INTERP_SEQ_MAX_STEPS 32 //!< Range size below which the interpolation-sequential search scans the values sequentially
+#endif
+
+// The interpolation blocks narrow the [first, last] range around the searched
+// position by estimating it from the values at the range boundaries.
+// When a probe does not halve the range, a bisection probe is added, so the
+// number of probes is at most twice the one of the binary search.
+// The interpolation-sequential blocks stop at a wider range and complete the
+// search with a sequential scan from the last estimated position.
+// Any remaining range is completed by the binary search loop, so the results
+// are the same of the binary search functions.
+
+#define INTERP_START_BLOCK(T) \
+    uint64_t size; \
+    T vlo, vhi; \
+    if ((*first < *last) && ((*last - *first) > INTERP_MIN_RANGE)) \
+    { \
+        middle = *first;
+
+#define INTERP_BOUNDS_BLOCK \
+        vlo = x; \
+        middle = (*last - 1);
+
+#define INTERP_BOUNDS_CHECK(C) \
+        vhi = x; \
+        if (!(vlo C search)) \
+        { \
+            *last = *first; \
+        } \
+        else if (vhi C search) \
+        { \
+            *first = *last; \
+        } \
+        else \
+        { \
+            ++(*first); \
+            --(*last); \
+        }
+
+#define INTERP_MIDDLE_POINT \
+            middle = (*first + (uint64_t)(((double)(search - vlo) / (double)(vhi - vlo)) * (double)size)); \
+            middle = (middle < *last) ? middle : (*last - 1);
+
+#define INTERP_UPDATE_TASK(C) \
+            if (x C search) \
+            { \
+                *first = (middle + 1); \
+                vlo = x; \
+            } \
+            else \
+            { \
+                *last = middle; \
+                vhi = x; \
+            }
+
+#define INTERP_LOOP_BLOCK(R) \
+        while ((*last - *first) > (R)) \
+        { \
+            size = (*last - *first); \
+            INTERP_MIDDLE_POINT
+
+#define INTERP_INNER_CHECK(C) \
+            INTERP_UPDATE_TASK(C) \
+            if ((*last - *first) > (size >> 1)) \
+            { \
+                middle = get_middle_point(*first, *last);
+
+#define INTERP_END_BLOCK(C) \
+                INTERP_UPDATE_TASK(C) \
+            } \
+        }
+
+#define INTERP_CLOSE_BLOCK \
+    }
+
+#define INTERP_SEQ_LOOP_BLOCK \
+        if (*first < *last) \
+        { \
+            uint64_t step; \
+            size = (*last - *first); \
+            INTERP_MIDDLE_POINT
+
+#define INTERP_SEQ_INNER_CHECK(C) \
+            step = (uint64_t)(x C search); \
+            if (step) \
+            { \
+                *first = (middle + 1); \
+            } \
+            else \
+            { \
+                *last = middle; \
+            } \
+            size = INTERP_SEQ_MAX_STEPS; \
+            while ((*first < *last) && (size > 0)) \
+            { \
+                middle = step ? *first : (*last - 1);
+
+#define INTERP_SEQ_END_BLOCK(C) \
+                if (x C search) \
+                { \
+                    *first = step ? (*first + 1) : *last; \
+                } \
+                else \
+                { \
+                    *last = step ? *first : (*last - 1); \
+                } \
+                --size; \
+            } \
+        }
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using an interpolation search.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_first_interp(O, T) \
+/** Search for the first occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+At each step the position is estimated from the values at the range boundaries,
+with a fallback to a bisection step when the range is not halved.
+This returns the same results of find_first_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t find_first_interp_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+INTERP_START_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+INTERP_BOUNDS_BLOCK \
+GET_ITEM_TASK(O, T) \
+INTERP_BOUNDS_CHECK(<) \
+INTERP_LOOP_BLOCK(INTERP_MIN_RANGE) \
+GET_ITEM_TASK(O, T) \
+INTERP_INNER_CHECK(<) \
+GET_ITEM_TASK(O, T) \
+INTERP_END_BLOCK(<) \
+INTERP_CLOSE_BLOCK \
+FIND_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+FIND_FIRST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_first_interp(be, uint8_t)
+define_find_first_interp(be, uint16_t)
+define_find_first_interp(be, uint32_t)
+define_find_first_interp(be, uint64_t)
+define_find_first_interp(le, uint8_t)
+define_find_first_interp(le, uint16_t)
+define_find_first_interp(le, uint32_t)
+define_find_first_interp(le, uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using an interpolation search.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_last_interp(O, T) \
+/** Search for the last occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+At each step the position is estimated from the values at the range boundaries,
+with a fallback to a bisection step when the range is not halved.
+This returns the same results of find_last_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t find_last_interp_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+INTERP_START_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+INTERP_BOUNDS_BLOCK \
+GET_ITEM_TASK(O, T) \
+INTERP_BOUNDS_CHECK(<=) \
+INTERP_LOOP_BLOCK(INTERP_MIN_RANGE) \
+GET_ITEM_TASK(O, T) \
+INTERP_INNER_CHECK(<=) \
+GET_ITEM_TASK(O, T) \
+INTERP_END_BLOCK(<=) \
+INTERP_CLOSE_BLOCK \
+FIND_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+FIND_LAST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_last_interp(be, uint8_t)
+define_find_last_interp(be, uint16_t)
+define_find_last_interp(be, uint32_t)
+define_find_last_interp(be, uint64_t)
+define_find_last_interp(le, uint8_t)
+define_find_last_interp(le, uint16_t)
+define_find_last_interp(le, uint32_t)
+define_find_last_interp(le, uint64_t)
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using an interpolation-sequential search.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_first_interp_seq(O, T) \
+/** Search for the first occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+The position is estimated from the values at the range boundaries until the range
+is smaller than INTERP_SEQ_MAX_STEPS, then the values are scanned sequentially
+from the last estimated position.
+This returns the same results of find_first_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t find_first_interp_seq_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+INTERP_START_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+INTERP_BOUNDS_BLOCK \
+GET_ITEM_TASK(O, T) \
+INTERP_BOUNDS_CHECK(<) \
+INTERP_LOOP_BLOCK(INTERP_SEQ_MAX_STEPS) \
+GET_ITEM_TASK(O, T) \
+INTERP_INNER_CHECK(<) \
+GET_ITEM_TASK(O, T) \
+INTERP_END_BLOCK(<) \
+INTERP_SEQ_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+INTERP_SEQ_INNER_CHECK(<) \
+GET_ITEM_TASK(O, T) \
+INTERP_SEQ_END_BLOCK(<) \
+INTERP_CLOSE_BLOCK \
+FIND_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+FIND_FIRST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_first_interp_seq(be, uint8_t)
+define_find_first_interp_seq(be, uint16_t)
+define_find_first_interp_seq(be, uint32_t)
+define_find_first_interp_seq(be, uint64_t)
+define_find_first_interp_seq(le, uint8_t)
+define_find_first_interp_seq(le, uint16_t)
+define_find_first_interp_seq(le, uint32_t)
+define_find_first_interp_seq(le, uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using an interpolation-sequential search.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_last_interp_seq(O, T) \
+/** Search for the last occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+The position is estimated from the values at the range boundaries until the range
+is smaller than INTERP_SEQ_MAX_STEPS, then the values are scanned sequentially
+from the last estimated position.
+This returns the same results of find_last_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t find_last_interp_seq_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+INTERP_START_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+INTERP_BOUNDS_BLOCK \
+GET_ITEM_TASK(O, T) \
+INTERP_BOUNDS_CHECK(<=) \
+INTERP_LOOP_BLOCK(INTERP_SEQ_MAX_STEPS) \
+GET_ITEM_TASK(O, T) \
+INTERP_INNER_CHECK(<=) \
+GET_ITEM_TASK(O, T) \
+INTERP_END_BLOCK(<=) \
+INTERP_SEQ_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+INTERP_SEQ_INNER_CHECK(<=) \
+GET_ITEM_TASK(O, T) \
+INTERP_SEQ_END_BLOCK(<=) \
+INTERP_CLOSE_BLOCK \
+FIND_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+FIND_LAST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_last_interp_seq(be, uint8_t)
+define_find_last_interp_seq(be, uint16_t)
+define_find_last_interp_seq(be, uint32_t)
+define_find_last_interp_seq(be, uint64_t)
+define_find_last_interp_seq(le, uint8_t)
+define_find_last_interp_seq(le, uint16_t)
+define_find_last_interp_seq(le, uint32_t)
+define_find_last_interp_seq(le, uint64_t)
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using an interpolation search.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_first_interp(T) \
+/** Search for the first occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+At each step the position is estimated from the values at the range boundaries,
+with a fallback to a bisection step when the range is not halved.
+This returns the same results of col_find_first_##T.
+@param src       Memory mapped file address.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t col_find_first_interp_##T(const T *src, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+INTERP_START_BLOCK(T) \
+COL_GET_ITEM_TASK \
+INTERP_BOUNDS_BLOCK \
+COL_GET_ITEM_TASK \
+INTERP_BOUNDS_CHECK(<) \
+INTERP_LOOP_BLOCK(INTERP_MIN_RANGE) \
+COL_GET_ITEM_TASK \
+INTERP_INNER_CHECK(<) \
+COL_GET_ITEM_TASK \
+INTERP_END_BLOCK(<) \
+INTERP_CLOSE_BLOCK \
+FIND_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_FIRST_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_first_interp(uint8_t)
+define_col_find_first_interp(uint16_t)
+define_col_find_first_interp(uint32_t)
+define_col_find_first_interp(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using an interpolation search.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_last_interp(T) \
+/** Search for the last occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+At each step the position is estimated from the values at the range boundaries,
+with a fallback to a bisection step when the range is not halved.
+This returns the same results of col_find_last_##T.
+@param src       Memory mapped file address.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t col_find_last_interp_##T(const T *src, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+INTERP_START_BLOCK(T) \
+COL_GET_ITEM_TASK \
+INTERP_BOUNDS_BLOCK \
+COL_GET_ITEM_TASK \
+INTERP_BOUNDS_CHECK(<=) \
+INTERP_LOOP_BLOCK(INTERP_MIN_RANGE) \
+COL_GET_ITEM_TASK \
+INTERP_INNER_CHECK(<=) \
+COL_GET_ITEM_TASK \
+INTERP_END_BLOCK(<=) \
+INTERP_CLOSE_BLOCK \
+FIND_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_LAST_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_last_interp(uint8_t)
+define_col_find_last_interp(uint16_t)
+define_col_find_last_interp(uint32_t)
+define_col_find_last_interp(uint64_t)
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using an interpolation-sequential search.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_first_interp_seq(T) \
+/** Search for the first occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The position is estimated from the values at the range boundaries until the range
+is smaller than INTERP_SEQ_MAX_STEPS, then the values are scanned sequentially
+from the last estimated position.
+This returns the same results of col_find_first_##T.
+@param src       Memory mapped file address.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t col_find_first_interp_seq_##T(const T *src, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+INTERP_START_BLOCK(T) \
+COL_GET_ITEM_TASK \
+INTERP_BOUNDS_BLOCK \
+COL_GET_ITEM_TASK \
+INTERP_BOUNDS_CHECK(<) \
+INTERP_LOOP_BLOCK(INTERP_SEQ_MAX_STEPS) \
+COL_GET_ITEM_TASK \
+INTERP_INNER_CHECK(<) \
+COL_GET_ITEM_TASK \
+INTERP_END_BLOCK(<) \
+INTERP_SEQ_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+INTERP_SEQ_INNER_CHECK(<) \
+COL_GET_ITEM_TASK \
+INTERP_SEQ_END_BLOCK(<) \
+INTERP_CLOSE_BLOCK \
+FIND_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_FIRST_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_first_interp_seq(uint8_t)
+define_col_find_first_interp_seq(uint16_t)
+define_col_find_first_interp_seq(uint32_t)
+define_col_find_first_interp_seq(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using an interpolation-sequential search.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_last_interp_seq(T) \
+/** Search for the last occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The position is estimated from the values at the range boundaries until the range
+is smaller than INTERP_SEQ_MAX_STEPS, then the values are scanned sequentially
+from the last estimated position.
+This returns the same results of col_find_last_##T.
+@param src       Memory mapped file address.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t col_find_last_interp_seq_##T(const T *src, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+INTERP_START_BLOCK(T) \
+COL_GET_ITEM_TASK \
+INTERP_BOUNDS_BLOCK \
+COL_GET_ITEM_TASK \
+INTERP_BOUNDS_CHECK(<=) \
+INTERP_LOOP_BLOCK(INTERP_SEQ_MAX_STEPS) \
+COL_GET_ITEM_TASK \
+INTERP_INNER_CHECK(<=) \
+COL_GET_ITEM_TASK \
+INTERP_END_BLOCK(<=) \
+INTERP_SEQ_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+INTERP_SEQ_INNER_CHECK(<=) \
+COL_GET_ITEM_TASK \
+INTERP_SEQ_END_BLOCK(<=) \
+INTERP_CLOSE_BLOCK \
+FIND_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_LAST_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_last_interp_seq(uint8_t)
+define_col_find_last_interp_seq(uint16_t)
+define_col_find_last_interp_seq(uint32_t)
+define_col_find_last_interp_seq(uint64_t)
+
+// --- HINT ---
+
+// The hint blocks gallop outward from a known position (1, 2, 4, ... items)
+// until the searched key is bracketed, then restrict [first, last] to the
+// bracket so the binary search loop completes the search in O(log(d)) steps,
+// where d is the distance between the hint and the result.
+// The C parameter is the comparison operator that sends the search to the
+// right side: < for the first occurrence and <= for the last one.
+
+#define FIND_HINT_START_BLOCK(T) \
+FIND_START_BLOCK(T) \
+    uint64_t step = 1, hpos; \
+    if (*first < *last) \
+    { \
+        middle = (hint < *first) ? *first : ((hint >= *last) ? (*last - 1) : hint);
+
+#define FIND_HINT_SPLIT_CHECK(C) \
+        hpos = middle; \
+        if (x C search) \
+        { \
+            *first = (middle + 1); \
+            while (step < (*last - hpos)) \
+            { \
+                middle = (hpos + step);
+
+#define FIND_HINT_RIGHT_CHECK(C) \
+                if (!(x C search)) \
+                { \
+                    *last = middle; \
+                    break; \
+                } \
+                *first = (middle + 1); \
+                step <<= 1; \
+            } \
+        } \
+        else \
+        { \
+            *last = middle; \
+            while (step <= (hpos - *first)) \
+            { \
+                middle = (hpos - step);
+
+#define FIND_HINT_LEFT_CHECK(C) \
+                if (x C search) \
+                { \
+                    *first = (middle + 1); \
+                    break; \
+                } \
+                *last = middle; \
+                step <<= 1; \
+            } \
+        } \
+    }
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * starting from a known position.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_first_from_hint(O, T) \
+/** Search for the first occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+The search gallops outward from the hint position and it is faster than find_first_##O##_##T
+when the result is close to the hint (e.g. the result of the previous search).
+This returns the same results of find_first_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param hint      Expected position of the result (it is clamped to the [first, last] range).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t find_first_from_hint_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t *first, uint64_t *last, uint64_t hint, T search) \
+{ \
+FIND_HINT_START_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+FIND_HINT_SPLIT_CHECK(<) \
+GET_ITEM_TASK(O, T) \
+FIND_HINT_RIGHT_CHECK(<) \
+GET_ITEM_TASK(O, T) \
+FIND_HINT_LEFT_CHECK(<) \
+FIND_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+FIND_FIRST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_first_from_hint(be, uint8_t)
+define_find_first_from_hint(be, uint16_t)
+define_find_first_from_hint(be, uint32_t)
+define_find_first_from_hint(be, uint64_t)
+define_find_first_from_hint(le, uint8_t)
+define_find_first_from_hint(le, uint16_t)
+define_find_first_from_hint(le, uint32_t)
+define_find_first_from_hint(le, uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * starting from a known position.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_last_from_hint(O, T) \
+/** Search for the last occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+The search gallops outward from the hint position and it is faster than find_last_##O##_##T
+when the result is close to the hint (e.g. the result of the previous search).
+This returns the same results of find_last_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param hint      Expected position of the result (it is clamped to the [first, last] range).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t find_last_from_hint_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t *first, uint64_t *last, uint64_t hint, T search) \
+{ \
+FIND_HINT_START_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+FIND_HINT_SPLIT_CHECK(<=) \
+GET_ITEM_TASK(O, T) \
+FIND_HINT_RIGHT_CHECK(<=) \
+GET_ITEM_TASK(O, T) \
+FIND_HINT_LEFT_CHECK(<=) \
+FIND_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+FIND_LAST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_last_from_hint(be, uint8_t)
+define_find_last_from_hint(be, uint16_t)
+define_find_last_from_hint(be, uint32_t)
+define_find_last_from_hint(be, uint64_t)
+define_find_last_from_hint(le, uint8_t)
+define_find_last_from_hint(le, uint16_t)
+define_find_last_from_hint(le, uint32_t)
+define_find_last_from_hint(le, uint64_t)
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * starting from a known position.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_first_from_hint(T) \
+/** Search for the first occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The search gallops outward from the hint position and it is faster than col_find_first_##T
+when the result is close to the hint (e.g. the result of the previous search).
+This returns the same results of col_find_first_##T.
+@param src       Memory mapped file address.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param hint      Expected position of the result (it is clamped to the [first, last] range).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t col_find_first_from_hint_##T(const T *src, uint64_t *first, uint64_t *last, uint64_t hint, T search) \
+{ \
+FIND_HINT_START_BLOCK(T) \
+COL_GET_ITEM_TASK \
+FIND_HINT_SPLIT_CHECK(<) \
+COL_GET_ITEM_TASK \
+FIND_HINT_RIGHT_CHECK(<) \
+COL_GET_ITEM_TASK \
+FIND_HINT_LEFT_CHECK(<) \
+FIND_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_FIRST_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_first_from_hint(uint8_t)
+define_col_find_first_from_hint(uint16_t)
+define_col_find_first_from_hint(uint32_t)
+define_col_find_first_from_hint(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * starting from a known position.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_last_from_hint(T) \
+/** Search for the last occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The search gallops outward from the hint position and it is faster than col_find_last_##T
+when the result is close to the hint (e.g. the result of the previous search).
+This returns the same results of col_find_last_##T.
+@param src       Memory mapped file address.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param hint      Expected position of the result (it is clamped to the [first, last] range).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t col_find_last_from_hint_##T(const T *src, uint64_t *first, uint64_t *last, uint64_t hint, T search) \
+{ \
+FIND_HINT_START_BLOCK(T) \
+COL_GET_ITEM_TASK \
+FIND_HINT_SPLIT_CHECK(<=) \
+COL_GET_ITEM_TASK \
+FIND_HINT_RIGHT_CHECK(<=) \
+COL_GET_ITEM_TASK \
+FIND_HINT_LEFT_CHECK(<=) \
+FIND_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_LAST_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_last_from_hint(uint8_t)
+define_col_find_last_from_hint(uint16_t)
+define_col_find_last_from_hint(uint32_t)
+define_col_find_last_from_hint(uint64_t)
+
+// --- RANGE ---
+
+// The range blocks search for both the first and the last occurrence of a
+// value with a single call. The two searches share the bisection steps until
+// the first item equal to the searched value is found, then the lower bound
+// is completed with a binary search on the left side, while the upper bound
+// is found by galloping (1, 2, 4, ... items) from the equal item, so the cost
+// of the second search only depends on the number of duplicates.
+
+#define FIND_RANGE_START_BLOCK(T) \
+FIND_START_BLOCK(T) \
+    uint64_t pos, end, lbound, step = 1; \
+    while (*first < *last) \
+    { \
+        middle = get_middle_point(*first, *last);
+
+#define FIND_RANGE_SPLIT_CHECK \
+        if (x < search) \
+        { \
+            *first = (middle + 1); \
+        } \
+        else if (x > search) \
+        { \
+            *last = middle; \
+        } \
+        else \
+        { \
+            break; \
+        } \
+    } \
+    if (*first >= *last) \
+    { \
+        *last = *first; \
+        return notfound; \
+    } \
+    pos = middle; \
+    end = *last; \
+    *last = pos; \
+    while (*first < *last) \
+    { \
+        middle = get_middle_point(*first, *last);
+
+#define FIND_RANGE_LOWER_CHECK \
+        if (x < search) \
+        { \
+            *first = (middle + 1); \
+        } \
+        else \
+        { \
+            *last = middle; \
+        } \
+    } \
+    lbound = *first; \
+    *first = (pos + 1); \
+    while (step < (end - pos)) \
+    { \
+        middle = (pos + step);
+
+#define FIND_RANGE_GALLOP_CHECK \
+        if (x > search) \
+        { \
+            end = middle; \
+            break; \
+        } \
+        *first = (middle + 1); \
+        step <<= 1; \
+    } \
+    *last = end; \
+    while (*first < *last) \
+    { \
+        middle = get_middle_point(*first, *last);
+
+#define FIND_RANGE_END_BLOCK \
+        if (x > search) \
+        { \
+            *last = middle; \
+        } \
+        else \
+        { \
+            *first = (middle + 1); \
+        } \
+    } \
+    *first = lbound; \
+    return lbound;
+
+/**
+ * Generic function to search for the range of items equal to an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_range(O, T) \
+/** Search for the range of items equal to an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+This is faster than calling find_first_##O##_##T and find_last_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     Pointer to the element from where to start the search (min value = 0).
+                 On return it contains the position of the first occurrence
+                 (or the insertion point if not found).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+                 On return it contains the position after the last occurrence
+                 (or the insertion point if not found).
+@param search    Unsigned number to search (type T).
+@return item number of the first occurrence if found or the initial value of last if not found.
+ */ \
+static inline uint64_t find_range_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_RANGE_START_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+FIND_RANGE_SPLIT_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_RANGE_LOWER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_RANGE_GALLOP_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_RANGE_END_BLOCK \
+}
+
+define_find_range(be, uint8_t)
+define_find_range(be, uint16_t)
+define_find_range(be, uint32_t)
+define_find_range(be, uint64_t)
+define_find_range(le, uint8_t)
+define_find_range(le, uint16_t)
+define_find_range(le, uint32_t)
+define_find_range(le, uint64_t)
+
+/**
+ * Generic function to count the items equal to an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_count(O, T) \
+/** Count the items equal to an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Number of items equal to the searched value.
+ */ \
+static inline uint64_t count_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, T search) \
+{ \
+    (void)find_range_##O##_##T(src, blklen, blkpos, &first, &last, search); \
+    return (last - first); \
+}
+
+define_count(be, uint8_t)
+define_count(be, uint16_t)
+define_count(be, uint32_t)
+define_count(be, uint64_t)
+define_count(le, uint8_t)
+define_count(le, uint16_t)
+define_count(le, uint32_t)
+define_count(le, uint64_t)
+
+/**
+ * Generic function to search for the range of items equal to an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_range(T) \
+/** Search for the range of items equal to an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+This is faster than calling col_find_first_##T and col_find_last_##T.
+@param src       Memory mapped file address.
+@param first     Pointer to the element from where to start the search (min value = 0).
+                 On return it contains the position of the first occurrence
+                 (or the insertion point if not found).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+                 On return it contains the position after the last occurrence
+                 (or the insertion point if not found).
+@param search    Unsigned number to search (type T).
+@return item number of the first occurrence if found or the initial value of last if not found.
+ */ \
+static inline uint64_t col_find_range_##T(const T *src, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_RANGE_START_BLOCK(T) \
+COL_GET_ITEM_TASK \
+FIND_RANGE_SPLIT_CHECK \
+COL_GET_ITEM_TASK \
+FIND_RANGE_LOWER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_RANGE_GALLOP_CHECK \
+COL_GET_ITEM_TASK \
+FIND_RANGE_END_BLOCK \
+}
+
+define_col_find_range(uint8_t)
+define_col_find_range(uint16_t)
+define_col_find_range(uint32_t)
+define_col_find_range(uint64_t)
+
+/**
+ * Generic function to count the items equal to an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_count(T) \
+/** Count the items equal to an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+@param src       Memory mapped file address.
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Number of items equal to the searched value.
+ */ \
+static inline uint64_t col_count_##T(const T *src, uint64_t first, uint64_t last, T search) \
+{ \
+    (void)col_find_range_##T(src, &first, &last, search); \
+    return (last - first); \
+}
+
+define_col_count(uint8_t)
+define_col_count(uint16_t)
+define_col_count(uint32_t)
+define_col_count(uint64_t)
+
+// --- TOP-LEVEL CACHE ---
+
+// The first probes of every search over the same [0, nitems) range always
+// read the same items: the middle points of the top levels of the implicit
+// binary search tree. The top-level cache stores these pivots in a compact
+// array in breadth-first order (node k has children 2k and 2k+1, index 0 is
+// unused), so the first "levels" probes are served from L1/L2 instead of the
+// mapped file. The cache array should be aligned to 64 bytes and it can be
+// pinned in memory with mlock(cache, sizeof(T) << levels).
+
+#ifndef TOPLEVEL_CACHE_LEVELS
+#define TOPLEVEL_CACHE_LEVELS 12 //!< Default number of cached levels (4096 pivots)
+#endif
+
+/**
+ * Returns the position of the item probed by the binary search at the node k of the top-level cache.
+ *
+ * @param k         Node index (1 for the root).
+ * @param nitems    Number of items in the searched range [0, nitems).
+ *
+ * @return Position of the probed item, or nitems if the node is never reached.
+ */
+static inline uint64_t toplevel_cache_middle(uint64_t k, uint64_t nitems)
+{
+    uint64_t first = 0, last = nitems, middle;
+    int b;
+    for (b = (62 - __builtin_clzll(k)); b >= 0; b--)
+    {
+        if (first >= last)
+        {
+            return nitems;
+        }
+        middle = get_middle_point(first, last);
+        if ((k >> b) & 1)
+        {
+            first = (middle + 1);
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+    return (first < last) ? get_middle_point(first, last) : nitems;
+}
+
+/**
+ * Generic function to build the top-level cache of a sorted column in a memory mapped binary file.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_build_toplevel_cache(O, T) \
+/** Build the top-level cache of the values in a memory mapped binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number inside a binary block.
+@param nitems    Number of items (rows).
+@param levels    Number of cached levels (e.g. TOPLEVEL_CACHE_LEVELS).
+@param cache     Output buffer of (1 << levels) elements, preferably aligned to 64 bytes.
+*/ \
+static inline void build_toplevel_cache_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t nitems, uint64_t levels, T *cache) \
+{ \
+    uint64_t k, middle; \
+    cache[0] = 0; \
+    for (k = 1; k < ((uint64_t)1 << levels); k++) \
+    { \
+        middle = toplevel_cache_middle(k, nitems); \
+        cache[k] = (middle < nitems) ? bytes_##O##_to_##T(src, get_address(blklen, blkpos, middle)) : 0; \
+    } \
+}
+
+define_build_toplevel_cache(be, uint8_t)
+define_build_toplevel_cache(be, uint16_t)
+define_build_toplevel_cache(be, uint32_t)
+define_build_toplevel_cache(be, uint64_t)
+define_build_toplevel_cache(le, uint8_t)
+define_build_toplevel_cache(le, uint16_t)
+define_build_toplevel_cache(le, uint32_t)
+define_build_toplevel_cache(le, uint64_t)
+
+/**
+ * Generic function to build the top-level cache of a sorted column.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_build_toplevel_cache(T) \
+/** Build the top-level cache of a column containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+@param src       Memory mapped column address (e.g. get_src_offset_##T(mf.src, mf.index[col])).
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@param levels    Number of cached levels (e.g. TOPLEVEL_CACHE_LEVELS).
+@param cache     Output buffer of (1 << levels) elements, preferably aligned to 64 bytes.
+*/ \
+static inline void col_build_toplevel_cache_##T(const T *src, uint64_t nitems, uint64_t levels, T *cache) \
+{ \
+    uint64_t k, middle; \
+    cache[0] = 0; \
+    for (k = 1; k < ((uint64_t)1 << levels); k++) \
+    { \
+        middle = toplevel_cache_middle(k, nitems); \
+        cache[k] = (middle < nitems) ? src[middle] : 0; \
+    } \
+}
+
+define_col_build_toplevel_cache(uint8_t)
+define_col_build_toplevel_cache(uint16_t)
+define_col_build_toplevel_cache(uint32_t)
+define_col_build_toplevel_cache(uint64_t)
+
+// The cached blocks follow the same path of the binary search loop reading
+// the pivots from the cache, so they are only used when the search starts
+// from the cached [0, nitems) range. The C parameter is the comparison
+// operator that sends the search to the right side: < for the first
+// occurrence and <= for the last one.
+
+#define FIND_CACHED_DESCENT_BLOCK(C) \
+    uint64_t k = 1; \
+    if ((*first == 0) && (*last == nitems)) \
+    { \
+        levels = ((uint64_t)1 << levels); \
+        while ((k < levels) && (*first < *last)) \
+        { \
+            middle = get_middle_point(*first, *last); \
+            if (cache[k] C search) \
+            { \
+                *first = (middle + 1); \
+                k = ((k << 1) + 1); \
+            } \
+            else \
+            { \
+                *last = middle; \
+                k <<= 1; \
+            } \
+        } \
+    }
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using the top-level cache.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_first_cached(O, T) \
+/** Search for the first occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+The top levels of the search are served by the cache when first = 0 and last = nitems.
+This returns the same results of find_first_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param cache     Top-level cache, as built by build_toplevel_cache_##O##_##T.
+@param levels    Number of cached levels.
+@param nitems    Number of items (rows) used to build the cache.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t find_first_cached_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const T *cache, uint64_t levels, uint64_t nitems, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+FIND_CACHED_DESCENT_BLOCK(<) \
+FIND_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+FIND_FIRST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_first_cached(be, uint8_t)
+define_find_first_cached(be, uint16_t)
+define_find_first_cached(be, uint32_t)
+define_find_first_cached(be, uint64_t)
+define_find_first_cached(le, uint8_t)
+define_find_first_cached(le, uint16_t)
+define_find_first_cached(le, uint32_t)
+define_find_first_cached(le, uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using the top-level cache.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_last_cached(O, T) \
+/** Search for the last occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+The top levels of the search are served by the cache when first = 0 and last = nitems.
+This returns the same results of find_last_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param cache     Top-level cache, as built by build_toplevel_cache_##O##_##T.
+@param levels    Number of cached levels.
+@param nitems    Number of items (rows) used to build the cache.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t find_last_cached_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const T *cache, uint64_t levels, uint64_t nitems, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+FIND_CACHED_DESCENT_BLOCK(<=) \
+FIND_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+FIND_LAST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_last_cached(be, uint8_t)
+define_find_last_cached(be, uint16_t)
+define_find_last_cached(be, uint32_t)
+define_find_last_cached(be, uint64_t)
+define_find_last_cached(le, uint8_t)
+define_find_last_cached(le, uint16_t)
+define_find_last_cached(le, uint32_t)
+define_find_last_cached(le, uint64_t)
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using the top-level cache.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_first_cached(T) \
+/** Search for the first occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The top levels of the search are served by the cache when first = 0 and last = nitems.
+This returns the same results of col_find_first_##T.
+@param src       Memory mapped file address.
+@param cache     Top-level cache, as built by col_build_toplevel_cache_##T.
+@param levels    Number of cached levels.
+@param nitems    Number of items used to build the cache.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t col_find_first_cached_##T(const T *src, const T *cache, uint64_t levels, uint64_t nitems, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+FIND_CACHED_DESCENT_BLOCK(<) \
+FIND_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_FIRST_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_first_cached(uint8_t)
+define_col_find_first_cached(uint16_t)
+define_col_find_first_cached(uint32_t)
+define_col_find_first_cached(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using the top-level cache.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_last_cached(T) \
+/** Search for the last occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The top levels of the search are served by the cache when first = 0 and last = nitems.
+This returns the same results of col_find_last_##T.
+@param src       Memory mapped file address.
+@param cache     Top-level cache, as built by col_build_toplevel_cache_##T.
+@param levels    Number of cached levels.
+@param nitems    Number of items used to build the cache.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t col_find_last_cached_##T(const T *src, const T *cache, uint64_t levels, uint64_t nitems, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+FIND_CACHED_DESCENT_BLOCK(<=) \
+FIND_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_LAST_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_last_cached(uint8_t)
+define_col_find_last_cached(uint16_t)
+define_col_find_last_cached(uint32_t)
+define_col_find_last_cached(uint64_t)
+
+// --- BATCH ---
+
+#ifndef FIND_BATCH_GROUP
+#define FIND_BATCH_GROUP 16 //!< Number of searches advanced in lockstep by the batch functions
+#endif
+
+// The batch functions search a group of keys on the same [first, last) range,
+// so every search in the group performs the same number of branchless steps.
+// The steps of the group are interleaved and the next probe of each search is
+// prefetched, so the memory accesses of different keys overlap.
+
+#define FIND_BATCH_START_BLOCK(T) \
+    uint64_t middle, i, j, g, len, half; \
+    uint64_t base[FIND_BATCH_GROUP]; \
+    T x = 0; \
+    for (i = 0; i < nkeys; i += g) \
+    { \
+        g = ((nkeys - i) < FIND_BATCH_GROUP) ? (nkeys - i) : FIND_BATCH_GROUP; \
+        for (j = 0; j < g; j++) \
+        { \
+            base[j] = first; \
+        } \
+        len = (first < last) ? (last - first) : 0; \
+        while (len > 1) \
+        { \
+            half = (len >> 1); \
+            for (j = 0; j < g; j++) \
+            { \
+                middle = (base[j] + half);
+
+#define FIND_FIRST_BATCH_INNER_CHECK \
+                base[j] = (x < keys[i + j]) ? middle : base[j]; \
+                middle = (base[j] + ((len - half) >> 1));
+
+#define FIND_LAST_BATCH_INNER_CHECK \
+                base[j] = (x > keys[i + j]) ? base[j] : middle; \
+                middle = (base[j] + ((len - half) >> 1));
+
+// The items are only read inside [first, last), or at (first - 1) for the last occurrence
+// as the single searches: any other final position always returns last, so the batch
+// searches never read outside the range of an exactly sized buffer.
+
+#define BATCH_PREFETCH_TASK \
+                __builtin_prefetch(src + get_address(blklen, blkpos, middle)); \
+            } \
+            len -= half; \
+        } \
+        for (j = 0; j < g; j++) \
+        { \
+            middle = base[j]; \
+            if (first < last) \
+            {
+
+#define COL_BATCH_PREFETCH_TASK \
+                __builtin_prefetch(src + middle); \
+            } \
+            len -= half; \
+        } \
+        for (j = 0; j < g; j++) \
+        { \
+            middle = base[j]; \
+            if (first < last) \
+            {
+
+#define FIND_FIRST_BATCH_END_CHECK \
+            } \
+            middle = (base[j] + (uint64_t)((first < last) && (x < keys[i + j]))); \
+            out[i + j] = last; \
+            if (middle < last) \
+            {
+
+#define FIND_LAST_BATCH_END_CHECK \
+            } \
+            middle = (base[j] + (uint64_t)((first < last) && (x <= keys[i + j]))); \
+            --middle; \
+            out[i + j] = last; \
+            if ((middle < last) && (middle != UINT64_MAX)) \
+            {
+
+#define FIND_BATCH_END_LOOP_BLOCK \
+                if (x == keys[i + j]) \
+                { \
+                    out[i + j] = middle; \
+                } \
+            } \
+        } \
+    }
+
+/**
+ * Generic function to search for the first occurrence of multiple unsigned integers
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_first_batch(O, T) \
+/** Search for the first occurrence of multiple unsigned integers on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The searches are performed in groups of FIND_BATCH_GROUP keys.
+Each result is the same returned by find_first_##O##_##T for the same key.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param out       Output buffer of nkeys elements: item number if found or last if not found.
+*/ \
+static inline void find_first_batch_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *out) \
+{ \
+FIND_BATCH_START_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+FIND_FIRST_BATCH_INNER_CHECK \
+BATCH_PREFETCH_TASK \
+GET_ITEM_TASK(O, T) \
+FIND_FIRST_BATCH_END_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_BATCH_END_LOOP_BLOCK \
+}
+
+define_find_first_batch(be, uint8_t)
+define_find_first_batch(be, uint16_t)
+define_find_first_batch(be, uint32_t)
+define_find_first_batch(be, uint64_t)
+define_find_first_batch(le, uint8_t)
+define_find_first_batch(le, uint16_t)
+define_find_first_batch(le, uint32_t)
+define_find_first_batch(le, uint64_t)
+
+/**
+ * Generic function to search for the first occurrence of multiple unsigned integers
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data.
+ * The values to search are the bits between bitstart and bitend.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_first_sub_batch(O, T) \
+/** Search for the first occurrence of multiple unsigned integers on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values to search are the bits between bitstart and bitend.
+The searches are performed in groups of FIND_BATCH_GROUP keys.
+Each result is the same returned by find_first_sub_##O##_##T for the same key.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param bitstart  First bit position to consider (usually 0).
+@param bitend    Last bit position to consider (usually the last bit, e.g. 7 for uint8_t, 15 for uint16_t, etc).
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param out       Output buffer of nkeys elements: item number if found or last if not found.
+*/ \
+static inline void find_first_sub_batch_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint8_t bitstart, uint8_t bitend, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *out) \
+{ \
+SUB_ITEM_VARS(T) \
+FIND_BATCH_START_BLOCK(T) \
+GET_SUB_ITEM_TASK(O, T) \
+FIND_FIRST_BATCH_INNER_CHECK \
+BATCH_PREFETCH_TASK \
+GET_SUB_ITEM_TASK(O, T) \
+FIND_FIRST_BATCH_END_CHECK \
+GET_SUB_ITEM_TASK(O, T) \
+FIND_BATCH_END_LOOP_BLOCK \
+}
+
+define_find_first_sub_batch(be, uint8_t)
+define_find_first_sub_batch(be, uint16_t)
+define_find_first_sub_batch(be, uint32_t)
+define_find_first_sub_batch(be, uint64_t)
+define_find_first_sub_batch(le, uint8_t)
+define_find_first_sub_batch(le, uint16_t)
+define_find_first_sub_batch(le, uint32_t)
+define_find_first_sub_batch(le, uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of multiple unsigned integers
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_last_batch(O, T) \
+/** Search for the last occurrence of multiple unsigned integers on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The searches are performed in groups of FIND_BATCH_GROUP keys.
+Each result is the same returned by find_last_##O##_##T for the same key.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param out       Output buffer of nkeys elements: item number if found or last if not found.
+*/ \
+static inline void find_last_batch_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *out) \
+{ \
+FIND_BATCH_START_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+FIND_LAST_BATCH_INNER_CHECK \
+BATCH_PREFETCH_TASK \
+GET_ITEM_TASK(O, T) \
+FIND_LAST_BATCH_END_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_BATCH_END_LOOP_BLOCK \
+}
+
+define_find_last_batch(be, uint8_t)
+define_find_last_batch(be, uint16_t)
+define_find_last_batch(be, uint32_t)
+define_find_last_batch(be, uint64_t)
+define_find_last_batch(le, uint8_t)
+define_find_last_batch(le, uint16_t)
+define_find_last_batch(le, uint32_t)
+define_find_last_batch(le, uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of multiple unsigned integers
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data.
+ * The values to search are the bits between bitstart and bitend.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_last_sub_batch(O, T) \
+/** Search for the last occurrence of multiple unsigned integers on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values to search are the bits between bitstart and bitend.
+The searches are performed in groups of FIND_BATCH_GROUP keys.
+Each result is the same returned by find_last_sub_##O##_##T for the same key.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param bitstart  First bit position to consider (usually 0).
+@param bitend    Last bit position to consider (usually the last bit, e.g. 7 for uint8_t, 15 for uint16_t, etc).
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param out       Output buffer of nkeys elements: item number if found or last if not found.
+*/ \
+static inline void find_last_sub_batch_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint8_t bitstart, uint8_t bitend, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *out) \
+{ \
+SUB_ITEM_VARS(T) \
+FIND_BATCH_START_BLOCK(T) \
+GET_SUB_ITEM_TASK(O, T) \
+FIND_LAST_BATCH_INNER_CHECK \
+BATCH_PREFETCH_TASK \
+GET_SUB_ITEM_TASK(O, T) \
+FIND_LAST_BATCH_END_CHECK \
+GET_SUB_ITEM_TASK(O, T) \
+FIND_BATCH_END_LOOP_BLOCK \
+}
+
+define_find_last_sub_batch(be, uint8_t)
+define_find_last_sub_batch(be, uint16_t)
+define_find_last_sub_batch(be, uint32_t)
+define_find_last_sub_batch(be, uint64_t)
+define_find_last_sub_batch(le, uint8_t)
+define_find_last_sub_batch(le, uint16_t)
+define_find_last_sub_batch(le, uint32_t)
+define_find_last_sub_batch(le, uint64_t)
+
+/**
+ * Generic function to search for the first occurrence of multiple unsigned integers
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_first_batch(T) \
+/** Search for the first occurrence of multiple unsigned integers on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The searches are performed in groups of FIND_BATCH_GROUP keys.
+Each result is the same returned by col_find_first_##T for the same key.
+@param src       Memory mapped file address.
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param out       Output buffer of nkeys elements: item number if found or last if not found.
+*/ \
+static inline void col_find_first_batch_##T(const T *src, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *out) \
+{ \
+FIND_BATCH_START_BLOCK(T) \
+COL_GET_ITEM_TASK \
+FIND_FIRST_BATCH_INNER_CHECK \
+COL_BATCH_PREFETCH_TASK \
+COL_GET_ITEM_TASK \
+FIND_FIRST_BATCH_END_CHECK \
+COL_GET_ITEM_TASK \
+FIND_BATCH_END_LOOP_BLOCK \
+}
+
+define_col_find_first_batch(uint8_t)
+define_col_find_first_batch(uint16_t)
+define_col_find_first_batch(uint32_t)
+define_col_find_first_batch(uint64_t)
+
+/**
+ * Generic function to search for the first occurrence of multiple unsigned integers
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+ * The values to search are the bits between bitstart and bitend.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_first_sub_batch(T) \
+/** Search for the first occurrence of multiple unsigned integers on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The values to search are the bits between bitstart and bitend.
+The searches are performed in groups of FIND_BATCH_GROUP keys.
+Each result is the same returned by col_find_first_sub_##T for the same key.
+@param src       Memory mapped file address.
+@param bitstart  First bit position to consider (usually 0).
+@param bitend    Last bit position to consider (usually the last bit, e.g. 7 for uint8_t, 15 for uint16_t, etc).
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param out       Output buffer of nkeys elements: item number if found or last if not found.
+*/ \
+static inline void col_find_first_sub_batch_##T(const T *src, uint8_t bitstart, uint8_t bitend, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *out) \
+{ \
+SUB_ITEM_VARS(T) \
+FIND_BATCH_START_BLOCK(T) \
+COL_GET_SUB_ITEM_TASK \
+FIND_FIRST_BATCH_INNER_CHECK \
+COL_BATCH_PREFETCH_TASK \
+COL_GET_SUB_ITEM_TASK \
+FIND_FIRST_BATCH_END_CHECK \
+COL_GET_SUB_ITEM_TASK \
+FIND_BATCH_END_LOOP_BLOCK \
+}
+
+define_col_find_first_sub_batch(uint8_t)
+define_col_find_first_sub_batch(uint16_t)
+define_col_find_first_sub_batch(uint32_t)
+define_col_find_first_sub_batch(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of multiple unsigned integers
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_last_batch(T) \
+/** Search for the last occurrence of multiple unsigned integers on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The searches are performed in groups of FIND_BATCH_GROUP keys.
+Each result is the same returned by col_find_last_##T for the same key.
+@param src       Memory mapped file address.
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param out       Output buffer of nkeys elements: item number if found or last if not found.
+*/ \
+static inline void col_find_last_batch_##T(const T *src, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *out) \
+{ \
+FIND_BATCH_START_BLOCK(T) \
+COL_GET_ITEM_TASK \
+FIND_LAST_BATCH_INNER_CHECK \
+COL_BATCH_PREFETCH_TASK \
+COL_GET_ITEM_TASK \
+FIND_LAST_BATCH_END_CHECK \
+COL_GET_ITEM_TASK \
+FIND_BATCH_END_LOOP_BLOCK \
+}
+
+define_col_find_last_batch(uint8_t)
+define_col_find_last_batch(uint16_t)
+define_col_find_last_batch(uint32_t)
+define_col_find_last_batch(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of multiple unsigned integers
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+ * The values to search are the bits between bitstart and bitend.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_last_sub_batch(T) \
+/** Search for the last occurrence of multiple unsigned integers on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The values to search are the bits between bitstart and bitend.
+The searches are performed in groups of FIND_BATCH_GROUP keys.
+Each result is the same returned by col_find_last_sub_##T for the same key.
+@param src       Memory mapped file address.
+@param bitstart  First bit position to consider (usually 0).
+@param bitend    Last bit position to consider (usually the last bit, e.g. 7 for uint8_t, 15 for uint16_t, etc).
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param out       Output buffer of nkeys elements: item number if found or last if not found.
+*/ \
+static inline void col_find_last_sub_batch_##T(const T *src, uint8_t bitstart, uint8_t bitend, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *out) \
+{ \
+SUB_ITEM_VARS(T) \
+FIND_BATCH_START_BLOCK(T) \
+COL_GET_SUB_ITEM_TASK \
+FIND_LAST_BATCH_INNER_CHECK \
+COL_BATCH_PREFETCH_TASK \
+COL_GET_SUB_ITEM_TASK \
+FIND_LAST_BATCH_END_CHECK \
+COL_GET_SUB_ITEM_TASK \
+FIND_BATCH_END_LOOP_BLOCK \
+}
+
+define_col_find_last_sub_batch(uint8_t)
+define_col_find_last_sub_batch(uint16_t)
+define_col_find_last_sub_batch(uint32_t)
+define_col_find_last_sub_batch(uint64_t)
+
+// --- SORTED BATCH ---
+
+// The sorted batch functions search keys sorted in ascending order.
+// The lower bound of each key is used as the starting point of the next one,
+// and the bounds are reached with exponential (galloping) steps followed by a
+// binary search, so each key only costs O(log(d)) where d is the distance from
+// the previous result.
+
+#define FIND_SORTED_START_BLOCK(T) \
+    uint64_t middle, i, lo, hi, step, pos = first; \
+    T x, search; \
+    for (i = 0; i < nkeys; i++) \
+    { \
+        search = keys[i]; \
+        lo = pos; \
+        hi = pos; \
+        step = 1; \
+        while (hi < last) \
+        { \
+            middle = hi;
+
+#define FIND_SORTED_FIRST_GALLOP_CHECK \
+            if (x >= search) \
+            { \
+                break; \
+            } \
+            lo = (hi + 1); \
+            hi += step; \
+            step <<= 1; \
+        } \
+        hi = (hi < last) ? hi : last; \
+        while (lo < hi) \
+        { \
+            middle = get_middle_point(lo, hi);
+
+#define FIND_SORTED_FIRST_INNER_CHECK \
+            if (x < search) \
+            { \
+                lo = (middle + 1); \
+            } \
+            else \
+            { \
+                hi = middle; \
+            } \
+        } \
+        pos = lo; \
+        ofirst[i] = last; \
+        if (lo < last) \
+        { \
+            middle = lo;
+
+#define FIND_SORTED_LAST_START_BLOCK \
+            ofirst[i] = (x == search) ? middle : last; \
+        } \
+        hi = pos; \
+        step = 1; \
+        while (hi < last) \
+        { \
+            middle = hi;
+
+#define FIND_SORTED_LAST_GALLOP_CHECK \
+            if (x > search) \
+            { \
+                break; \
+            } \
+            lo = (hi + 1); \
+            hi += step; \
+            step <<= 1; \
+        } \
+        hi = (hi < last) ? hi : last; \
+        while (lo < hi) \
+        { \
+            middle = get_middle_point(lo, hi);
+
+#define FIND_SORTED_LAST_INNER_CHECK \
+            if (x > search) \
+            { \
+                hi = middle; \
+            } \
+            else \
+            { \
+                lo = (middle + 1); \
+            } \
+        } \
+        olast[i] = last; \
+        if (lo > 0) \
+        { \
+            middle = (lo - 1);
+
+#define FIND_SORTED_END_LOOP_BLOCK \
+            olast[i] = (x == search) ? middle : last; \
+        } \
+    }
+
+/**
+ * Generic function to search for the first and last occurrences of multiple sorted unsigned integers
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_sorted_batch(O, T) \
+/** Search for the first and last occurrences of multiple unsigned integers on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The keys must be sorted in ascending order.
+Each result is the same returned by find_first_##O##_##T and find_last_##O##_##T for the same key.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Sorted unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param ofirst    Output buffer of nkeys elements: first item number if found or last if not found.
+@param olast     Output buffer of nkeys elements: last item number if found or last if not found.
+*/ \
+static inline void find_sorted_batch_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *ofirst, uint64_t *olast) \
+{ \
+FIND_SORTED_START_BLOCK(T) \
+GET_ITEM_TASK(O, T) \
+FIND_SORTED_FIRST_GALLOP_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_SORTED_FIRST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_SORTED_LAST_START_BLOCK \
+GET_ITEM_TASK(O, T) \
+FIND_SORTED_LAST_GALLOP_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_SORTED_LAST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_SORTED_END_LOOP_BLOCK \
+}
+
+define_find_sorted_batch(be, uint8_t)
+define_find_sorted_batch(be, uint16_t)
+define_find_sorted_batch(be, uint32_t)
+define_find_sorted_batch(be, uint64_t)
+define_find_sorted_batch(le, uint8_t)
+define_find_sorted_batch(le, uint16_t)
+define_find_sorted_batch(le, uint32_t)
+define_find_sorted_batch(le, uint64_t)
+
+/**
+ * Generic function to search for the first and last occurrences of multiple sorted unsigned integers
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_sorted_batch(T) \
+/** Search for the first and last occurrences of multiple unsigned integers on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The keys must be sorted in ascending order.
+Each result is the same returned by col_find_first_##T and col_find_last_##T for the same key.
+@param src       Memory mapped file address.
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Sorted unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param ofirst    Output buffer of nkeys elements: first item number if found or last if not found.
+@param olast     Output buffer of nkeys elements: last item number if found or last if not found.
+*/ \
+static inline void col_find_sorted_batch_##T(const T *src, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *ofirst, uint64_t *olast) \
+{ \
+FIND_SORTED_START_BLOCK(T) \
+COL_GET_ITEM_TASK \
+FIND_SORTED_FIRST_GALLOP_CHECK \
+COL_GET_ITEM_TASK \
+FIND_SORTED_FIRST_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_SORTED_LAST_START_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_SORTED_LAST_GALLOP_CHECK \
+COL_GET_ITEM_TASK \
+FIND_SORTED_LAST_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_SORTED_END_LOOP_BLOCK \
+}
+
+define_col_find_sorted_batch(uint8_t)
+define_col_find_sorted_batch(uint16_t)
+define_col_find_sorted_batch(uint32_t)
+define_col_find_sorted_batch(uint64_t)
+
+// --- FILE ---
+
+static inline void parse_col_offset(mmfile_t *mf)
+{
+    uint8_t i = 0;
+    uint64_t b = 0;
+    mf->index[0] = mf->doffset;
+    for (i = 0; i < mf->ncols; i++)
+    {
+        b += mf->ctbytes[i];
+    }
+    if (b == 0)
+    {
+        return;
+    }
+    mf->nrows = (mf->dlength / b);
+    for (i = 1; i < mf->ncols; i++)
+    {
+        b = (mf->nrows * mf->ctbytes[(i - 1)]);
+        mf->index[i] = mf->index[(i - 1)] + b + ((8 - (b & 7)) & 7); // account for 8-byte padding
+    }
+}
+
+static inline void parse_info_binsrc(mmfile_t *mf)
+{
+    const uint8_t *tp = (const uint8_t *)(mf->src + 8);
+    mf->ncols = *tp++;
+    mf->doffset = (uint64_t)9 + mf->ncols + ((8 - ((mf->ncols + 1) & 7)) & 7); // account for 8-byte padding
+    const uint64_t *op = (const uint64_t *)(mf->src + mf->doffset);
+    mf->nrows = *op++;
+    uint8_t i = 0;
+    for (i = 0; i < mf->ncols; i++)
+    {
+        mf->ctbytes[i] = *tp++;
+        mf->index[i] = *op++;
+    }
+    mf->doffset += ((uint64_t)(mf->ncols + 1) * 8); // skip column offsets section
+    mf->dlength -= mf->doffset;
+}
+
+static inline void parse_info_arrow(mmfile_t *mf)
+{
+    mf->doffset = (uint64_t)(*((const uint32_t *)(mf->src + 9))) + 13; // skip metadata
+    mf->doffset += (uint64_t)(*((const uint32_t *)(mf->src + mf->doffset)) + 4); // skip dictionary
+    mf->dlength -= mf->doffset;
+    uint64_t type = (*((const uint64_t *)(mf->src + mf->size - 8)));
+    if ((type & 0xffffffffffff0000) == 0x31574f5252410000) // magic number "ARROW1" in LE
+    {
+        mf->dlength -= (uint64_t)(*((const uint32_t *)(mf->src + mf->size - 10))) + 10; // remove footer
+    }
+}
+
+static inline void parse_info_feather(mmfile_t *mf)
+{
+    mf->doffset = 8;
+    mf->dlength -= mf->doffset;
+    uint32_t type = (*((const uint32_t *)(mf->src + mf->size - 4)));
+    if (type == 0x31414546) // magic number "FEA1" in LE
+    {
+        mf->dlength -= (uint64_t)(*((const uint32_t *)(mf->src + mf->size - 8))) + 8; // remove metadata
+    }
+}
+
+//!< \cond
+
+static inline void mmap_binfile_flags(const char *file, mmfile_t *mf, int flags)
+{
+    mf->src = (uint8_t*)MAP_FAILED; // NOLINT
+    mf->fd = -1;
+    mf->size = 0;
+    mf->doffset = 0;
+    mf->dlength = 0;
+    mf->nrows = 0;
+    mf->mapsize = 0;
+    struct stat statbuf;
+    mf->fd = open(file, O_RDONLY);
+    if ((mf->fd < 0) || (fstat(mf->fd, &statbuf) < 0))
+    {
+        return;
+    }
+    mf->size = (uint64_t)statbuf.st_size;
+    mf->src = (uint8_t*)mmap(0, mf->size, PROT_READ, flags, mf->fd, 0);
+    mf->dlength = mf->size;
+    if (mf->size < 28)
+    {
+        return;
+    }
+    uint64_t type = (*((const uint64_t *)(mf->src)));
+    switch (type)
+    {
+    // Custom binsearch format
+    case 0x00314352534e4942: // magic number "BINSRC1" in LE
+        parse_info_binsrc(mf);
+        return;
+    // Basic support for Apache Arrow File format with a single RecordBatch.
+    case 0x000031574f525241: // magic number "ARROW1" in LE
+        parse_info_arrow(mf);
+        break;
+    // Basic support for Feather File format.
+    case 0x0000000031414546: // magic number "FEA1" in LE
+        parse_info_feather(mf);
+        break;
+    default:
+        break;
+    }
+    parse_col_offset(mf);
+}
+
+// Apply the access advice to the pages of the region [offset, offset + len) of the memory map.
+static inline int mmap_binfile_advise(const mmfile_t *mf, uint64_t offset, uint64_t len, uint8_t advice)
+{
+    if ((advice == MMAP_ADVICE_NORMAL) || (len == 0))
+    {
+        return 0;
+    }
+#if defined(MADV_RANDOM) && defined(MADV_SEQUENTIAL) && defined(MADV_WILLNEED)
+    static const int madv[] = {MADV_NORMAL, MADV_RANDOM, MADV_SEQUENTIAL, MADV_WILLNEED};
+    if (advice > MMAP_ADVICE_WILLNEED)
+    {
+        return -1;
+    }
+    long pagesize = sysconf(_SC_PAGESIZE);
+    uint64_t page = (pagesize > 0) ? (uint64_t)pagesize : 4096;
+    uint64_t start = (offset / page) * page; // madvise requires a page-aligned address
+    return madvise((mf->src + start), (size_t)(len + offset - start), madv[advice]);
+#else
+    (void)mf;
+    (void)offset;
+    return -1;
+#endif
+}
+
+// Replace the file mapping with a copy in anonymous huge pages.
+static inline int mmap_binfile_hugetlb(mmfile_t *mf)
+{
+#if defined(MAP_ANONYMOUS)
+    uint64_t mapsize = ((mf->size + MMAP_HUGETLB_SIZE - 1) / MMAP_HUGETLB_SIZE) * MMAP_HUGETLB_SIZE;
+    uint8_t *dst = (uint8_t *)MAP_FAILED; // NOLINT
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+    dst = (uint8_t *)mmap(0, mapsize, (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (__builtin_ctzll(MMAP_HUGETLB_SIZE) << MAP_HUGE_SHIFT)), -1, 0);
+#endif
+    if (dst == MAP_FAILED) // no reserved huge pages: fall back to transparent huge pages
+    {
+        dst = (uint8_t *)mmap(0, mapsize, (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+        if (dst == MAP_FAILED)
+        {
+            return -1;
+        }
+#if defined(MADV_HUGEPAGE)
+        (void)madvise(dst, mapsize, MADV_HUGEPAGE);
+#endif
+    }
+    memcpy(dst, mf->src, mf->size);
+    (void)mprotect(dst, mapsize, PROT_READ);
+    (void)munmap(mf->src, mf->size);
+    mf->src = dst;
+    mf->mapsize = mapsize;
+    return 0;
+#else
+    (void)mf;
+    return -1;
+#endif
+}
+
+//!< \endcond
+
+/**
+ * Memory map the specified file.
+ *
+ * @param file  Path to the file to map.
+ * @param mf    Structure containing the memory mapped file.
+ */
+static inline void mmap_binfile(const char *file, mmfile_t *mf)
+{
+    mmap_binfile_flags(file, mf, MAP_PRIVATE);
+}
+
+/**
+ * Memory map the specified file with the specified options,
+ * to control the page size, the readahead and the residency of the mapped pages.
+ * The options not supported by the platform are not applied:
+ * the access advice and the huge pages require Linux with _DEFAULT_SOURCE or _GNU_SOURCE defined.
+ * The options are applied after parsing the file header,
+ * so the column advice and locks can be used with all the supported formats.
+ * The memory map must be released with munmap_binfile.
+ *
+ * @param file  Path to the file to map.
+ * @param mf    Structure containing the memory mapped file.
+ * @param opts  Mapping options.
+ *
+ * @return 0 on success,
+ *         -1 if the file can't be mapped (as in mmap_binfile, check mf->fd and mf->src),
+ *         1 if the file is mapped but at least one option could not be applied
+ *         (e.g. mlock over the RLIMIT_MEMLOCK limit).
+ */
+static inline int mmap_binfile_ex(const char *file, mmfile_t *mf, const mmap_opts_t *opts)
+{
+    int flags = MAP_PRIVATE;
+    int ret = 0;
+    uint16_t i;
+#if defined(MAP_POPULATE)
+    if ((opts->flags & (MMAP_OPT_POPULATE | MMAP_OPT_HUGETLB)) == MMAP_OPT_POPULATE)
+    {
+        flags |= MAP_POPULATE;
+    }
+#endif
+    mmap_binfile_flags(file, mf, flags);
+    if ((mf->fd < 0) || (mf->src == MAP_FAILED))
+    {
+        return -1;
+    }
+#if !defined(MAP_POPULATE)
+    if ((opts->flags & (MMAP_OPT_POPULATE | MMAP_OPT_HUGETLB)) == MMAP_OPT_POPULATE)
+    {
+        ret = 1;
+    }
+#endif
+    if (opts->flags & MMAP_OPT_HUGETLB)
+    {
+        ret |= (mmap_binfile_hugetlb(mf) != 0);
+    }
+    else if (opts->flags & MMAP_OPT_HUGEPAGE)
+    {
+#if defined(MADV_HUGEPAGE)
+        ret |= (madvise(mf->src, mf->size, MADV_HUGEPAGE) != 0);
+#else
+        ret = 1;
+#endif
+    }
+    ret |= (mmap_binfile_advise(mf, 0, mf->size, opts->advice) != 0);
+    for (i = 0; i < mf->ncols; i++)
+    {
+        ret |= (mmap_binfile_advise(mf, mf->index[i], (mf->nrows * mf->ctbytes[i]), opts->col_advice[i]) != 0);
+    }
+    if (opts->flags & MMAP_OPT_LOCK)
+    {
+        ret |= (mlock(mf->src, mf->size) != 0);
+    }
+    for (i = 0; i < mf->ncols; i++)
+    {
+        if (opts->col_lock[i] && ((mf->nrows * mf->ctbytes[i]) > 0))
+        {
+            ret |= (mlock((mf->src + mf->index[i]), (mf->nrows * mf->ctbytes[i])) != 0);
+        }
+    }
+    return ret;
+}
+
+/**
+ * Unmap and close the memory-mapped file.
+ *
+ * @param mf Descriptor of memory-mapped file.
+ *
+ * @return On success, munmap() returns 0,
+ *         on failure -1, and errno is set (probably to EINVAL).
+ */
+static inline int munmap_binfile(mmfile_t mf)
+{
+    int err = munmap(mf.src, ((mf.mapsize > 0) ? mf.mapsize : mf.size));
+    if (err != 0)
+    {
+        return err;
+    }
+    return close(mf.fd);
+}
+
+/**
+ * Create a new file in the BINSRC format with the specified columns and memory map it in read-write mode.
+ * The file is created with all the column values set to zero,
+ * the caller can fill the columns using the addresses at (mf->src + mf->index[col]).
+ * Each column starts at a 64-byte aligned offset.
+ * The changes are written to the file when the memory is unmapped with munmap_binfile.
+ *
+ * @param file      Path to the file to create (any existing file is truncated).
+ * @param ncols     Number of columns.
+ * @param ctbytes   Number of bytes per column type (i.e. 1 for uint8_t, 2 for uint16_t, 4 for uint32_t, 8 for uint64_t).
+ * @param nrows     Number of rows.
+ * @param mf        Structure containing the memory mapped file.
+ *                  On failure mf->fd is negative or mf->src is MAP_FAILED.
+ */
+static inline void create_binsrc(const char *file, uint8_t ncols, const uint8_t *ctbytes, uint64_t nrows, mmfile_t *mf)
+{
+    uint8_t i = 0;
+    mf->src = (uint8_t*)MAP_FAILED; // NOLINT
+    mf->mapsize = 0;
+    mf->ncols = ncols;
+    mf->nrows = nrows;
+    mf->doffset = (uint64_t)9 + ncols + ((8 - ((ncols + 1) & 7)) & 7); // account for 8-byte padding
+    uint64_t hlen = mf->doffset + ((uint64_t)(ncols + 1) * 8);
+    mf->size = hlen;
+    for (i = 0; i < ncols; i++)
+    {
+        mf->ctbytes[i] = ctbytes[i];
+        mf->index[i] = (mf->size + ((64 - (mf->size & 63)) & 63)); // align each column to 64 bytes
+        mf->size = mf->index[i] + (nrows * ctbytes[i]);
+    }
+    mf->size += ((8 - (mf->size & 7)) & 7); // account for 8-byte padding
+    mf->dlength = (mf->size - hlen);
+    mf->fd = open(file, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (mf->fd < 0)
+    {
+        return;
+    }
+    if ((lseek(mf->fd, (off_t)(mf->size - 1), SEEK_SET) < 0) || (write(mf->fd, "", 1) != 1)) // extend the file with zeros
+    {
+        return;
+    }
+    mf->src = (uint8_t*)mmap(0, mf->size, PROT_READ | PROT_WRITE, MAP_SHARED, mf->fd, 0);
+    if (mf->src == MAP_FAILED)
+    {
+        return;
+    }
+    *((uint64_t *)(mf->src)) = 0x00314352534e4942; // magic number "BINSRC1" in LE
+    uint8_t *tp = (mf->src + 8);
+    *tp++ = ncols;
+    uint64_t *op = (uint64_t *)(mf->src + mf->doffset);
+    *op++ = nrows;
+    for (i = 0; i < ncols; i++)
+    {
+        *tp++ = ctbytes[i];
+        *op++ = mf->index[i];
+    }
+    mf->doffset = hlen;
+}
+
+// --- EYTZINGER ---
+
+// The Eytzinger layout stores the sorted values in breadth-first order of an
+// implicit binary search tree: node k has children 2k and 2k+1, and position 0
+// is unused. The top levels of the tree share a few cache lines, and the
+// descendants of a node are contiguous, so they can be prefetched in advance.
+
+#define EYTZINGER_PREFETCH_LEVELS 4 //!< Number of tree levels to prefetch ahead.
+
+/**
+ * Returns the position in the sorted column of the Eytzinger node k.
+ *
+ * @param k         Eytzinger node position (1 to nitems).
+ * @param nitems    Number of items in the Eytzinger index (excluding position 0).
+ *
+ * @return Position in the sorted column.
+ */
+static inline uint64_t eytzinger_rank(uint64_t k, uint64_t nitems)
+{
+    uint64_t levels = (uint64_t)(64 - __builtin_clzll(nitems));
+    uint64_t depth = (uint64_t)(63 - __builtin_clzll(k));
+    // position in a perfect tree with the same number of levels
+    uint64_t r = ((((k - ((uint64_t)1 << depth)) << 1) + 1) << (levels - 1 - depth)) - 1;
+    // number of leaves of the last level
+    uint64_t m = nitems - (((uint64_t)1 << (levels - 1)) - 1);
+    // remove the missing leaves on the left
+    uint64_t h = ((r + 1) >> 1);
+    return (h > m) ? (r - (h - m)) : r;
+}
+
+/**
+ * Generic function to build the Eytzinger layout of a sorted column.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_build_eytzinger(T) \
+/** Build the Eytzinger (BFS order) copy of a column containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The source column is read sequentially.
+@param src       Memory mapped column address (e.g. get_src_offset_##T(mf.src, mf.index[col])).
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@param dst       Destination buffer for (nitems + 1) items, preferably aligned to 64 bytes. The position 0 is set to 0 and unused.
+*/ \
+static inline void col_build_eytzinger_##T(const T *src, uint64_t nitems, T *dst) \
+{ \
+    uint64_t i, k = 1; \
+    dst[0] = 0; \
+    if (nitems == 0) \
+    { \
+        return; \
+    } \
+    while ((k << 1) <= nitems) \
+    { \
+        k <<= 1; \
+    } \
+    for (i = 0; i < nitems; i++) \
+    { \
+        dst[k] = src[i]; \
+        if (((k << 1) | 1) <= nitems) \
+        { \
+            k = ((k << 1) | 1); \
+            while ((k << 1) <= nitems) \
+            { \
+                k <<= 1; \
+            } \
+            continue; \
+        } \
+        k >>= (__builtin_ctzll(~k) + 1); \
+    } \
+}
+
+define_col_build_eytzinger(uint8_t)
+define_col_build_eytzinger(uint16_t)
+define_col_build_eytzinger(uint32_t)
+define_col_build_eytzinger(uint64_t)
+
+/**
+ * Build the Eytzinger layout of a sorted column and save it as a BINSRC sidecar file
+ * with a single column of (mf.nrows + 1) items.
+ * The sidecar file can be loaded with mmap_binfile and the index is at (smf.src + smf.index[0]).
+ *
+ * @param file  Path to the sidecar file to create.
+ * @param mf    Structure containing the memory mapped source file.
+ * @param col   Column number of the sorted column in the source file.
+ *
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+static inline int save_eytzinger(const char *file, mmfile_t mf, uint8_t col)
+{
+    mmfile_t smf;
+    create_binsrc(file, 1, &mf.ctbytes[col], (mf.nrows + 1), &smf);
+    if ((smf.fd < 0) || (smf.src == MAP_FAILED))
+    {
+        if (smf.fd >= 0)
+        {
+            close(smf.fd);
+        }
+        return -1;
+    }
+    switch (mf.ctbytes[col])
+    {
+    case 1:
+        col_build_eytzinger_uint8_t(get_src_offset_uint8_t(mf.src, mf.index[col]), mf.nrows, (uint8_t *)(smf.src + smf.index[0]));
+        break;
+    case 2:
+        col_build_eytzinger_uint16_t(get_src_offset_uint16_t(mf.src, mf.index[col]), mf.nrows, (uint16_t *)(smf.src + smf.index[0]));
+        break;
+    case 4:
+        col_build_eytzinger_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[col]), mf.nrows, (uint32_t *)(smf.src + smf.index[0]));
+        break;
+    case 8:
+        col_build_eytzinger_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[col]), mf.nrows, (uint64_t *)(smf.src + smf.index[0]));
+        break;
+    default:
+        break;
+    }
+    return munmap_binfile(smf);
+}
+
+// The Eytzinger search finds the lower (or upper) bound in the whole column,
+// then clamps it to the [first, last] range, so the final check returns the
+// same results of the binary search functions. The last node where the
+// search turned left (right) holds the value at the lower (upper - 1) bound,
+// so the source column is only read when the bound has been clamped.
+
+#define EYTZINGER_DESCENT_BLOCK(C) \
+    uint64_t k = 1, pos; \
+    while (k <= nitems) \
+    { \
+        __builtin_prefetch(eyt + (k << EYTZINGER_PREFETCH_LEVELS)); \
+        k = ((k << 1) + (uint64_t)(eyt[k] C search)); \
+    }
+
+#define EYTZINGER_FIRST_BLOCK \
+    k >>= (__builtin_ctzll(~k) + 1); \
+    pos = (k == 0) ? nitems : eytzinger_rank(k, nitems);
+
+#define EYTZINGER_LAST_BLOCK \
+    k >>= (__builtin_ctzll(k) + 1); \
+    pos = (k == 0) ? 0 : (eytzinger_rank(k, nitems) + 1);
+
+#define EYTZINGER_CLAMP_BLOCK \
+    *first = (pos < *first) ? *first : ((pos > *last) ? *last : pos); \
+    *last = *first; \
+    k = (pos == *first) ? k : 0;
+
+#define EYTZINGER_GET_ITEM_TASK \
+    x = (k == 0) ? *(src + middle) : eyt[k];
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using the Eytzinger layout index.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_first_eytzinger(T) \
+/** Search for the first occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+This returns the same results of col_find_first_##T.
+@param src       Memory mapped file address.
+@param eyt       Eytzinger index of the whole column, as built by col_build_eytzinger_##T.
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t col_find_first_eytzinger_##T(const T *src, const T *eyt, uint64_t nitems, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+EYTZINGER_DESCENT_BLOCK(<) \
+EYTZINGER_FIRST_BLOCK \
+EYTZINGER_CLAMP_BLOCK \
+middle = *first; \
+EYTZINGER_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_first_eytzinger(uint8_t)
+define_col_find_first_eytzinger(uint16_t)
+define_col_find_first_eytzinger(uint32_t)
+define_col_find_first_eytzinger(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using the Eytzinger layout index.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_last_eytzinger(T) \
+/** Search for the last occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+This returns the same results of col_find_last_##T.
+@param src       Memory mapped file address.
+@param eyt       Eytzinger index of the whole column, as built by col_build_eytzinger_##T.
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t col_find_last_eytzinger_##T(const T *src, const T *eyt, uint64_t nitems, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+EYTZINGER_DESCENT_BLOCK(<=) \
+EYTZINGER_LAST_BLOCK \
+EYTZINGER_CLAMP_BLOCK \
+middle = *first; \
+--middle; \
+EYTZINGER_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_last_eytzinger(uint8_t)
+define_col_find_last_eytzinger(uint16_t)
+define_col_find_last_eytzinger(uint32_t)
+define_col_find_last_eytzinger(uint64_t)
+
+// --- LEARNED INDEX ---
+
+// The learned index is a piecewise-linear model of the key to position
+// function, stored as a list of knots (key, position) taken from the data.
+// The knots are selected in one pass with a greedy spline corridor, so the
+// position interpolated between two consecutive knots is at most eps items
+// away from the position of the first occurrence of any key.
+// For the keys not in the column, an extra point (previous key + 1) is added
+// at the position of the next key, so the model is valid for any key.
+
+/**
+ * Add a point (x, y) to the greedy spline corridor.
+ *
+ * @param x         Key.
+ * @param y         Position of the first occurrence of the key.
+ * @param eps       Maximum error.
+ * @param st        State: base x, base y, previous x, previous y, number of points.
+ * @param dst       State: upper slope, lower slope.
+ * @param kkeys     Output buffer for the knot keys (can be NULL).
+ * @param kpos      Output buffer for the knot positions (can be NULL).
+ * @param nknots    Number of knots already added.
+ *
+ * @return Number of knots.
+ */
+static inline uint64_t learned_add_point(uint64_t x, uint64_t y, uint64_t eps, uint64_t *st, double *dst, uint64_t *kkeys, uint64_t *kpos, uint64_t nknots)
+{
+    double dx, slope;
+    if (st[4] == 0)
+    {
+        if (kkeys != NULL)
+        {
+            kkeys[nknots] = x;
+            kpos[nknots] = y;
+        }
+        ++nknots;
+        st[0] = x;
+        st[1] = y;
+    }
+    else
+    {
+        dx = (double)(x - st[0]);
+        slope = ((double)y - (double)st[1]) / dx;
+        if ((st[4] > 1) && ((slope > dst[0]) || (slope < dst[1])))
+        {
+            // the point is outside the corridor: the previous point becomes a knot
+            if (kkeys != NULL)
+            {
+                kkeys[nknots] = st[2];
+                kpos[nknots] = st[3];
+            }
+            ++nknots;
+            st[0] = st[2];
+            st[1] = st[3];
+            st[4] = 1;
+            dx = (double)(x - st[0]);
+        }
+        slope = (((double)y + (double)eps) - (double)st[1]) / dx;
+        dst[0] = ((st[4] == 1) || (slope < dst[0])) ? slope : dst[0];
+        slope = (((double)y - (double)eps) - (double)st[1]) / dx;
+        dst[1] = ((st[4] == 1) || (slope > dst[1])) ? slope : dst[1];
+    }
+    st[2] = x;
+    st[3] = y;
+    ++st[4];
+    return nknots;
+}
+
+/**
+ * Add the last point to the greedy spline corridor.
+ *
+ * @param st        State: base x, base y, previous x, previous y, number of points.
+ * @param kkeys     Output buffer for the knot keys (can be NULL).
+ * @param kpos      Output buffer for the knot positions (can be NULL).
+ * @param nknots    Number of knots already added.
+ *
+ * @return Number of knots.
+ */
+static inline uint64_t learned_end(const uint64_t *st, uint64_t *kkeys, uint64_t *kpos, uint64_t nknots)
+{
+    if (st[4] > 1)
+    {
+        if (kkeys != NULL)
+        {
+            kkeys[nknots] = st[2];
+            kpos[nknots] = st[3];
+        }
+        ++nknots;
+    }
+    return nknots;
+}
+
+#define LEARNED_BUILD_BLOCK(T) \
+    uint64_t i, nknots = 0, st[5] = {0}; \
+    double dst[2] = {0}; \
+    T x, prev = 0; \
+    for (i = 0; i < nitems; i++) \
+    {
+
+#define LEARNED_BUILD_END_BLOCK \
+        if ((i > 0) && (x == prev)) \
+        { \
+            continue; \
+        } \
+        if ((i > 0) && (x > (prev + 1))) \
+        { \
+            nknots = learned_add_point(((uint64_t)prev + 1), i, eps, st, dst, kkeys, kpos, nknots); \
+        } \
+        nknots = learned_add_point((uint64_t)x, i, eps, st, dst, kkeys, kpos, nknots); \
+        prev = x; \
+    } \
+    if ((nitems > 0) && (((uint64_t)prev + 1) > 0)) \
+    { \
+        nknots = learned_add_point(((uint64_t)prev + 1), nitems, eps, st, dst, kkeys, kpos, nknots); \
+    } \
+    return learned_end(st, kkeys, kpos, nknots);
+
+/**
+ * Generic function to build the learned index of a sorted column in a memory mapped binary file.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_build_learned(O, T) \
+/** Build the learned index (piecewise-linear model) of the values in a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+Call it first with NULL output buffers to get the number of knots.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number inside a binary block.
+@param nitems    Number of items (rows).
+@param eps       Maximum distance between the predicted and the actual position.
+@param kkeys     Output buffer for the knot keys, or NULL.
+@param kpos      Output buffer for the knot positions, or NULL.
+@return Number of knots.
+*/ \
+static inline uint64_t build_learned_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t nitems, uint64_t eps, uint64_t *kkeys, uint64_t *kpos) \
+{ \
+LEARNED_BUILD_BLOCK(T) \
+        x = bytes_##O##_to_##T(src, get_address(blklen, blkpos, i)); \
+LEARNED_BUILD_END_BLOCK \
+}
+
+define_build_learned(be, uint8_t)
+define_build_learned(be, uint16_t)
+define_build_learned(be, uint32_t)
+define_build_learned(be, uint64_t)
+define_build_learned(le, uint8_t)
+define_build_learned(le, uint16_t)
+define_build_learned(le, uint32_t)
+define_build_learned(le, uint64_t)
+
+/**
+ * Generic function to build the learned index of a sorted column.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_build_learned(T) \
+/** Build the learned index (piecewise-linear model) of a column containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+Call it first with NULL output buffers to get the number of knots.
+@param src       Memory mapped column address (e.g. get_src_offset_##T(mf.src, mf.index[col])).
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@param eps       Maximum distance between the predicted and the actual position.
+@param kkeys     Output buffer for the knot keys, or NULL.
+@param kpos      Output buffer for the knot positions, or NULL.
+@return Number of knots.
+*/ \
+static inline uint64_t col_build_learned_##T(const T *src, uint64_t nitems, uint64_t eps, uint64_t *kkeys, uint64_t *kpos) \
+{ \
+LEARNED_BUILD_BLOCK(T) \
+        x = src[i]; \
+LEARNED_BUILD_END_BLOCK \
+}
+
+define_col_build_learned(uint8_t)
+define_col_build_learned(uint16_t)
+define_col_build_learned(uint32_t)
+define_col_build_learned(uint64_t)
+
+/**
+ * Build the learned index of a sorted column and save it as a BINSRC sidecar file
+ * with two uint64_t columns: the knot keys and the knot positions.
+ * The sidecar file can be loaded with mmap_binfile and the number of knots is in smf.nrows.
+ *
+ * @param file  Path to the sidecar file to create.
+ * @param mf    Structure containing the memory mapped source file.
+ * @param col   Column number of the sorted column in the source file.
+ * @param eps   Maximum distance between the predicted and the actual position.
+ *
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+static inline int save_learned(const char *file, mmfile_t mf, uint8_t col, uint64_t eps)
+{
+    const uint8_t ctbytes[2] = {8, 8};
+    uint64_t nknots = 0;
+    switch (mf.ctbytes[col])
+    {
+    case 1:
+        nknots = col_build_learned_uint8_t(get_src_offset_uint8_t(mf.src, mf.index[col]), mf.nrows, eps, NULL, NULL);
+        break;
+    case 2:
+        nknots = col_build_learned_uint16_t(get_src_offset_uint16_t(mf.src, mf.index[col]), mf.nrows, eps, NULL, NULL);
+        break;
+    case 4:
+        nknots = col_build_learned_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[col]), mf.nrows, eps, NULL, NULL);
+        break;
+    case 8:
+        nknots = col_build_learned_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[col]), mf.nrows, eps, NULL, NULL);
+        break;
+    default:
+        return -1;
+    }
+    mmfile_t smf;
+    create_binsrc(file, 2, ctbytes, nknots, &smf);
+    if ((smf.fd < 0) || (smf.src == MAP_FAILED))
+    {
+        if (smf.fd >= 0)
+        {
+            close(smf.fd);
+        }
+        return -1;
+    }
+    uint64_t *kkeys = (uint64_t *)(smf.src + smf.index[0]);
+    uint64_t *kpos = (uint64_t *)(smf.src + smf.index[1]);
+    switch (mf.ctbytes[col])
+    {
+    case 1:
+        col_build_learned_uint8_t(get_src_offset_uint8_t(mf.src, mf.index[col]), mf.nrows, eps, kkeys, kpos);
+        break;
+    case 2:
+        col_build_learned_uint16_t(get_src_offset_uint16_t(mf.src, mf.index[col]), mf.nrows, eps, kkeys, kpos);
+        break;
+    case 4:
+        col_build_learned_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[col]), mf.nrows, eps, kkeys, kpos);
+        break;
+    default:
+        col_build_learned_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[col]), mf.nrows, eps, kkeys, kpos);
+        break;
+    }
+    return munmap_binfile(smf);
+}
+
+/**
+ * Predict the position of the first occurrence of a key using the learned index.
+ *
+ * @param kkeys     Knot keys.
+ * @param kpos      Knot positions.
+ * @param nknots    Number of knots.
+ * @param key       Key to search.
+ *
+ * @return Predicted position.
+ */
+static inline uint64_t learned_predict(const uint64_t *kkeys, const uint64_t *kpos, uint64_t nknots, uint64_t key)
+{
+    uint64_t lo = 0, hi, mid;
+    if ((nknots == 0) || (key <= kkeys[0]))
+    {
+        return (nknots == 0) ? 0 : kpos[0];
+    }
+    hi = (nknots - 1);
+    if (key >= kkeys[hi])
+    {
+        return kpos[hi];
+    }
+    while ((hi - lo) > 1)
+    {
+        mid = get_middle_point(lo, hi);
+        if (kkeys[mid] <= key)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return kpos[lo] + (uint64_t)(((double)(key - kkeys[lo]) * (double)(kpos[hi] - kpos[lo])) / (double)(kkeys[hi] - kkeys[lo]));
+}
+
+// The learned blocks restrict the [first, last] range to the items around the
+// predicted position, (eps + 1) on the left and (eps + 2) on the right to
+// account for the rounding, then the binary search loop completes the search.
+
+#define LEARNED_NARROW_BLOCK(K) \
+    uint64_t key = (K), lo, hi; \
+    middle = learned_predict(kkeys, kpos, nknots, key); \
+    lo = (middle > (eps + 1)) ? (middle - eps - 1) : 0; \
+    hi = (middle + eps + 2); \
+    lo = (lo < *first) ? *first : ((lo > *last) ? *last : lo); \
+    hi = (hi < *first) ? *first : ((hi > *last) ? *last : hi);
+
+#define LEARNED_FIRST_NARROW_BLOCK \
+LEARNED_NARROW_BLOCK((uint64_t)search) \
+    *first = lo; \
+    *last = hi;
+
+#define LEARNED_LAST_NARROW_BLOCK \
+LEARNED_NARROW_BLOCK((uint64_t)search + 1) \
+    *first = lo; \
+    *last = (key == 0) ? *last : hi;
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using the learned index.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_first_learned(O, T) \
+/** Search for the first occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+The search is restricted to the items around the position predicted by the learned index.
+This returns the same results of find_first_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param kkeys     Knot keys of the learned index, as built by build_learned_##O##_##T.
+@param kpos      Knot positions of the learned index.
+@param nknots    Number of knots.
+@param eps       Maximum error used to build the learned index.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t find_first_learned_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *kkeys, const uint64_t *kpos, uint64_t nknots, uint64_t eps, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+LEARNED_FIRST_NARROW_BLOCK \
+FIND_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+FIND_FIRST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_first_learned(be, uint8_t)
+define_find_first_learned(be, uint16_t)
+define_find_first_learned(be, uint32_t)
+define_find_first_learned(be, uint64_t)
+define_find_first_learned(le, uint8_t)
+define_find_first_learned(le, uint16_t)
+define_find_first_learned(le, uint32_t)
+define_find_first_learned(le, uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using the learned index.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_last_learned(O, T) \
+/** Search for the last occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+The search is restricted to the items around the position predicted by the learned index.
+This returns the same results of find_last_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param kkeys     Knot keys of the learned index, as built by build_learned_##O##_##T.
+@param kpos      Knot positions of the learned index.
+@param nknots    Number of knots.
+@param eps       Maximum error used to build the learned index.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t find_last_learned_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *kkeys, const uint64_t *kpos, uint64_t nknots, uint64_t eps, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+LEARNED_LAST_NARROW_BLOCK \
+FIND_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+FIND_LAST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_last_learned(be, uint8_t)
+define_find_last_learned(be, uint16_t)
+define_find_last_learned(be, uint32_t)
+define_find_last_learned(be, uint64_t)
+define_find_last_learned(le, uint8_t)
+define_find_last_learned(le, uint16_t)
+define_find_last_learned(le, uint32_t)
+define_find_last_learned(le, uint64_t)
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using the learned index.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_first_learned(T) \
+/** Search for the first occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The search is restricted to the items around the position predicted by the learned index.
+This returns the same results of col_find_first_##T.
+@param src       Memory mapped file address.
+@param kkeys     Knot keys of the learned index, as built by col_build_learned_##T.
+@param kpos      Knot positions of the learned index.
+@param nknots    Number of knots.
+@param eps       Maximum error used to build the learned index.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t col_find_first_learned_##T(const T *src, const uint64_t *kkeys, const uint64_t *kpos, uint64_t nknots, uint64_t eps, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+LEARNED_FIRST_NARROW_BLOCK \
+FIND_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_FIRST_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_first_learned(uint8_t)
+define_col_find_first_learned(uint16_t)
+define_col_find_first_learned(uint32_t)
+define_col_find_first_learned(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using the learned index.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_last_learned(T) \
+/** Search for the last occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The search is restricted to the items around the position predicted by the learned index.
+This returns the same results of col_find_last_##T.
+@param src       Memory mapped file address.
+@param kkeys     Knot keys of the learned index, as built by col_build_learned_##T.
+@param kpos      Knot positions of the learned index.
+@param nknots    Number of knots.
+@param eps       Maximum error used to build the learned index.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t col_find_last_learned_##T(const T *src, const uint64_t *kkeys, const uint64_t *kpos, uint64_t nknots, uint64_t eps, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+LEARNED_LAST_NARROW_BLOCK \
+FIND_LOOP_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_LAST_INNER_CHECK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_last_learned(uint8_t)
+define_col_find_last_learned(uint16_t)
+define_col_find_last_learned(uint32_t)
+define_col_find_last_learned(uint64_t)
+
+// --- S-TREE ---
+
+// The S-tree is a static B+tree where each node contains the keys that fill
+// one 64 bytes cache line, so each level of the tree costs at most one cache
+// miss and the keys of a node are compared in parallel with SIMD instructions.
+// The leaves are the blocks of STREE_KEYS items of the sorted column itself,
+// so only the internal nodes are stored in the index, from the root level down.
+// The i-th key of an internal node is the first value of the (i + 1)-th child
+// subtree, padded with the maximum value of the type, and the number of keys
+// less than the searched value is the index of the child to visit.
+// Only AVX2 and AVX-512 are used for the node comparison, as the plain loop
+// is faster than the SSE2 version (no unsigned or 64 bit comparisons).
+
+#define STREE_KEYS_uint32_t 16 //!< Number of uint32_t keys in a 64 bytes S-tree node
+#define STREE_KEYS_uint64_t 8  //!< Number of uint64_t keys in a 64 bytes S-tree node
+#define STREE_MAX_LEVELS 24    //!< Maximum number of internal levels of a S-tree
+
+/**
+ * Count the number of keys in a 64 bytes S-tree node (16 values) that are less than the search value.
+ *
+ * @param node      Pointer to the first key of the node.
+ * @param search    Unsigned number to search.
+ *
+ * @return Number of keys less than the search value.
+ */
+static inline uint64_t stree_count_lt_uint32_t(const uint32_t *node, uint32_t search)
+{
+#if defined(BINSEARCH_AVX512)
+    __m512i v = _mm512_loadu_si512((const void *)node);
+    return (uint64_t)__builtin_popcount((unsigned int)_mm512_cmplt_epu32_mask(v, _mm512_set1_epi32((int)search)));
+#elif defined(BINSEARCH_AVX2)
+    const __m256i bias = _mm256_set1_epi32((int)0x80000000);
+    const __m256i s = _mm256_xor_si256(_mm256_set1_epi32((int)search), bias);
+    __m256i v0 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)node), bias);
+    __m256i v1 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(node + 8)), bias);
+    int m0 = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(s, v0)));
+    int m1 = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(s, v1)));
+    return (uint64_t)__builtin_popcount((unsigned int)(m0 | (m1 << 8)));
+#else
+    uint64_t i, cnt = 0;
+    for (i = 0; i < STREE_KEYS_uint32_t; i++)
+    {
+        cnt += (uint64_t)(node[i] < search);
+    }
+    return cnt;
+#endif
+}
+
+/**
+ * Count the number of keys in a 64 bytes S-tree node (8 values) that are less than the search value.
+ *
+ * @param node      Pointer to the first key of the node.
+ * @param search    Unsigned number to search.
+ *
+ * @return Number of keys less than the search value.
+ */
+static inline uint64_t stree_count_lt_uint64_t(const uint64_t *node, uint64_t search)
+{
+#if defined(BINSEARCH_AVX512)
+    __m512i v = _mm512_loadu_si512((const void *)node);
+    return (uint64_t)__builtin_popcount((unsigned int)_mm512_cmplt_epu64_mask(v, _mm512_set1_epi64((long long)search)));
+#elif defined(BINSEARCH_AVX2)
+    const __m256i bias = _mm256_set1_epi64x((long long)0x8000000000000000);
+    const __m256i s = _mm256_xor_si256(_mm256_set1_epi64x((long long)search), bias);
+    __m256i v0 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)node), bias);
+    __m256i v1 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(node + 4)), bias);
+    int m0 = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(s, v0)));
+    int m1 = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(s, v1)));
+    return (uint64_t)__builtin_popcount((unsigned int)(m0 | (m1 << 4)));
+#else
+    uint64_t i, cnt = 0;
+    for (i = 0; i < STREE_KEYS_uint64_t; i++)
+    {
+        cnt += (uint64_t)(node[i] < search);
+    }
+    return cnt;
+#endif
+}
+
+/**
+ * Compute the number of nodes of each internal level of a S-tree, from the bottom level to the root.
+ *
+ * @param nitems    Number of items in the column.
+ * @param nkeys     Number of keys in a node.
+ * @param nnodes    Output array of STREE_MAX_LEVELS elements.
+ *
+ * @return Number of internal levels.
+ */
+static inline uint64_t stree_levels(uint64_t nitems, uint64_t nkeys, uint64_t *nnodes)
+{
+    uint64_t h = 0;
+    uint64_t nb = ((nitems + nkeys - 1) / nkeys); // number of leaf blocks
+    while ((nb > 1) && (h < STREE_MAX_LEVELS))
+    {
+        nb = ((nb + nkeys) / (nkeys + 1));
+        nnodes[h++] = nb;
+    }
+    return h;
+}
+
+/**
+ * Generic function to get the number of keys of the S-tree index of a column.
+ *
+ * @param T Unsigned integer type, one of: uint32_t, uint64_t.
+ */
+#define define_stree_size(T) \
+/** Returns the number of T elements of the S-tree index (internal nodes) of a column.
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@return Number of T keys of the S-tree index.
+*/ \
+static inline uint64_t stree_size_##T(uint64_t nitems) \
+{ \
+    uint64_t nnodes[STREE_MAX_LEVELS]; \
+    uint64_t h = stree_levels(nitems, STREE_KEYS_##T, nnodes); \
+    uint64_t size = 0; \
+    while (h > 0) \
+    { \
+        size += nnodes[--h]; \
+    } \
+    return (size * STREE_KEYS_##T); \
+}
+
+define_stree_size(uint32_t)
+define_stree_size(uint64_t)
+
+/**
+ * Generic function to build the S-tree index of a sorted column.
+ *
+ * @param T Unsigned integer type, one of: uint32_t, uint64_t.
+ * @param M Maximum value for the type T.
+ */
+#define define_col_build_stree(T, M) \
+/** Build the S-tree index (static B+tree with 64 bytes nodes) of a column containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+@param src       Memory mapped column address (e.g. get_src_offset_##T(mf.src, mf.index[col])).
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@param dst       Output buffer of stree_size_##T(nitems) elements, preferably aligned to 64 bytes.
+*/ \
+static inline void col_build_stree_##T(const T *src, uint64_t nitems, T *dst) \
+{ \
+    uint64_t nnodes[STREE_MAX_LEVELS]; \
+    uint64_t h = stree_levels(nitems, STREE_KEYS_##T, nnodes); \
+    uint64_t span = STREE_KEYS_##T; /* number of items covered by a child subtree */ \
+    uint64_t level, j, i, pos, off = stree_size_##T(nitems); \
+    for (level = 0; level < h; level++) \
+    { \
+        off -= (nnodes[level] * STREE_KEYS_##T); \
+        for (j = 0; j < nnodes[level]; j++) \
+        { \
+            for (i = 0; i < STREE_KEYS_##T; i++) \
+            { \
+                pos = (((j * (STREE_KEYS_##T + 1)) + i + 1) * span); \
+                dst[off + (j * STREE_KEYS_##T) + i] = (pos < nitems) ? src[pos] : (M); \
+            } \
+        } \
+        span *= (STREE_KEYS_##T + 1); \
+    } \
+}
+
+define_col_build_stree(uint32_t, UINT32_MAX)
+define_col_build_stree(uint64_t, UINT64_MAX)
+
+/**
+ * Generic function to find the position of the first item not less than the searched value using the S-tree index.
+ *
+ * @param T Unsigned integer type, one of: uint32_t, uint64_t.
+ */
+#define define_stree_lower_bound(T) \
+/** Returns the position of the first item not less than the searched value (or nitems) using the S-tree index.
+@param src       Memory mapped column address.
+@param tree      S-tree index, as built by col_build_stree_##T.
+@param nitems    Number of items in the column.
+@param search    Unsigned number to search (type T).
+@return Position of the first item not less than the searched value.
+*/ \
+static inline uint64_t stree_lower_bound_##T(const T *src, const T *tree, uint64_t nitems, T search) \
+{ \
+    uint64_t nnodes[STREE_MAX_LEVELS]; \
+    uint64_t h = stree_levels(nitems, STREE_KEYS_##T, nnodes); \
+    uint64_t k = 0, off = 0, pos, i; \
+    while (h > 0) \
+    { \
+        --h; \
+        k = ((k * (STREE_KEYS_##T + 1)) + stree_count_lt_##T(tree + ((off + k) * STREE_KEYS_##T), search)); \
+        off += nnodes[h]; \
+    } \
+    pos = (k * STREE_KEYS_##T); \
+    if ((pos + STREE_KEYS_##T) <= nitems) \
+    { \
+        return (pos + stree_count_lt_##T(src + pos, search)); \
+    } \
+    for (i = pos; (i < nitems) && (src[i] < search); i++) {} \
+    return i; \
+}
+
+define_stree_lower_bound(uint32_t)
+define_stree_lower_bound(uint64_t)
+
+/**
+ * Build the S-tree index of a sorted column and save it as a BINSRC sidecar file.
+ * The sidecar file can be loaded with mmap_binfile and the S-tree is the first column.
+ *
+ * @param file  Path to the sidecar file to create.
+ * @param mf    Structure containing the memory mapped source file.
+ * @param col   Column number of the sorted column in the source file (4 or 8 bytes).
+ *
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+static inline int save_stree(const char *file, mmfile_t mf, uint8_t col)
+{
+    mmfile_t smf;
+    uint64_t size;
+    switch (mf.ctbytes[col])
+    {
+    case 4:
+        size = stree_size_uint32_t(mf.nrows);
+        break;
+    case 8:
+        size = stree_size_uint64_t(mf.nrows);
+        break;
+    default:
+        return -1;
+    }
+    create_binsrc(file, 1, &mf.ctbytes[col], size, &smf);
+    if ((smf.fd < 0) || (smf.src == MAP_FAILED))
+    {
+        if (smf.fd >= 0)
+        {
+            close(smf.fd);
+        }
+        return -1;
+    }
+    if (mf.ctbytes[col] == 4)
+    {
+        col_build_stree_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[col]), mf.nrows, (uint32_t *)(smf.src + smf.index[0]));
+    }
+    else
+    {
+        col_build_stree_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[col]), mf.nrows, (uint64_t *)(smf.src + smf.index[0]));
+    }
+    return munmap_binfile(smf);
+}
+
+// The S-tree blocks set [first, last] to the lower (or upper) bound found with
+// the index, clamped to the initial range, so the results are the same of the
+// binary search functions.
+
+#define STREE_NARROW_BLOCK \
+    *first = (middle < *first) ? *first : ((middle > *last) ? *last : middle); \
+    *last = *first; \
+    middle = *first;
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using the S-tree index.
+ *
+ * @param T Unsigned integer type, one of: uint32_t, uint64_t.
+ */
+#define define_col_find_first_stree(T) \
+/** Search for the first occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The search descends the S-tree index, with one cache line per level.
+This returns the same results of col_find_first_##T.
+@param src       Memory mapped file address.
+@param tree      S-tree index, as built by col_build_stree_##T.
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+BINSEARCH_KERNEL(col_find_first_stree_##T, (const T *src, const T *tree, uint64_t nitems, uint64_t *first, uint64_t *last, T search)) \
+{ \
+FIND_START_BLOCK(T) \
+    middle = stree_lower_bound_##T(src, tree, nitems, search); \
+STREE_NARROW_BLOCK \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_first_stree(uint32_t)
+define_col_find_first_stree(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * using the S-tree index.
+ *
+ * @param T Unsigned integer type, one of: uint32_t, uint64_t.
+ * @param M Maximum value for the type T.
+ */
+#define define_col_find_last_stree(T, M) \
+/** Search for the last occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+The search descends the S-tree index, with one cache line per level.
+This returns the same results of col_find_last_##T.
+@param src       Memory mapped file address.
+@param tree      S-tree index, as built by col_build_stree_##T.
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+BINSEARCH_KERNEL(col_find_last_stree_##T, (const T *src, const T *tree, uint64_t nitems, uint64_t *first, uint64_t *last, T search)) \
+{ \
+FIND_START_BLOCK(T) \
+    middle = (search == (M)) ? nitems : stree_lower_bound_##T(src, tree, nitems, (T)(search + 1)); \
+STREE_NARROW_BLOCK \
+    --middle; \
+COL_GET_ITEM_TASK \
+FIND_END_LOOP_BLOCK \
+}
+
+define_col_find_last_stree(uint32_t, UINT32_MAX)
+define_col_find_last_stree(uint64_t, UINT64_MAX)
+
+// --- FENCE INDEX ---
+
+// The fence index is a sparse copy of one key every "step" rows of a row-mode
+// file (e.g. the first key of every memory page when step = 4096 / blklen).
+// The compact fence array is searched first, then the search of the mapped
+// file is restricted to the (step + 1) rows between two fences, so a cold
+// lookup only touches one or two pages of the file.
+
+/**
+ * Generic function to build the fence index of a sorted column in a memory mapped binary file.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_build_fence(O, T) \
+/** Build the fence index of the values in a memory mapped binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+The fence index contains the values of the items 0, step, (2 * step), ... in native format.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number inside a binary block.
+@param nitems    Number of items (rows).
+@param step      Distance in rows between two fences (e.g. 4096 / blklen), greater than 0.
+@param dst       Output buffer of ((nitems + step - 1) / step) elements or NULL to only count the fences.
+@return Number of fences, or 0 if step is 0.
+*/ \
+static inline uint64_t build_fence_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t nitems, uint64_t step, T *dst) \
+{ \
+    uint64_t i, nfences = 0; \
+    if (step == 0) \
+    { \
+        return 0; \
+    } \
+    if (dst == NULL) \
+    { \
+        return ((nitems + step - 1) / step); \
+    } \
+    for (i = 0; i < nitems; i += step) \
+    { \
+        dst[nfences++] = bytes_##O##_to_##T(src, get_address(blklen, blkpos, i)); \
+    } \
+    return nfences; \
+}
+
+define_build_fence(be, uint8_t)
+define_build_fence(be, uint16_t)
+define_build_fence(be, uint32_t)
+define_build_fence(be, uint64_t)
+define_build_fence(le, uint8_t)
+define_build_fence(le, uint16_t)
+define_build_fence(le, uint32_t)
+define_build_fence(le, uint64_t)
+
+/**
+ * Generic function to build the fence index of a sorted column in a memory mapped binary file
+ * and save it as a BINSRC sidecar file.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_save_fence(O, T) \
+/** Build the fence index of the values in a memory mapped binary file containing adjacent blocks of sorted binary data
+and save it as a BINSRC sidecar file with one column.
+The sidecar file can be loaded with mmap_binfile and the number of fences is in smf.nrows.
+@param file      Path to the sidecar file to create.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number inside a binary block.
+@param nitems    Number of items (rows).
+@param step      Distance in rows between two fences (e.g. 4096 / blklen), greater than 0.
+@return 0 on success, -1 on failure (errno is set).
+*/ \
+static inline int save_fence_##O##_##T(const char *file, const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t nitems, uint64_t step) \
+{ \
+    const uint8_t ctbytes = (uint8_t)sizeof(T); \
+    mmfile_t smf; \
+    if (step == 0) \
+    { \
+        return -1; \
+    } \
+    create_binsrc(file, 1, &ctbytes, build_fence_##O##_##T(src, blklen, blkpos, nitems, step, NULL), &smf); \
+    if ((smf.fd < 0) || (smf.src == MAP_FAILED)) \
+    { \
+        if (smf.fd >= 0) \
+        { \
+            close(smf.fd); \
+        } \
+        return -1; \
+    } \
+    build_fence_##O##_##T(src, blklen, blkpos, nitems, step, (T *)(smf.src + smf.index[0])); \
+    return munmap_binfile(smf); \
+}
+
+define_save_fence(be, uint8_t)
+define_save_fence(be, uint16_t)
+define_save_fence(be, uint32_t)
+define_save_fence(be, uint64_t)
+define_save_fence(le, uint8_t)
+define_save_fence(le, uint16_t)
+define_save_fence(le, uint32_t)
+define_save_fence(le, uint64_t)
+
+// The fence blocks count the fences that send the search to the right side
+// (C is < for the first occurrence and <= for the last one) and restrict
+// [first, last] to the rows between the last of these fences and the next one.
+
+#define FENCE_NARROW_BLOCK(C) \
+    uint64_t lo = 0, hi = nfences; \
+    while (lo < hi) \
+    { \
+        middle = get_middle_point(lo, hi); \
+        if (fence[middle] C search) \
+        { \
+            lo = (middle + 1); \
+        } \
+        else \
+        { \
+            hi = middle; \
+        } \
+    } \
+    hi = (lo * step); \
+    lo = (lo > 0) ? (hi - step + 1) : 0; \
+    lo = (lo < *first) ? *first : ((lo > *last) ? *last : lo); \
+    hi = (hi < *first) ? *first : ((hi > *last) ? *last : hi); \
+    *first = lo; \
+    *last = hi;
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using the fence index.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_first_fence(O, T) \
+/** Search for the first occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+The fence index is searched first, then the file search is restricted to the rows between two fences.
+This returns the same results of find_first_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param fence     Fence index, as built by build_fence_##O##_##T.
+@param nfences   Number of fences.
+@param step      Distance in rows between two fences.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t find_first_fence_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const T *fence, uint64_t nfences, uint64_t step, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+FENCE_NARROW_BLOCK(<) \
+FIND_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+FIND_FIRST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_first_fence(be, uint8_t)
+define_find_first_fence(be, uint16_t)
+define_find_first_fence(be, uint32_t)
+define_find_first_fence(be, uint64_t)
+define_find_first_fence(le, uint8_t)
+define_find_first_fence(le, uint16_t)
+define_find_first_fence(le, uint32_t)
+define_find_first_fence(le, uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * using the fence index.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_last_fence(O, T) \
+/** Search for the last occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+The fence index is searched first, then the file search is restricted to the rows between two fences.
+This returns the same results of find_last_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param fence     Fence index, as built by build_fence_##O##_##T.
+@param nfences   Number of fences.
+@param step      Distance in rows between two fences.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t find_last_fence_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const T *fence, uint64_t nfences, uint64_t step, uint64_t *first, uint64_t *last, T search) \
+{ \
+FIND_START_BLOCK(T) \
+FENCE_NARROW_BLOCK(<=) \
+FIND_LOOP_BLOCK \
+GET_ITEM_TASK(O, T) \
+FIND_LAST_INNER_CHECK \
+GET_ITEM_TASK(O, T) \
+FIND_END_LOOP_BLOCK \
+}
+
+define_find_last_fence(be, uint8_t)
+define_find_last_fence(be, uint16_t)
+define_find_last_fence(be, uint32_t)
+define_find_last_fence(be, uint64_t)
+define_find_last_fence(le, uint8_t)
+define_find_last_fence(le, uint16_t)
+define_find_last_fence(le, uint32_t)
+define_find_last_fence(le, uint64_t)
+
+// --- BLOOM FILTER ---
+
+// The blocked Bloom filter is an approximate membership filter where all the
+// bits of a key are set in the same 64 bytes block (8 words of 64 bits, one
+// bit per word), so a negative lookup costs one cache line and no probes of
+// the searched data. There are no false negatives, while the false positive
+// rate is about 3% with 8 bits per key, 0.4% with 12 and 0.1% with 16.
+
+/**
+ * Mix the bits of a key (MurmurHash3 64 bit finalizer).
+ *
+ * @param key   Key to hash.
+ *
+ * @return Hash value.
+ */
+static inline uint64_t bloom_hash(uint64_t key)
+{
+    key ^= (key >> 33);
+    key *= 0xff51afd7ed558ccd;
+    key ^= (key >> 33);
+    key *= 0xc4ceb9fe1a85ec53;
+    key ^= (key >> 33);
+    return key;
+}
+
+/**
+ * Returns the number of 64 bytes blocks of a Bloom filter.
+ *
+ * @param nkeys         Number of distinct keys.
+ * @param bits_per_key  Number of bits per key (e.g. 12).
+ *
+ * @return Number of blocks (the filter contains 8 uint64_t words per block).
+ */
+static inline uint64_t bloom_nblocks(uint64_t nkeys, uint64_t bits_per_key)
+{
+    uint64_t nblocks = (((nkeys * bits_per_key) + 511) >> 9);
+    return (nblocks > 0) ? nblocks : 1;
+}
+
+/**
+ * Add a key to the Bloom filter.
+ *
+ * @param filter    Bloom filter (nblocks * 8 words).
+ * @param nblocks   Number of blocks.
+ * @param key       Key to add.
+ */
+static inline void bloom_add(uint64_t *filter, uint64_t nblocks, uint64_t key)
+{
+    uint64_t h = bloom_hash(key);
+    uint64_t *b = (filter + ((((h >> 32) * nblocks) >> 32) << 3));
+    h *= 0x9e3779b97f4a7c15;
+    int i;
+    for (i = 0; i < 8; i++)
+    {
+        b[i] |= ((uint64_t)1 << ((h >> (16 + (6 * i))) & 63));
+    }
+}
+
+/**
+ * Check if a key may be contained in the Bloom filter.
+ *
+ * @param filter    Bloom filter (nblocks * 8 words).
+ * @param nblocks   Number of blocks.
+ * @param key       Key to check.
+ *
+ * @return False if the key is certainly not present, true if it may be present.
+ */
+static inline bool maybe_contains(const uint64_t *filter, uint64_t nblocks, uint64_t key)
+{
+    uint64_t h = bloom_hash(key);
+    const uint64_t *b = (filter + ((((h >> 32) * nblocks) >> 32) << 3));
+    h *= 0x9e3779b97f4a7c15;
+    uint64_t m = 1;
+    int i;
+    for (i = 0; i < 8; i++)
+    {
+        m &= (b[i] >> ((h >> (16 + (6 * i))) & 63));
+    }
+    return (m != 0);
+}
+
+#define BLOOM_BUILD_BLOCK(T) \
+    uint64_t i; \
+    T x, prev = 0; \
+    for (i = 0; i < (nblocks << 3); i++) \
+    { \
+        filter[i] = 0; \
+    } \
+    for (i = 0; i < nitems; i++) \
+    {
+
+#define BLOOM_BUILD_END_BLOCK \
+        if ((i == 0) || (x != prev)) \
+        { \
+            bloom_add(filter, nblocks, (uint64_t)x); \
+        } \
+        prev = x; \
+    }
+
+/**
+ * Generic function to build the Bloom filter of a sorted column in a memory mapped binary file.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_build_bloom(O, T) \
+/** Build the Bloom filter of the values in a memory mapped binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number inside a binary block.
+@param nitems    Number of items (rows).
+@param nblocks   Number of blocks of the filter (e.g. bloom_nblocks(nitems, 12)).
+@param filter    Output buffer of (nblocks * 8) elements.
+*/ \
+static inline void build_bloom_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t nitems, uint64_t nblocks, uint64_t *filter) \
+{ \
+BLOOM_BUILD_BLOCK(T) \
+        x = bytes_##O##_to_##T(src, get_address(blklen, blkpos, i)); \
+BLOOM_BUILD_END_BLOCK \
+}
+
+define_build_bloom(be, uint8_t)
+define_build_bloom(be, uint16_t)
+define_build_bloom(be, uint32_t)
+define_build_bloom(be, uint64_t)
+define_build_bloom(le, uint8_t)
+define_build_bloom(le, uint16_t)
+define_build_bloom(le, uint32_t)
+define_build_bloom(le, uint64_t)
+
+/**
+ * Generic function to build the Bloom filter of a sorted column.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_build_bloom(T) \
+/** Build the Bloom filter of a column containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+@param src       Memory mapped column address (e.g. get_src_offset_##T(mf.src, mf.index[col])).
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@param nblocks   Number of blocks of the filter (e.g. bloom_nblocks(nitems, 12)).
+@param filter    Output buffer of (nblocks * 8) elements.
+*/ \
+static inline void col_build_bloom_##T(const T *src, uint64_t nitems, uint64_t nblocks, uint64_t *filter) \
+{ \
+BLOOM_BUILD_BLOCK(T) \
+        x = src[i]; \
+BLOOM_BUILD_END_BLOCK \
+}
+
+define_col_build_bloom(uint8_t)
+define_col_build_bloom(uint16_t)
+define_col_build_bloom(uint32_t)
+define_col_build_bloom(uint64_t)
+
+/**
+ * Generic function to count the distinct values of a sorted column.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_count_distinct(T) \
+/** Count the distinct values of a column containing contiguos blocks of unsigned integers of the same type.
+The values must be sorted in ascending order.
+@param src       Memory mapped column address (e.g. get_src_offset_##T(mf.src, mf.index[col])).
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@return Number of distinct values.
+*/ \
+static inline uint64_t col_count_distinct_##T(const T *src, uint64_t nitems) \
+{ \
+    uint64_t i, n = (nitems > 0); \
+    for (i = 1; i < nitems; i++) \
+    { \
+        n += (uint64_t)(src[i] != src[i - 1]); \
+    } \
+    return n; \
+}
+
+define_col_count_distinct(uint8_t)
+define_col_count_distinct(uint16_t)
+define_col_count_distinct(uint32_t)
+define_col_count_distinct(uint64_t)
+
+/**
+ * Build the Bloom filter of a sorted column and save it as a BINSRC sidecar file
+ * with one uint64_t column. The sidecar file can be loaded with mmap_binfile and
+ * the number of blocks is (smf.nrows / 8).
+ *
+ * @param file          Path to the sidecar file to create.
+ * @param mf            Structure containing the memory mapped source file.
+ * @param col           Column number of the sorted column in the source file.
+ * @param bits_per_key  Number of bits per distinct key (e.g. 12).
+ *
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+static inline int save_bloom(const char *file, mmfile_t mf, uint8_t col, uint64_t bits_per_key)
+{
+    const uint8_t ctbytes = 8;
+    uint64_t nkeys;
+    switch (mf.ctbytes[col])
+    {
+    case 1:
+        nkeys = col_count_distinct_uint8_t(get_src_offset_uint8_t(mf.src, mf.index[col]), mf.nrows);
+        break;
+    case 2:
+        nkeys = col_count_distinct_uint16_t(get_src_offset_uint16_t(mf.src, mf.index[col]), mf.nrows);
+        break;
+    case 4:
+        nkeys = col_count_distinct_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[col]), mf.nrows);
+        break;
+    case 8:
+        nkeys = col_count_distinct_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[col]), mf.nrows);
+        break;
+    default:
+        return -1;
+    }
+    uint64_t nblocks = bloom_nblocks(nkeys, bits_per_key);
+    mmfile_t smf;
+    create_binsrc(file, 1, &ctbytes, (nblocks << 3), &smf);
+    if ((smf.fd < 0) || (smf.src == MAP_FAILED))
+    {
+        if (smf.fd >= 0)
+        {
+            close(smf.fd);
+        }
+        return -1;
+    }
+    uint64_t *filter = (uint64_t *)(smf.src + smf.index[0]);
+    switch (mf.ctbytes[col])
+    {
+    case 1:
+        col_build_bloom_uint8_t(get_src_offset_uint8_t(mf.src, mf.index[col]), mf.nrows, nblocks, filter);
+        break;
+    case 2:
+        col_build_bloom_uint16_t(get_src_offset_uint16_t(mf.src, mf.index[col]), mf.nrows, nblocks, filter);
+        break;
+    case 4:
+        col_build_bloom_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[col]), mf.nrows, nblocks, filter);
+        break;
+    default:
+        col_build_bloom_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[col]), mf.nrows, nblocks, filter);
+        break;
+    }
+    return munmap_binfile(smf);
+}
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * skipping the search when the Bloom filter excludes the value.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_first_filtered(O, T) \
+/** Search for the first occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+When the Bloom filter excludes the value this returns (last) without searching
+and without changing the first and last values, otherwise it returns the same
+results of find_first_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param filter    Bloom filter, as built by build_bloom_##O##_##T.
+@param nblocks   Number of blocks of the Bloom filter.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t find_first_filtered_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *filter, uint64_t nblocks, uint64_t *first, uint64_t *last, T search) \
+{ \
+    if (!maybe_contains(filter, nblocks, (uint64_t)search)) \
+    { \
+        return *last; \
+    } \
+    return find_first_##O##_##T(src, blklen, blkpos, first, last, search); \
+}
+
+define_find_first_filtered(be, uint8_t)
+define_find_first_filtered(be, uint16_t)
+define_find_first_filtered(be, uint32_t)
+define_find_first_filtered(be, uint64_t)
+define_find_first_filtered(le, uint8_t)
+define_find_first_filtered(le, uint16_t)
+define_find_first_filtered(le, uint32_t)
+define_find_first_filtered(le, uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory mapped binary file containing adjacent blocks of sorted binary data,
+ * skipping the search when the Bloom filter excludes the value.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_last_filtered(O, T) \
+/** Search for the last occurrence of an unsigned integer on a memory mapped
+binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+When the Bloom filter excludes the value this returns (last) without searching
+and without changing the first and last values, otherwise it returns the same
+results of find_last_##O##_##T.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param filter    Bloom filter, as built by build_bloom_##O##_##T.
+@param nblocks   Number of blocks of the Bloom filter.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t find_last_filtered_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *filter, uint64_t nblocks, uint64_t *first, uint64_t *last, T search) \
+{ \
+    if (!maybe_contains(filter, nblocks, (uint64_t)search)) \
+    { \
+        return *last; \
+    } \
+    return find_last_##O##_##T(src, blklen, blkpos, first, last, search); \
+}
+
+define_find_last_filtered(be, uint8_t)
+define_find_last_filtered(be, uint16_t)
+define_find_last_filtered(be, uint32_t)
+define_find_last_filtered(be, uint64_t)
+define_find_last_filtered(le, uint8_t)
+define_find_last_filtered(le, uint16_t)
+define_find_last_filtered(le, uint32_t)
+define_find_last_filtered(le, uint64_t)
+
+/**
+ * Generic function to search for the first occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * skipping the search when the Bloom filter excludes the value.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_first_filtered(T) \
+/** Search for the first occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+When the Bloom filter excludes the value this returns (last) without searching
+and without changing the first and last values, otherwise it returns the same
+results of col_find_first_##T.
+@param src       Memory mapped file address.
+@param filter    Bloom filter, as built by col_build_bloom_##T.
+@param nblocks   Number of blocks of the Bloom filter.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return item number if notfound or (last + 1) if not notfound.
+ */ \
+static inline uint64_t col_find_first_filtered_##T(const T *src, const uint64_t *filter, uint64_t nblocks, uint64_t *first, uint64_t *last, T search) \
+{ \
+    if (!maybe_contains(filter, nblocks, (uint64_t)search)) \
+    { \
+        return *last; \
+    } \
+    return col_find_first_##T(src, first, last, search); \
+}
+
+define_col_find_first_filtered(uint8_t)
+define_col_find_first_filtered(uint16_t)
+define_col_find_first_filtered(uint32_t)
+define_col_find_first_filtered(uint64_t)
+
+/**
+ * Generic function to search for the last occurrence of an unsigned integer
+ * on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+ * skipping the search when the Bloom filter excludes the value.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_last_filtered(T) \
+/** Search for the last occurrence of an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+When the Bloom filter excludes the value this returns (last) without searching
+and without changing the first and last values, otherwise it returns the same
+results of col_find_last_##T.
+@param src       Memory mapped file address.
+@param filter    Bloom filter, as built by col_build_bloom_##T.
+@param nblocks   Number of blocks of the Bloom filter.
+@param first     Pointer to the element from where to start the search (min value = 0).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@return Item number if notfound or (last + 1) if not notfound.
+*/ \
+static inline uint64_t col_find_last_filtered_##T(const T *src, const uint64_t *filter, uint64_t nblocks, uint64_t *first, uint64_t *last, T search) \
+{ \
+    if (!maybe_contains(filter, nblocks, (uint64_t)search)) \
+    { \
+        return *last; \
+    } \
+    return col_find_last_##T(src, first, last, search); \
+}
+
+define_col_find_last_filtered(uint8_t)
+define_col_find_last_filtered(uint16_t)
+define_col_find_last_filtered(uint32_t)
+define_col_find_last_filtered(uint64_t)
+
+// --- RANGE FILTER ---
+
+// The range filter answers "is there any key in [lo, hi]?" without touching the
+// data, in the spirit of Rosetta: the prefixes (key >> (level * stride)) of every
+// key are added, for each level, to a single blocked Bloom filter. A range query
+// probes the prefixes covering [lo, hi] at the top level and only descends into
+// the positive ones, so an empty range usually costs a few cache lines. There are
+// no false negatives. The filter words start with a header of
+// RANGE_FILTER_HEADER_WORDS words: stride, nlevels, nblocks, min key, max key.
+// The top level should cover the typical range width: ranges wider than about
+// (RANGE_FILTER_MAX_PROBES << ((nlevels - 1) * stride)) are reported as non-empty.
+
+#define RANGE_FILTER_HEADER_WORDS 8
+
+#ifndef RANGE_FILTER_MAX_PROBES
+// Maximum number of Bloom filter probes per range query, after which the range is
+// reported as possibly non-empty (e.g. for ranges much wider than the top level).
+#define RANGE_FILTER_MAX_PROBES 64
+#endif
+
+/**
+ * Check the level parameters of a range filter.
+ *
+ * @param stride    Number of bits between levels.
+ * @param nlevels   Number of levels.
+ *
+ * @return True if stride and nlevels are greater than 0 and ((nlevels - 1) * stride) < 64.
+ */
+static inline bool range_filter_valid(uint64_t stride, uint64_t nlevels)
+{
+    return ((stride > 0) && (stride < 64) && (nlevels > 0) && ((nlevels - 1) <= (63 / stride)));
+}
+
+/**
+ * Returns the Bloom filter key of a prefix at the specified level.
+ *
+ * @param prefix    Key prefix (key >> (level * stride)).
+ * @param level     Level number.
+ *
+ * @return Bloom filter key.
+ */
+static inline uint64_t range_filter_key(uint64_t prefix, uint64_t level)
+{
+    return (prefix ^ (level * 0x9e3779b97f4a7c15));
+}
+
+/**
+ * Check the prefixes of the [lo, hi] range at the specified level and recursively
+ * descend into the positive ones that are not fully contained in the range.
+ *
+ * @param filter    Bloom filter blocks.
+ * @param nblocks   Number of blocks.
+ * @param stride    Number of bits between levels.
+ * @param level     Level number.
+ * @param lo        Lower bound of the range (included).
+ * @param hi        Upper bound of the range (included).
+ * @param budget    Pointer to the number of probes left.
+ *
+ * @return False if the range is certainly empty, true if it may contain a key.
+ */
+static inline bool range_filter_scan(const uint64_t *filter, uint64_t nblocks, uint64_t stride, uint64_t level, uint64_t lo, uint64_t hi, uint64_t *budget)
+{
+    uint64_t shift = (level * stride);
+    uint64_t mask = (((uint64_t)1 << shift) - 1);
+    uint64_t c = (lo >> shift), cend = (hi >> shift), nlo, nhi;
+    for (;;)
+    {
+        if (*budget == 0)
+        {
+            return true;
+        }
+        --*budget;
+        if (maybe_contains(filter, nblocks, range_filter_key(c, level)))
+        {
+            nlo = (c << shift);
+            nhi = (nlo | mask);
+            if ((level == 0) || ((nlo >= lo) && (nhi <= hi)))
+            {
+                return true;
+            }
+            if (range_filter_scan(filter, nblocks, stride, (level - 1), ((nlo > lo) ? nlo : lo), ((nhi < hi) ? nhi : hi), budget))
+            {
+                return true;
+            }
+        }
+        if (c == cend)
+        {
+            return false;
+        }
+        ++c;
+    }
+}
+
+/**
+ * Check if the [lo, hi] range may contain any key.
+ *
+ * @param rf    Range filter words (header followed by the Bloom filter blocks).
+ * @param lo    Lower bound of the range (included).
+ * @param hi    Upper bound of the range (included).
+ *
+ * @return False if the range is certainly empty, true if it may contain a key
+ *         (always true for a non-empty range if the filter was built with invalid parameters).
+ */
+static inline bool range_maybe_nonempty(const uint64_t *rf, uint64_t lo, uint64_t hi)
+{
+    if (!range_filter_valid(rf[0], rf[1]) || (rf[2] == 0))
+    {
+        return (lo <= hi);
+    }
+    if (lo < rf[3])
+    {
+        lo = rf[3];
+    }
+    if (hi > rf[4])
+    {
+        hi = rf[4];
+    }
+    if (lo > hi)
+    {
+        return false;
+    }
+    uint64_t budget = RANGE_FILTER_MAX_PROBES;
+    return range_filter_scan((rf + RANGE_FILTER_HEADER_WORDS), rf[2], rf[0], (rf[1] - 1), lo, hi, &budget);
+}
+
+#define RANGE_FILTER_BUILD_BLOCK \
+    uint64_t i, j, s, n = 0; \
+    uint64_t x, prev = 0; \
+    if (!range_filter_valid(stride, nlevels) || ((rf != NULL) && (nblocks == 0))) \
+    { \
+        if (rf != NULL) \
+        { \
+            for (i = 0; i < RANGE_FILTER_HEADER_WORDS; i++) \
+            { \
+                rf[i] = 0; \
+            } \
+        } \
+        return 0; \
+    } \
+    if (rf != NULL) \
+    { \
+        for (i = 0; i < (RANGE_FILTER_HEADER_WORDS + (nblocks << 3)); i++) \
+        { \
+            rf[i] = 0; \
+        } \
+        rf[0] = stride; \
+        rf[1] = nlevels; \
+        rf[2] = nblocks; \
+        rf[3] = UINT64_MAX; \
+    } \
+    for (i = 0; i < nitems; i++) \
+    {
+
+#define RANGE_FILTER_BUILD_END_BLOCK \
+        for (j = 0, s = 0; j < nlevels; j++, s += stride) \
+        { \
+            if ((i > 0) && ((x >> s) == (prev >> s))) \
+            { \
+                break; \
+            } \
+            if (rf != NULL) \
+            { \
+                bloom_add((rf + RANGE_FILTER_HEADER_WORDS), nblocks, range_filter_key((x >> s), j)); \
+            } \
+            ++n; \
+        } \
+        prev = x; \
+    } \
+    if ((rf != NULL) && (nitems > 0)) \
+    { \
+        rf[3] = first_key; \
+        rf[4] = prev; \
+    } \
+    return n;
+
+/**
+ * Generic function to build the range filter of a sorted column in a memory mapped binary file.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_build_range_filter(O, T) \
+/** Build the range filter of the values in a memory mapped binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number inside a binary block.
+@param nitems    Number of items (rows).
+@param stride    Number of bits between levels (e.g. 4).
+@param nlevels   Number of levels (e.g. 4), with ((nlevels - 1) * stride) < 64.
+@param nblocks   Number of Bloom filter blocks (e.g. bloom_nblocks(nprefixes, 12)), greater than 0.
+@param rf        Output buffer of (RANGE_FILTER_HEADER_WORDS + (nblocks * 8)) elements or NULL to only count the prefixes.
+@return Number of prefixes (keys of the Bloom filter), or 0 if the parameters are not valid
+(the header is cleared and range_maybe_nonempty returns true for any non-empty range).
+*/ \
+static inline uint64_t build_range_filter_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t nitems, uint64_t stride, uint64_t nlevels, uint64_t nblocks, uint64_t *rf) \
+{ \
+    uint64_t first_key = (nitems > 0) ? (uint64_t)bytes_##O##_to_##T(src, get_address(blklen, blkpos, 0)) : 0; \
+RANGE_FILTER_BUILD_BLOCK \
+        x = (uint64_t)bytes_##O##_to_##T(src, get_address(blklen, blkpos, i)); \
+RANGE_FILTER_BUILD_END_BLOCK \
+}
+
+define_build_range_filter(be, uint8_t)
+define_build_range_filter(be, uint16_t)
+define_build_range_filter(be, uint32_t)
+define_build_range_filter(be, uint64_t)
+define_build_range_filter(le, uint8_t)
+define_build_range_filter(le, uint16_t)
+define_build_range_filter(le, uint32_t)
+define_build_range_filter(le, uint64_t)
+
+/**
+ * Generic function to build the range filter of a sorted column.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_build_range_filter(T) \
+/** Build the range filter of a column containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+@param src       Memory mapped column address (e.g. get_src_offset_##T(mf.src, mf.index[col])).
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@param stride    Number of bits between levels (e.g. 4).
+@param nlevels   Number of levels (e.g. 4), with ((nlevels - 1) * stride) < 64.
+@param nblocks   Number of Bloom filter blocks (e.g. bloom_nblocks(nprefixes, 12)), greater than 0.
+@param rf        Output buffer of (RANGE_FILTER_HEADER_WORDS + (nblocks * 8)) elements or NULL to only count the prefixes.
+@return Number of prefixes (keys of the Bloom filter), or 0 if the parameters are not valid
+(the header is cleared and range_maybe_nonempty returns true for any non-empty range).
+*/ \
+static inline uint64_t col_build_range_filter_##T(const T *src, uint64_t nitems, uint64_t stride, uint64_t nlevels, uint64_t nblocks, uint64_t *rf) \
+{ \
+    uint64_t first_key = (nitems > 0) ? (uint64_t)src[0] : 0; \
+RANGE_FILTER_BUILD_BLOCK \
+        x = (uint64_t)src[i]; \
+RANGE_FILTER_BUILD_END_BLOCK \
+}
+
+define_col_build_range_filter(uint8_t)
+define_col_build_range_filter(uint16_t)
+define_col_build_range_filter(uint32_t)
+define_col_build_range_filter(uint64_t)
+
+/**
+ * Build the range filter of a sorted column and save it as a BINSRC sidecar file
+ * with one uint64_t column. The sidecar file can be loaded with mmap_binfile and
+ * the range filter words start at (smf.src + smf.index[0]).
+ *
+ * @param file          Path to the sidecar file to create.
+ * @param mf            Structure containing the memory mapped source file.
+ * @param col           Column number of the sorted column in the source file.
+ * @param stride        Number of bits between levels (e.g. 4).
+ * @param nlevels       Number of levels (e.g. 4), with ((nlevels - 1) * stride) < 64.
+ * @param bits_per_key  Number of bits per prefix (e.g. 12).
+ *
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+static inline int save_range_filter(const char *file, mmfile_t mf, uint8_t col, uint64_t stride, uint64_t nlevels, uint64_t bits_per_key)
+{
+    const uint8_t ctbytes = 8;
+    uint64_t nkeys;
+    if (!range_filter_valid(stride, nlevels))
+    {
+        return -1;
+    }
+    switch (mf.ctbytes[col])
+    {
+    case 1:
+        nkeys = col_build_range_filter_uint8_t(get_src_offset_uint8_t(mf.src, mf.index[col]), mf.nrows, stride, nlevels, 0, NULL);
+        break;
+    case 2:
+        nkeys = col_build_range_filter_uint16_t(get_src_offset_uint16_t(mf.src, mf.index[col]), mf.nrows, stride, nlevels, 0, NULL);
+        break;
+    case 4:
+        nkeys = col_build_range_filter_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[col]), mf.nrows, stride, nlevels, 0, NULL);
+        break;
+    case 8:
+        nkeys = col_build_range_filter_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[col]), mf.nrows, stride, nlevels, 0, NULL);
+        break;
+    default:
+        return -1;
+    }
+    uint64_t nblocks = bloom_nblocks(nkeys, bits_per_key);
+    mmfile_t smf;
+    create_binsrc(file, 1, &ctbytes, (RANGE_FILTER_HEADER_WORDS + (nblocks << 3)), &smf);
+    if ((smf.fd < 0) || (smf.src == MAP_FAILED))
+    {
+        if (smf.fd >= 0)
+        {
+            close(smf.fd);
+        }
+        return -1;
+    }
+    uint64_t *rf = (uint64_t *)(smf.src + smf.index[0]);
+    switch (mf.ctbytes[col])
+    {
+    case 1:
+        col_build_range_filter_uint8_t(get_src_offset_uint8_t(mf.src, mf.index[col]), mf.nrows, stride, nlevels, nblocks, rf);
+        break;
+    case 2:
+        col_build_range_filter_uint16_t(get_src_offset_uint16_t(mf.src, mf.index[col]), mf.nrows, stride, nlevels, nblocks, rf);
+        break;
+    case 4:
+        col_build_range_filter_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[col]), mf.nrows, stride, nlevels, nblocks, rf);
+        break;
+    default:
+        col_build_range_filter_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[col]), mf.nrows, stride, nlevels, nblocks, rf);
+        break;
+    }
+    return munmap_binfile(smf);
+}
+
+// --- HASH INDEX ---
+
+// The hash index is a static open addressing (linear probing) hash table that maps
+// each distinct key of a sorted column to its [first, last) range of rows, so an
+// exact-match lookup costs one or two cache misses regardless of the number of
+// rows. The table words start with a header of HASH_INDEX_HEADER_WORDS words
+// (nslots, nitems, nkeys) followed by nslots slots of HASH_INDEX_SLOT_WORDS words
+// (key, first, last, unused), two slots per 64 bytes cache line.
+// Empty slots have last == 0.
+
+#define HASH_INDEX_HEADER_WORDS 8
+#define HASH_INDEX_SLOT_WORDS 4
+
+/**
+ * Returns the number of slots of a hash index (power of two with load factor <= 0.5).
+ *
+ * @param nkeys     Number of distinct keys.
+ *
+ * @return Number of slots (the table contains HASH_INDEX_HEADER_WORDS + (nslots * HASH_INDEX_SLOT_WORDS) words).
+ */
+static inline uint64_t hash_index_nslots(uint64_t nkeys)
+{
+    uint64_t nslots = 2;
+    while (nslots < (nkeys << 1))
+    {
+        nslots <<= 1;
+    }
+    return nslots;
+}
+
+/**
+ * Add a key with its range of rows to the hash index.
+ *
+ * @param ht        Hash index words.
+ * @param key       Key to add.
+ * @param first     First row containing the key.
+ * @param last      Row after the last one containing the key.
+ *
+ * @return True if the key is added, false if the table is full.
+ */
+static inline bool hash_index_add(uint64_t *ht, uint64_t key, uint64_t first, uint64_t last)
+{
+    uint64_t mask = (ht[0] - 1);
+    uint64_t pos = (bloom_hash(key) & mask);
+    uint64_t n;
+    uint64_t *slot;
+    for (n = 0; n < ht[0]; n++)
+    {
+        slot = (ht + HASH_INDEX_HEADER_WORDS + (pos * HASH_INDEX_SLOT_WORDS));
+        if (slot[2] == 0)
+        {
+            slot[0] = key;
+            slot[1] = first;
+            slot[2] = last;
+            return true;
+        }
+        pos = ((pos + 1) & mask);
+    }
+    return false;
+}
+
+/**
+ * Lookup the range of rows containing the specified key.
+ *
+ * @param ht        Hash index words.
+ * @param key       Key to search.
+ * @param first     Pointer to the first row containing the key (set only if found).
+ * @param last      Pointer to the row after the last one containing the key (set only if found).
+ *
+ * @return True if the key is found, false otherwise.
+ */
+static inline bool hash_index_lookup(const uint64_t *ht, uint64_t key, uint64_t *first, uint64_t *last)
+{
+    uint64_t mask = (ht[0] - 1);
+    uint64_t pos = (bloom_hash(key) & mask);
+    uint64_t n;
+    const uint64_t *slot;
+    for (n = 0; n < ht[0]; n++)
+    {
+        slot = (ht + HASH_INDEX_HEADER_WORDS + (pos * HASH_INDEX_SLOT_WORDS));
+        if (slot[2] == 0)
+        {
+            return false;
+        }
+        if (slot[0] == key)
+        {
+            *first = slot[1];
+            *last = slot[2];
+            return true;
+        }
+        pos = ((pos + 1) & mask);
+    }
+    return false;
+}
+
+/**
+ * Search for the first occurrence of an unsigned integer using the hash index.
+ * This returns the same item number of the find_first functions for the same range.
+ * The range is passed by value because the hash lookup has no intermediate bisection range to report:
+ * use find_range_hash to get the whole range of rows containing the key.
+ *
+ * @param ht        Hash index words.
+ * @param first     Element from where to start the search (min value = 0).
+ * @param last      Element (up to but not including) where to end the search (max value = nrows).
+ * @param search    Unsigned number to search.
+ *
+ * @return Item number if found or (last) if not found.
+ */
+static inline uint64_t find_first_hash(const uint64_t *ht, uint64_t first, uint64_t last, uint64_t search)
+{
+    uint64_t kfirst, klast;
+    if (hash_index_lookup(ht, search, &kfirst, &klast))
+    {
+        if (kfirst < first)
+        {
+            kfirst = first;
+        }
+        if ((kfirst < klast) && (kfirst < last))
+        {
+            return kfirst;
+        }
+    }
+    return last;
+}
+
+/**
+ * Search for the last occurrence of an unsigned integer using the hash index.
+ * This returns the same item number of the find_last functions for the same range.
+ *
+ * @param ht        Hash index words.
+ * @param first     Element from where to start the search (min value = 0).
+ * @param last      Element (up to but not including) where to end the search (max value = nrows).
+ * @param search    Unsigned number to search.
+ *
+ * @return Item number if found or (last) if not found.
+ */
+static inline uint64_t find_last_hash(const uint64_t *ht, uint64_t first, uint64_t last, uint64_t search)
+{
+    uint64_t kfirst, klast;
+    if (hash_index_lookup(ht, search, &kfirst, &klast))
+    {
+        if (klast > last)
+        {
+            klast = last;
+        }
+        // as find_last, this also matches the item just before the first one
+        if ((kfirst < klast) && (first <= klast))
+        {
+            return (klast - 1);
+        }
+    }
+    return last;
+}
+
+/**
+ * Search for the range of rows containing an unsigned integer using the hash index.
+ * When the key is found in [first, last) the range is the same delimited by
+ * find_first and find_last: [find_first, find_last + 1).
+ *
+ * @param ht        Hash index words.
+ * @param first     Element from where to start the search (min value = 0).
+ * @param last      Element (up to but not including) where to end the search (max value = nrows).
+ * @param search    Unsigned number to search.
+ * @param rfirst    Pointer to the first row containing the key, or (last) if not found.
+ * @param rlast     Pointer to the row after the last one containing the key, or (last) if not found.
+ *
+ * @return True if the key is found in [first, last), false otherwise.
+ */
+static inline bool find_range_hash(const uint64_t *ht, uint64_t first, uint64_t last, uint64_t search, uint64_t *rfirst, uint64_t *rlast)
+{
+    uint64_t kfirst, klast;
+    *rfirst = last;
+    *rlast = last;
+    if (!hash_index_lookup(ht, search, &kfirst, &klast))
+    {
+        return false;
+    }
+    if (kfirst < first)
+    {
+        kfirst = first;
+    }
+    if (klast > last)
+    {
+        klast = last;
+    }
+    if (kfirst >= klast)
+    {
+        return false;
+    }
+    *rfirst = kfirst;
+    *rlast = klast;
+    return true;
+}
+
+// The table is marked as empty (zero slots) when nslots is not a valid size for the keys.
+#define HASH_INDEX_BUILD_FAIL \
+        { \
+            ht[0] = 0; \
+            ht[1] = 0; \
+            ht[2] = 0; \
+            return 0; \
+        }
+
+#define HASH_INDEX_BUILD_BLOCK(T) \
+    uint64_t i, n = 0, start = 0; \
+    T x, prev = 0; \
+    if (ht != NULL) \
+    { \
+        if ((nslots < 2) || ((nslots & (nslots - 1)) != 0)) \
+        HASH_INDEX_BUILD_FAIL \
+        for (i = 0; i < (HASH_INDEX_HEADER_WORDS + (nslots * HASH_INDEX_SLOT_WORDS)); i++) \
+        { \
+            ht[i] = 0; \
+        } \
+        ht[0] = nslots; \
+        ht[1] = nitems; \
+    } \
+    for (i = 0; i < nitems; i++) \
+    {
+
+#define HASH_INDEX_BUILD_END_BLOCK \
+        if ((i > 0) && (x != prev)) \
+        { \
+            if ((ht != NULL) && ((((n + 1) << 1) > nslots) || !hash_index_add(ht, (uint64_t)prev, start, i))) \
+            HASH_INDEX_BUILD_FAIL \
+            ++n; \
+            start = i; \
+        } \
+        prev = x; \
+    } \
+    if (nitems > 0) \
+    { \
+        if ((ht != NULL) && ((((n + 1) << 1) > nslots) || !hash_index_add(ht, (uint64_t)prev, start, nitems))) \
+        HASH_INDEX_BUILD_FAIL \
+        ++n; \
+    } \
+    if (ht != NULL) \
+    { \
+        ht[2] = n; \
+    } \
+    return n;
+
+/**
+ * Generic function to build the hash index of a sorted column in a memory mapped binary file.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_build_hash_index(O, T) \
+/** Build the hash index of the values in a memory mapped binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number inside a binary block.
+@param nitems    Number of items (rows).
+@param nslots    Number of slots: a power of two not less than (2 * nkeys), e.g. hash_index_nslots(nkeys).
+@param ht        Output buffer of (HASH_INDEX_HEADER_WORDS + (nslots * HASH_INDEX_SLOT_WORDS)) elements or NULL to only count the distinct keys.
+@return Number of distinct keys, or 0 if nslots is not valid for the keys (the table is left empty).
+*/ \
+static inline uint64_t build_hash_index_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t nitems, uint64_t nslots, uint64_t *ht) \
+{ \
+HASH_INDEX_BUILD_BLOCK(T) \
+        x = bytes_##O##_to_##T(src, get_address(blklen, blkpos, i)); \
+HASH_INDEX_BUILD_END_BLOCK \
+}
+
+define_build_hash_index(be, uint8_t)
+define_build_hash_index(be, uint16_t)
+define_build_hash_index(be, uint32_t)
+define_build_hash_index(be, uint64_t)
+define_build_hash_index(le, uint8_t)
+define_build_hash_index(le, uint16_t)
+define_build_hash_index(le, uint32_t)
+define_build_hash_index(le, uint64_t)
+
+/**
+ * Generic function to build the hash index of a sorted column.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_build_hash_index(T) \
+/** Build the hash index of a column containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+@param src       Memory mapped column address (e.g. get_src_offset_##T(mf.src, mf.index[col])).
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@param nslots    Number of slots: a power of two not less than (2 * nkeys), e.g. hash_index_nslots(nkeys).
+@param ht        Output buffer of (HASH_INDEX_HEADER_WORDS + (nslots * HASH_INDEX_SLOT_WORDS)) elements or NULL to only count the distinct keys.
+@return Number of distinct keys, or 0 if nslots is not valid for the keys (the table is left empty).
+*/ \
+static inline uint64_t col_build_hash_index_##T(const T *src, uint64_t nitems, uint64_t nslots, uint64_t *ht) \
+{ \
+HASH_INDEX_BUILD_BLOCK(T) \
+        x = src[i]; \
+HASH_INDEX_BUILD_END_BLOCK \
+}
+
+define_col_build_hash_index(uint8_t)
+define_col_build_hash_index(uint16_t)
+define_col_build_hash_index(uint32_t)
+define_col_build_hash_index(uint64_t)
+
+/**
+ * Build the hash index of a sorted column and save it as a BINSRC sidecar file
+ * with one uint64_t column. The sidecar file can be loaded with mmap_binfile and
+ * the hash index words start at (smf.src + smf.index[0]).
+ *
+ * @param file  Path to the sidecar file to create.
+ * @param mf    Structure containing the memory mapped source file.
+ * @param col   Column number of the sorted column in the source file.
+ *
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+static inline int save_hash_index(const char *file, mmfile_t mf, uint8_t col)
+{
+    const uint8_t ctbytes = 8;
+    uint64_t nkeys;
+    switch (mf.ctbytes[col])
+    {
+    case 1:
+        nkeys = col_build_hash_index_uint8_t(get_src_offset_uint8_t(mf.src, mf.index[col]), mf.nrows, 0, NULL);
+        break;
+    case 2:
+        nkeys = col_build_hash_index_uint16_t(get_src_offset_uint16_t(mf.src, mf.index[col]), mf.nrows, 0, NULL);
+        break;
+    case 4:
+        nkeys = col_build_hash_index_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[col]), mf.nrows, 0, NULL);
+        break;
+    case 8:
+        nkeys = col_build_hash_index_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[col]), mf.nrows, 0, NULL);
+        break;
+    default:
+        return -1;
+    }
+    uint64_t nslots = hash_index_nslots(nkeys);
+    mmfile_t smf;
+    create_binsrc(file, 1, &ctbytes, (HASH_INDEX_HEADER_WORDS + (nslots * HASH_INDEX_SLOT_WORDS)), &smf);
+    if ((smf.fd < 0) || (smf.src == MAP_FAILED))
+    {
+        if (smf.fd >= 0)
+        {
+            close(smf.fd);
+        }
+        return -1;
+    }
+    uint64_t *ht = (uint64_t *)(smf.src + smf.index[0]);
+    switch (mf.ctbytes[col])
+    {
+    case 1:
+        col_build_hash_index_uint8_t(get_src_offset_uint8_t(mf.src, mf.index[col]), mf.nrows, nslots, ht);
+        break;
+    case 2:
+        col_build_hash_index_uint16_t(get_src_offset_uint16_t(mf.src, mf.index[col]), mf.nrows, nslots, ht);
+        break;
+    case 4:
+        col_build_hash_index_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[col]), mf.nrows, nslots, ht);
+        break;
+    default:
+        col_build_hash_index_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[col]), mf.nrows, nslots, ht);
+        break;
+    }
+    return munmap_binfile(smf);
+}
+
+// --- RUN INDEX ---
+
+// The run index stores each distinct key of a sorted column with the first row of
+// its run of duplicates: keys[k] and rows[k], for k < nkeys, plus a final entry
+// with rows[nkeys] = nitems, so the rows of keys[k] are [rows[k], rows[k + 1]).
+// Searches only visit the distinct keys and the row range comes straight from the
+// index, instead of walking the duplicates with the has_next and has_prev functions.
+
+#define RUN_INDEX_BUILD_BLOCK(T) \
+    uint64_t i, n = 0; \
+    T x, prev = 0; \
+    for (i = 0; i < nitems; i++) \
+    {
+
+#define RUN_INDEX_BUILD_END_BLOCK \
+        if ((i == 0) || (x != prev)) \
+        { \
+            if (keys != NULL) \
+            { \
+                keys[n] = x; \
+                rows[n] = i; \
+            } \
+            ++n; \
+        } \
+        prev = x; \
+    } \
+    if (keys != NULL) \
+    { \
+        keys[n] = prev; \
+        rows[n] = nitems; \
+    } \
+    return n;
+
+/**
+ * Generic function to build the run index of a sorted column in a memory mapped binary file.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_build_run_index(O, T) \
+/** Build the run index of the values in a memory mapped binary file containing adjacent blocks of sorted binary data.
+The values in the file must be encoded in "O" format and sorted in ascending order.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number inside a binary block.
+@param nitems    Number of items (rows).
+@param keys      Output buffer of (nkeys + 1) distinct keys or NULL to only count the distinct keys.
+@param rows      Output buffer of (nkeys + 1) first rows (ignored if keys is NULL).
+@return Number of distinct keys (nkeys).
+*/ \
+static inline uint64_t build_run_index_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t nitems, T *keys, uint64_t *rows) \
+{ \
+RUN_INDEX_BUILD_BLOCK(T) \
+        x = bytes_##O##_to_##T(src, get_address(blklen, blkpos, i)); \
+RUN_INDEX_BUILD_END_BLOCK \
+}
+
+define_build_run_index(be, uint8_t)
+define_build_run_index(be, uint16_t)
+define_build_run_index(be, uint32_t)
+define_build_run_index(be, uint64_t)
+define_build_run_index(le, uint8_t)
+define_build_run_index(le, uint16_t)
+define_build_run_index(le, uint32_t)
+define_build_run_index(le, uint64_t)
+
+/**
+ * Generic function to build the run index of a sorted column.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_build_run_index(T) \
+/** Build the run index of a column containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+@param src       Memory mapped column address (e.g. get_src_offset_##T(mf.src, mf.index[col])).
+@param nitems    Number of items in the column (e.g. mf.nrows).
+@param keys      Output buffer of (nkeys + 1) distinct keys or NULL to only count the distinct keys.
+@param rows      Output buffer of (nkeys + 1) first rows (ignored if keys is NULL).
+@return Number of distinct keys (nkeys).
+*/ \
+static inline uint64_t col_build_run_index_##T(const T *src, uint64_t nitems, T *keys, uint64_t *rows) \
+{ \
+RUN_INDEX_BUILD_BLOCK(T) \
+        x = src[i]; \
+RUN_INDEX_BUILD_END_BLOCK \
+}
+
+define_col_build_run_index(uint8_t)
+define_col_build_run_index(uint16_t)
+define_col_build_run_index(uint32_t)
+define_col_build_run_index(uint64_t)
+
+/**
+ * Build the run index of a sorted column and save it as a BINSRC sidecar file
+ * with two columns: the distinct keys (same type of the source column) and
+ * the first rows (uint64_t). The sidecar file can be loaded with mmap_binfile
+ * and the number of distinct keys is (smf.nrows - 1).
+ *
+ * @param file  Path to the sidecar file to create.
+ * @param mf    Structure containing the memory mapped source file.
+ * @param col   Column number of the sorted column in the source file.
+ *
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+static inline int save_run_index(const char *file, mmfile_t mf, uint8_t col)
+{
+    const uint8_t ctbytes[2] = {mf.ctbytes[col], 8};
+    uint64_t nkeys;
+    switch (mf.ctbytes[col])
+    {
+    case 1:
+        nkeys = col_build_run_index_uint8_t(get_src_offset_uint8_t(mf.src, mf.index[col]), mf.nrows, NULL, NULL);
+        break;
+    case 2:
+        nkeys = col_build_run_index_uint16_t(get_src_offset_uint16_t(mf.src, mf.index[col]), mf.nrows, NULL, NULL);
+        break;
+    case 4:
+        nkeys = col_build_run_index_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[col]), mf.nrows, NULL, NULL);
+        break;
+    case 8:
+        nkeys = col_build_run_index_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[col]), mf.nrows, NULL, NULL);
+        break;
+    default:
+        return -1;
+    }
+    mmfile_t smf;
+    create_binsrc(file, 2, ctbytes, (nkeys + 1), &smf);
+    if ((smf.fd < 0) || (smf.src == MAP_FAILED))
+    {
+        if (smf.fd >= 0)
+        {
+            close(smf.fd);
+        }
+        return -1;
+    }
+    uint64_t *rows = (uint64_t *)(smf.src + smf.index[1]);
+    switch (mf.ctbytes[col])
+    {
+    case 1:
+        col_build_run_index_uint8_t(get_src_offset_uint8_t(mf.src, mf.index[col]), mf.nrows, (uint8_t *)(smf.src + smf.index[0]), rows);
+        break;
+    case 2:
+        col_build_run_index_uint16_t(get_src_offset_uint16_t(mf.src, mf.index[col]), mf.nrows, (uint16_t *)(smf.src + smf.index[0]), rows);
+        break;
+    case 4:
+        col_build_run_index_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[col]), mf.nrows, (uint32_t *)(smf.src + smf.index[0]), rows);
+        break;
+    default:
+        col_build_run_index_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[col]), mf.nrows, (uint64_t *)(smf.src + smf.index[0]), rows);
+        break;
+    }
+    return munmap_binfile(smf);
+}
+
+/**
+ * Generic function to search for the range of items equal to an unsigned integer using the run index.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_range_runs(T) \
+/** Search for the range of items equal to an unsigned integer using the run index.
+This returns the same results of find_range and col_find_range, but the search
+only visits the distinct keys.
+@param keys      Distinct keys of the run index.
+@param rows      First rows of the run index.
+@param nkeys     Number of distinct keys.
+@param first     Pointer to the element from where to start the search (min value = 0).
+                 On return it contains the position of the first occurrence
+                 (or the insertion point if not found).
+@param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+                 On return it contains the position after the last occurrence
+                 (or the insertion point if not found).
+@param search    Unsigned number to search (type T).
+@return item number of the first occurrence if found or the initial value of last if not found.
+ */ \
+static inline uint64_t find_range_runs_##T(const T *keys, const uint64_t *rows, uint64_t nkeys, uint64_t *first, uint64_t *last, T search) \
+{ \
+    uint64_t notfound = *last; \
+    uint64_t kfirst = 0, klast = nkeys; \
+    col_find_range_##T(keys, &kfirst, &klast, search); \
+    uint64_t rfirst = rows[kfirst], rlast = rows[klast]; \
+    if (rfirst < *first) \
+    { \
+        rfirst = *first; \
+    } \
+    if (rfirst > *last) \
+    { \
+        rfirst = *last; \
+    } \
+    if (rlast > *last) \
+    { \
+        rlast = *last; \
+    } \
+    if (rlast < rfirst) \
+    { \
+        rlast = rfirst; \
+    } \
+    *first = rfirst; \
+    *last = rlast; \
+    return (rfirst < rlast) ? rfirst : notfound; \
+}
+
+define_find_range_runs(uint8_t)
+define_find_range_runs(uint16_t)
+define_find_range_runs(uint32_t)
+define_find_range_runs(uint64_t)
+
+// --- CURSOR ---
+
+// The items matching an exact, sub-field or [lo, hi] range predicate on a sorted
+// column are contiguous, so a cursor only needs the position of the next matching
+// item and the end of the matching range, both found with binary searches.
+// Each call of the col_cursor_next_* functions copies a block of matching row
+// numbers or values to a caller-provided buffer, so the cost of consuming long
+// runs is bounded by the memory bandwidth instead of one call per item.
+
+/**
+ * Cursor over the items of a column matching a search predicate.
+ */
+typedef struct col_cursor_t
+{
+    const void *src;            //!< Memory buffer containing contiguos blocks of unsigned integers of the same type.
+    uint64_t pos;               //!< Position of the next matching item.
+    uint64_t end;               //!< Position after the last matching item.
+} col_cursor_t;
+
+/**
+ * Copy the row numbers of the next matching items to a buffer and advance the cursor.
+ *
+ * @param cur       Cursor initialized by one of the col_cursor_* functions.
+ * @param rows      Buffer to store at most nmax row numbers.
+ * @param nmax      Maximum number of row numbers to return.
+ *
+ * @return Number of row numbers stored in the buffer (0 when the cursor is exhausted).
+ */
+static inline uint64_t col_cursor_next_rows(col_cursor_t *cur, uint64_t *rows, uint64_t nmax)
+{
+    uint64_t i, n = (cur->end - cur->pos);
+    if (n > nmax)
+    {
+        n = nmax;
+    }
+    for (i = 0; i < n; i++)
+    {
+        rows[i] = (cur->pos + i);
+    }
+    cur->pos += n;
+    return n;
+}
+
+/**
+ * Generic function to initialize a cursor over a sorted column.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_cursor(T) \
+/** Initialize a cursor over the items equal to an unsigned integer on a memory buffer
+containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+@param src       Memory mapped file address.
+@param first     Element from where to start the search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@param cur       Cursor to initialize.
+@return Number of matching items.
+*/ \
+static inline uint64_t col_cursor_##T(const T *src, uint64_t first, uint64_t last, T search, col_cursor_t *cur) \
+{ \
+    cur->src = src; \
+    col_find_range_##T(src, &first, &last, search); \
+    cur->pos = first; \
+    cur->end = last; \
+    return (last - first); \
+} \
+/** Initialize a cursor over the items where the bits between bitstart and bitend are equal to an unsigned integer,
+on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order by the selected bits.
+@param src       Memory mapped file address.
+@param bitstart  First bit position to consider (usually 0).
+@param bitend    Last bit position to consider (usually the last bit, e.g. 7 for uint8_t, 15 for uint16_t, etc).
+@param first     Element from where to start the search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param search    Unsigned number to search (type T).
+@param cur       Cursor to initialize.
+@return Number of matching items.
+*/ \
+static inline uint64_t col_cursor_sub_##T(const T *src, uint8_t bitstart, uint8_t bitend, uint64_t first, uint64_t last, T search, col_cursor_t *cur) \
+{ \
+    uint64_t end = last, found; \
+    cur->src = src; \
+    cur->pos = last; \
+    cur->end = last; \
+    if (first >= last) \
+    { \
+        return 0; \
+    } \
+    found = col_find_first_sub_##T(src, bitstart, bitend, &first, &last, search); \
+    if (found >= end) \
+    { \
+        return 0; \
+    } \
+    cur->pos = found; \
+    first = found; \
+    last = end; \
+    cur->end = (col_find_last_sub_##T(src, bitstart, bitend, &first, &last, search) + 1); \
+    return (cur->end - cur->pos); \
+} \
+/** Initialize a cursor over the items between two unsigned integers (included),
+on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+The values must be encoded in Little-Endian format and sorted in ascending order.
+@param src       Memory mapped file address.
+@param first     Element from where to start the search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param lo        Lowest value to match (type T).
+@param hi        Highest value to match (type T).
+@param cur       Cursor to initialize.
+@return Number of matching items.
+*/ \
+static inline uint64_t col_cursor_range_##T(const T *src, uint64_t first, uint64_t last, T lo, T hi, col_cursor_t *cur) \
+{ \
+    uint64_t end = last; \
+    cur->src = src; \
+    cur->pos = last; \
+    cur->end = last; \
+    if ((first >= last) || (lo > hi)) \
+    { \
+        return 0; \
+    } \
+    col_find_range_##T(src, &first, &last, lo); \
+    cur->pos = first; \
+    last = end; \
+    col_find_range_##T(src, &first, &last, hi); \
+    cur->end = last; \
+    return (cur->end - cur->pos); \
+} \
+/** Copy the values of the next matching items to a buffer and advance the cursor.
+The cursor must be initialized by a col_cursor_*##T function of the same type.
+@param cur       Cursor to advance.
+@param values    Buffer to store at most nmax values.
+@param nmax      Maximum number of values to return.
+@return Number of values stored in the buffer (0 when the cursor is exhausted).
+*/ \
+static inline uint64_t col_cursor_next_values_##T(col_cursor_t *cur, T *values, uint64_t nmax) \
+{ \
+    const T *src = ((const T *)cur->src + cur->pos); \
+    uint64_t i, n = (cur->end - cur->pos); \
+    if (n > nmax) \
+    { \
+        n = nmax; \
+    } \
+    for (i = 0; i < n; i++) \
+    { \
+        values[i] = src[i]; \
+    } \
+    cur->pos += n; \
+    return n; \
+}
+
+define_col_cursor(uint8_t)
+define_col_cursor(uint16_t)
+define_col_cursor(uint32_t)
+define_col_cursor(uint64_t)
+
+// --- GATHER ---
+
+// Late materialization: once a search has located the matching rows in the key column,
+// the values of the other columns are copied at those rows to caller-provided buffers.
+// Contiguous row ranges are copied with memcpy or with a simple loop that the compiler
+// vectorizes, while the scattered row numbers use the AVX2 gather instructions when available
+// (a strided AVX2 gather is slower than the vectorized loop for contiguous ranges).
+// The values of the row files are converted from the file byte order (be or le).
+
+//!< \cond
+
+#if defined(BINSEARCH_AVX2)
+// Returns the byte offsets (rows * blklen) of 4 row numbers, for blklen < 2^32.
+#define GATHER_ROW_OFFSETS(r, b) _mm256_add_epi64(_mm256_mul_epu32((r), (b)), _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64((r), 32), (b)), 32))
+
+#define COL_GATHER_ROWS_BLOCK_uint32_t \
+    for (; (i + 4) <= nrows; i += 4) \
+    { \
+        _mm_storeu_si128((__m128i *)(void *)(dst + i), _mm256_i64gather_epi32((const int *)(const void *)src, _mm256_loadu_si256((const __m256i *)(const void *)(rows + i)), 4)); \
+    }
+#define COL_GATHER_ROWS_BLOCK_uint64_t \
+    for (; (i + 4) <= nrows; i += 4) \
+    { \
+        _mm256_storeu_si256((__m256i *)(void *)(dst + i), _mm256_i64gather_epi64((const long long *)(const void *)src, _mm256_loadu_si256((const __m256i *)(const void *)(rows + i)), 8)); \
+    }
+#define GATHER_ROWS_BLOCK_uint32_t(O) \
+    if (blklen <= 0xFFFFFFFF) \
+    { \
+        const __m256i b = _mm256_set1_epi64x((long long)blklen); \
+        for (; (i + 4) <= nrows; i += 4) \
+        { \
+            const __m256i r = _mm256_loadu_si256((const __m256i *)(const void *)(rows + i)); \
+            _mm_storeu_si128((__m128i *)(void *)(dst + i), gather_order_##O##_m128i(uint32_t, _mm256_i64gather_epi32((const int *)(const void *)(src + blkpos), GATHER_ROW_OFFSETS(r, b), 1))); \
+        } \
+    }
+#define GATHER_ROWS_BLOCK_uint64_t(O) \
+    if (blklen <= 0xFFFFFFFF) \
+    { \
+        const __m256i b = _mm256_set1_epi64x((long long)blklen); \
+        for (; (i + 4) <= nrows; i += 4) \
+        { \
+            const __m256i r = _mm256_loadu_si256((const __m256i *)(const void *)(rows + i)); \
+            _mm256_storeu_si256((__m256i *)(void *)(dst + i), gather_order_##O##_m256i(uint64_t, _mm256_i64gather_epi64((const long long *)(const void *)(src + blkpos), GATHER_ROW_OFFSETS(r, b), 1))); \
+        } \
+    }
+#else
+#define COL_GATHER_ROWS_BLOCK_uint32_t
+#define COL_GATHER_ROWS_BLOCK_uint64_t
+#define GATHER_ROWS_BLOCK_uint32_t(O)
+#define GATHER_ROWS_BLOCK_uint64_t(O)
+#endif
+
+#define COL_GATHER_ROWS_BLOCK_uint8_t
+#define COL_GATHER_ROWS_BLOCK_uint16_t
+#define GATHER_ROWS_BLOCK_uint8_t(O)
+#define GATHER_ROWS_BLOCK_uint16_t(O)
+
+//!< \endcond
+
+/**
+ * Generic function to copy the values of a column at the specified rows.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_gather(T) \
+/** Copy the values of the contiguous rows [first, last) of a column to a buffer.
+@param src       Memory buffer containing contiguos blocks of unsigned integers of the same type.
+@param first     First row to copy.
+@param last      Row (up to but not including) where to end the copy.
+@param dst       Buffer to store (last - first) values.
+*/ \
+static inline void col_gather_range_##T(const T *src, uint64_t first, uint64_t last, T *dst) \
+{ \
+    if (last > first) \
+    { \
+        memcpy(dst, (src + first), ((last - first) * sizeof(T))); \
+    } \
+} \
+/** Copy the values of a column at the specified row numbers to a buffer.
+@param src       Memory buffer containing contiguos blocks of unsigned integers of the same type.
+@param rows      Row numbers to copy (each must be less than the number of rows).
+@param nrows     Number of row numbers.
+@param dst       Buffer to store nrows values.
+*/ \
+BINSEARCH_KERNEL_VOID(col_gather_rows_##T, (const T *src, const uint64_t *rows, uint64_t nrows, T *dst)) \
+{ \
+    uint64_t i = 0; \
+    COL_GATHER_ROWS_BLOCK_##T \
+    for (; i < nrows; i++) \
+    { \
+        dst[i] = src[rows[i]]; \
+    } \
+}
+
+define_col_gather(uint8_t)
+define_col_gather(uint16_t)
+define_col_gather(uint32_t)
+define_col_gather(uint64_t)
+
+/**
+ * Generic function to copy the values of a memory mapped binary file containing adjacent blocks of data,
+ * at the specified rows, converted from the file byte order.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_gather(O, T) \
+/** Copy the values of the contiguous items [first, last) to a buffer.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the value inside a binary block.
+@param first     First item to copy.
+@param last      Item (up to but not including) where to end the copy.
+@param dst       Buffer to store (last - first) values.
+*/ \
+static inline void gather_range_##O##_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, T *dst) \
+{ \
+    uint64_t i; \
+    for (i = first; i < last; i++) \
+    { \
+        dst[i - first] = bytes_##O##_to_##T(src, get_address(blklen, blkpos, i)); \
+    } \
+} \
+/** Copy the values of the specified items to a buffer.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the value inside a binary block.
+@param rows      Item numbers to copy (each must be less than the number of items).
+@param nrows     Number of item numbers.
+@param dst       Buffer to store nrows values.
+*/ \
+BINSEARCH_KERNEL_VOID(gather_rows_##O##_##T, (const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, T *dst)) \
+{ \
+    uint64_t i = 0; \
+    GATHER_ROWS_BLOCK_##T(O) \
+    for (; i < nrows; i++) \
+    { \
+        dst[i] = bytes_##O##_to_##T(src, get_address(blklen, blkpos, rows[i])); \
+    } \
+}
+
+define_gather(be, uint8_t)
+define_gather(be, uint16_t)
+define_gather(be, uint32_t)
+define_gather(be, uint64_t)
+define_gather(le, uint8_t)
+define_gather(le, uint16_t)
+define_gather(le, uint32_t)
+define_gather(le, uint64_t)
+
+//!< \cond
+
+static inline int col_gather_check(mmfile_t mf, const uint8_t *cols, uint64_t ncols)
+{
+    uint64_t j;
+    for (j = 0; j < ncols; j++)
+    {
+        if (cols[j] >= mf.ncols)
+        {
+            return -1;
+        }
+        switch (mf.ctbytes[cols[j]])
+        {
+        case 1:
+        case 2:
+        case 4:
+        case 8:
+            break;
+        default:
+            return -1;
+        }
+    }
+    return 0;
+}
+
+//!< \endcond
+
+/**
+ * Copy the values of the selected columns at the contiguous rows [first, last)
+ * of a memory mapped column file to caller-provided buffers.
+ *
+ * @param mf        Structure containing the memory mapped file.
+ * @param cols      Column numbers to copy.
+ * @param ncols     Number of column numbers.
+ * @param first     First row to copy.
+ * @param last      Row (up to but not including) where to end the copy (max value = mf.nrows).
+ * @param dst       Array of ncols buffers, each one with (last - first) values of the type of the corresponding column.
+ *
+ * @return 0 on success, -1 if a column or the row range is not valid (no values are copied).
+ */
+static inline int col_gather_range(mmfile_t mf, const uint8_t *cols, uint64_t ncols, uint64_t first, uint64_t last, void *const *dst)
+{
+    uint64_t j;
+    if ((last > mf.nrows) || (col_gather_check(mf, cols, ncols) != 0))
+    {
+        return -1;
+    }
+    for (j = 0; j < ncols; j++)
+    {
+        switch (mf.ctbytes[cols[j]])
+        {
+        case 1:
+            col_gather_range_uint8_t(get_src_offset_uint8_t(mf.src, mf.index[cols[j]]), first, last, (uint8_t *)dst[j]);
+            break;
+        case 2:
+            col_gather_range_uint16_t(get_src_offset_uint16_t(mf.src, mf.index[cols[j]]), first, last, (uint16_t *)dst[j]);
+            break;
+        case 4:
+            col_gather_range_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[cols[j]]), first, last, (uint32_t *)dst[j]);
+            break;
+        default:
+            col_gather_range_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[cols[j]]), first, last, (uint64_t *)dst[j]);
+            break;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Copy the values of the selected columns at the specified rows
+ * of a memory mapped column file to caller-provided buffers.
+ *
+ * @param mf        Structure containing the memory mapped file.
+ * @param cols      Column numbers to copy.
+ * @param ncols     Number of column numbers.
+ * @param rows      Row numbers to copy (each must be less than mf.nrows).
+ * @param nrows     Number of row numbers.
+ * @param dst       Array of ncols buffers, each one with nrows values of the type of the corresponding column.
+ *
+ * @return 0 on success, -1 if a column is not valid (no values are copied).
+ */
+static inline int col_gather_rows(mmfile_t mf, const uint8_t *cols, uint64_t ncols, const uint64_t *rows, uint64_t nrows, void *const *dst)
+{
+    uint64_t j;
+    if (col_gather_check(mf, cols, ncols) != 0)
+    {
+        return -1;
+    }
+    for (j = 0; j < ncols; j++)
+    {
+        switch (mf.ctbytes[cols[j]])
+        {
+        case 1:
+            col_gather_rows_uint8_t(get_src_offset_uint8_t(mf.src, mf.index[cols[j]]), rows, nrows, (uint8_t *)dst[j]);
+            break;
+        case 2:
+            col_gather_rows_uint16_t(get_src_offset_uint16_t(mf.src, mf.index[cols[j]]), rows, nrows, (uint16_t *)dst[j]);
+            break;
+        case 4:
+            col_gather_rows_uint32_t(get_src_offset_uint32_t(mf.src, mf.index[cols[j]]), rows, nrows, (uint32_t *)dst[j]);
+            break;
+        default:
+            col_gather_rows_uint64_t(get_src_offset_uint64_t(mf.src, mf.index[cols[j]]), rows, nrows, (uint64_t *)dst[j]);
+            break;
+        }
+    }
+    return 0;
 }
 
 #endif  // BINSEARCH_BINSEARCH_H
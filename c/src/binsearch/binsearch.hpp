@@ -0,0 +1,424 @@
+// BinSearch
+//
+// binsearch.hpp
+//
+// @category   Libraries
+// @author     Nicola Asuni <info@tecnick.com>
+// @link       https://github.com/tecnickcom/binsearch
+// @license    MIT (see LICENSE file)
+// @copyright  (c) 2017-2026 Nicola Asuni - Tecnick.com
+
+/**
+ * @file binsearch.hpp
+ * @brief C++17 templates to search values in binary files made of constant-length items.
+ *
+ * The templates provide the same searches of binsearch.h, where the endianness,
+ * the key type, the block length, the key position and the bit range can be
+ * compile-time (constexpr) template parameters, so the compiler can replace the
+ * address multiplications with shifts, fold the bit masks and unroll the loops.
+ * Each compile-time parameter can be left as binsearch::dynamic to pass it at runtime.
+ *
+ * The key accessors (row_key, col_key, sub_key) read the items of a memory mapped
+ * file, and the search functions (find_first, find_last, has_next, has_prev)
+ * return the same results of the corresponding C functions.
+ *
+ * The memory mapped files are the same mmfile_t structures of binsearch.h, so they
+ * can be shared between C and C++ code, e.g.:
+ *
+ *   mmfile_t mf = {0};
+ *   mmap_binfile("file.bin", &mf);
+ *   binsearch::row_key<binsearch::order::be, uint32_t, 16, 4> key(mf);
+ *   uint64_t first = 0, last = mf.nrows;
+ *   uint64_t found = binsearch::find_first(key, &first, &last, 0x12345678);
+ */
+
+#ifndef BINSEARCH_BINSEARCH_HPP
+#define BINSEARCH_BINSEARCH_HPP
+
+#if !defined(__cplusplus) || (__cplusplus < 201703L)
+#error "binsearch.hpp requires C++17"
+#endif
+
+#include <cstring>
+#include <type_traits>
+#include "binsearch.h"
+
+namespace binsearch
+{
+
+static_assert(std::is_standard_layout_v<mmfile_t>, "mmfile_t must have the same layout in C and C++");
+
+/**
+ * Byte order of the values in the binary file.
+ */
+enum class order
+{
+    be, //!< Big-Endian
+    le, //!< Little-Endian
+};
+
+/**
+ * Value of a template parameter that is passed at runtime instead.
+ */
+inline constexpr uint64_t dynamic = UINT64_MAX;
+
+/**
+ * Convert a value read from the file in the specified byte order to the host byte order.
+ *
+ * @tparam O    Byte order of the value.
+ * @tparam T    Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ *
+ * @param x     Value as read from the file.
+ *
+ * @return Value in the host byte order.
+ */
+template <order O, typename T>
+inline T order_value(T x)
+{
+    static_assert(std::is_unsigned_v<T> && (sizeof(T) <= 8), "T must be one of: uint8_t, uint16_t, uint32_t, uint64_t");
+    if constexpr (sizeof(T) == 1)
+    {
+        return x;
+    }
+    else if constexpr (O == order::be)
+    {
+        if constexpr (sizeof(T) == 2)
+        {
+            return static_cast<T>(order_be_uint16_t(x));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return static_cast<T>(order_be_uint32_t(x));
+        }
+        else
+        {
+            return static_cast<T>(order_be_uint64_t(x));
+        }
+    }
+    else
+    {
+        if constexpr (sizeof(T) == 2)
+        {
+            return static_cast<T>(order_le_uint16_t(x));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return static_cast<T>(order_le_uint32_t(x));
+        }
+        else
+        {
+            return static_cast<T>(order_le_uint64_t(x));
+        }
+    }
+}
+
+/**
+ * Accessor for the keys stored in a memory mapped file containing adjacent blocks of sorted binary data.
+ *
+ * @tparam O        Byte order of the keys in the file.
+ * @tparam T        Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ * @tparam BLKLEN   Length of the binary block in bytes, or dynamic to set it at runtime.
+ * @tparam BLKPOS   Position of the key inside a binary block, or dynamic to set it at runtime.
+ */
+template <order O, typename T, uint64_t BLKLEN = dynamic, uint64_t BLKPOS = dynamic>
+class row_key
+{
+public:
+    using value_type = T; //!< Key type.
+
+    /**
+     * @param src       Memory mapped file address.
+     * @param blklen    Length of the binary block in bytes (ignored if BLKLEN is not dynamic).
+     * @param blkpos    Position of the key inside a binary block (ignored if BLKPOS is not dynamic).
+     */
+    explicit row_key(const uint8_t *src, uint64_t blklen = BLKLEN, uint64_t blkpos = BLKPOS)
+        : src_(src), blklen_(blklen), blkpos_(blkpos)
+    {
+    }
+
+    /**
+     * @param mf        Structure containing the memory mapped file.
+     * @param blklen    Length of the binary block in bytes (ignored if BLKLEN is not dynamic).
+     * @param blkpos    Position of the key inside a binary block (ignored if BLKPOS is not dynamic).
+     */
+    explicit row_key(const mmfile_t &mf, uint64_t blklen = BLKLEN, uint64_t blkpos = BLKPOS)
+        : row_key(mf.src + mf.doffset, blklen, blkpos)
+    {
+    }
+
+    /**
+     * Returns the absolute file address position of the key of the specified item.
+     *
+     * @param item  Item number (row).
+     */
+    uint64_t address(uint64_t item) const
+    {
+        if constexpr ((BLKLEN != dynamic) && (BLKPOS != dynamic))
+        {
+            return get_address(BLKLEN, BLKPOS, item);
+        }
+        else if constexpr (BLKLEN != dynamic)
+        {
+            return get_address(BLKLEN, blkpos_, item);
+        }
+        else if constexpr (BLKPOS != dynamic)
+        {
+            return get_address(blklen_, BLKPOS, item);
+        }
+        else
+        {
+            return get_address(blklen_, blkpos_, item);
+        }
+    }
+
+    /**
+     * Returns the key of the specified item.
+     *
+     * @param item  Item number (row).
+     */
+    T operator()(uint64_t item) const
+    {
+        T x;
+        std::memcpy(&x, src_ + address(item), sizeof(T));
+        return order_value<O, T>(x);
+    }
+
+private:
+    const uint8_t *src_;
+    uint64_t blklen_;
+    uint64_t blkpos_;
+};
+
+/**
+ * Accessor for the keys stored in a column of contiguos Little-Endian unsigned integers of the same type.
+ *
+ * @tparam T    Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+template <typename T>
+class col_key
+{
+public:
+    using value_type = T; //!< Key type.
+
+    /**
+     * @param src   Memory mapped column address.
+     */
+    explicit col_key(const T *src)
+        : src_(src)
+    {
+    }
+
+    /**
+     * @param mf    Structure containing the memory mapped file.
+     * @param col   Column number.
+     */
+    col_key(const mmfile_t &mf, uint8_t col)
+        : src_(reinterpret_cast<const T *>(mf.src + mf.index[col]))
+    {
+    }
+
+    /**
+     * Returns the key of the specified item.
+     *
+     * @param item  Item number (row).
+     */
+    T operator()(uint64_t item) const
+    {
+        return *(src_ + item);
+    }
+
+private:
+    const T *src_;
+};
+
+/**
+ * Accessor for the bits between BITSTART and BITEND of the keys returned by another accessor.
+ *
+ * @tparam K        Key accessor (row_key or col_key).
+ * @tparam BITSTART First bit position to consider (usually 0), or dynamic to set it at runtime.
+ * @tparam BITEND   Last bit position to consider (e.g. 7 for uint8_t), or dynamic to set it at runtime.
+ */
+template <typename K, uint64_t BITSTART = dynamic, uint64_t BITEND = dynamic>
+class sub_key
+{
+public:
+    using value_type = typename K::value_type; //!< Key type.
+
+    /**
+     * @param key       Key accessor.
+     * @param bitstart  First bit position to consider (ignored if BITSTART is not dynamic).
+     * @param bitend    Last bit position to consider (ignored if BITEND is not dynamic).
+     */
+    explicit sub_key(const K &key, uint8_t bitstart = static_cast<uint8_t>(BITSTART), uint8_t bitend = static_cast<uint8_t>(BITEND))
+        : key_(key), bitmask_(mask(bitstart, bitend)), rshift_(shift(bitend))
+    {
+    }
+
+    /**
+     * Returns the selected bits of the key of the specified item.
+     *
+     * @param item  Item number (row).
+     */
+    value_type operator()(uint64_t item) const
+    {
+        if constexpr ((BITSTART != dynamic) && (BITEND != dynamic))
+        {
+            return static_cast<value_type>((key_(item) >> shift(BITEND)) & mask(BITSTART, BITEND));
+        }
+        else
+        {
+            return static_cast<value_type>((key_(item) >> rshift_) & bitmask_);
+        }
+    }
+
+private:
+    static constexpr value_type mask(uint64_t bitstart, uint64_t bitend)
+    {
+        value_type bitmask = static_cast<value_type>(static_cast<value_type>(1) << (bitend - bitstart));
+        return static_cast<value_type>(bitmask ^ static_cast<value_type>(bitmask - 1));
+    }
+
+    static constexpr uint8_t shift(uint64_t bitend)
+    {
+        return static_cast<uint8_t>(((sizeof(value_type) * 8) - 1) - bitend);
+    }
+
+    K key_;
+    value_type bitmask_;
+    uint8_t rshift_;
+};
+
+/**
+ * Search for the first occurrence of a key.
+ * This returns the same results of the find_first C functions.
+ *
+ * @param key       Key accessor (row_key, col_key or sub_key).
+ * @param first     Pointer to the element from where to start the search (min value = 0).
+ * @param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+ * @param search    Unsigned number to search.
+ *
+ * @return Item number if found or (last) if not found.
+ */
+template <typename K>
+inline uint64_t find_first(const K &key, uint64_t *first, uint64_t *last, typename K::value_type search)
+{
+    uint64_t middle, notfound = *last;
+    typename K::value_type x;
+    while (*first < *last)
+    {
+        middle = get_middle_point(*first, *last);
+        x = key(middle);
+        if (x < search)
+        {
+            *first = middle;
+            ++(*first);
+        }
+        else
+        {
+            *last = middle;
+        }
+    }
+    middle = *first;
+    x = key(middle);
+    if (x == search)
+    {
+        return middle;
+    }
+    if (*first > 0)
+    {
+        --(*first);
+    }
+    return notfound;
+}
+
+/**
+ * Search for the last occurrence of a key.
+ * This returns the same results of the find_last C functions.
+ *
+ * @param key       Key accessor (row_key, col_key or sub_key).
+ * @param first     Pointer to the element from where to start the search (min value = 0).
+ * @param last      Pointer to the element (up to but not including) where to end the search (max value = nrows).
+ * @param search    Unsigned number to search.
+ *
+ * @return Item number if found or (last) if not found.
+ */
+template <typename K>
+inline uint64_t find_last(const K &key, uint64_t *first, uint64_t *last, typename K::value_type search)
+{
+    uint64_t middle, notfound = *last;
+    typename K::value_type x;
+    while (*first < *last)
+    {
+        middle = get_middle_point(*first, *last);
+        x = key(middle);
+        if (x > search)
+        {
+            *last = middle;
+        }
+        else
+        {
+            *first = middle;
+            ++(*first);
+        }
+    }
+    middle = *first;
+    --middle;
+    x = key(middle);
+    if (x == search)
+    {
+        return middle;
+    }
+    if (*first > 0)
+    {
+        --(*first);
+    }
+    return notfound;
+}
+
+/**
+ * Check if the next item still matches the search value.
+ * This returns the same results of the has_next C functions.
+ *
+ * @param key       Key accessor (row_key, col_key or sub_key).
+ * @param pos       Pointer to the current item position. This will be updated to point to the next position.
+ * @param last      Element (up to but not including) where to end the search (max value = nrows).
+ * @param search    Unsigned number to search.
+ *
+ * @return True if the next item is valid, false otherwise.
+ */
+template <typename K>
+inline bool has_next(const K &key, uint64_t *pos, uint64_t last, typename K::value_type search)
+{
+    if (*pos >= (last - 1))
+    {
+        return false;
+    }
+    ++(*pos);
+    return (key(*pos) == search);
+}
+
+/**
+ * Check if the previous item still matches the search value.
+ * This returns the same results of the has_prev C functions.
+ *
+ * @param key       Key accessor (row_key, col_key or sub_key).
+ * @param first     Element from where to start the search (min value = 0).
+ * @param pos       Pointer to the current item position. This will be updated to point to the previous position.
+ * @param search    Unsigned number to search.
+ *
+ * @return True if the previous item is valid, false otherwise.
+ */
+template <typename K>
+inline bool has_prev(const K &key, uint64_t first, uint64_t *pos, typename K::value_type search)
+{
+    if (*pos <= first)
+    {
+        return false;
+    }
+    --(*pos);
+    return (key(*pos) == search);
+}
+
+} // namespace binsearch
+
+#endif // BINSEARCH_BINSEARCH_HPP
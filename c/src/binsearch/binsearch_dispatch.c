@@ -0,0 +1,290 @@
+// BinSearch
+//
+// binsearch_dispatch.c
+//
+// @category   Libraries
+// @author     Nicola Asuni <info@tecnick.com>
+// @link       https://github.com/tecnickcom/binsearch
+// @license    MIT (see LICENSE file)
+// @copyright  (c) 2017-2026 Nicola Asuni - Tecnick.com
+
+/**
+ * @file binsearch_dispatch.c
+ * @brief Runtime CPU dispatch of the SIMD search kernels.
+ *
+ * The kernels declared by binsearch.h with BINSEARCH_KERNEL (or BINSEARCH_KERNEL_VOID) are exported here with
+ * their public names and forwarded through a function table. The table initially
+ * points to the compile-time ("_inline") kernels and, on x86, is updated when the
+ * library is loaded with the best of the SSE2, AVX2 (+BMI2) and AVX-512 kernels
+ * compiled from binsearch_kernels.c for the running CPU.
+ */
+
+#include "binsearch.h"
+
+#ifndef BINSEARCH_DISPATCH
+#error "BINSEARCH_DISPATCH must be defined"
+#endif
+
+//!< \cond
+
+#define define_kernel_types(T) \
+typedef uint64_t (*col_find_kary_##T##_fn)(const T *src, uint64_t *first, uint64_t *last, T search); \
+typedef uint64_t (*col_find_stree_##T##_fn)(const T *src, const T *tree, uint64_t nitems, uint64_t *first, uint64_t *last, T search);
+
+#define define_scan_kernel_types(T) \
+typedef uint64_t (*col_scan_count_##T##_fn)(const T *src, uint64_t first, uint64_t last, T search); \
+typedef uint64_t (*scan_count_##T##_fn)(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, T search); \
+typedef uint64_t (*col_scan_equal_run_##T##_fn)(const T *src, uint64_t pos, uint64_t last, T mask, T value); \
+typedef uint64_t (*scan_equal_run_##T##_fn)(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t pos, uint64_t last, T mask, T value); \
+typedef void (*col_gather_rows_##T##_fn)(const T *src, const uint64_t *rows, uint64_t nrows, T *dst); \
+typedef void (*gather_rows_##T##_fn)(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, T *dst);
+
+define_kernel_types(uint32_t)
+define_kernel_types(uint64_t)
+
+define_scan_kernel_types(uint8_t)
+define_scan_kernel_types(uint16_t)
+define_scan_kernel_types(uint32_t)
+define_scan_kernel_types(uint64_t)
+
+typedef struct kernel_table_t
+{
+    const char *isa;
+    col_find_kary_uint32_t_fn col_find_first_kary_uint32_t;
+    col_find_kary_uint32_t_fn col_find_last_kary_uint32_t;
+    col_find_kary_uint64_t_fn col_find_first_kary_uint64_t;
+    col_find_kary_uint64_t_fn col_find_last_kary_uint64_t;
+    col_find_stree_uint32_t_fn col_find_first_stree_uint32_t;
+    col_find_stree_uint32_t_fn col_find_last_stree_uint32_t;
+    col_find_stree_uint64_t_fn col_find_first_stree_uint64_t;
+    col_find_stree_uint64_t_fn col_find_last_stree_uint64_t;
+    col_scan_count_uint8_t_fn col_scan_count_lt_uint8_t;
+    col_scan_count_uint16_t_fn col_scan_count_lt_uint16_t;
+    col_scan_count_uint32_t_fn col_scan_count_lt_uint32_t;
+    col_scan_count_uint64_t_fn col_scan_count_lt_uint64_t;
+    scan_count_uint8_t_fn scan_count_lt_be_uint8_t;
+    scan_count_uint16_t_fn scan_count_lt_be_uint16_t;
+    scan_count_uint32_t_fn scan_count_lt_be_uint32_t;
+    scan_count_uint64_t_fn scan_count_lt_be_uint64_t;
+    scan_count_uint8_t_fn scan_count_lt_le_uint8_t;
+    scan_count_uint16_t_fn scan_count_lt_le_uint16_t;
+    scan_count_uint32_t_fn scan_count_lt_le_uint32_t;
+    scan_count_uint64_t_fn scan_count_lt_le_uint64_t;
+    col_scan_equal_run_uint8_t_fn col_scan_equal_run_mask_uint8_t;
+    col_scan_equal_run_uint16_t_fn col_scan_equal_run_mask_uint16_t;
+    col_scan_equal_run_uint32_t_fn col_scan_equal_run_mask_uint32_t;
+    col_scan_equal_run_uint64_t_fn col_scan_equal_run_mask_uint64_t;
+    scan_equal_run_uint8_t_fn scan_equal_run_mask_uint8_t;
+    scan_equal_run_uint16_t_fn scan_equal_run_mask_uint16_t;
+    scan_equal_run_uint32_t_fn scan_equal_run_mask_uint32_t;
+    scan_equal_run_uint64_t_fn scan_equal_run_mask_uint64_t;
+    col_gather_rows_uint8_t_fn col_gather_rows_uint8_t;
+    col_gather_rows_uint16_t_fn col_gather_rows_uint16_t;
+    col_gather_rows_uint32_t_fn col_gather_rows_uint32_t;
+    col_gather_rows_uint64_t_fn col_gather_rows_uint64_t;
+    gather_rows_uint8_t_fn gather_rows_be_uint8_t;
+    gather_rows_uint16_t_fn gather_rows_be_uint16_t;
+    gather_rows_uint32_t_fn gather_rows_be_uint32_t;
+    gather_rows_uint64_t_fn gather_rows_be_uint64_t;
+    gather_rows_uint8_t_fn gather_rows_le_uint8_t;
+    gather_rows_uint16_t_fn gather_rows_le_uint16_t;
+    gather_rows_uint32_t_fn gather_rows_le_uint32_t;
+    gather_rows_uint64_t_fn gather_rows_le_uint64_t;
+} kernel_table_t;
+
+#define KERNEL_TABLE(I, S) \
+{ \
+    I, \
+    col_find_first_kary_uint32_t##S, \
+    col_find_last_kary_uint32_t##S, \
+    col_find_first_kary_uint64_t##S, \
+    col_find_last_kary_uint64_t##S, \
+    col_find_first_stree_uint32_t##S, \
+    col_find_last_stree_uint32_t##S, \
+    col_find_first_stree_uint64_t##S, \
+    col_find_last_stree_uint64_t##S, \
+    col_scan_count_lt_uint8_t##S, \
+    col_scan_count_lt_uint16_t##S, \
+    col_scan_count_lt_uint32_t##S, \
+    col_scan_count_lt_uint64_t##S, \
+    scan_count_lt_be_uint8_t##S, \
+    scan_count_lt_be_uint16_t##S, \
+    scan_count_lt_be_uint32_t##S, \
+    scan_count_lt_be_uint64_t##S, \
+    scan_count_lt_le_uint8_t##S, \
+    scan_count_lt_le_uint16_t##S, \
+    scan_count_lt_le_uint32_t##S, \
+    scan_count_lt_le_uint64_t##S, \
+    col_scan_equal_run_mask_uint8_t##S, \
+    col_scan_equal_run_mask_uint16_t##S, \
+    col_scan_equal_run_mask_uint32_t##S, \
+    col_scan_equal_run_mask_uint64_t##S, \
+    scan_equal_run_mask_uint8_t##S, \
+    scan_equal_run_mask_uint16_t##S, \
+    scan_equal_run_mask_uint32_t##S, \
+    scan_equal_run_mask_uint64_t##S, \
+    col_gather_rows_uint8_t##S, \
+    col_gather_rows_uint16_t##S, \
+    col_gather_rows_uint32_t##S, \
+    col_gather_rows_uint64_t##S, \
+    gather_rows_be_uint8_t##S, \
+    gather_rows_be_uint16_t##S, \
+    gather_rows_be_uint32_t##S, \
+    gather_rows_be_uint64_t##S, \
+    gather_rows_le_uint8_t##S, \
+    gather_rows_le_uint16_t##S, \
+    gather_rows_le_uint32_t##S, \
+    gather_rows_le_uint64_t##S, \
+}
+
+static kernel_table_t kernels = KERNEL_TABLE("inline", _inline);
+
+#if defined(BINSEARCH_DISPATCH_X86) && (defined(__GNUC__) || defined(__clang__))
+
+#define define_isa_kernel_decl(T, S) \
+uint64_t col_find_first_kary_##T##S(const T *src, uint64_t *first, uint64_t *last, T search); \
+uint64_t col_find_last_kary_##T##S(const T *src, uint64_t *first, uint64_t *last, T search); \
+uint64_t col_find_first_stree_##T##S(const T *src, const T *tree, uint64_t nitems, uint64_t *first, uint64_t *last, T search); \
+uint64_t col_find_last_stree_##T##S(const T *src, const T *tree, uint64_t nitems, uint64_t *first, uint64_t *last, T search);
+
+define_isa_kernel_decl(uint32_t, _sse2)
+define_isa_kernel_decl(uint64_t, _sse2)
+define_isa_kernel_decl(uint32_t, _avx2)
+define_isa_kernel_decl(uint64_t, _avx2)
+define_isa_kernel_decl(uint32_t, _avx512)
+define_isa_kernel_decl(uint64_t, _avx512)
+
+#define define_isa_scan_kernel_decl(S) \
+uint64_t col_scan_count_lt_uint8_t##S(const uint8_t *src, uint64_t first, uint64_t last, uint8_t search); \
+uint64_t col_scan_count_lt_uint16_t##S(const uint16_t *src, uint64_t first, uint64_t last, uint16_t search); \
+uint64_t col_scan_count_lt_uint32_t##S(const uint32_t *src, uint64_t first, uint64_t last, uint32_t search); \
+uint64_t col_scan_count_lt_uint64_t##S(const uint64_t *src, uint64_t first, uint64_t last, uint64_t search); \
+uint64_t scan_count_lt_be_uint8_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, uint8_t search); \
+uint64_t scan_count_lt_be_uint16_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, uint16_t search); \
+uint64_t scan_count_lt_be_uint32_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, uint32_t search); \
+uint64_t scan_count_lt_be_uint64_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, uint64_t search); \
+uint64_t scan_count_lt_le_uint8_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, uint8_t search); \
+uint64_t scan_count_lt_le_uint16_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, uint16_t search); \
+uint64_t scan_count_lt_le_uint32_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, uint32_t search); \
+uint64_t scan_count_lt_le_uint64_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, uint64_t search); \
+uint64_t col_scan_equal_run_mask_uint8_t##S(const uint8_t *src, uint64_t pos, uint64_t last, uint8_t mask, uint8_t value); \
+uint64_t col_scan_equal_run_mask_uint16_t##S(const uint16_t *src, uint64_t pos, uint64_t last, uint16_t mask, uint16_t value); \
+uint64_t col_scan_equal_run_mask_uint32_t##S(const uint32_t *src, uint64_t pos, uint64_t last, uint32_t mask, uint32_t value); \
+uint64_t col_scan_equal_run_mask_uint64_t##S(const uint64_t *src, uint64_t pos, uint64_t last, uint64_t mask, uint64_t value); \
+uint64_t scan_equal_run_mask_uint8_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t pos, uint64_t last, uint8_t mask, uint8_t value); \
+uint64_t scan_equal_run_mask_uint16_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t pos, uint64_t last, uint16_t mask, uint16_t value); \
+uint64_t scan_equal_run_mask_uint32_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t pos, uint64_t last, uint32_t mask, uint32_t value); \
+uint64_t scan_equal_run_mask_uint64_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t pos, uint64_t last, uint64_t mask, uint64_t value); \
+void col_gather_rows_uint8_t##S(const uint8_t *src, const uint64_t *rows, uint64_t nrows, uint8_t *dst); \
+void col_gather_rows_uint16_t##S(const uint16_t *src, const uint64_t *rows, uint64_t nrows, uint16_t *dst); \
+void col_gather_rows_uint32_t##S(const uint32_t *src, const uint64_t *rows, uint64_t nrows, uint32_t *dst); \
+void col_gather_rows_uint64_t##S(const uint64_t *src, const uint64_t *rows, uint64_t nrows, uint64_t *dst); \
+void gather_rows_be_uint8_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, uint8_t *dst); \
+void gather_rows_be_uint16_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, uint16_t *dst); \
+void gather_rows_be_uint32_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, uint32_t *dst); \
+void gather_rows_be_uint64_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, uint64_t *dst); \
+void gather_rows_le_uint8_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, uint8_t *dst); \
+void gather_rows_le_uint16_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, uint16_t *dst); \
+void gather_rows_le_uint32_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, uint32_t *dst); \
+void gather_rows_le_uint64_t##S(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, uint64_t *dst);
+
+define_isa_scan_kernel_decl(_sse2)
+define_isa_scan_kernel_decl(_avx2)
+define_isa_scan_kernel_decl(_avx512)
+
+static const kernel_table_t kernels_sse2 = KERNEL_TABLE("sse2", _sse2);
+static const kernel_table_t kernels_avx2 = KERNEL_TABLE("avx2", _avx2);
+static const kernel_table_t kernels_avx512 = KERNEL_TABLE("avx512", _avx512);
+
+__attribute__((constructor)) static void binsearch_dispatch_init(void)
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("bmi2"))
+    {
+        kernels = kernels_avx512;
+        return;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2"))
+    {
+        kernels = kernels_avx2;
+        return;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        kernels = kernels_sse2;
+    }
+}
+
+#endif
+
+//!< \endcond
+
+/**
+ * Returns the name of the instruction set selected for the SIMD search kernels.
+ *
+ * @return One of: "inline" (compile-time selection), "sse2", "avx2", "avx512".
+ */
+const char *binsearch_dispatch_isa(void)
+{
+    return kernels.isa;
+}
+
+#define define_dispatch_kernels(T) \
+uint64_t col_find_first_kary_##T(const T *src, uint64_t *first, uint64_t *last, T search) \
+{ \
+    return kernels.col_find_first_kary_##T(src, first, last, search); \
+} \
+uint64_t col_find_last_kary_##T(const T *src, uint64_t *first, uint64_t *last, T search) \
+{ \
+    return kernels.col_find_last_kary_##T(src, first, last, search); \
+} \
+uint64_t col_find_first_stree_##T(const T *src, const T *tree, uint64_t nitems, uint64_t *first, uint64_t *last, T search) \
+{ \
+    return kernels.col_find_first_stree_##T(src, tree, nitems, first, last, search); \
+} \
+uint64_t col_find_last_stree_##T(const T *src, const T *tree, uint64_t nitems, uint64_t *first, uint64_t *last, T search) \
+{ \
+    return kernels.col_find_last_stree_##T(src, tree, nitems, first, last, search); \
+}
+
+#define define_dispatch_scan_kernels(T) \
+uint64_t col_scan_count_lt_##T(const T *src, uint64_t first, uint64_t last, T search) \
+{ \
+    return kernels.col_scan_count_lt_##T(src, first, last, search); \
+} \
+uint64_t scan_count_lt_be_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, T search) \
+{ \
+    return kernels.scan_count_lt_be_##T(src, blklen, blkpos, first, last, search); \
+} \
+uint64_t scan_count_lt_le_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, T search) \
+{ \
+    return kernels.scan_count_lt_le_##T(src, blklen, blkpos, first, last, search); \
+} \
+uint64_t col_scan_equal_run_mask_##T(const T *src, uint64_t pos, uint64_t last, T mask, T value) \
+{ \
+    return kernels.col_scan_equal_run_mask_##T(src, pos, last, mask, value); \
+} \
+uint64_t scan_equal_run_mask_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t pos, uint64_t last, T mask, T value) \
+{ \
+    return kernels.scan_equal_run_mask_##T(src, blklen, blkpos, pos, last, mask, value); \
+} \
+void col_gather_rows_##T(const T *src, const uint64_t *rows, uint64_t nrows, T *dst) \
+{ \
+    kernels.col_gather_rows_##T(src, rows, nrows, dst); \
+} \
+void gather_rows_be_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, T *dst) \
+{ \
+    kernels.gather_rows_be_##T(src, blklen, blkpos, rows, nrows, dst); \
+} \
+void gather_rows_le_##T(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, T *dst) \
+{ \
+    kernels.gather_rows_le_##T(src, blklen, blkpos, rows, nrows, dst); \
+}
+
+define_dispatch_kernels(uint32_t)
+define_dispatch_kernels(uint64_t)
+
+define_dispatch_scan_kernels(uint8_t)
+define_dispatch_scan_kernels(uint16_t)
+define_dispatch_scan_kernels(uint32_t)
+define_dispatch_scan_kernels(uint64_t)
@@ -0,0 +1,113 @@
+// BinSearch
+//
+// binsearch_kernels.c
+//
+// @category   Libraries
+// @author     Nicola Asuni <info@tecnick.com>
+// @link       https://github.com/tecnickcom/binsearch
+// @license    MIT (see LICENSE file)
+// @copyright  (c) 2017-2026 Nicola Asuni - Tecnick.com
+
+/**
+ * @file binsearch_kernels.c
+ * @brief SIMD search kernels compiled for one instruction set.
+ *
+ * This file is compiled once for each instruction set supported by the runtime
+ * CPU dispatch (CMake option BINSEARCH_DISPATCH), with the matching compiler flags
+ * and BINSEARCH_ISA set to the instruction set name (e.g. avx2).
+ * Each kernel is exported with the instruction set name as suffix
+ * (e.g. col_find_first_kary_uint32_t_avx2) and selected by binsearch_dispatch.c.
+ */
+
+#undef BINSEARCH_DISPATCH
+#include "binsearch.h"
+
+#ifndef BINSEARCH_ISA
+#error "BINSEARCH_ISA must be defined"
+#endif
+
+//!< \cond
+
+#define BINSEARCH_ISA_NAME_(F, I) F##_##I
+#define BINSEARCH_ISA_NAME(F, I) BINSEARCH_ISA_NAME_(F, I)
+
+#define define_isa_kernels(T) \
+uint64_t BINSEARCH_ISA_NAME(col_find_first_kary_##T, BINSEARCH_ISA)(const T *src, uint64_t *first, uint64_t *last, T search); \
+uint64_t BINSEARCH_ISA_NAME(col_find_first_kary_##T, BINSEARCH_ISA)(const T *src, uint64_t *first, uint64_t *last, T search) \
+{ \
+    return col_find_first_kary_##T(src, first, last, search); \
+} \
+uint64_t BINSEARCH_ISA_NAME(col_find_last_kary_##T, BINSEARCH_ISA)(const T *src, uint64_t *first, uint64_t *last, T search); \
+uint64_t BINSEARCH_ISA_NAME(col_find_last_kary_##T, BINSEARCH_ISA)(const T *src, uint64_t *first, uint64_t *last, T search) \
+{ \
+    return col_find_last_kary_##T(src, first, last, search); \
+} \
+uint64_t BINSEARCH_ISA_NAME(col_find_first_stree_##T, BINSEARCH_ISA)(const T *src, const T *tree, uint64_t nitems, uint64_t *first, uint64_t *last, T search); \
+uint64_t BINSEARCH_ISA_NAME(col_find_first_stree_##T, BINSEARCH_ISA)(const T *src, const T *tree, uint64_t nitems, uint64_t *first, uint64_t *last, T search) \
+{ \
+    return col_find_first_stree_##T(src, tree, nitems, first, last, search); \
+} \
+uint64_t BINSEARCH_ISA_NAME(col_find_last_stree_##T, BINSEARCH_ISA)(const T *src, const T *tree, uint64_t nitems, uint64_t *first, uint64_t *last, T search); \
+uint64_t BINSEARCH_ISA_NAME(col_find_last_stree_##T, BINSEARCH_ISA)(const T *src, const T *tree, uint64_t nitems, uint64_t *first, uint64_t *last, T search) \
+{ \
+    return col_find_last_stree_##T(src, tree, nitems, first, last, search); \
+}
+
+#define define_isa_scan_kernels(T) \
+uint64_t BINSEARCH_ISA_NAME(col_scan_count_lt_##T, BINSEARCH_ISA)(const T *src, uint64_t first, uint64_t last, T search); \
+uint64_t BINSEARCH_ISA_NAME(col_scan_count_lt_##T, BINSEARCH_ISA)(const T *src, uint64_t first, uint64_t last, T search) \
+{ \
+    return col_scan_count_lt_##T(src, first, last, search); \
+} \
+uint64_t BINSEARCH_ISA_NAME(scan_count_lt_be_##T, BINSEARCH_ISA)(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, T search); \
+uint64_t BINSEARCH_ISA_NAME(scan_count_lt_be_##T, BINSEARCH_ISA)(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, T search) \
+{ \
+    return scan_count_lt_be_##T(src, blklen, blkpos, first, last, search); \
+} \
+uint64_t BINSEARCH_ISA_NAME(scan_count_lt_le_##T, BINSEARCH_ISA)(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, T search); \
+uint64_t BINSEARCH_ISA_NAME(scan_count_lt_le_##T, BINSEARCH_ISA)(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, T search) \
+{ \
+    return scan_count_lt_le_##T(src, blklen, blkpos, first, last, search); \
+} \
+uint64_t BINSEARCH_ISA_NAME(col_scan_equal_run_mask_##T, BINSEARCH_ISA)(const T *src, uint64_t pos, uint64_t last, T mask, T value); \
+uint64_t BINSEARCH_ISA_NAME(col_scan_equal_run_mask_##T, BINSEARCH_ISA)(const T *src, uint64_t pos, uint64_t last, T mask, T value) \
+{ \
+    return col_scan_equal_run_mask_##T(src, pos, last, mask, value); \
+} \
+uint64_t BINSEARCH_ISA_NAME(scan_equal_run_mask_##T, BINSEARCH_ISA)(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t pos, uint64_t last, T mask, T value); \
+uint64_t BINSEARCH_ISA_NAME(scan_equal_run_mask_##T, BINSEARCH_ISA)(const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t pos, uint64_t last, T mask, T value) \
+{ \
+    return scan_equal_run_mask_##T(src, blklen, blkpos, pos, last, mask, value); \
+}
+
+#define define_isa_gather_kernels(T) \
+void BINSEARCH_ISA_NAME(col_gather_rows_##T, BINSEARCH_ISA)(const T *src, const uint64_t *rows, uint64_t nrows, T *dst); \
+void BINSEARCH_ISA_NAME(col_gather_rows_##T, BINSEARCH_ISA)(const T *src, const uint64_t *rows, uint64_t nrows, T *dst) \
+{ \
+    col_gather_rows_##T(src, rows, nrows, dst); \
+} \
+void BINSEARCH_ISA_NAME(gather_rows_be_##T, BINSEARCH_ISA)(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, T *dst); \
+void BINSEARCH_ISA_NAME(gather_rows_be_##T, BINSEARCH_ISA)(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, T *dst) \
+{ \
+    gather_rows_be_##T(src, blklen, blkpos, rows, nrows, dst); \
+} \
+void BINSEARCH_ISA_NAME(gather_rows_le_##T, BINSEARCH_ISA)(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, T *dst); \
+void BINSEARCH_ISA_NAME(gather_rows_le_##T, BINSEARCH_ISA)(const uint8_t *src, uint64_t blklen, uint64_t blkpos, const uint64_t *rows, uint64_t nrows, T *dst) \
+{ \
+    gather_rows_le_##T(src, blklen, blkpos, rows, nrows, dst); \
+}
+
+//!< \endcond
+
+define_isa_kernels(uint32_t)
+define_isa_kernels(uint64_t)
+
+define_isa_scan_kernels(uint8_t)
+define_isa_scan_kernels(uint16_t)
+define_isa_scan_kernels(uint32_t)
+define_isa_scan_kernels(uint64_t)
+
+define_isa_gather_kernels(uint8_t)
+define_isa_gather_kernels(uint16_t)
+define_isa_gather_kernels(uint32_t)
+define_isa_gather_kernels(uint64_t)
@@ -0,0 +1,772 @@
+// BinSearch
+//
+// binsearch_pool.h
+//
+// @category   Libraries
+// @author     Nicola Asuni <info@tecnick.com>
+// @link       https://github.com/tecnickcom/binsearch
+// @license    MIT (see LICENSE file)
+// @copyright  (c) 2017-2026 Nicola Asuni - Tecnick.com
+
+/**
+ * @file binsearch_pool.h
+ * @brief Multi-threaded batch searches with a work-stealing pool of worker threads.
+ *
+ * A batch_pool_t is a fixed pool of worker threads that split a large batch of keys
+ * in chunks and run the prefetching batch searches of binsearch.h on each chunk,
+ * writing the results in a shared output array.
+ * The chunks are initially divided in one contiguous range per worker: each worker
+ * takes the chunks from the front of its own range and, when it is empty, steals the
+ * chunks from the back of the ranges of the other workers, so the workers that hit
+ * more cache misses do not delay the whole batch.
+ * The calling thread also works on the batch, so a pool of N threads starts N-1 threads.
+ *
+ * The worker threads are pinned to one CPU each when the CPU affinity functions are
+ * available (Linux with _GNU_SOURCE defined before including any header).
+ * The programs using this header must be linked with the POSIX threads library (-pthread).
+ *
+ * On NUMA hosts the hot columns (or any other read-only buffer, like the acceleration
+ * indices) can be replicated in the memory of each node with batch_pool_replicate.
+ * The pool searches then transparently read the replica on the node of each worker,
+ * instead of paying the remote-memory latency on half of the probes.
+ * The node is sampled before each chunk, so the unpinned calling thread reads the
+ * replica of its current node even if it migrates during a batch.
+ * The replication requires Linux with _GNU_SOURCE defined, otherwise it does nothing.
+ *
+ *   batch_pool_t pool;
+ *   batch_pool_init(&pool, 0, true); // one thread per online CPU
+ *   batch_pool_replicate_cols(&pool, mf, cols, ncols); // optional, on NUMA hosts
+ *   col_find_first_batch_pool_uint64_t(&pool, src, 0, nrows, keys, nkeys, out);
+ *   batch_pool_destroy(&pool);
+ */
+
+#ifndef BINSEARCH_POOL_H
+#define BINSEARCH_POOL_H
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include "binsearch.h"
+#if defined(__linux__) && defined(CPU_SET)
+#include <sys/syscall.h>
+#if defined(SYS_mbind) && defined(SYS_get_mempolicy) && defined(SYS_getcpu)
+#define BATCH_POOL_NUMA 1 //!< NUMA replication supported
+#endif
+#endif
+
+#ifndef BATCH_POOL_CHUNK
+#define BATCH_POOL_CHUNK 4096 //!< Default number of keys searched by a worker before taking the next chunk
+#endif
+
+#ifndef BATCH_POOL_MAX_THREADS
+#define BATCH_POOL_MAX_THREADS 1024 //!< Maximum number of threads in a pool
+#endif
+
+#ifndef BATCH_POOL_MAX_NODES
+#define BATCH_POOL_MAX_NODES 64 //!< Maximum number of NUMA nodes with a replica
+#endif
+
+/**
+ * Function processing the items [start, end) of a batch.
+ * The node is the NUMA node of the worker (always 0 without replicas).
+ */
+typedef void (*batch_pool_task_t)(void *ctx, uint32_t node, uint64_t start, uint64_t end);
+
+/**
+ * Read-only memory region replicated in the memory of each NUMA node.
+ */
+typedef struct batch_pool_replica_t
+{
+    uintptr_t src;                          //!< Start address of the original region.
+    uint64_t size;                          //!< Size of the region in bytes.
+    uint64_t mapsize;                       //!< Size of each copy, rounded up to the page size.
+    uint8_t *copy[BATCH_POOL_MAX_NODES];    //!< Copy of the region on each node.
+} batch_pool_replica_t;
+
+/**
+ * Range of chunks owned by a worker, padded to a cache line to avoid false sharing.
+ * The first (low 32 bits) and last (high 32 bits) chunk numbers are packed in a
+ * single word, so the owner and the thieves can update them with a single CAS.
+ */
+typedef struct batch_pool_slot_t
+{
+    uint64_t range;             //!< Packed range of chunks [first, last) still to process.
+    uint8_t pad[56];            //!< Padding to a 64 bytes cache line.
+} batch_pool_slot_t;
+
+/**
+ * Pool of worker threads for the batch searches.
+ */
+typedef struct batch_pool_t
+{
+    pthread_t *threads;         //!< Worker threads (nthreads - 1, the caller is the worker 0).
+    batch_pool_slot_t *slots;   //!< Range of chunks of each worker.
+    uint32_t nthreads;          //!< Number of workers, including the calling thread.
+    pthread_mutex_t run;        //!< Lock serializing the batches of concurrent callers.
+    pthread_mutex_t lock;       //!< Lock protecting the job and the counters.
+    pthread_cond_t start;       //!< Signaled when a new job is available.
+    pthread_cond_t done;        //!< Signaled when the last worker completes a job.
+    uint64_t generation;        //!< Job number, incremented for each job.
+    uint32_t active;            //!< Number of worker threads still processing the current job.
+    bool stop;                  //!< Set to terminate the worker threads.
+    batch_pool_task_t task;     //!< Task of the current job.
+    void *ctx;                  //!< Context of the current job.
+    uint64_t nitems;            //!< Number of items of the current job.
+    uint64_t chunk;             //!< Number of items per chunk of the current job.
+    uint32_t nnodes;            //!< Number of NUMA nodes (1 if the host is not NUMA).
+    int32_t node;               //!< NUMA node forced for all the workers (e.g. for testing), or -1 (default) for the node of the running CPU.
+    uint32_t nreplicas;         //!< Number of replicated regions.
+    batch_pool_replica_t *replicas; //!< Replicated regions.
+    uint64_t node_bytes[BATCH_POOL_MAX_NODES]; //!< Bytes of replicas allocated on each node.
+} batch_pool_t;
+
+//!< \cond
+
+#define batch_pool_pack(first, last) (((uint64_t)(last) << 32) | (uint64_t)(first))
+
+// Take the first chunk of the range owned by the worker.
+static inline bool batch_pool_pop(batch_pool_slot_t *slot, uint64_t *chunk)
+{
+    uint64_t r = __atomic_load_n(&slot->range, __ATOMIC_ACQUIRE);
+    while ((r & 0xFFFFFFFF) < (r >> 32))
+    {
+        if (__atomic_compare_exchange_n(&slot->range, &r, (r + 1), true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            *chunk = (r & 0xFFFFFFFF);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Take the last chunk of the range owned by another worker.
+static inline bool batch_pool_steal(batch_pool_slot_t *slot, uint64_t *chunk)
+{
+    uint64_t r = __atomic_load_n(&slot->range, __ATOMIC_ACQUIRE);
+    while ((r & 0xFFFFFFFF) < (r >> 32))
+    {
+        if (__atomic_compare_exchange_n(&slot->range, &r, (r - ((uint64_t)1 << 32)), true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            *chunk = ((r >> 32) - 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+// NUMA node of the calling thread, if there is any replica to route to.
+static inline uint32_t batch_pool_node(const batch_pool_t *pool)
+{
+#ifdef BATCH_POOL_NUMA
+    unsigned int cpu = 0, node = 0;
+    if (pool->nreplicas == 0)
+    {
+        return 0;
+    }
+    if ((pool->node >= 0) && ((uint32_t)pool->node < pool->nnodes))
+    {
+        return (uint32_t)pool->node;
+    }
+    if ((syscall(SYS_getcpu, &cpu, &node, NULL) == 0) && (node < pool->nnodes))
+    {
+        return (uint32_t)node;
+    }
+#else
+    (void)pool;
+#endif
+    return 0;
+}
+
+// The node is sampled for each chunk, as a thread may migrate to another node during a batch.
+static inline void batch_pool_run_chunk(const batch_pool_t *pool, uint64_t chunk)
+{
+    uint64_t start = (chunk * pool->chunk);
+    uint64_t end = start + pool->chunk;
+    pool->task(pool->ctx, batch_pool_node(pool), start, ((end < pool->nitems) ? end : pool->nitems));
+}
+
+// Process the chunks of the worker w, then steal the chunks of the other workers.
+static inline void batch_pool_work(const batch_pool_t *pool, uint32_t w)
+{
+    uint64_t chunk;
+    uint32_t k;
+    while (batch_pool_pop(&pool->slots[w], &chunk))
+    {
+        batch_pool_run_chunk(pool, chunk);
+    }
+    for (k = 1; k < pool->nthreads; k++)
+    {
+        batch_pool_slot_t *victim = &pool->slots[((w + k) % pool->nthreads)];
+        while (batch_pool_steal(victim, &chunk))
+        {
+            batch_pool_run_chunk(pool, chunk);
+        }
+    }
+}
+
+typedef struct batch_pool_arg_t
+{
+    batch_pool_t *pool;
+    uint32_t w;
+} batch_pool_arg_t;
+
+static inline void *batch_pool_thread(void *arg)
+{
+    batch_pool_t *pool = ((batch_pool_arg_t *)arg)->pool;
+    uint32_t w = ((batch_pool_arg_t *)arg)->w;
+    uint64_t generation = 0;
+    free(arg);
+    pthread_mutex_lock(&pool->lock);
+    for (;;)
+    {
+        while ((!pool->stop) && (pool->generation == generation))
+        {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->stop)
+        {
+            break;
+        }
+        generation = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+        batch_pool_work(pool, w);
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->active == 0)
+        {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+static inline void batch_pool_pin(pthread_t thread, uint32_t cpu)
+{
+#if defined(__linux__) && defined(CPU_SET)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    (void)pthread_setaffinity_np(thread, sizeof(set), &set);
+#else
+    (void)thread;
+    (void)cpu;
+#endif
+}
+
+// Number of NUMA nodes the process can allocate memory on (highest allowed node + 1).
+static inline uint32_t batch_pool_numa_nodes(void)
+{
+    uint32_t nnodes = 1;
+#ifdef BATCH_POOL_NUMA
+    unsigned long mask[BATCH_POOL_MAX_NODES / (8 * sizeof(unsigned long))] = {0};
+    const uint32_t bits = (uint32_t)(8 * sizeof(unsigned long));
+    uint32_t i;
+    if (syscall(SYS_get_mempolicy, NULL, mask, (unsigned long)BATCH_POOL_MAX_NODES, NULL, 4 /* MPOL_F_MEMS_ALLOWED */) != 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < BATCH_POOL_MAX_NODES; i++)
+    {
+        if ((mask[(i / bits)] >> (i % bits)) & 1)
+        {
+            nnodes = (i + 1);
+        }
+    }
+#endif
+    return nnodes;
+}
+
+// Allocate memory bound to the specified NUMA node and copy the source data in it.
+// If the binding fails (e.g. the node has no memory) the pages are allocated with the default policy.
+static inline uint8_t *batch_pool_node_copy(const uint8_t *src, uint64_t size, uint64_t mapsize, uint32_t node)
+{
+#ifdef BATCH_POOL_NUMA
+    unsigned long mask[BATCH_POOL_MAX_NODES / (8 * sizeof(unsigned long))] = {0};
+    const uint32_t bits = (uint32_t)(8 * sizeof(unsigned long));
+    uint8_t *dst = (uint8_t *)mmap(NULL, mapsize, (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+    if (dst == MAP_FAILED)
+    {
+        return NULL;
+    }
+    mask[(node / bits)] = (1UL << (node % bits));
+    (void)syscall(SYS_mbind, dst, mapsize, 2 /* MPOL_BIND */, mask, (unsigned long)(BATCH_POOL_MAX_NODES + 1), 0);
+    memcpy(dst, src, size);
+    (void)mprotect(dst, mapsize, PROT_READ);
+    return dst;
+#else
+    (void)src;
+    (void)size;
+    (void)mapsize;
+    (void)node;
+    return NULL;
+#endif
+}
+
+// Address of the replica on the specified node of the region [src, src + size),
+// or src if the region is not entirely contained in a replicated region.
+static inline const void *batch_pool_local(const batch_pool_t *pool, uint32_t node, const void *src, uint64_t size)
+{
+    uintptr_t p = (uintptr_t)src;
+    uint32_t i;
+    for (i = 0; i < pool->nreplicas; i++)
+    {
+        const batch_pool_replica_t *r = &pool->replicas[i];
+        if ((p >= r->src) && ((p - r->src) <= r->size) && (size <= (r->size - (p - r->src))))
+        {
+            return (r->copy[node] + (p - r->src));
+        }
+    }
+    return src;
+}
+
+//!< \endcond
+
+//!< \cond
+
+static inline void batch_pool_free_replicas(batch_pool_t *pool)
+{
+    uint32_t i, n;
+    for (i = 0; i < pool->nreplicas; i++)
+    {
+        for (n = 0; n < pool->nnodes; n++)
+        {
+            (void)munmap(pool->replicas[i].copy[n], pool->replicas[i].mapsize);
+        }
+    }
+    free(pool->replicas);
+    pool->replicas = NULL;
+    pool->nreplicas = 0;
+    for (n = 0; n < BATCH_POOL_MAX_NODES; n++)
+    {
+        pool->node_bytes[n] = 0;
+    }
+}
+
+//!< \endcond
+
+/**
+ * Release all the NUMA replicas of a pool.
+ * This must be called before unmapping or modifying the replicated data.
+ * It waits for the batch running on the pool, if any, so it can be called by any thread.
+ *
+ * @param pool      Pool initialized by batch_pool_init.
+ */
+static inline void batch_pool_release_replicas(batch_pool_t *pool)
+{
+    pthread_mutex_lock(&pool->run);
+    batch_pool_free_replicas(pool);
+    pthread_mutex_unlock(&pool->run);
+}
+
+/**
+ * Replicate a read-only memory region (e.g. a column or an index) in the memory of each NUMA node.
+ * The pool searches on data entirely contained in a replicated region read the replica
+ * on the node of each worker. The region must not change until the replicas are released.
+ * It waits for the batch running on the pool, if any, so it can be called by any thread.
+ * It does nothing if the host has a single NUMA node or NUMA is not supported.
+ *
+ * @param pool      Pool initialized by batch_pool_init.
+ * @param src       Start address of the region.
+ * @param size      Size of the region in bytes.
+ *
+ * @return 0 on success, -1 on failure (the region is not replicated).
+ */
+static inline int batch_pool_replicate(batch_pool_t *pool, const void *src, uint64_t size)
+{
+    uint32_t n;
+    if ((pool->nnodes < 2) || (size == 0))
+    {
+        return 0;
+    }
+    long pagesize = sysconf(_SC_PAGESIZE);
+    uint64_t mapsize = (pagesize > 0) ? (((size + (uint64_t)pagesize - 1) / (uint64_t)pagesize) * (uint64_t)pagesize) : size;
+    pthread_mutex_lock(&pool->run);
+    batch_pool_replica_t *replicas = (batch_pool_replica_t *)realloc(pool->replicas, ((pool->nreplicas + 1) * sizeof(batch_pool_replica_t)));
+    if (replicas == NULL)
+    {
+        pthread_mutex_unlock(&pool->run);
+        return -1;
+    }
+    pool->replicas = replicas;
+    batch_pool_replica_t *r = &replicas[pool->nreplicas];
+    r->src = (uintptr_t)src;
+    r->size = size;
+    r->mapsize = mapsize;
+    for (n = 0; n < pool->nnodes; n++)
+    {
+        r->copy[n] = batch_pool_node_copy((const uint8_t *)src, size, mapsize, n);
+        if (r->copy[n] == NULL)
+        {
+            while (n-- > 0)
+            {
+                (void)munmap(r->copy[n], mapsize);
+            }
+            pthread_mutex_unlock(&pool->run);
+            return -1;
+        }
+    }
+    for (n = 0; n < pool->nnodes; n++)
+    {
+        pool->node_bytes[n] += mapsize;
+    }
+    pool->nreplicas++;
+    pthread_mutex_unlock(&pool->run);
+    return 0;
+}
+
+/**
+ * Replicate the specified columns of a memory-mapped file in the memory of each NUMA node.
+ * See batch_pool_replicate.
+ *
+ * @param pool      Pool initialized by batch_pool_init.
+ * @param mf        Descriptor of memory-mapped file.
+ * @param cols      Column numbers to replicate.
+ * @param ncols     Number of columns.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+static inline int batch_pool_replicate_cols(batch_pool_t *pool, mmfile_t mf, const uint8_t *cols, uint64_t ncols)
+{
+    uint64_t i;
+    for (i = 0; i < ncols; i++)
+    {
+        if (cols[i] >= mf.ncols)
+        {
+            return -1;
+        }
+        if (batch_pool_replicate(pool, (mf.src + mf.index[cols[i]]), (mf.nrows * mf.ctbytes[cols[i]])) != 0)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Memory allocated for the replicas on a NUMA node.
+ *
+ * @param pool      Pool initialized by batch_pool_init.
+ * @param node      NUMA node number (less than pool->nnodes).
+ *
+ * @return Number of bytes allocated on the node.
+ */
+static inline uint64_t batch_pool_node_bytes(const batch_pool_t *pool, uint32_t node)
+{
+    return (node < BATCH_POOL_MAX_NODES) ? pool->node_bytes[node] : 0;
+}
+
+/**
+ * Destroy a pool, terminating and joining its worker threads.
+ *
+ * @param pool      Pool initialized by batch_pool_init.
+ */
+static inline void batch_pool_destroy(batch_pool_t *pool)
+{
+    uint32_t i;
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (i = 1; i < pool->nthreads; i++)
+    {
+        pthread_join(pool->threads[i - 1], NULL);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+    batch_pool_free_replicas(pool);
+    pthread_mutex_destroy(&pool->run);
+    free(pool->threads);
+    free(pool->slots);
+    pool->threads = NULL;
+    pool->slots = NULL;
+    pool->nthreads = 0;
+}
+
+/**
+ * Initialize a pool of worker threads.
+ *
+ * @param pool      Pool to initialize.
+ * @param nthreads  Number of workers, including the calling thread (0 = one per online CPU).
+ * @param pin       Pin the worker i to the CPU i (the calling thread is not pinned).
+ *
+ * @return 0 on success, -1 on failure (the pool is not initialized).
+ */
+static inline int batch_pool_init(batch_pool_t *pool, uint32_t nthreads, bool pin)
+{
+    uint32_t i;
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpu < 1)
+    {
+        ncpu = 1;
+    }
+    if (nthreads == 0)
+    {
+        nthreads = (uint32_t)ncpu;
+    }
+    if (nthreads > BATCH_POOL_MAX_THREADS)
+    {
+        nthreads = BATCH_POOL_MAX_THREADS;
+    }
+    pool->nthreads = 1;
+    pool->generation = 0;
+    pool->active = 0;
+    pool->stop = false;
+    pool->task = NULL;
+    pool->ctx = NULL;
+    pool->nitems = 0;
+    pool->chunk = BATCH_POOL_CHUNK;
+    pool->nnodes = batch_pool_numa_nodes();
+    pool->node = -1;
+    pool->nreplicas = 0;
+    pool->replicas = NULL;
+    for (i = 0; i < BATCH_POOL_MAX_NODES; i++)
+    {
+        pool->node_bytes[i] = 0;
+    }
+    pool->threads = (pthread_t *)malloc(nthreads * sizeof(pthread_t));
+    pool->slots = (batch_pool_slot_t *)aligned_alloc(64, nthreads * sizeof(batch_pool_slot_t));
+    if ((pool->threads == NULL) || (pool->slots == NULL))
+    {
+        free(pool->threads);
+        free(pool->slots);
+        return -1;
+    }
+    for (i = 0; i < nthreads; i++)
+    {
+        pool->slots[i].range = 0;
+    }
+    pthread_mutex_init(&pool->run, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    for (i = 1; i < nthreads; i++)
+    {
+        batch_pool_arg_t *arg = (batch_pool_arg_t *)malloc(sizeof(batch_pool_arg_t));
+        if (arg == NULL)
+        {
+            batch_pool_destroy(pool);
+            return -1;
+        }
+        arg->pool = pool;
+        arg->w = i;
+        if (pthread_create(&pool->threads[i - 1], NULL, batch_pool_thread, arg) != 0)
+        {
+            free(arg);
+            batch_pool_destroy(pool);
+            return -1;
+        }
+        pool->nthreads = (i + 1);
+        if (pin)
+        {
+            batch_pool_pin(pool->threads[i - 1], (uint32_t)(i % (uint32_t)ncpu));
+        }
+    }
+    return 0;
+}
+
+/**
+ * Process the items [0, nitems) of a batch with all the workers of a pool.
+ * The items are split in chunks and the task is called once per chunk,
+ * by any of the workers. The function returns when all the items are processed.
+ * A pool runs one batch at a time: the batches of concurrent callers are serialized.
+ *
+ * @param pool      Pool initialized by batch_pool_init.
+ * @param task      Function processing a range of items.
+ * @param ctx       Context passed to the task.
+ * @param nitems    Number of items.
+ * @param chunk     Number of items per chunk (0 = BATCH_POOL_CHUNK).
+ */
+static inline void batch_pool_run(batch_pool_t *pool, batch_pool_task_t task, void *ctx, uint64_t nitems, uint64_t chunk)
+{
+    uint64_t nchunks;
+    uint32_t i;
+    if (nitems == 0)
+    {
+        return;
+    }
+    if (chunk == 0)
+    {
+        chunk = BATCH_POOL_CHUNK;
+    }
+    if ((nitems / chunk) >= 0xFFFFFFFF)
+    {
+        chunk = ((nitems >> 32) + 1); // the chunk numbers must fit in 32 bits
+    }
+    nchunks = ((nitems + chunk - 1) / chunk);
+    pthread_mutex_lock(&pool->run);
+    if ((pool->nthreads == 1) || (nchunks == 1))
+    {
+        task(ctx, batch_pool_node(pool), 0, nitems);
+        pthread_mutex_unlock(&pool->run);
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->ctx = ctx;
+    pool->nitems = nitems;
+    pool->chunk = chunk;
+    for (i = 0; i < pool->nthreads; i++)
+    {
+        __atomic_store_n(&pool->slots[i].range, batch_pool_pack(((nchunks * i) / pool->nthreads), ((nchunks * (i + 1)) / pool->nthreads)), __ATOMIC_RELEASE);
+    }
+    pool->active = (pool->nthreads - 1);
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    batch_pool_work(pool, 0);
+    pthread_mutex_lock(&pool->lock);
+    while (pool->active > 0)
+    {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->run);
+}
+
+/**
+ * Generic function to run the column batch searches on a pool of threads.
+ *
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_col_find_batch_pool(T) \
+/** \cond */ \
+typedef struct col_find_batch_pool_##T##_ctx_t \
+{ \
+    const batch_pool_t *pool; \
+    const T *src; \
+    uint64_t first; \
+    uint64_t last; \
+    const T *keys; \
+    uint64_t *out; \
+} col_find_batch_pool_##T##_ctx_t; \
+static inline void col_find_first_batch_pool_##T##_task(void *ctx, uint32_t node, uint64_t start, uint64_t end) \
+{ \
+    const col_find_batch_pool_##T##_ctx_t *c = (const col_find_batch_pool_##T##_ctx_t *)ctx; \
+    const T *src = (const T *)batch_pool_local(c->pool, node, c->src, (c->last * sizeof(T))); \
+    col_find_first_batch_##T(src, c->first, c->last, (c->keys + start), (end - start), (c->out + start)); \
+} \
+static inline void col_find_last_batch_pool_##T##_task(void *ctx, uint32_t node, uint64_t start, uint64_t end) \
+{ \
+    const col_find_batch_pool_##T##_ctx_t *c = (const col_find_batch_pool_##T##_ctx_t *)ctx; \
+    const T *src = (const T *)batch_pool_local(c->pool, node, c->src, (c->last * sizeof(T))); \
+    col_find_last_batch_##T(src, c->first, c->last, (c->keys + start), (end - start), (c->out + start)); \
+} \
+/** \endcond */ \
+/** Search for the first occurrence of multiple unsigned integers on a memory buffer
+containing contiguos blocks of unsigned integers of the same type, using all the workers of a pool.
+Each result is the same returned by col_find_first_batch_##T for the same key.
+@param pool      Pool initialized by batch_pool_init.
+@param src       Memory mapped file address.
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param out       Output buffer of nkeys elements: item number if found or last if not found.
+*/ \
+static inline void col_find_first_batch_pool_##T(batch_pool_t *pool, const T *src, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *out) \
+{ \
+    col_find_batch_pool_##T##_ctx_t ctx = {pool, src, first, last, keys, out}; \
+    batch_pool_run(pool, col_find_first_batch_pool_##T##_task, &ctx, nkeys, 0); \
+} \
+/** Search for the last occurrence of multiple unsigned integers on a memory buffer
+containing contiguos blocks of unsigned integers of the same type, using all the workers of a pool.
+Each result is the same returned by col_find_last_batch_##T for the same key.
+@param pool      Pool initialized by batch_pool_init.
+@param src       Memory mapped file address.
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param out       Output buffer of nkeys elements: item number if found or last if not found.
+*/ \
+static inline void col_find_last_batch_pool_##T(batch_pool_t *pool, const T *src, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *out) \
+{ \
+    col_find_batch_pool_##T##_ctx_t ctx = {pool, src, first, last, keys, out}; \
+    batch_pool_run(pool, col_find_last_batch_pool_##T##_task, &ctx, nkeys, 0); \
+}
+
+define_col_find_batch_pool(uint8_t)
+define_col_find_batch_pool(uint16_t)
+define_col_find_batch_pool(uint32_t)
+define_col_find_batch_pool(uint64_t)
+
+/**
+ * Generic function to run the batch searches on a pool of threads.
+ *
+ * @param O Endiannes: be or le.
+ * @param T Unsigned integer type, one of: uint8_t, uint16_t, uint32_t, uint64_t.
+ */
+#define define_find_batch_pool(O, T) \
+/** \cond */ \
+typedef struct find_batch_pool_##O##_##T##_ctx_t \
+{ \
+    const batch_pool_t *pool; \
+    const uint8_t *src; \
+    uint64_t blklen; \
+    uint64_t blkpos; \
+    uint64_t first; \
+    uint64_t last; \
+    const T *keys; \
+    uint64_t *out; \
+} find_batch_pool_##O##_##T##_ctx_t; \
+static inline void find_first_batch_pool_##O##_##T##_task(void *ctx, uint32_t node, uint64_t start, uint64_t end) \
+{ \
+    const find_batch_pool_##O##_##T##_ctx_t *c = (const find_batch_pool_##O##_##T##_ctx_t *)ctx; \
+    const uint8_t *src = (const uint8_t *)batch_pool_local(c->pool, node, c->src, (c->last * c->blklen)); \
+    find_first_batch_##O##_##T(src, c->blklen, c->blkpos, c->first, c->last, (c->keys + start), (end - start), (c->out + start)); \
+} \
+static inline void find_last_batch_pool_##O##_##T##_task(void *ctx, uint32_t node, uint64_t start, uint64_t end) \
+{ \
+    const find_batch_pool_##O##_##T##_ctx_t *c = (const find_batch_pool_##O##_##T##_ctx_t *)ctx; \
+    const uint8_t *src = (const uint8_t *)batch_pool_local(c->pool, node, c->src, (c->last * c->blklen)); \
+    find_last_batch_##O##_##T(src, c->blklen, c->blkpos, c->first, c->last, (c->keys + start), (end - start), (c->out + start)); \
+} \
+/** \endcond */ \
+/** Search for the first occurrence of multiple unsigned integers on a memory mapped
+binary file containing adjacent blocks of sorted binary data, using all the workers of a pool.
+Each result is the same returned by find_first_batch_##O##_##T for the same key.
+@param pool      Pool initialized by batch_pool_init.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param out       Output buffer of nkeys elements: item number if found or last if not found.
+*/ \
+static inline void find_first_batch_pool_##O##_##T(batch_pool_t *pool, const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *out) \
+{ \
+    find_batch_pool_##O##_##T##_ctx_t ctx = {pool, src, blklen, blkpos, first, last, keys, out}; \
+    batch_pool_run(pool, find_first_batch_pool_##O##_##T##_task, &ctx, nkeys, 0); \
+} \
+/** Search for the last occurrence of multiple unsigned integers on a memory mapped
+binary file containing adjacent blocks of sorted binary data, using all the workers of a pool.
+Each result is the same returned by find_last_batch_##O##_##T for the same key.
+@param pool      Pool initialized by batch_pool_init.
+@param src       Memory mapped file address.
+@param blklen    Length of the binary block in bytes.
+@param blkpos    Indicates the position of the number to search inside a binary block.
+@param first     First element of the range to search (min value = 0).
+@param last      Element (up to but not including) where to end the search (max value = nrows).
+@param keys      Unsigned numbers to search (type T).
+@param nkeys     Number of keys to search.
+@param out       Output buffer of nkeys elements: item number if found or last if not found.
+*/ \
+static inline void find_last_batch_pool_##O##_##T(batch_pool_t *pool, const uint8_t *src, uint64_t blklen, uint64_t blkpos, uint64_t first, uint64_t last, const T *keys, uint64_t nkeys, uint64_t *out) \
+{ \
+    find_batch_pool_##O##_##T##_ctx_t ctx = {pool, src, blklen, blkpos, first, last, keys, out}; \
+    batch_pool_run(pool, find_last_batch_pool_##O##_##T##_task, &ctx, nkeys, 0); \
+}
+
+define_find_batch_pool(be, uint8_t)
+define_find_batch_pool(be, uint16_t)
+define_find_batch_pool(be, uint32_t)
+define_find_batch_pool(be, uint64_t)
+define_find_batch_pool(le, uint8_t)
+define_find_batch_pool(le, uint16_t)
+define_find_batch_pool(le, uint32_t)
+define_find_batch_pool(le, uint64_t)
+
+#endif  // BINSEARCH_POOL_H
@@ -18,6 +18,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+
 // NOTE: This test is slow because it generates the test files from scratch.
 
 #if __STDC_VERSION__ >= 199901L
@@ -25,6 +26,7 @@
 #else
 #define _XOPEN_SOURCE 500
 #endif
+#define _GNU_SOURCE // CPU affinity of the batch pool threads
 
 #include <inttypes.h>
 #include <stdio.h>
@@ -32,7 +34,7 @@
 #include <string.h>
 #include <time.h>
 #include <sys/mman.h>
-#include "../../src/binsearch/binsearch.h"
+#include "../../src/binsearch/binsearch_pool.h"
 
 #define TEST_DATA_SIZE 10000000ULL
 
@@ -44,51 +46,422 @@ uint64_t get_time()
     return (((uint64_t)t.tv_sec * 1000000000) + (uint64_t)t.tv_nsec);
 }
 
-int benchmark_find_first_be_uint64()
+// Write the test.bin file with TEST_DATA_SIZE rows of (row >> shift) values of nbytes bytes,
+// in big-endian (be) or little-endian order.
+int write_test_file(const char *func, uint8_t nbytes, uint8_t shift, bool be)
 {
     const char *filename = "test.bin";
-
-    uint64_t i;
-
     FILE *f = fopen(filename, "we");
     if (f == NULL)
     {
-        fprintf(stderr, " * %s Unable to open %s file in writing mode.\n", __func__, filename);
+        fprintf(stderr, " * %s Unable to open %s file in writing mode.\n", func, filename);
         return 1;
     }
-    uint8_t b0, b1, b2, b3, z = 0;
+    uint8_t row[8];
+    uint64_t i, v;
+    uint8_t k;
     for (i=0 ; i < TEST_DATA_SIZE; i++)
     {
-        b0 = i & 0xFF;
-        b1 = (i >> 8) & 0xFF;
-        b2 = (i >> 16) & 0xFF;
-        b3 = (i >> 24) & 0xFF;
-        fprintf(f, "%c%c%c%c%c%c%c%c", z, z, z, z, b3, b2, b1, b0);
+        v = (i >> shift);
+        for (k=0 ; k < nbytes; k++)
+        {
+            row[(be ? (nbytes - 1 - k) : k)] = (uint8_t)(v >> (8 * k));
+        }
+        fwrite(row, 1, nbytes, f);
     }
     fclose(f);
+    return 0;
+}
+
+// Write the test.bin file (see write_test_file) and map it as a single column.
+int map_test_file(const char *func, mmfile_t *mf, uint8_t nbytes, uint8_t shift, bool be)
+{
+    if (write_test_file(func, nbytes, shift, be) != 0)
+    {
+        return 1;
+    }
+    mf->nrows = TEST_DATA_SIZE;
+    mf->ncols = 1;
+    mf->ctbytes[0] = nbytes;
+    mmap_binfile("test.bin", mf);
+    if (mf->nrows != TEST_DATA_SIZE)
+    {
+        fprintf(stderr, " * %s Expecting test.bin %" PRIu64 " items, got instead: %" PRIu64 "\n", func, (uint64_t)TEST_DATA_SIZE, mf->nrows);
+        return 1;
+    }
+    return 0;
+}
 
+// Empty SETUP or CLEANUP argument of define_benchmark.
+#define BENCHMARK_NONE
+
+// Define a benchmark_N function timing TEST_DATA_SIZE searches of the 64 bit test column (big-endian when BE is true).
+// SETUP and CLEANUP are the statements (or block macros) that build and free any index used by the SEARCH expression,
+// which can use src, mf, lastitem, the first/last range and the searched value i.
+#define define_benchmark(N, BE, SETUP, SEARCH, CLEANUP) \
+int benchmark_##N() \
+{ \
+    mmfile_t mf = {0}; \
+    if (map_test_file(__func__, &mf, 8, 0, BE) != 0) \
+    { \
+        return 1; \
+    } \
+    uint64_t i, tstart, tend, offset; \
+    volatile uint64_t sum = 0; \
+    uint64_t first, last; \
+    uint64_t lastitem = mf.nrows; \
+    tstart = get_time(); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = 0; \
+        last = lastitem; \
+        sum += i; \
+    } \
+    tend = get_time(); \
+    offset = (tend - tstart); \
+    fprintf(stdout, " * %s sum: %" PRIu64 "\n", __func__, sum); \
+    const uint64_t *src = (const uint64_t *)(mf.src); \
+    (void)src; /* not every search reads src, first and last */ \
+    (void)first; \
+    (void)last; \
+    SETUP \
+    int j; \
+    for (j=0 ; j < 3; j++) \
+    { \
+        sum = 0; \
+        tstart = get_time(); \
+        for (i=0 ; i < TEST_DATA_SIZE; i++) \
+        { \
+            first = 0; \
+            last = lastitem; \
+            sum += SEARCH; \
+        } \
+        tend = get_time(); \
+        fprintf(stdout, "   * %s %d. sum: %" PRIu64 " -- time: %" PRIu64 " ns -- %" PRIu64 " ns/op\n", __func__, j, sum, (tend - tstart - offset), (tend - tstart - offset)/(uint64_t)TEST_DATA_SIZE); \
+    } \
+    CLEANUP \
+    return 0; \
+}
+
+// Define a benchmark_N function timing one batch SEARCH statement over the TEST_DATA_SIZE sorted keys,
+// writing the results in out.
+#define define_benchmark_batch(N, BE, SEARCH) \
+int benchmark_##N() \
+{ \
+    mmfile_t mf = {0}; \
+    if (map_test_file(__func__, &mf, 8, 0, BE) != 0) \
+    { \
+        return 1; \
+    } \
+    uint64_t i, tstart, tend; \
+    volatile uint64_t sum = 0; \
+    uint64_t *keys = (uint64_t *)malloc(TEST_DATA_SIZE * sizeof(uint64_t)); \
+    uint64_t *out = (uint64_t *)malloc(TEST_DATA_SIZE * sizeof(uint64_t)); \
+    if ((keys == NULL) || (out == NULL)) \
+    { \
+        fprintf(stderr, " * %s Unable to allocate the keys and output buffers.\n", __func__); \
+        free(keys); \
+        free(out); \
+        return 1; \
+    } \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        keys[i] = i; \
+    } \
+    const uint64_t *src = (const uint64_t *)(mf.src); \
+    (void)src; /* the byte-order searches read mf.src */ \
+    int j; \
+    for (j=0 ; j < 3; j++) \
+    { \
+        sum = 0; \
+        tstart = get_time(); \
+        SEARCH; \
+        tend = get_time(); \
+        for (i=0 ; i < TEST_DATA_SIZE; i++) \
+        { \
+            sum += out[i]; \
+        } \
+        fprintf(stdout, "   * %s %d. sum: %" PRIu64 " -- time: %" PRIu64 " ns -- %" PRIu64 " ns/op\n", __func__, j, sum, (tend - tstart), (tend - tstart)/(uint64_t)TEST_DATA_SIZE); \
+    } \
+    free(keys); \
+    free(out); \
+    return 0; \
+}
+
+#define EYTZINGER_SETUP \
+    uint64_t *eyt = (uint64_t *)aligned_alloc(64, (((lastitem + 1) * sizeof(uint64_t)) + 63) & ~(uint64_t)63); \
+    if (eyt == NULL) \
+    { \
+        fprintf(stderr, " * %s Unable to allocate the Eytzinger index.\n", __func__); \
+        return 1; \
+    } \
+    col_build_eytzinger_uint64_t(src, lastitem, eyt);
+
+#define LEARNED_SETUP \
+    const uint64_t eps = 64; \
+    uint64_t nknots = col_build_learned_uint64_t(src, lastitem, eps, NULL, NULL); \
+    uint64_t *kkeys = (uint64_t *)malloc(nknots * sizeof(uint64_t)); \
+    uint64_t *kpos = (uint64_t *)malloc(nknots * sizeof(uint64_t)); \
+    if ((kkeys == NULL) || (kpos == NULL)) \
+    { \
+        fprintf(stderr, " * %s Unable to allocate the learned index.\n", __func__); \
+        free(kkeys); \
+        free(kpos); \
+        return 1; \
+    } \
+    col_build_learned_uint64_t(src, lastitem, eps, kkeys, kpos); \
+    fprintf(stdout, " * %s knots: %" PRIu64 "\n", __func__, nknots);
+
+#define STREE_SETUP \
+    uint64_t *tree = (uint64_t *)aligned_alloc(64, ((stree_size_uint64_t(lastitem) * sizeof(uint64_t)) + 63) & ~(uint64_t)63); \
+    if (tree == NULL) \
+    { \
+        fprintf(stderr, " * %s Unable to allocate the S-tree index.\n", __func__); \
+        return 1; \
+    } \
+    col_build_stree_uint64_t(src, lastitem, tree);
+
+#define FENCE_SETUP \
+    const uint64_t step = (4096 / 8); /* one fence per page */ \
+    uint64_t nfences = ((lastitem + step - 1) / step); \
+    uint64_t *fence = (uint64_t *)malloc(nfences * sizeof(uint64_t)); \
+    if (fence == NULL) \
+    { \
+        fprintf(stderr, " * %s Unable to allocate the fence index.\n", __func__); \
+        return 1; \
+    } \
+    build_fence_be_uint64_t(mf.src, 8, 0, lastitem, step, fence);
+
+#define CACHED_SETUP \
+    uint64_t *cache = (uint64_t *)aligned_alloc(64, ((uint64_t)sizeof(uint64_t) << TOPLEVEL_CACHE_LEVELS)); \
+    if (cache == NULL) \
+    { \
+        fprintf(stderr, " * %s Unable to allocate the top-level cache.\n", __func__); \
+        return 1; \
+    } \
+    col_build_toplevel_cache_uint64_t(src, lastitem, TOPLEVEL_CACHE_LEVELS, cache);
+
+#define FILTERED_SETUP \
+    uint64_t nblocks = bloom_nblocks(lastitem, 12); \
+    uint64_t *filter = (uint64_t *)aligned_alloc(64, (nblocks * 64)); \
+    if (filter == NULL) \
+    { \
+        fprintf(stderr, " * %s Unable to allocate the Bloom filter.\n", __func__); \
+        return 1; \
+    } \
+    col_build_bloom_uint64_t(src, lastitem, nblocks, filter);
+
+#define RANGE_FILTER_SETUP \
+    uint64_t nblocks = bloom_nblocks(col_build_range_filter_uint64_t(src, lastitem, 4, 4, 0, NULL), 12); \
+    uint64_t *rf = (uint64_t *)aligned_alloc(64, ((RANGE_FILTER_HEADER_WORDS + (nblocks * 8)) * sizeof(uint64_t))); \
+    if (rf == NULL) \
+    { \
+        fprintf(stderr, " * %s Unable to allocate the range filter.\n", __func__); \
+        return 1; \
+    } \
+    col_build_range_filter_uint64_t(src, lastitem, 4, 4, nblocks, rf);
+
+#define HASH_SETUP \
+    uint64_t nslots = hash_index_nslots(col_build_hash_index_uint64_t(src, lastitem, 0, NULL)); \
+    uint64_t *ht = (uint64_t *)aligned_alloc(64, ((HASH_INDEX_HEADER_WORDS + (nslots * HASH_INDEX_SLOT_WORDS)) * sizeof(uint64_t))); \
+    if (ht == NULL) \
+    { \
+        fprintf(stderr, " * %s Unable to allocate the hash index.\n", __func__); \
+        return 1; \
+    } \
+    col_build_hash_index_uint64_t(src, lastitem, nslots, ht);
+
+#define RUN_INDEX_SETUP \
+    uint64_t nkeys = col_build_run_index_uint64_t(src, lastitem, NULL, NULL); \
+    uint64_t *keys = (uint64_t *)malloc((nkeys + 1) * sizeof(uint64_t)); \
+    uint64_t *rows = (uint64_t *)malloc((nkeys + 1) * sizeof(uint64_t)); \
+    if ((keys == NULL) || (rows == NULL)) \
+    { \
+        fprintf(stderr, " * %s Unable to allocate the run index.\n", __func__); \
+        free(keys); \
+        free(rows); \
+        return 1; \
+    } \
+    col_build_run_index_uint64_t(src, lastitem, keys, rows);
+
+define_benchmark(find_first_be_uint64, true, BENCHMARK_NONE, find_first_be_uint64_t(mf.src, 8, 0, &first, &last, i), BENCHMARK_NONE)
+define_benchmark(find_first_le_uint64, false, BENCHMARK_NONE, find_first_le_uint64_t(mf.src, 8, 0, &first, &last, i), BENCHMARK_NONE)
+define_benchmark(col_find_first_uint64, false, BENCHMARK_NONE, col_find_first_uint64_t(src, &first, &last, i), BENCHMARK_NONE)
+define_benchmark(find_first_branchless_be_uint64, true, BENCHMARK_NONE, find_first_branchless_be_uint64_t(mf.src, 8, 0, &first, &last, i), BENCHMARK_NONE)
+define_benchmark(col_find_first_branchless_uint64, false, BENCHMARK_NONE, col_find_first_branchless_uint64_t(src, &first, &last, i), BENCHMARK_NONE)
+define_benchmark(col_find_first_kary_uint64, false, BENCHMARK_NONE, col_find_first_kary_uint64_t(src, &first, &last, i), BENCHMARK_NONE)
+define_benchmark(col_find_first_eytzinger_uint64, false, EYTZINGER_SETUP, col_find_first_eytzinger_uint64_t(src, eyt, lastitem, &first, &last, i), free(eyt);)
+define_benchmark_batch(find_first_batch_be_uint64, true, find_first_batch_be_uint64_t(mf.src, 8, 0, 0, mf.nrows, keys, TEST_DATA_SIZE, out))
+define_benchmark_batch(col_find_first_batch_uint64, false, col_find_first_batch_uint64_t(src, 0, mf.nrows, keys, TEST_DATA_SIZE, out))
+
+int benchmark_col_find_first_batch_pool_uint64()
+{
     mmfile_t mf = {0};
-    mf.nrows = TEST_DATA_SIZE;
-    mf.ncols = 1;
-    mf.ctbytes[0] = 8;
-    mmap_binfile(filename, &mf);
-    if (mf.nrows != TEST_DATA_SIZE)
+    if (map_test_file(__func__, &mf, 8, 0, false) != 0)
     {
-        fprintf(stderr, " * %s Expecting test.bin %" PRIu64 " items, got instead: %" PRIu64 "\n", __func__, (uint64_t)TEST_DATA_SIZE, mf.nrows);
         return 1;
     }
 
-    uint64_t tstart, tend, offset;
+    uint64_t i, tstart, tend;
+    volatile uint64_t sum = 0;
+    uint64_t *keys = (uint64_t *)malloc(TEST_DATA_SIZE * sizeof(uint64_t));
+    uint64_t *out = (uint64_t *)malloc(TEST_DATA_SIZE * sizeof(uint64_t));
+    if ((keys == NULL) || (out == NULL))
+    {
+        fprintf(stderr, " * %s Unable to allocate the keys and output buffers.\n", __func__);
+        free(keys);
+        free(out);
+        return 1;
+    }
+    for (i=0 ; i < TEST_DATA_SIZE; i++)
+    {
+        keys[i] = ((i * 2654435761) % TEST_DATA_SIZE);
+    }
+
+    const uint64_t *src = (const uint64_t *)(mf.src);
+    long nproc = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t ncpu = (nproc > 0) ? (uint32_t)nproc : 1;
+    uint32_t nthreads;
+    batch_pool_t pool;
+    const uint8_t col = 0;
+
+    for (nthreads = 1; ; nthreads *= 2)
+    {
+        if (nthreads > ncpu)
+        {
+            nthreads = ncpu;
+        }
+        if (batch_pool_init(&pool, nthreads, true) != 0)
+        {
+            fprintf(stderr, " * %s Unable to start %" PRIu32 " threads.\n", __func__, nthreads);
+            break;
+        }
+        int j, r;
+        for (r = 0; r < ((pool.nnodes > 1) ? 2 : 1); r++)
+        {
+            // the second round reads the column replicas on the node of each thread
+            if ((r == 1) && (batch_pool_replicate_cols(&pool, mf, &col, 1) != 0))
+            {
+                fprintf(stderr, " * %s Unable to replicate the column.\n", __func__);
+                break;
+            }
+            for (j=0 ; j < 3; j++)
+            {
+                sum = 0;
+                tstart = get_time();
+                col_find_first_batch_pool_uint64_t(&pool, src, 0, mf.nrows, keys, TEST_DATA_SIZE, out);
+                tend = get_time();
+                for (i=0 ; i < TEST_DATA_SIZE; i++)
+                {
+                    sum += out[i];
+                }
+                fprintf(stdout, "   * %s %" PRIu32 " threads %" PRIu32 " replicas %d. sum: %" PRIu64 " -- time: %" PRIu64 " ns -- %" PRIu64 " ns/op\n", __func__, nthreads, (r * pool.nnodes), j, sum, (tend - tstart), (tend - tstart)/(uint64_t)TEST_DATA_SIZE);
+            }
+        }
+        batch_pool_destroy(&pool);
+        if (nthreads == ncpu)
+        {
+            break;
+        }
+    }
+    free(keys);
+    free(out);
+    return 0;
+}
+
+int benchmark_col_find_first_mmap_opts_uint64()
+{
+    const char *filename = "test.bin";
+
+    if (write_test_file(__func__, 8, 0, false) != 0)
+    {
+        return 1;
+    }
+
+    uint64_t i;
+
+    const char *names[] = {"default", "random", "populate+random", "hugepage", "hugetlb"};
+    const uint32_t flags[] = {0, 0, MMAP_OPT_POPULATE, (MMAP_OPT_POPULATE | MMAP_OPT_HUGEPAGE), MMAP_OPT_HUGETLB};
+    const uint8_t advice[] = {MMAP_ADVICE_NORMAL, MMAP_ADVICE_RANDOM, MMAP_ADVICE_RANDOM, MMAP_ADVICE_RANDOM, MMAP_ADVICE_NORMAL};
+    uint64_t tstart, tend;
     volatile uint64_t sum = 0;
     uint64_t first, last;
+    size_t k;
+    for (k = 0; k < (sizeof(flags) / sizeof(flags[0])); k++)
+    {
+        mmap_opts_t opts = {0};
+        opts.flags = flags[k];
+        opts.advice = advice[k];
+        mmfile_t mf = {0};
+        mf.nrows = TEST_DATA_SIZE;
+        mf.ncols = 1;
+        mf.ctbytes[0] = 8;
+        tstart = get_time();
+        int ret = mmap_binfile_ex(filename, &mf, &opts);
+        tend = get_time();
+        if ((ret < 0) || (mf.nrows != TEST_DATA_SIZE))
+        {
+            fprintf(stderr, " * %s Unable to map test.bin with the %s options.\n", __func__, names[k]);
+            return 1;
+        }
+        fprintf(stdout, "   * %s %s map (return %d) -- time: %" PRIu64 " ns\n", __func__, names[k], ret, (tend - tstart));
+        const uint64_t *src = (const uint64_t *)(mf.src);
+        int j;
+        for (j=0 ; j < 3; j++)
+        {
+            sum = 0;
+            tstart = get_time();
+            for (i=0 ; i < TEST_DATA_SIZE; i++)
+            {
+                first = 0;
+                last = mf.nrows;
+                sum += col_find_first_uint64_t(src, &first, &last, ((i * 2654435761) % TEST_DATA_SIZE));
+            }
+            tend = get_time();
+            fprintf(stdout, "   * %s %s %d. sum: %" PRIu64 " -- time: %" PRIu64 " ns -- %" PRIu64 " ns/op\n", __func__, names[k], j, sum, (tend - tstart), (tend - tstart)/(uint64_t)TEST_DATA_SIZE);
+        }
+        munmap_binfile(mf);
+    }
+    return 0;
+}
+
+define_benchmark_batch(find_sorted_batch_be_uint64, true, find_sorted_batch_be_uint64_t(mf.src, 8, 0, 0, mf.nrows, keys, TEST_DATA_SIZE, out, out))
+define_benchmark_batch(col_find_sorted_batch_uint64, false, col_find_sorted_batch_uint64_t(src, 0, mf.nrows, keys, TEST_DATA_SIZE, out, out))
+define_benchmark(find_first_interp_be_uint64, true, BENCHMARK_NONE, find_first_interp_be_uint64_t(mf.src, 8, 0, &first, &last, i), BENCHMARK_NONE)
+define_benchmark(col_find_first_interp_uint64, false, BENCHMARK_NONE, col_find_first_interp_uint64_t(src, &first, &last, i), BENCHMARK_NONE)
+define_benchmark(find_first_interp_seq_be_uint64, true, BENCHMARK_NONE, find_first_interp_seq_be_uint64_t(mf.src, 8, 0, &first, &last, i), BENCHMARK_NONE)
+define_benchmark(col_find_first_interp_seq_uint64, false, BENCHMARK_NONE, col_find_first_interp_seq_uint64_t(src, &first, &last, i), BENCHMARK_NONE)
+define_benchmark(col_find_first_learned_uint64, false, LEARNED_SETUP, col_find_first_learned_uint64_t(src, kkeys, kpos, nknots, eps, &first, &last, i), free(kkeys); free(kpos);)
+// each search starts from the position found by the previous one
+define_benchmark(col_find_first_from_hint_uint64, false, uint64_t hint = 0;, (hint = col_find_first_from_hint_uint64_t(src, &first, &last, hint, i)), BENCHMARK_NONE)
+define_benchmark(col_count_uint64, false, BENCHMARK_NONE, col_count_uint64_t(src, first, last, i), BENCHMARK_NONE)
+define_benchmark(col_find_first_stree_uint64, false, STREE_SETUP, col_find_first_stree_uint64_t(src, tree, lastitem, &first, &last, i), free(tree);)
+define_benchmark(find_first_fence_be_uint64, true, FENCE_SETUP, find_first_fence_be_uint64_t(mf.src, 8, 0, fence, nfences, step, &first, &last, i), free(fence);)
+define_benchmark(col_find_first_cached_uint64, false, CACHED_SETUP, col_find_first_cached_uint64_t(src, cache, TOPLEVEL_CACHE_LEVELS, lastitem, &first, &last, i), free(cache);)
+// 3 out of 4 searched values are not present
+define_benchmark(col_find_first_filtered_uint64, false, FILTERED_SETUP, col_find_first_filtered_uint64_t(src, filter, nblocks, &first, &last, (((i & 3) != 0) ? (i + TEST_DATA_SIZE) : i)), free(filter);)
+define_benchmark(col_range_maybe_nonempty_uint64, false, RANGE_FILTER_SETUP, (uint64_t)range_maybe_nonempty(rf, i, (i + 15)), free(rf);)
+define_benchmark(col_find_first_hash_uint64, false, HASH_SETUP, find_first_hash(ht, first, last, i), free(ht);)
+define_benchmark(find_range_runs_uint64, false, RUN_INDEX_SETUP, find_range_runs_uint64_t(keys, rows, nkeys, &first, &last, i), free(keys); free(rows);)
+
+int benchmark_has_next_le_uint32()
+{
+    mmfile_t mf = {0};
+    if (map_test_file(__func__, &mf, 8, 6, false) != 0)
+    {
+        return 1;
+    }
+
+    uint64_t i, tstart, tend, offset;
+    volatile uint64_t sum = 0;
+    uint64_t pos;
     uint64_t lastitem = mf.nrows;
 
     tstart = get_time();
     for (i=0 ; i < TEST_DATA_SIZE; i++)
     {
-        first = 0;
-        last = lastitem;
-        sum += i;
+        pos = i;
+        sum += (i >> 6);
     }
     tend = get_time();
     offset = (tend - tstart);
@@ -101,9 +474,11 @@ int benchmark_find_first_be_uint64()
         tstart = get_time();
         for (i=0 ; i < TEST_DATA_SIZE; i++)
         {
-            first = 0;
-            last = lastitem;
-            sum += find_first_be_uint64_t(mf.src, 8, 0, &first, &last, i);
+            pos = i;
+            while (has_next_le_uint32_t(mf.src, 8, 0, &pos, lastitem, (uint32_t)(i >> 6)))
+            {
+                sum++;
+            }
         }
         tend = get_time();
         fprintf(stdout, "   * %s %d. sum: %" PRIu64 " -- time: %" PRIu64 " ns -- %" PRIu64 " ns/op\n", __func__, j, sum, (tend - tstart - offset), (tend - tstart - offset)/(uint64_t)TEST_DATA_SIZE);
@@ -111,51 +486,22 @@ int benchmark_find_first_be_uint64()
     return 0;
 }
 
-int benchmark_find_first_le_uint64()
+int benchmark_scan_equal_run_le_uint32()
 {
-    const char *filename = "test.bin";
-
-    uint64_t i;
-
-    FILE *f = fopen(filename, "we");
-    if (f == NULL)
-    {
-        fprintf(stderr, " * %s Unable to open %s file in writing mode.\n", __func__, filename);
-        return 1;
-    }
-    uint8_t b0, b1, b2, b3, z = 0;
-    for (i=0 ; i < TEST_DATA_SIZE; i++)
-    {
-        b0 = i & 0xFF;
-        b1 = (i >> 8) & 0xFF;
-        b2 = (i >> 16) & 0xFF;
-        b3 = (i >> 24) & 0xFF;
-        fprintf(f, "%c%c%c%c%c%c%c%c", b0, b1, b2, b3, z, z, z, z);
-    }
-    fclose(f);
-
     mmfile_t mf = {0};
-    mf.nrows = TEST_DATA_SIZE;
-    mf.ncols = 1;
-    mf.ctbytes[0] = 8;
-    mmap_binfile(filename, &mf);
-    if (mf.nrows != TEST_DATA_SIZE)
+    if (map_test_file(__func__, &mf, 8, 6, false) != 0)
     {
-        fprintf(stderr, " * %s Expecting test.bin %" PRIu64 " items, got instead: %" PRIu64 "\n", __func__, (uint64_t)TEST_DATA_SIZE, mf.nrows);
         return 1;
     }
 
-    uint64_t tstart, tend, offset;
+    uint64_t i, tstart, tend, offset;
     volatile uint64_t sum = 0;
-    uint64_t first, last;
     uint64_t lastitem = mf.nrows;
 
     tstart = get_time();
     for (i=0 ; i < TEST_DATA_SIZE; i++)
     {
-        first = 0;
-        last = lastitem;
-        sum += i;
+        sum += (i >> 6);
     }
     tend = get_time();
     offset = (tend - tstart);
@@ -168,9 +514,7 @@ int benchmark_find_first_le_uint64()
         tstart = get_time();
         for (i=0 ; i < TEST_DATA_SIZE; i++)
         {
-            first = 0;
-            last = lastitem;
-            sum += find_first_le_uint64_t(mf.src, 8, 0, &first, &last, i);
+            sum += scan_equal_run_le_uint32_t(mf.src, 8, 0, i, lastitem, (uint32_t)(i >> 6));
         }
         tend = get_time();
         fprintf(stdout, "   * %s %d. sum: %" PRIu64 " -- time: %" PRIu64 " ns -- %" PRIu64 " ns/op\n", __func__, j, sum, (tend - tstart - offset), (tend - tstart - offset)/(uint64_t)TEST_DATA_SIZE);
@@ -178,68 +522,93 @@ int benchmark_find_first_le_uint64()
     return 0;
 }
 
-int benchmark_col_find_first_uint64()
+int benchmark_col_cursor_uint32()
 {
-    const char *filename = "test.bin";
+    mmfile_t mf = {0};
+    if (map_test_file(__func__, &mf, 4, 6, false) != 0)
+    {
+        return 1;
+    }
 
-    uint64_t i;
+    uint64_t i, tstart, tend, offset;
+    volatile uint64_t sum = 0;
+    uint64_t lastitem = mf.nrows;
 
-    FILE *f = fopen(filename, "we");
-    if (f == NULL)
+    tstart = get_time();
+    for (i=0 ; i < TEST_DATA_SIZE; i += 64)
     {
-        fprintf(stderr, " * %s Unable to open %s file in writing mode.\n", __func__, filename);
-        return 1;
+        sum += (i >> 6);
     }
-    uint8_t b0, b1, b2, b3, z = 0;
-    for (i=0 ; i < TEST_DATA_SIZE; i++)
+    tend = get_time();
+    offset = (tend - tstart);
+    fprintf(stdout, " * %s sum: %" PRIu64 "\n", __func__, sum);
+
+    const uint32_t *src = (const uint32_t *)(mf.src);
+    uint64_t rows[256];
+    uint64_t n;
+    col_cursor_t cur;
+
+    int j;
+    for (j=0 ; j < 3; j++)
     {
-        b0 = i & 0xFF;
-        b1 = (i >> 8) & 0xFF;
-        b2 = (i >> 16) & 0xFF;
-        b3 = (i >> 24) & 0xFF;
-        fprintf(f, "%c%c%c%c%c%c%c%c", b0, b1, b2, b3, z, z, z, z);
+        sum = 0;
+        tstart = get_time();
+        for (i=0 ; i < TEST_DATA_SIZE; i += 64)
+        {
+            col_cursor_uint32_t(src, 0, lastitem, (uint32_t)(i >> 6), &cur);
+            while ((n = col_cursor_next_rows(&cur, rows, 256)) > 0)
+            {
+                sum += rows[n - 1];
+            }
+        }
+        tend = get_time();
+        fprintf(stdout, "   * %s %d. sum: %" PRIu64 " -- time: %" PRIu64 " ns -- %" PRIu64 " ns/op\n", __func__, j, sum, (tend - tstart - offset), (tend - tstart - offset)/(uint64_t)TEST_DATA_SIZE);
     }
-    fclose(f);
+    return 0;
+}
 
+int benchmark_col_gather_rows_uint32()
+{
     mmfile_t mf = {0};
-    mf.nrows = TEST_DATA_SIZE;
-    mf.ncols = 1;
-    mf.ctbytes[0] = 8;
-    mmap_binfile(filename, &mf);
-    if (mf.nrows != TEST_DATA_SIZE)
+    if (map_test_file(__func__, &mf, 4, 0, false) != 0)
     {
-        fprintf(stderr, " * %s Expecting test.bin %" PRIu64 " items, got instead: %" PRIu64 "\n", __func__, (uint64_t)TEST_DATA_SIZE, mf.nrows);
         return 1;
     }
 
-    uint64_t tstart, tend, offset;
+    uint64_t i, tstart, tend, offset;
     volatile uint64_t sum = 0;
-    uint64_t first, last;
-    uint64_t lastitem = mf.nrows;
+    uint64_t rows[256];
+    uint32_t values[256];
+    uint64_t k;
 
     tstart = get_time();
-    for (i=0 ; i < TEST_DATA_SIZE; i++)
+    for (i=0 ; i < TEST_DATA_SIZE; i += 256)
     {
-        first = 0;
-        last = lastitem;
-        sum += i;
+        for (k=0 ; k < 256; k++)
+        {
+            rows[k] = (((i + k) * 2654435761) % TEST_DATA_SIZE);
+        }
+        sum += rows[255];
     }
     tend = get_time();
     offset = (tend - tstart);
     fprintf(stdout, " * %s sum: %" PRIu64 "\n", __func__, sum);
 
-    const uint64_t *src = (const uint64_t *)(mf.src);
+    const uint32_t *src = (const uint32_t *)(mf.src);
 
     int j;
     for (j=0 ; j < 3; j++)
     {
         sum = 0;
         tstart = get_time();
-        for (i=0 ; i < TEST_DATA_SIZE; i++)
+        for (i=0 ; i < TEST_DATA_SIZE; i += 256)
         {
-            first = 0;
-            last = lastitem;
-            sum += col_find_first_uint64_t(src, &first, &last, i);
+            for (k=0 ; k < 256; k++)
+            {
+                rows[k] = (((i + k) * 2654435761) % TEST_DATA_SIZE);
+            }
+            col_gather_rows_uint32_t(src, rows, 256, values);
+            sum += values[255];
         }
         tend = get_time();
         fprintf(stdout, "   * %s %d. sum: %" PRIu64 " -- time: %" PRIu64 " ns -- %" PRIu64 " ns/op\n", __func__, j, sum, (tend - tstart - offset), (tend - tstart - offset)/(uint64_t)TEST_DATA_SIZE);
@@ -247,10 +616,99 @@ int benchmark_col_find_first_uint64()
     return 0;
 }
 
+#define HYBRID_CALIBRATION_STEPS 10
+
+// Measure the hybrid search for a set of scan thresholds and report the fastest one.
+// The selected value can be used to set HYBRID_SCAN_##T for the current CPU.
+#define define_calibrate_col_find_first_hybrid(T) \
+int calibrate_col_find_first_hybrid_##T() \
+{ \
+    static const uint64_t scan[HYBRID_CALIBRATION_STEPS] = {0, 4, 8, 16, 32, 64, 128, 256, 512, 1024}; \
+    uint64_t nitems = (sizeof(T) < 4) ? ((uint64_t)1 << (8 * sizeof(T))) : TEST_DATA_SIZE; \
+    uint64_t i, first, last, tstart, tend, offset, best = 0, besttime = UINT64_MAX; \
+    volatile uint64_t sum = 0; \
+    T *src = (T *)malloc(nitems * sizeof(T)); \
+    if (src == NULL) \
+    { \
+        fprintf(stderr, " * %s Unable to allocate the test data.\n", __func__); \
+        return 1; \
+    } \
+    for (i=0 ; i < nitems; i++) \
+    { \
+        src[i] = (T)i; \
+    } \
+    tstart = get_time(); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        sum += ((i * 0x9e3779b97f4a7c15) % nitems); \
+    } \
+    tend = get_time(); \
+    offset = (tend - tstart); \
+    int j; \
+    for (j=0 ; j < HYBRID_CALIBRATION_STEPS; j++) \
+    { \
+        sum = 0; \
+        tstart = get_time(); \
+        for (i=0 ; i < TEST_DATA_SIZE; i++) \
+        { \
+            first = 0; \
+            last = nitems; \
+            sum += col_find_first_hybrid_##T(src, scan[j], &first, &last, (T)((i * 0x9e3779b97f4a7c15) % nitems)); \
+        } \
+        tend = get_time(); \
+        fprintf(stdout, "   * %s scan %" PRIu64 ". sum: %" PRIu64 " -- time: %" PRIu64 " ns -- %" PRIu64 " ns/op\n", __func__, scan[j], sum, (tend - tstart - offset), (tend - tstart - offset)/(uint64_t)TEST_DATA_SIZE); \
+        if ((tend - tstart) < besttime) \
+        { \
+            besttime = (tend - tstart); \
+            best = scan[j]; \
+        } \
+    } \
+    fprintf(stdout, " * %s best scan threshold: %" PRIu64 " (HYBRID_SCAN_" #T " = %d)\n", __func__, best, HYBRID_SCAN_##T); \
+    free(src); \
+    return 0; \
+}
+
+define_calibrate_col_find_first_hybrid(uint8_t)
+define_calibrate_col_find_first_hybrid(uint16_t)
+define_calibrate_col_find_first_hybrid(uint32_t)
+define_calibrate_col_find_first_hybrid(uint64_t)
+
 int main()
 {
     benchmark_find_first_be_uint64();
     benchmark_find_first_le_uint64();
     benchmark_col_find_first_uint64();
+    benchmark_find_first_branchless_be_uint64();
+    benchmark_col_find_first_branchless_uint64();
+    benchmark_col_find_first_kary_uint64();
+    benchmark_col_find_first_eytzinger_uint64();
+    benchmark_find_first_batch_be_uint64();
+    benchmark_col_find_first_batch_uint64();
+    benchmark_col_find_first_batch_pool_uint64();
+    benchmark_col_find_first_mmap_opts_uint64();
+    benchmark_find_sorted_batch_be_uint64();
+    benchmark_col_find_sorted_batch_uint64();
+    benchmark_find_first_interp_be_uint64();
+    benchmark_col_find_first_interp_uint64();
+    benchmark_find_first_interp_seq_be_uint64();
+    benchmark_col_find_first_interp_seq_uint64();
+    benchmark_col_find_first_learned_uint64();
+    benchmark_col_find_first_from_hint_uint64();
+    benchmark_col_count_uint64();
+    benchmark_col_find_first_stree_uint64();
+    benchmark_find_first_fence_be_uint64();
+    benchmark_col_find_first_cached_uint64();
+    benchmark_col_find_first_filtered_uint64();
+    benchmark_col_range_maybe_nonempty_uint64();
+    benchmark_col_find_first_hash_uint64();
+    benchmark_find_range_runs_uint64();
+    benchmark_has_next_le_uint32();
+    benchmark_scan_equal_run_le_uint32();
+    benchmark_col_cursor_uint32();
+    benchmark_col_gather_rows_uint32();
+    calibrate_col_find_first_hybrid_uint8_t();
+    calibrate_col_find_first_hybrid_uint16_t();
+    calibrate_col_find_first_hybrid_uint32_t();
+    calibrate_col_find_first_hybrid_uint64_t();
     return 0;
 }
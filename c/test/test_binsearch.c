@@ -22,6 +22,7 @@
 #include <string.h>
 #include <time.h>
 #include <errno.h>
+#include <unistd.h>
 #include <sys/mman.h>
 #include "../src/binsearch/binsearch.h"
 
@@ -975,14 +976,1328 @@ define_test_find_last(le, uint16_t)
 define_test_find_last(le, uint32_t)
 define_test_find_last(le, uint64_t)
 
+#define define_test_find_first_branchless(O, T) \
+int test_find_first_branchless_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint8_t nbytes = (uint8_t)sizeof(T); \
+    uint8_t bitstart = ((nbytes >> 2) * 8); \
+    uint8_t bitend = ((8 * nbytes) - 1 - bitstart); \
+    uint64_t ffound, lfound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_first_branchless_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+        first = test_data_sub_##O##_##T[i].first; \
+        last = test_data_sub_##O##_##T[i].last; \
+        lfound = find_first_sub_branchless_##O##_##T(mf.src, blklen, test_data_sub_##O##_##T[i].blkpos, bitstart, bitend, &first, &last, test_data_sub_##O##_##T[i].search); \
+        if (lfound != test_data_sub_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_sub_##O##_##T[i].foundFirst, lfound); \
+            ++errors; \
+        } \
+        if (first != test_data_sub_##O##_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_sub_##O##_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_sub_##O##_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_sub_##O##_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_first_branchless(be, uint8_t)
+define_test_find_first_branchless(be, uint16_t)
+define_test_find_first_branchless(be, uint32_t)
+define_test_find_first_branchless(be, uint64_t)
+define_test_find_first_branchless(le, uint8_t)
+define_test_find_first_branchless(le, uint16_t)
+define_test_find_first_branchless(le, uint32_t)
+define_test_find_first_branchless(le, uint64_t)
+
+#define define_test_find_last_branchless(O, T) \
+int test_find_last_branchless_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint8_t nbytes = (uint8_t)sizeof(T); \
+    uint8_t bitstart = ((nbytes >> 2) * 8); \
+    uint8_t bitend = ((8 * nbytes) - 1 - bitstart); \
+    uint64_t ffound, lfound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_last_branchless_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+        first = test_data_sub_##O##_##T[i].first; \
+        last = test_data_sub_##O##_##T[i].last; \
+        lfound = find_last_sub_branchless_##O##_##T(mf.src, blklen, test_data_sub_##O##_##T[i].blkpos, bitstart, bitend, &first, &last, test_data_sub_##O##_##T[i].search); \
+        if (lfound != test_data_sub_##O##_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_sub_##O##_##T[i].foundLast, lfound); \
+            ++errors; \
+        } \
+        if (first != test_data_sub_##O##_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_sub_##O##_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_sub_##O##_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_sub_##O##_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_last_branchless(be, uint8_t)
+define_test_find_last_branchless(be, uint16_t)
+define_test_find_last_branchless(be, uint32_t)
+define_test_find_last_branchless(be, uint64_t)
+define_test_find_last_branchless(le, uint8_t)
+define_test_find_last_branchless(le, uint16_t)
+define_test_find_last_branchless(le, uint32_t)
+define_test_find_last_branchless(le, uint64_t)
+
+#define define_test_find_first_batch(O, T) \
+int test_find_first_batch_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint8_t nbytes = (uint8_t)sizeof(T); \
+    uint8_t bitstart = ((nbytes >> 2) * 8); \
+    uint8_t bitend = ((8 * nbytes) - 1 - bitstart); \
+    T keys[TEST_DATA_SIZE], subkeys[TEST_DATA_SIZE]; \
+    uint64_t out[TEST_DATA_SIZE]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        keys[i] = test_data_##O##_##T[i].search; \
+        subkeys[i] = test_data_sub_##O##_##T[i].search; \
+    } \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        find_first_batch_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, test_data_##O##_##T[i].first, test_data_##O##_##T[i].last, keys, TEST_DATA_SIZE, out); \
+        if (out[i] != test_data_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFirst, out[i]); \
+            ++errors; \
+        } \
+        find_first_sub_batch_##O##_##T(mf.src, blklen, test_data_sub_##O##_##T[i].blkpos, bitstart, bitend, test_data_sub_##O##_##T[i].first, test_data_sub_##O##_##T[i].last, subkeys, TEST_DATA_SIZE, out); \
+        if (out[i] != test_data_sub_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_sub_##O##_##T[i].foundFirst, out[i]); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_first_batch(be, uint8_t)
+define_test_find_first_batch(be, uint16_t)
+define_test_find_first_batch(be, uint32_t)
+define_test_find_first_batch(be, uint64_t)
+define_test_find_first_batch(le, uint8_t)
+define_test_find_first_batch(le, uint16_t)
+define_test_find_first_batch(le, uint32_t)
+define_test_find_first_batch(le, uint64_t)
+
+#define define_test_find_last_batch(O, T) \
+int test_find_last_batch_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint8_t nbytes = (uint8_t)sizeof(T); \
+    uint8_t bitstart = ((nbytes >> 2) * 8); \
+    uint8_t bitend = ((8 * nbytes) - 1 - bitstart); \
+    T keys[TEST_DATA_SIZE], subkeys[TEST_DATA_SIZE]; \
+    uint64_t out[TEST_DATA_SIZE]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        keys[i] = test_data_##O##_##T[i].search; \
+        subkeys[i] = test_data_sub_##O##_##T[i].search; \
+    } \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        find_last_batch_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, test_data_##O##_##T[i].first, test_data_##O##_##T[i].last, keys, TEST_DATA_SIZE, out); \
+        if (out[i] != test_data_##O##_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLast, out[i]); \
+            ++errors; \
+        } \
+        find_last_sub_batch_##O##_##T(mf.src, blklen, test_data_sub_##O##_##T[i].blkpos, bitstart, bitend, test_data_sub_##O##_##T[i].first, test_data_sub_##O##_##T[i].last, subkeys, TEST_DATA_SIZE, out); \
+        if (out[i] != test_data_sub_##O##_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_sub_##O##_##T[i].foundLast, out[i]); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_last_batch(be, uint8_t)
+define_test_find_last_batch(be, uint16_t)
+define_test_find_last_batch(be, uint32_t)
+define_test_find_last_batch(be, uint64_t)
+define_test_find_last_batch(le, uint8_t)
+define_test_find_last_batch(le, uint16_t)
+define_test_find_last_batch(le, uint32_t)
+define_test_find_last_batch(le, uint64_t)
+
+#define define_test_find_sorted_batch(O, T) \
+int test_find_sorted_batch_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i, j; \
+    T keys[TEST_DATA_SIZE], tmp; \
+    uint64_t ofirst[TEST_DATA_SIZE], olast[TEST_DATA_SIZE]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        tmp = test_data_##O##_##T[i].search; \
+        for (j = i; (j > 0) && (keys[j - 1] > tmp); j--) \
+        { \
+            keys[j] = keys[j - 1]; \
+        } \
+        keys[j] = tmp; \
+    } \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        find_sorted_batch_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, test_data_##O##_##T[i].first, test_data_##O##_##T[i].last, keys, TEST_DATA_SIZE, ofirst, olast); \
+        for (j=0 ; keys[j] != test_data_##O##_##T[i].search; j++) \
+        { \
+        } \
+        if (ofirst[j] != test_data_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFirst, ofirst[j]); \
+            ++errors; \
+        } \
+        if (olast[j] != test_data_##O##_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLast, olast[j]); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_sorted_batch(be, uint8_t)
+define_test_find_sorted_batch(be, uint16_t)
+define_test_find_sorted_batch(be, uint32_t)
+define_test_find_sorted_batch(be, uint64_t)
+define_test_find_sorted_batch(le, uint8_t)
+define_test_find_sorted_batch(le, uint16_t)
+define_test_find_sorted_batch(le, uint32_t)
+define_test_find_sorted_batch(le, uint64_t)
+
+#define define_test_find_first_interp(O, T) \
+int test_find_first_interp_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_first_interp_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_first_interp(be, uint8_t)
+define_test_find_first_interp(be, uint16_t)
+define_test_find_first_interp(be, uint32_t)
+define_test_find_first_interp(be, uint64_t)
+define_test_find_first_interp(le, uint8_t)
+define_test_find_first_interp(le, uint16_t)
+define_test_find_first_interp(le, uint32_t)
+define_test_find_first_interp(le, uint64_t)
+
+#define define_test_find_last_interp(O, T) \
+int test_find_last_interp_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_last_interp_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_last_interp(be, uint8_t)
+define_test_find_last_interp(be, uint16_t)
+define_test_find_last_interp(be, uint32_t)
+define_test_find_last_interp(be, uint64_t)
+define_test_find_last_interp(le, uint8_t)
+define_test_find_last_interp(le, uint16_t)
+define_test_find_last_interp(le, uint32_t)
+define_test_find_last_interp(le, uint64_t)
+
+#define define_test_find_first_interp_seq(O, T) \
+int test_find_first_interp_seq_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_first_interp_seq_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_first_interp_seq(be, uint8_t)
+define_test_find_first_interp_seq(be, uint16_t)
+define_test_find_first_interp_seq(be, uint32_t)
+define_test_find_first_interp_seq(be, uint64_t)
+define_test_find_first_interp_seq(le, uint8_t)
+define_test_find_first_interp_seq(le, uint16_t)
+define_test_find_first_interp_seq(le, uint32_t)
+define_test_find_first_interp_seq(le, uint64_t)
+
+#define define_test_find_last_interp_seq(O, T) \
+int test_find_last_interp_seq_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_last_interp_seq_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_last_interp_seq(be, uint8_t)
+define_test_find_last_interp_seq(be, uint16_t)
+define_test_find_last_interp_seq(be, uint32_t)
+define_test_find_last_interp_seq(be, uint64_t)
+define_test_find_last_interp_seq(le, uint8_t)
+define_test_find_last_interp_seq(le, uint16_t)
+define_test_find_last_interp_seq(le, uint32_t)
+define_test_find_last_interp_seq(le, uint64_t)
+
 // returns current time in nanoseconds
 uint64_t get_time()
 {
-    struct timespec t;
-    (void)timespec_get(&t, TIME_UTC);
-    return (((uint64_t)t.tv_sec * 1000000000) + (uint64_t)t.tv_nsec);
+    struct timespec t;
+    (void)timespec_get(&t, TIME_UTC);
+    return (((uint64_t)t.tv_sec * 1000000000) + (uint64_t)t.tv_nsec);
+}
+
+#define define_test_find_first_from_hint(O, T) \
+int test_find_first_from_hint_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i, h; \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        const uint64_t hints[] = {0, test_data_##O##_##T[i].first, ((test_data_##O##_##T[i].first + test_data_##O##_##T[i].last) / 2), test_data_##O##_##T[i].last, UINT64_MAX}; \
+        for (h=0 ; h < (int)(sizeof(hints) / sizeof(hints[0])); h++) \
+        { \
+            first = test_data_##O##_##T[i].first; \
+            last = test_data_##O##_##T[i].last; \
+            ffound = find_first_from_hint_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, &first, &last, hints[h], test_data_##O##_##T[i].search); \
+            if (ffound != test_data_##O##_##T[i].foundFirst) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d:%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, h, test_data_##O##_##T[i].foundFirst, ffound); \
+                ++errors; \
+            } \
+            if (first != test_data_##O##_##T[i].foundFFirst) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d:%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, h, test_data_##O##_##T[i].foundFFirst, first); \
+                ++errors; \
+            } \
+            if (last != test_data_##O##_##T[i].foundFLast) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d:%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, h, test_data_##O##_##T[i].foundFLast, last); \
+                ++errors; \
+            } \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_first_from_hint(be, uint8_t)
+define_test_find_first_from_hint(be, uint16_t)
+define_test_find_first_from_hint(be, uint32_t)
+define_test_find_first_from_hint(be, uint64_t)
+define_test_find_first_from_hint(le, uint8_t)
+define_test_find_first_from_hint(le, uint16_t)
+define_test_find_first_from_hint(le, uint32_t)
+define_test_find_first_from_hint(le, uint64_t)
+
+#define define_test_find_last_from_hint(O, T) \
+int test_find_last_from_hint_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i, h; \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        const uint64_t hints[] = {0, test_data_##O##_##T[i].first, ((test_data_##O##_##T[i].first + test_data_##O##_##T[i].last) / 2), test_data_##O##_##T[i].last, UINT64_MAX}; \
+        for (h=0 ; h < (int)(sizeof(hints) / sizeof(hints[0])); h++) \
+        { \
+            first = test_data_##O##_##T[i].first; \
+            last = test_data_##O##_##T[i].last; \
+            ffound = find_last_from_hint_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, &first, &last, hints[h], test_data_##O##_##T[i].search); \
+            if (ffound != test_data_##O##_##T[i].foundLast) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d:%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, h, test_data_##O##_##T[i].foundLast, ffound); \
+                ++errors; \
+            } \
+            if (first != test_data_##O##_##T[i].foundLFirst) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d:%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, h, test_data_##O##_##T[i].foundLFirst, first); \
+                ++errors; \
+            } \
+            if (last != test_data_##O##_##T[i].foundLLast) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d:%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, h, test_data_##O##_##T[i].foundLLast, last); \
+                ++errors; \
+            } \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_last_from_hint(be, uint8_t)
+define_test_find_last_from_hint(be, uint16_t)
+define_test_find_last_from_hint(be, uint32_t)
+define_test_find_last_from_hint(be, uint64_t)
+define_test_find_last_from_hint(le, uint8_t)
+define_test_find_last_from_hint(le, uint16_t)
+define_test_find_last_from_hint(le, uint32_t)
+define_test_find_last_from_hint(le, uint64_t)
+
+#define define_test_find_range(O, T) \
+int test_find_range_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last, efirst, elast, count; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        efirst = test_data_##O##_##T[i].foundFLast; \
+        elast = test_data_##O##_##T[i].foundFLast; \
+        if (test_data_##O##_##T[i].foundFirst != test_data_##O##_##T[i].last) \
+        { \
+            efirst = test_data_##O##_##T[i].foundFirst; \
+            elast = (test_data_##O##_##T[i].foundLast + 1); \
+        } \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_range_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != efirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, efirst, first); \
+            ++errors; \
+        } \
+        if (last != elast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, elast, last); \
+            ++errors; \
+        } \
+        count = count_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, test_data_##O##_##T[i].first, test_data_##O##_##T[i].last, test_data_##O##_##T[i].search); \
+        if (count != (elast - efirst)) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected count %" PRIu64 ", got %" PRIu64 "\n", __func__, i, (elast - efirst), count); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_range(be, uint8_t)
+define_test_find_range(be, uint16_t)
+define_test_find_range(be, uint32_t)
+define_test_find_range(be, uint64_t)
+define_test_find_range(le, uint8_t)
+define_test_find_range(le, uint16_t)
+define_test_find_range(le, uint32_t)
+define_test_find_range(le, uint64_t)
+
+#define TEST_LEARNED_EPS 2
+#define TEST_LEARNED_KNOTS ((2 * 251) + 1)
+
+#define define_test_find_first_learned(O, T) \
+int test_find_first_learned_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last, nknots; \
+    uint64_t kkeys[TEST_LEARNED_KNOTS], kpos[TEST_LEARNED_KNOTS]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        nknots = build_learned_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, nrows, TEST_LEARNED_EPS, kkeys, kpos); \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_first_learned_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, kkeys, kpos, nknots, TEST_LEARNED_EPS, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_first_learned(be, uint8_t)
+define_test_find_first_learned(be, uint16_t)
+define_test_find_first_learned(be, uint32_t)
+define_test_find_first_learned(be, uint64_t)
+define_test_find_first_learned(le, uint8_t)
+define_test_find_first_learned(le, uint16_t)
+define_test_find_first_learned(le, uint32_t)
+define_test_find_first_learned(le, uint64_t)
+
+#define define_test_find_last_learned(O, T) \
+int test_find_last_learned_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last, nknots; \
+    uint64_t kkeys[TEST_LEARNED_KNOTS], kpos[TEST_LEARNED_KNOTS]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        nknots = build_learned_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, nrows, TEST_LEARNED_EPS, kkeys, kpos); \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_last_learned_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, kkeys, kpos, nknots, TEST_LEARNED_EPS, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_last_learned(be, uint8_t)
+define_test_find_last_learned(be, uint16_t)
+define_test_find_last_learned(be, uint32_t)
+define_test_find_last_learned(be, uint64_t)
+define_test_find_last_learned(le, uint8_t)
+define_test_find_last_learned(le, uint16_t)
+define_test_find_last_learned(le, uint32_t)
+define_test_find_last_learned(le, uint64_t)
+
+#define TEST_FENCE_STEP 4
+#define TEST_FENCES ((251 + TEST_FENCE_STEP - 1) / TEST_FENCE_STEP)
+
+#define define_test_find_first_fence(O, T) \
+int test_find_first_fence_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last, nfences; \
+    T fence[TEST_FENCES]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        nfences = build_fence_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, nrows, TEST_FENCE_STEP, fence); \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_first_fence_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, fence, nfences, TEST_FENCE_STEP, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_first_fence(be, uint8_t)
+define_test_find_first_fence(be, uint16_t)
+define_test_find_first_fence(be, uint32_t)
+define_test_find_first_fence(be, uint64_t)
+define_test_find_first_fence(le, uint8_t)
+define_test_find_first_fence(le, uint16_t)
+define_test_find_first_fence(le, uint32_t)
+define_test_find_first_fence(le, uint64_t)
+
+#define define_test_find_last_fence(O, T) \
+int test_find_last_fence_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last, nfences; \
+    T fence[TEST_FENCES]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        nfences = build_fence_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, nrows, TEST_FENCE_STEP, fence); \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_last_fence_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, fence, nfences, TEST_FENCE_STEP, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_last_fence(be, uint8_t)
+define_test_find_last_fence(be, uint16_t)
+define_test_find_last_fence(be, uint32_t)
+define_test_find_last_fence(be, uint64_t)
+define_test_find_last_fence(le, uint8_t)
+define_test_find_last_fence(le, uint16_t)
+define_test_find_last_fence(le, uint32_t)
+define_test_find_last_fence(le, uint64_t)
+
+#define TEST_CACHE_LEVELS 4
+
+#define define_test_find_first_cached(O, T) \
+int test_find_first_cached_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last; \
+    T cache[1 << TEST_CACHE_LEVELS]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        build_toplevel_cache_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, nrows, TEST_CACHE_LEVELS, cache); \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_first_cached_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, cache, TEST_CACHE_LEVELS, nrows, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_first_cached(be, uint8_t)
+define_test_find_first_cached(be, uint16_t)
+define_test_find_first_cached(be, uint32_t)
+define_test_find_first_cached(be, uint64_t)
+define_test_find_first_cached(le, uint8_t)
+define_test_find_first_cached(le, uint16_t)
+define_test_find_first_cached(le, uint32_t)
+define_test_find_first_cached(le, uint64_t)
+
+#define define_test_find_last_cached(O, T) \
+int test_find_last_cached_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last; \
+    T cache[1 << TEST_CACHE_LEVELS]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        build_toplevel_cache_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, nrows, TEST_CACHE_LEVELS, cache); \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_last_cached_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, cache, TEST_CACHE_LEVELS, nrows, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_last_cached(be, uint8_t)
+define_test_find_last_cached(be, uint16_t)
+define_test_find_last_cached(be, uint32_t)
+define_test_find_last_cached(be, uint64_t)
+define_test_find_last_cached(le, uint8_t)
+define_test_find_last_cached(le, uint16_t)
+define_test_find_last_cached(le, uint32_t)
+define_test_find_last_cached(le, uint64_t)
+
+#define TEST_HYBRID_SCANS 4
+static const uint64_t test_hybrid_scan[TEST_HYBRID_SCANS] = {0, 7, 32, 1000};
+
+#define define_test_find_first_hybrid(O, T) \
+int test_find_first_hybrid_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last; \
+    uint64_t s; \
+    for (s=0 ; s < TEST_HYBRID_SCANS; s++) \
+    { \
+        for (i=0 ; i < TEST_DATA_SIZE; i++) \
+        { \
+            first = test_data_##O##_##T[i].first; \
+            last = test_data_##O##_##T[i].last; \
+            ffound = find_first_hybrid_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, test_hybrid_scan[s], &first, &last, test_data_##O##_##T[i].search); \
+            if (ffound != test_data_##O##_##T[i].foundFirst) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFirst, ffound); \
+                ++errors; \
+            } \
+            if (first != test_data_##O##_##T[i].foundFFirst) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFFirst, first); \
+                ++errors; \
+            } \
+            if (last != test_data_##O##_##T[i].foundFLast) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFLast, last); \
+                ++errors; \
+            } \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_first_hybrid(be, uint8_t)
+define_test_find_first_hybrid(be, uint16_t)
+define_test_find_first_hybrid(be, uint32_t)
+define_test_find_first_hybrid(be, uint64_t)
+define_test_find_first_hybrid(le, uint8_t)
+define_test_find_first_hybrid(le, uint16_t)
+define_test_find_first_hybrid(le, uint32_t)
+define_test_find_first_hybrid(le, uint64_t)
+
+#define define_test_find_last_hybrid(O, T) \
+int test_find_last_hybrid_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last; \
+    uint64_t s; \
+    for (s=0 ; s < TEST_HYBRID_SCANS; s++) \
+    { \
+        for (i=0 ; i < TEST_DATA_SIZE; i++) \
+        { \
+            first = test_data_##O##_##T[i].first; \
+            last = test_data_##O##_##T[i].last; \
+            ffound = find_last_hybrid_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, test_hybrid_scan[s], &first, &last, test_data_##O##_##T[i].search); \
+            if (ffound != test_data_##O##_##T[i].foundLast) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLast, ffound); \
+                ++errors; \
+            } \
+            if (first != test_data_##O##_##T[i].foundLFirst) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLFirst, first); \
+                ++errors; \
+            } \
+            if (last != test_data_##O##_##T[i].foundLLast) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLLast, last); \
+                ++errors; \
+            } \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_last_hybrid(be, uint8_t)
+define_test_find_last_hybrid(be, uint16_t)
+define_test_find_last_hybrid(be, uint32_t)
+define_test_find_last_hybrid(be, uint64_t)
+define_test_find_last_hybrid(le, uint8_t)
+define_test_find_last_hybrid(le, uint16_t)
+define_test_find_last_hybrid(le, uint32_t)
+define_test_find_last_hybrid(le, uint64_t)
+
+#define define_test_scan_equal_run(O, T) \
+int test_scan_equal_run_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint8_t nbytes = (uint8_t)sizeof(T); \
+    uint8_t bitstart = ((nbytes >> 2) * 8); \
+    uint8_t bitend = ((8 * nbytes) - 1 - bitstart); \
+    uint64_t numitems, run; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        if (test_data_##O##_##T[i].foundFirst < test_data_##O##_##T[i].last) \
+        { \
+            numitems = (test_data_##O##_##T[i].foundLast - test_data_##O##_##T[i].foundFirst + 1); \
+            run = scan_equal_run_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, test_data_##O##_##T[i].foundFirst, test_data_##O##_##T[i].last, test_data_##O##_##T[i].search); \
+            if (run != numitems) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected %" PRIu64 ", got %" PRIu64 "\n", __func__, i, numitems, run); \
+                ++errors; \
+            } \
+        } \
+        if (test_data_sub_##O##_##T[i].foundFirst < test_data_sub_##O##_##T[i].last) \
+        { \
+            numitems = (test_data_sub_##O##_##T[i].foundLast - test_data_sub_##O##_##T[i].foundFirst + 1); \
+            run = scan_equal_run_sub_##O##_##T(mf.src, blklen, test_data_sub_##O##_##T[i].blkpos, bitstart, bitend, test_data_sub_##O##_##T[i].foundFirst, test_data_sub_##O##_##T[i].last, test_data_sub_##O##_##T[i].search); \
+            if (run != numitems) \
+            { \
+                (void)fprintf_s(stderr, "%s SUB (%d) Expected %" PRIu64 ", got %" PRIu64 "\n", __func__, i, numitems, run); \
+                ++errors; \
+            } \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_scan_equal_run(be, uint8_t)
+define_test_scan_equal_run(be, uint16_t)
+define_test_scan_equal_run(be, uint32_t)
+define_test_scan_equal_run(be, uint64_t)
+define_test_scan_equal_run(le, uint8_t)
+define_test_scan_equal_run(le, uint16_t)
+define_test_scan_equal_run(le, uint32_t)
+define_test_scan_equal_run(le, uint64_t)
+
+#define TEST_GATHER_ITEMS 251 // number of items in test_data.bin
+
+#define define_test_gather(O, T) \
+int test_gather_##O##_##T(mmfile_t mf, uint64_t blklen) \
+{ \
+    int errors = 0; \
+    uint64_t i; \
+    uint64_t blkpos = test_data_##O##_##T[0].blkpos; \
+    uint64_t rows[TEST_GATHER_ITEMS]; \
+    T dst[TEST_GATHER_ITEMS]; \
+    T exp; \
+    for (i = 0; i < TEST_GATHER_ITEMS; i++) \
+    { \
+        rows[i] = ((i * 97) % TEST_GATHER_ITEMS); \
+    } \
+    gather_rows_##O##_##T(mf.src, blklen, blkpos, rows, TEST_GATHER_ITEMS, dst); \
+    for (i = 0; i < TEST_GATHER_ITEMS; i++) \
+    { \
+        exp = bytes_##O##_to_##T(mf.src, get_address(blklen, blkpos, rows[i])); \
+        if (dst[i] != exp) \
+        { \
+            (void)fprintf_s(stderr, "%s ROWS (%" PRIu64 ") Expected %" PRIu64 ", got %" PRIu64 "\n", __func__, i, (uint64_t)exp, (uint64_t)dst[i]); \
+            ++errors; \
+        } \
+    } \
+    gather_range_##O##_##T(mf.src, blklen, blkpos, 5, (TEST_GATHER_ITEMS - 1), dst); \
+    for (i = 5; i < (TEST_GATHER_ITEMS - 1); i++) \
+    { \
+        exp = bytes_##O##_to_##T(mf.src, get_address(blklen, blkpos, i)); \
+        if (dst[(i - 5)] != exp) \
+        { \
+            (void)fprintf_s(stderr, "%s RANGE (%" PRIu64 ") Expected %" PRIu64 ", got %" PRIu64 "\n", __func__, i, (uint64_t)exp, (uint64_t)dst[(i - 5)]); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_gather(be, uint8_t)
+define_test_gather(be, uint16_t)
+define_test_gather(be, uint32_t)
+define_test_gather(be, uint64_t)
+define_test_gather(le, uint8_t)
+define_test_gather(le, uint16_t)
+define_test_gather(le, uint32_t)
+define_test_gather(le, uint64_t)
+
+#define TEST_BLOOM_BITS 16
+#define TEST_BLOOM_WORDS 64 // (bloom_nblocks(251, TEST_BLOOM_BITS) * 8)
+
+#define define_test_find_first_filtered(O, T) \
+int test_find_first_filtered_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last; \
+    uint64_t nblocks = bloom_nblocks(nrows, TEST_BLOOM_BITS); \
+    uint64_t filter[TEST_BLOOM_WORDS]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        build_bloom_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, nrows, nblocks, filter); \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_first_filtered_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, filter, nblocks, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (test_data_##O##_##T[i].foundFirst == test_data_##O##_##T[i].last) \
+        { \
+            continue; /* first and last are not updated when the filter excludes the value */ \
+        } \
+        if (!maybe_contains(filter, nblocks, (uint64_t)test_data_##O##_##T[i].search)) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Unexpected false negative\n", __func__, i); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_first_filtered(be, uint8_t)
+define_test_find_first_filtered(be, uint16_t)
+define_test_find_first_filtered(be, uint32_t)
+define_test_find_first_filtered(be, uint64_t)
+define_test_find_first_filtered(le, uint8_t)
+define_test_find_first_filtered(le, uint16_t)
+define_test_find_first_filtered(le, uint32_t)
+define_test_find_first_filtered(le, uint64_t)
+
+#define define_test_find_last_filtered(O, T) \
+int test_find_last_filtered_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last; \
+    uint64_t nblocks = bloom_nblocks(nrows, TEST_BLOOM_BITS); \
+    uint64_t filter[TEST_BLOOM_WORDS]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        build_bloom_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, nrows, nblocks, filter); \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_last_filtered_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, filter, nblocks, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (test_data_##O##_##T[i].foundLast == test_data_##O##_##T[i].last) \
+        { \
+            continue; /* first and last are not updated when the filter excludes the value */ \
+        } \
+        if (!maybe_contains(filter, nblocks, (uint64_t)test_data_##O##_##T[i].search)) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Unexpected false negative\n", __func__, i); \
+            ++errors; \
+        } \
+        if (first != test_data_##O##_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_data_##O##_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_last_filtered(be, uint8_t)
+define_test_find_last_filtered(be, uint16_t)
+define_test_find_last_filtered(be, uint32_t)
+define_test_find_last_filtered(be, uint64_t)
+define_test_find_last_filtered(le, uint8_t)
+define_test_find_last_filtered(le, uint16_t)
+define_test_find_last_filtered(le, uint32_t)
+define_test_find_last_filtered(le, uint64_t)
+
+#define TEST_RANGE_FILTER_STRIDE 2
+#define TEST_RANGE_FILTER_LEVELS 4
+#define TEST_RANGE_FILTER_WORDS 264 // (RANGE_FILTER_HEADER_WORDS + (bloom_nblocks((251 * TEST_RANGE_FILTER_LEVELS), TEST_BLOOM_BITS) * 8))
+
+static const uint64_t test_range_filter_width[] = {0, 1, 7, 100};
+
+#define define_test_range_maybe_nonempty(O, T) \
+int test_range_maybe_nonempty_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
+{ \
+    int errors = 0; \
+    int i, j; \
+    uint64_t k, lo, hi, n; \
+    bool exact; \
+    uint64_t rf[TEST_RANGE_FILTER_WORDS]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        uint64_t blkpos = test_data_##O##_##T[i].blkpos; \
+        n = build_range_filter_##O##_##T(mf.src, blklen, blkpos, nrows, TEST_RANGE_FILTER_STRIDE, TEST_RANGE_FILTER_LEVELS, 0, NULL); \
+        build_range_filter_##O##_##T(mf.src, blklen, blkpos, nrows, TEST_RANGE_FILTER_STRIDE, TEST_RANGE_FILTER_LEVELS, bloom_nblocks(n, TEST_BLOOM_BITS), rf); \
+        for (j=0 ; j < 4; j++) \
+        { \
+            lo = (uint64_t)test_data_##O##_##T[i].search; \
+            hi = lo + test_range_filter_width[j]; \
+            exact = false; \
+            for (k=0 ; k < nrows; k++) \
+            { \
+                uint64_t x = (uint64_t)bytes_##O##_to_##T(mf.src, get_address(blklen, blkpos, k)); \
+                exact |= ((x >= lo) && (x <= hi)); \
+            } \
+            if (exact && !range_maybe_nonempty(rf, lo, hi)) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Unexpected false negative for [%" PRIx64 ", %" PRIx64 "]\n", __func__, i, lo, hi); \
+                ++errors; \
+            } \
+        } \
+        if (range_maybe_nonempty(rf, 1, 0)) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected empty range\n", __func__, i); \
+            ++errors; \
+        } \
+        if ((rf[4] < UINT64_MAX) && range_maybe_nonempty(rf, (rf[4] + 1), UINT64_MAX)) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected empty range after the last key\n", __func__, i); \
+            ++errors; \
+        } \
+    } \
+    if ((build_range_filter_##O##_##T(mf.src, blklen, 0, nrows, TEST_RANGE_FILTER_STRIDE, 0, 1, rf) != 0) || !range_maybe_nonempty(rf, 0, UINT64_MAX)) \
+    { \
+        (void)fprintf_s(stderr, "%s Expected zero levels to be rejected\n", __func__); \
+        ++errors; \
+    } \
+    if ((build_range_filter_##O##_##T(mf.src, blklen, 0, nrows, 8, 9, 1, rf) != 0) || !range_maybe_nonempty(rf, 0, UINT64_MAX)) \
+    { \
+        (void)fprintf_s(stderr, "%s Expected a top level shift of 64 bits to be rejected\n", __func__); \
+        ++errors; \
+    } \
+    return errors; \
+}
+
+define_test_range_maybe_nonempty(be, uint8_t)
+define_test_range_maybe_nonempty(be, uint16_t)
+define_test_range_maybe_nonempty(be, uint32_t)
+define_test_range_maybe_nonempty(be, uint64_t)
+define_test_range_maybe_nonempty(le, uint8_t)
+define_test_range_maybe_nonempty(le, uint16_t)
+define_test_range_maybe_nonempty(le, uint32_t)
+define_test_range_maybe_nonempty(le, uint64_t)
+
+#define TEST_HASH_INDEX_WORDS 2056 // (HASH_INDEX_HEADER_WORDS + (hash_index_nslots(251) * HASH_INDEX_SLOT_WORDS))
+
+#define define_test_find_hash(O, T) \
+int test_find_hash_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, lfound, first, last, nkeys; \
+    uint64_t ht[TEST_HASH_INDEX_WORDS]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        nkeys = build_hash_index_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, nrows, 0, NULL); \
+        build_hash_index_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, nrows, hash_index_nslots(nkeys), ht); \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_first_hash(ht, first, last, (uint64_t)test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        lfound = find_last_hash(ht, first, last, (uint64_t)test_data_##O##_##T[i].search); \
+        if (lfound != test_data_##O##_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundLast, lfound); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_hash(be, uint8_t)
+define_test_find_hash(be, uint16_t)
+define_test_find_hash(be, uint32_t)
+define_test_find_hash(be, uint64_t)
+define_test_find_hash(le, uint8_t)
+define_test_find_hash(le, uint16_t)
+define_test_find_hash(le, uint32_t)
+define_test_find_hash(le, uint64_t)
+
+#define TEST_RUN_INDEX_KEYS 252 // (nrows + 1)
+
+#define define_test_find_range_runs(O, T) \
+int test_find_range_runs_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last, efirst, elast, nkeys; \
+    T keys[TEST_RUN_INDEX_KEYS]; \
+    uint64_t rows[TEST_RUN_INDEX_KEYS]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        nkeys = build_run_index_##O##_##T(mf.src, blklen, test_data_##O##_##T[i].blkpos, nrows, keys, rows); \
+        efirst = test_data_##O##_##T[i].foundFLast; \
+        elast = test_data_##O##_##T[i].foundFLast; \
+        if (test_data_##O##_##T[i].foundFirst != test_data_##O##_##T[i].last) \
+        { \
+            efirst = test_data_##O##_##T[i].foundFirst; \
+            elast = (test_data_##O##_##T[i].foundLast + 1); \
+        } \
+        first = test_data_##O##_##T[i].first; \
+        last = test_data_##O##_##T[i].last; \
+        ffound = find_range_runs_##T(keys, rows, nkeys, &first, &last, test_data_##O##_##T[i].search); \
+        if (ffound != test_data_##O##_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_##O##_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != efirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, efirst, first); \
+            ++errors; \
+        } \
+        if (last != elast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, elast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_find_range_runs(be, uint8_t)
+define_test_find_range_runs(be, uint16_t)
+define_test_find_range_runs(be, uint32_t)
+define_test_find_range_runs(be, uint64_t)
+define_test_find_range_runs(le, uint8_t)
+define_test_find_range_runs(le, uint16_t)
+define_test_find_range_runs(le, uint32_t)
+define_test_find_range_runs(le, uint64_t)
+
+int test_save_fence(mmfile_t mf, uint64_t blklen, uint64_t nrows)
+{
+    int errors = 0;
+    int i;
+    const char *file = "test_fence.bin"; // sidecar file created by the test
+    uint64_t ffound, lfound, first, last;
+    mmfile_t smf = {0};
+    if (build_fence_be_uint64_t(mf.src, blklen, 0, nrows, TEST_FENCE_STEP, NULL) != TEST_FENCES)
+    {
+        (void)fprintf_s(stderr, "%s Expected %d fences to be counted\n", __func__, TEST_FENCES);
+        ++errors;
+    }
+    if (build_fence_be_uint64_t(mf.src, blklen, 0, nrows, 0, NULL) != 0)
+    {
+        (void)fprintf_s(stderr, "%s Expected no fences with a zero step\n", __func__);
+        ++errors;
+    }
+    if (save_fence_be_uint64_t(file, mf.src, blklen, 0, nrows, 0) != -1)
+    {
+        (void)fprintf_s(stderr, "%s Expected a zero step to be rejected\n", __func__);
+        ++errors;
+    }
+    for (i=0 ; i < TEST_DATA_SIZE; i++)
+    {
+        if (save_fence_be_uint64_t(file, mf.src, blklen, test_data_be_uint64_t[i].blkpos, nrows, TEST_FENCE_STEP) != 0)
+        {
+            (void)fprintf_s(stderr, "%s can't create %s [%s]\n", __func__, file, strerror(errno));
+            (void)unlink(file);
+            return 1;
+        }
+        mmap_binfile(file, &smf);
+        if ((smf.fd < 0) || (smf.src == MAP_FAILED))
+        {
+            (void)fprintf_s(stderr, "%s can't open %s for reading\n", __func__, file);
+            (void)unlink(file);
+            return 1;
+        }
+        if ((smf.nrows != TEST_FENCES) || (smf.ncols != 1) || (smf.ctbytes[0] != 8))
+        {
+            (void)fprintf_s(stderr, "%s Unexpected sidecar format: %" PRIu64 " rows, %" PRIu8 " columns\n", __func__, smf.nrows, smf.ncols);
+            (void)munmap_binfile(smf);
+            (void)unlink(file);
+            return 1;
+        }
+        const uint64_t *fence = (const uint64_t *)(smf.src + smf.index[0]);
+        first = test_data_be_uint64_t[i].first;
+        last = test_data_be_uint64_t[i].last;
+        ffound = find_first_fence_be_uint64_t(mf.src, blklen, test_data_be_uint64_t[i].blkpos, fence, smf.nrows, TEST_FENCE_STEP, &first, &last, test_data_be_uint64_t[i].search);
+        if (ffound != test_data_be_uint64_t[i].foundFirst)
+        {
+            (void)fprintf_s(stderr, "%s (%d) Expected first found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_be_uint64_t[i].foundFirst, ffound);
+            ++errors;
+        }
+        first = test_data_be_uint64_t[i].first;
+        last = test_data_be_uint64_t[i].last;
+        lfound = find_last_fence_be_uint64_t(mf.src, blklen, test_data_be_uint64_t[i].blkpos, fence, smf.nrows, TEST_FENCE_STEP, &first, &last, test_data_be_uint64_t[i].search);
+        if (lfound != test_data_be_uint64_t[i].foundLast)
+        {
+            (void)fprintf_s(stderr, "%s (%d) Expected last found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_data_be_uint64_t[i].foundLast, lfound);
+            ++errors;
+        }
+        int e = munmap_binfile(smf);
+        if (e != 0)
+        {
+            (void)fprintf_s(stderr, "%s Got %d error while unmapping the file\n", __func__, e);
+            errors++;
+        }
+    }
+    (void)unlink(file);
+    return errors;
 }
 
+
 #define define_benchmark_find_first(O, T) \
 void benchmark_find_first_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
 { \
@@ -1105,6 +2420,64 @@ define_benchmark_find_last_sub(le, uint16_t)
 define_benchmark_find_last_sub(le, uint32_t)
 define_benchmark_find_last_sub(le, uint64_t)
 
+#define define_benchmark_find_first_branchless(O, T) \
+void benchmark_find_first_branchless_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
+{ \
+    uint64_t tstart, tend; \
+    uint64_t first = 0; \
+    uint64_t last = nrows; \
+    uint64_t found; \
+    int i; \
+    int size = 10000; \
+    tstart = get_time(); \
+    for (i=0 ; i < size; i++) \
+    { \
+        first = 0; \
+        last = nrows; \
+        found = find_first_branchless_##O##_##T(mf.src, blklen, test_data_##O##_##T[4].blkpos, &first, &last, test_data_##O##_##T[4].search); \
+    } \
+    tend = get_time(); \
+    (void)fprintf_s(stdout, " * %s : %lu ns/op (%" PRIx64 ")\n", __func__, (tend - tstart)/(uint64_t)(size*4), found); \
+}
+
+define_benchmark_find_first_branchless(be, uint8_t)
+define_benchmark_find_first_branchless(be, uint16_t)
+define_benchmark_find_first_branchless(be, uint32_t)
+define_benchmark_find_first_branchless(be, uint64_t)
+define_benchmark_find_first_branchless(le, uint8_t)
+define_benchmark_find_first_branchless(le, uint16_t)
+define_benchmark_find_first_branchless(le, uint32_t)
+define_benchmark_find_first_branchless(le, uint64_t)
+
+#define define_benchmark_find_last_branchless(O, T) \
+void benchmark_find_last_branchless_##O##_##T(mmfile_t mf, uint64_t blklen, uint64_t nrows) \
+{ \
+    uint64_t tstart, tend; \
+    uint64_t first = 0; \
+    uint64_t last = nrows; \
+    uint64_t found; \
+    int i; \
+    int size = 10000; \
+    tstart = get_time(); \
+    for (i=0 ; i < size; i++) \
+    { \
+        first = 0; \
+        last = nrows; \
+        found = find_last_branchless_##O##_##T(mf.src, blklen, test_data_##O##_##T[4].blkpos, &first, &last, test_data_##O##_##T[4].search); \
+    } \
+    tend = get_time(); \
+    (void)fprintf_s(stdout, " * %s : %lu ns/op (%" PRIx64 ")\n", __func__, (tend - tstart)/(uint64_t)(size*4), found); \
+}
+
+define_benchmark_find_last_branchless(be, uint8_t)
+define_benchmark_find_last_branchless(be, uint16_t)
+define_benchmark_find_last_branchless(be, uint32_t)
+define_benchmark_find_last_branchless(be, uint64_t)
+define_benchmark_find_last_branchless(le, uint8_t)
+define_benchmark_find_last_branchless(le, uint16_t)
+define_benchmark_find_last_branchless(le, uint32_t)
+define_benchmark_find_last_branchless(le, uint64_t)
+
 int main()
 {
     int errors = 0;
@@ -1168,6 +2541,231 @@ int main()
     errors += test_find_first_le_uint64_t(mf, blklen);
     errors += test_find_last_le_uint64_t(mf, blklen);
 
+    errors += test_find_first_branchless_be_uint8_t(mf, blklen);
+    errors += test_find_last_branchless_be_uint8_t(mf, blklen);
+    errors += test_find_first_branchless_be_uint16_t(mf, blklen);
+    errors += test_find_last_branchless_be_uint16_t(mf, blklen);
+    errors += test_find_first_branchless_be_uint32_t(mf, blklen);
+    errors += test_find_last_branchless_be_uint32_t(mf, blklen);
+    errors += test_find_first_branchless_be_uint64_t(mf, blklen);
+    errors += test_find_last_branchless_be_uint64_t(mf, blklen);
+
+    errors += test_find_first_branchless_le_uint8_t(mf, blklen);
+    errors += test_find_last_branchless_le_uint8_t(mf, blklen);
+    errors += test_find_first_branchless_le_uint16_t(mf, blklen);
+    errors += test_find_last_branchless_le_uint16_t(mf, blklen);
+    errors += test_find_first_branchless_le_uint32_t(mf, blklen);
+    errors += test_find_last_branchless_le_uint32_t(mf, blklen);
+    errors += test_find_first_branchless_le_uint64_t(mf, blklen);
+    errors += test_find_last_branchless_le_uint64_t(mf, blklen);
+
+    errors += test_find_first_batch_be_uint8_t(mf, blklen);
+    errors += test_find_last_batch_be_uint8_t(mf, blklen);
+    errors += test_find_first_batch_be_uint16_t(mf, blklen);
+    errors += test_find_last_batch_be_uint16_t(mf, blklen);
+    errors += test_find_first_batch_be_uint32_t(mf, blklen);
+    errors += test_find_last_batch_be_uint32_t(mf, blklen);
+    errors += test_find_first_batch_be_uint64_t(mf, blklen);
+    errors += test_find_last_batch_be_uint64_t(mf, blklen);
+
+    errors += test_find_first_batch_le_uint8_t(mf, blklen);
+    errors += test_find_last_batch_le_uint8_t(mf, blklen);
+    errors += test_find_first_batch_le_uint16_t(mf, blklen);
+    errors += test_find_last_batch_le_uint16_t(mf, blklen);
+    errors += test_find_first_batch_le_uint32_t(mf, blklen);
+    errors += test_find_last_batch_le_uint32_t(mf, blklen);
+    errors += test_find_first_batch_le_uint64_t(mf, blklen);
+    errors += test_find_last_batch_le_uint64_t(mf, blklen);
+
+    errors += test_find_sorted_batch_be_uint8_t(mf, blklen);
+    errors += test_find_sorted_batch_be_uint16_t(mf, blklen);
+    errors += test_find_sorted_batch_be_uint32_t(mf, blklen);
+    errors += test_find_sorted_batch_be_uint64_t(mf, blklen);
+
+    errors += test_find_sorted_batch_le_uint8_t(mf, blklen);
+    errors += test_find_sorted_batch_le_uint16_t(mf, blklen);
+    errors += test_find_sorted_batch_le_uint32_t(mf, blklen);
+    errors += test_find_sorted_batch_le_uint64_t(mf, blklen);
+
+    errors += test_find_first_interp_be_uint8_t(mf, blklen);
+    errors += test_find_last_interp_be_uint8_t(mf, blklen);
+    errors += test_find_first_interp_be_uint16_t(mf, blklen);
+    errors += test_find_last_interp_be_uint16_t(mf, blklen);
+    errors += test_find_first_interp_be_uint32_t(mf, blklen);
+    errors += test_find_last_interp_be_uint32_t(mf, blklen);
+    errors += test_find_first_interp_be_uint64_t(mf, blklen);
+    errors += test_find_last_interp_be_uint64_t(mf, blklen);
+    errors += test_find_first_interp_seq_be_uint8_t(mf, blklen);
+    errors += test_find_last_interp_seq_be_uint8_t(mf, blklen);
+    errors += test_find_first_interp_seq_be_uint16_t(mf, blklen);
+    errors += test_find_last_interp_seq_be_uint16_t(mf, blklen);
+    errors += test_find_first_interp_seq_be_uint32_t(mf, blklen);
+    errors += test_find_last_interp_seq_be_uint32_t(mf, blklen);
+    errors += test_find_first_interp_seq_be_uint64_t(mf, blklen);
+    errors += test_find_last_interp_seq_be_uint64_t(mf, blklen);
+    errors += test_find_first_learned_be_uint8_t(mf, blklen, nrows);
+    errors += test_find_last_learned_be_uint8_t(mf, blklen, nrows);
+    errors += test_find_first_learned_be_uint16_t(mf, blklen, nrows);
+    errors += test_find_last_learned_be_uint16_t(mf, blklen, nrows);
+    errors += test_find_first_learned_be_uint32_t(mf, blklen, nrows);
+    errors += test_find_last_learned_be_uint32_t(mf, blklen, nrows);
+    errors += test_find_first_learned_be_uint64_t(mf, blklen, nrows);
+    errors += test_find_last_learned_be_uint64_t(mf, blklen, nrows);
+    errors += test_find_first_from_hint_be_uint8_t(mf, blklen);
+    errors += test_find_last_from_hint_be_uint8_t(mf, blklen);
+    errors += test_find_first_from_hint_be_uint16_t(mf, blklen);
+    errors += test_find_last_from_hint_be_uint16_t(mf, blklen);
+    errors += test_find_first_from_hint_be_uint32_t(mf, blklen);
+    errors += test_find_last_from_hint_be_uint32_t(mf, blklen);
+    errors += test_find_first_from_hint_be_uint64_t(mf, blklen);
+    errors += test_find_last_from_hint_be_uint64_t(mf, blklen);
+    errors += test_find_range_be_uint8_t(mf, blklen);
+    errors += test_find_range_be_uint16_t(mf, blklen);
+    errors += test_find_range_be_uint32_t(mf, blklen);
+    errors += test_find_range_be_uint64_t(mf, blklen);
+    errors += test_find_first_fence_be_uint8_t(mf, blklen, nrows);
+    errors += test_find_last_fence_be_uint8_t(mf, blklen, nrows);
+    errors += test_find_first_fence_be_uint16_t(mf, blklen, nrows);
+    errors += test_find_last_fence_be_uint16_t(mf, blklen, nrows);
+    errors += test_find_first_fence_be_uint32_t(mf, blklen, nrows);
+    errors += test_find_last_fence_be_uint32_t(mf, blklen, nrows);
+    errors += test_find_first_fence_be_uint64_t(mf, blklen, nrows);
+    errors += test_find_last_fence_be_uint64_t(mf, blklen, nrows);
+    errors += test_find_first_cached_be_uint8_t(mf, blklen, nrows);
+    errors += test_find_last_cached_be_uint8_t(mf, blklen, nrows);
+    errors += test_find_first_cached_be_uint16_t(mf, blklen, nrows);
+    errors += test_find_last_cached_be_uint16_t(mf, blklen, nrows);
+    errors += test_find_first_cached_be_uint32_t(mf, blklen, nrows);
+    errors += test_find_last_cached_be_uint32_t(mf, blklen, nrows);
+    errors += test_find_first_cached_be_uint64_t(mf, blklen, nrows);
+    errors += test_find_last_cached_be_uint64_t(mf, blklen, nrows);
+    errors += test_find_first_filtered_be_uint8_t(mf, blklen, nrows);
+    errors += test_find_last_filtered_be_uint8_t(mf, blklen, nrows);
+    errors += test_find_first_filtered_be_uint16_t(mf, blklen, nrows);
+    errors += test_find_last_filtered_be_uint16_t(mf, blklen, nrows);
+    errors += test_find_first_filtered_be_uint32_t(mf, blklen, nrows);
+    errors += test_find_last_filtered_be_uint32_t(mf, blklen, nrows);
+    errors += test_find_first_filtered_be_uint64_t(mf, blklen, nrows);
+    errors += test_find_last_filtered_be_uint64_t(mf, blklen, nrows);
+    errors += test_range_maybe_nonempty_be_uint8_t(mf, blklen, nrows);
+    errors += test_range_maybe_nonempty_be_uint16_t(mf, blklen, nrows);
+    errors += test_range_maybe_nonempty_be_uint32_t(mf, blklen, nrows);
+    errors += test_range_maybe_nonempty_be_uint64_t(mf, blklen, nrows);
+    errors += test_find_hash_be_uint8_t(mf, blklen, nrows);
+    errors += test_find_hash_be_uint16_t(mf, blklen, nrows);
+    errors += test_find_hash_be_uint32_t(mf, blklen, nrows);
+    errors += test_find_hash_be_uint64_t(mf, blklen, nrows);
+    errors += test_find_range_runs_be_uint8_t(mf, blklen, nrows);
+    errors += test_find_range_runs_be_uint16_t(mf, blklen, nrows);
+    errors += test_find_range_runs_be_uint32_t(mf, blklen, nrows);
+    errors += test_find_range_runs_be_uint64_t(mf, blklen, nrows);
+    errors += test_find_first_hybrid_be_uint8_t(mf, blklen);
+    errors += test_find_last_hybrid_be_uint8_t(mf, blklen);
+    errors += test_find_first_hybrid_be_uint16_t(mf, blklen);
+    errors += test_find_last_hybrid_be_uint16_t(mf, blklen);
+    errors += test_find_first_hybrid_be_uint32_t(mf, blklen);
+    errors += test_find_last_hybrid_be_uint32_t(mf, blklen);
+    errors += test_find_first_hybrid_be_uint64_t(mf, blklen);
+    errors += test_find_last_hybrid_be_uint64_t(mf, blklen);
+    errors += test_scan_equal_run_be_uint8_t(mf, blklen);
+    errors += test_scan_equal_run_be_uint16_t(mf, blklen);
+    errors += test_scan_equal_run_be_uint32_t(mf, blklen);
+    errors += test_scan_equal_run_be_uint64_t(mf, blklen);
+    errors += test_gather_be_uint8_t(mf, blklen);
+    errors += test_gather_be_uint16_t(mf, blklen);
+    errors += test_gather_be_uint32_t(mf, blklen);
+    errors += test_gather_be_uint64_t(mf, blklen);
+
+    errors += test_find_first_interp_le_uint8_t(mf, blklen);
+    errors += test_find_last_interp_le_uint8_t(mf, blklen);
+    errors += test_find_first_interp_le_uint16_t(mf, blklen);
+    errors += test_find_last_interp_le_uint16_t(mf, blklen);
+    errors += test_find_first_interp_le_uint32_t(mf, blklen);
+    errors += test_find_last_interp_le_uint32_t(mf, blklen);
+    errors += test_find_first_interp_le_uint64_t(mf, blklen);
+    errors += test_find_last_interp_le_uint64_t(mf, blklen);
+    errors += test_find_first_interp_seq_le_uint8_t(mf, blklen);
+    errors += test_find_last_interp_seq_le_uint8_t(mf, blklen);
+    errors += test_find_first_interp_seq_le_uint16_t(mf, blklen);
+    errors += test_find_last_interp_seq_le_uint16_t(mf, blklen);
+    errors += test_find_first_interp_seq_le_uint32_t(mf, blklen);
+    errors += test_find_last_interp_seq_le_uint32_t(mf, blklen);
+    errors += test_find_first_interp_seq_le_uint64_t(mf, blklen);
+    errors += test_find_last_interp_seq_le_uint64_t(mf, blklen);
+    errors += test_find_first_learned_le_uint8_t(mf, blklen, nrows);
+    errors += test_find_last_learned_le_uint8_t(mf, blklen, nrows);
+    errors += test_find_first_learned_le_uint16_t(mf, blklen, nrows);
+    errors += test_find_last_learned_le_uint16_t(mf, blklen, nrows);
+    errors += test_find_first_learned_le_uint32_t(mf, blklen, nrows);
+    errors += test_find_last_learned_le_uint32_t(mf, blklen, nrows);
+    errors += test_find_first_learned_le_uint64_t(mf, blklen, nrows);
+    errors += test_find_last_learned_le_uint64_t(mf, blklen, nrows);
+    errors += test_find_first_from_hint_le_uint8_t(mf, blklen);
+    errors += test_find_last_from_hint_le_uint8_t(mf, blklen);
+    errors += test_find_first_from_hint_le_uint16_t(mf, blklen);
+    errors += test_find_last_from_hint_le_uint16_t(mf, blklen);
+    errors += test_find_first_from_hint_le_uint32_t(mf, blklen);
+    errors += test_find_last_from_hint_le_uint32_t(mf, blklen);
+    errors += test_find_first_from_hint_le_uint64_t(mf, blklen);
+    errors += test_find_last_from_hint_le_uint64_t(mf, blklen);
+    errors += test_find_range_le_uint8_t(mf, blklen);
+    errors += test_find_range_le_uint16_t(mf, blklen);
+    errors += test_find_range_le_uint32_t(mf, blklen);
+    errors += test_find_range_le_uint64_t(mf, blklen);
+    errors += test_find_first_fence_le_uint8_t(mf, blklen, nrows);
+    errors += test_find_last_fence_le_uint8_t(mf, blklen, nrows);
+    errors += test_find_first_fence_le_uint16_t(mf, blklen, nrows);
+    errors += test_find_last_fence_le_uint16_t(mf, blklen, nrows);
+    errors += test_find_first_fence_le_uint32_t(mf, blklen, nrows);
+    errors += test_find_last_fence_le_uint32_t(mf, blklen, nrows);
+    errors += test_find_first_fence_le_uint64_t(mf, blklen, nrows);
+    errors += test_find_last_fence_le_uint64_t(mf, blklen, nrows);
+    errors += test_find_first_cached_le_uint8_t(mf, blklen, nrows);
+    errors += test_find_last_cached_le_uint8_t(mf, blklen, nrows);
+    errors += test_find_first_cached_le_uint16_t(mf, blklen, nrows);
+    errors += test_find_last_cached_le_uint16_t(mf, blklen, nrows);
+    errors += test_find_first_cached_le_uint32_t(mf, blklen, nrows);
+    errors += test_find_last_cached_le_uint32_t(mf, blklen, nrows);
+    errors += test_find_first_cached_le_uint64_t(mf, blklen, nrows);
+    errors += test_find_last_cached_le_uint64_t(mf, blklen, nrows);
+    errors += test_find_first_filtered_le_uint8_t(mf, blklen, nrows);
+    errors += test_find_last_filtered_le_uint8_t(mf, blklen, nrows);
+    errors += test_find_first_filtered_le_uint16_t(mf, blklen, nrows);
+    errors += test_find_last_filtered_le_uint16_t(mf, blklen, nrows);
+    errors += test_find_first_filtered_le_uint32_t(mf, blklen, nrows);
+    errors += test_find_last_filtered_le_uint32_t(mf, blklen, nrows);
+    errors += test_find_first_filtered_le_uint64_t(mf, blklen, nrows);
+    errors += test_find_last_filtered_le_uint64_t(mf, blklen, nrows);
+    errors += test_range_maybe_nonempty_le_uint8_t(mf, blklen, nrows);
+    errors += test_range_maybe_nonempty_le_uint16_t(mf, blklen, nrows);
+    errors += test_range_maybe_nonempty_le_uint32_t(mf, blklen, nrows);
+    errors += test_range_maybe_nonempty_le_uint64_t(mf, blklen, nrows);
+    errors += test_find_hash_le_uint8_t(mf, blklen, nrows);
+    errors += test_find_hash_le_uint16_t(mf, blklen, nrows);
+    errors += test_find_hash_le_uint32_t(mf, blklen, nrows);
+    errors += test_find_hash_le_uint64_t(mf, blklen, nrows);
+    errors += test_find_range_runs_le_uint8_t(mf, blklen, nrows);
+    errors += test_find_range_runs_le_uint16_t(mf, blklen, nrows);
+    errors += test_find_range_runs_le_uint32_t(mf, blklen, nrows);
+    errors += test_find_range_runs_le_uint64_t(mf, blklen, nrows);
+    errors += test_find_first_hybrid_le_uint8_t(mf, blklen);
+    errors += test_find_last_hybrid_le_uint8_t(mf, blklen);
+    errors += test_find_first_hybrid_le_uint16_t(mf, blklen);
+    errors += test_find_last_hybrid_le_uint16_t(mf, blklen);
+    errors += test_find_first_hybrid_le_uint32_t(mf, blklen);
+    errors += test_find_last_hybrid_le_uint32_t(mf, blklen);
+    errors += test_find_first_hybrid_le_uint64_t(mf, blklen);
+    errors += test_find_last_hybrid_le_uint64_t(mf, blklen);
+    errors += test_scan_equal_run_le_uint8_t(mf, blklen);
+    errors += test_scan_equal_run_le_uint16_t(mf, blklen);
+    errors += test_scan_equal_run_le_uint32_t(mf, blklen);
+    errors += test_scan_equal_run_le_uint64_t(mf, blklen);
+    errors += test_gather_le_uint8_t(mf, blklen);
+    errors += test_gather_le_uint16_t(mf, blklen);
+    errors += test_gather_le_uint32_t(mf, blklen);
+    errors += test_gather_le_uint64_t(mf, blklen);
+    errors += test_save_fence(mf, blklen, nrows);
+
     benchmark_find_first_be_uint8_t(mf, blklen, nrows);
     benchmark_find_last_be_uint8_t(mf, blklen, nrows);
     benchmark_find_first_be_uint16_t(mf, blklen, nrows);
@@ -1204,6 +2802,24 @@ int main()
     benchmark_find_first_sub_le_uint64_t(mf, blklen, nrows);
     benchmark_find_last_sub_le_uint64_t(mf, blklen, nrows);
 
+    benchmark_find_first_branchless_be_uint8_t(mf, blklen, nrows);
+    benchmark_find_last_branchless_be_uint8_t(mf, blklen, nrows);
+    benchmark_find_first_branchless_be_uint16_t(mf, blklen, nrows);
+    benchmark_find_last_branchless_be_uint16_t(mf, blklen, nrows);
+    benchmark_find_first_branchless_be_uint32_t(mf, blklen, nrows);
+    benchmark_find_last_branchless_be_uint32_t(mf, blklen, nrows);
+    benchmark_find_first_branchless_be_uint64_t(mf, blklen, nrows);
+    benchmark_find_last_branchless_be_uint64_t(mf, blklen, nrows);
+
+    benchmark_find_first_branchless_le_uint8_t(mf, blklen, nrows);
+    benchmark_find_last_branchless_le_uint8_t(mf, blklen, nrows);
+    benchmark_find_first_branchless_le_uint16_t(mf, blklen, nrows);
+    benchmark_find_last_branchless_le_uint16_t(mf, blklen, nrows);
+    benchmark_find_first_branchless_le_uint32_t(mf, blklen, nrows);
+    benchmark_find_last_branchless_le_uint32_t(mf, blklen, nrows);
+    benchmark_find_first_branchless_le_uint64_t(mf, blklen, nrows);
+    benchmark_find_last_branchless_le_uint64_t(mf, blklen, nrows);
+
     int e = munmap_binfile(mf);
     if (e != 0)
     {
@@ -22,6 +22,7 @@
 #include <string.h>
 #include <time.h>
 #include <errno.h>
+#include <unistd.h>
 #include <sys/mman.h>
 #include "../src/binsearch/binsearch.h"
 
@@ -601,6 +602,1780 @@ define_test_col_find_last(uint16_t)
 define_test_col_find_last(uint32_t)
 define_test_col_find_last(uint64_t)
 
+#define define_test_col_find_first_branchless(T) \
+int test_col_find_first_branchless_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint8_t nbytes = (uint8_t)sizeof(T); \
+    uint8_t bitstart = ((nbytes >> 2) * 8); \
+    uint8_t bitend = ((8 * nbytes) - 1 - bitstart); \
+    uint64_t ffound, lfound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_first_branchless_##T(src, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+        first = test_col_data_sub_##T[i].first; \
+        last = test_col_data_sub_##T[i].last; \
+        lfound = col_find_first_sub_branchless_##T(src, bitstart, bitend, &first, &last, test_col_data_sub_##T[i].search); \
+        if (lfound != test_col_data_sub_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_sub_##T[i].foundFirst, lfound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_sub_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_sub_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_sub_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_sub_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_first_branchless(uint8_t)
+define_test_col_find_first_branchless(uint16_t)
+define_test_col_find_first_branchless(uint32_t)
+define_test_col_find_first_branchless(uint64_t)
+
+#define define_test_col_find_last_branchless(T) \
+int test_col_find_last_branchless_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint8_t nbytes = (uint8_t)sizeof(T); \
+    uint8_t bitstart = ((nbytes >> 2) * 8); \
+    uint8_t bitend = ((8 * nbytes) - 1 - bitstart); \
+    uint64_t ffound, lfound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_last_branchless_##T(src, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+        first = test_col_data_sub_##T[i].first; \
+        last = test_col_data_sub_##T[i].last; \
+        lfound = col_find_last_sub_branchless_##T(src, bitstart, bitend, &first, &last, test_col_data_sub_##T[i].search); \
+        if (lfound != test_col_data_sub_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_sub_##T[i].foundLast, lfound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_sub_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_sub_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_sub_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_sub_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_last_branchless(uint8_t)
+define_test_col_find_last_branchless(uint16_t)
+define_test_col_find_last_branchless(uint32_t)
+define_test_col_find_last_branchless(uint64_t)
+
+#define define_test_col_find_first_batch(T) \
+int test_col_find_first_batch_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint8_t nbytes = (uint8_t)sizeof(T); \
+    uint8_t bitstart = ((nbytes >> 2) * 8); \
+    uint8_t bitend = ((8 * nbytes) - 1 - bitstart); \
+    T keys[TEST_DATA_SIZE], subkeys[TEST_DATA_SIZE]; \
+    uint64_t out[TEST_DATA_SIZE]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        keys[i] = test_col_data_##T[i].search; \
+        subkeys[i] = test_col_data_sub_##T[i].search; \
+    } \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        col_find_first_batch_##T(src, test_col_data_##T[i].first, test_col_data_##T[i].last, keys, TEST_DATA_SIZE, out); \
+        if (out[i] != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, out[i]); \
+            ++errors; \
+        } \
+        col_find_first_sub_batch_##T(src, bitstart, bitend, test_col_data_sub_##T[i].first, test_col_data_sub_##T[i].last, subkeys, TEST_DATA_SIZE, out); \
+        if (out[i] != test_col_data_sub_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_sub_##T[i].foundFirst, out[i]); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_first_batch(uint8_t)
+define_test_col_find_first_batch(uint16_t)
+define_test_col_find_first_batch(uint32_t)
+define_test_col_find_first_batch(uint64_t)
+
+#define define_test_col_find_last_batch(T) \
+int test_col_find_last_batch_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint8_t nbytes = (uint8_t)sizeof(T); \
+    uint8_t bitstart = ((nbytes >> 2) * 8); \
+    uint8_t bitend = ((8 * nbytes) - 1 - bitstart); \
+    T keys[TEST_DATA_SIZE], subkeys[TEST_DATA_SIZE]; \
+    uint64_t out[TEST_DATA_SIZE]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        keys[i] = test_col_data_##T[i].search; \
+        subkeys[i] = test_col_data_sub_##T[i].search; \
+    } \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        col_find_last_batch_##T(src, test_col_data_##T[i].first, test_col_data_##T[i].last, keys, TEST_DATA_SIZE, out); \
+        if (out[i] != test_col_data_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLast, out[i]); \
+            ++errors; \
+        } \
+        col_find_last_sub_batch_##T(src, bitstart, bitend, test_col_data_sub_##T[i].first, test_col_data_sub_##T[i].last, subkeys, TEST_DATA_SIZE, out); \
+        if (out[i] != test_col_data_sub_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_sub_##T[i].foundLast, out[i]); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_last_batch(uint8_t)
+define_test_col_find_last_batch(uint16_t)
+define_test_col_find_last_batch(uint32_t)
+define_test_col_find_last_batch(uint64_t)
+
+#define TEST_BATCH_BOUNDS_ITEMS 64
+
+// The batch searches must not read outside [first, last) when the keys are outside the
+// values range: the source is an exactly sized array so any overread is detectable.
+#define define_test_col_find_batch_bounds(T) \
+int test_col_find_batch_bounds_##T(void) \
+{ \
+    int errors = 0; \
+    uint64_t i; \
+    T src[TEST_BATCH_BOUNDS_ITEMS]; \
+    const T keys[4] = {0, 1, (T)(2 * TEST_BATCH_BOUNDS_ITEMS + 2), (T)(~(T)0)}; \
+    uint64_t out[4]; \
+    for (i = 0; i < TEST_BATCH_BOUNDS_ITEMS; i++) \
+    { \
+        src[i] = (T)(2 * (i + 1)); \
+    } \
+    col_find_first_batch_##T(src, 0, TEST_BATCH_BOUNDS_ITEMS, keys, 4, out); \
+    for (i = 0; i < 4; i++) \
+    { \
+        if (out[i] != TEST_BATCH_BOUNDS_ITEMS) \
+        { \
+            (void)fprintf_s(stderr, "%s FIRST (%" PRIu64 ") Expected %d, got %" PRIu64 "\n", __func__, i, TEST_BATCH_BOUNDS_ITEMS, out[i]); \
+            ++errors; \
+        } \
+    } \
+    col_find_last_batch_##T(src, 0, TEST_BATCH_BOUNDS_ITEMS, keys, 4, out); \
+    for (i = 0; i < 4; i++) \
+    { \
+        if (out[i] != TEST_BATCH_BOUNDS_ITEMS) \
+        { \
+            (void)fprintf_s(stderr, "%s LAST (%" PRIu64 ") Expected %d, got %" PRIu64 "\n", __func__, i, TEST_BATCH_BOUNDS_ITEMS, out[i]); \
+            ++errors; \
+        } \
+    } \
+    col_find_first_sub_batch_##T(src, 0, (uint8_t)(8 * sizeof(T) - 1), 0, TEST_BATCH_BOUNDS_ITEMS, keys, 4, out); \
+    for (i = 0; i < 4; i++) \
+    { \
+        if (out[i] != TEST_BATCH_BOUNDS_ITEMS) \
+        { \
+            (void)fprintf_s(stderr, "%s FIRST SUB (%" PRIu64 ") Expected %d, got %" PRIu64 "\n", __func__, i, TEST_BATCH_BOUNDS_ITEMS, out[i]); \
+            ++errors; \
+        } \
+    } \
+    col_find_last_sub_batch_##T(src, 0, (uint8_t)(8 * sizeof(T) - 1), 0, TEST_BATCH_BOUNDS_ITEMS, keys, 4, out); \
+    for (i = 0; i < 4; i++) \
+    { \
+        if (out[i] != TEST_BATCH_BOUNDS_ITEMS) \
+        { \
+            (void)fprintf_s(stderr, "%s LAST SUB (%" PRIu64 ") Expected %d, got %" PRIu64 "\n", __func__, i, TEST_BATCH_BOUNDS_ITEMS, out[i]); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_batch_bounds(uint8_t)
+define_test_col_find_batch_bounds(uint16_t)
+define_test_col_find_batch_bounds(uint32_t)
+define_test_col_find_batch_bounds(uint64_t)
+
+#define define_test_col_find_sorted_batch(T) \
+int test_col_find_sorted_batch_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i, j; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    T keys[TEST_DATA_SIZE], tmp; \
+    uint64_t ofirst[TEST_DATA_SIZE], olast[TEST_DATA_SIZE]; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        tmp = test_col_data_##T[i].search; \
+        for (j = i; (j > 0) && (keys[j - 1] > tmp); j--) \
+        { \
+            keys[j] = keys[j - 1]; \
+        } \
+        keys[j] = tmp; \
+    } \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        col_find_sorted_batch_##T(src, test_col_data_##T[i].first, test_col_data_##T[i].last, keys, TEST_DATA_SIZE, ofirst, olast); \
+        for (j=0 ; keys[j] != test_col_data_##T[i].search; j++) \
+        { \
+        } \
+        if (ofirst[j] != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ofirst[j]); \
+            ++errors; \
+        } \
+        if (olast[j] != test_col_data_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLast, olast[j]); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_sorted_batch(uint8_t)
+define_test_col_find_sorted_batch(uint16_t)
+define_test_col_find_sorted_batch(uint32_t)
+define_test_col_find_sorted_batch(uint64_t)
+
+#define define_test_col_find_first_interp(T) \
+int test_col_find_first_interp_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_first_interp_##T(src, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_first_interp(uint8_t)
+define_test_col_find_first_interp(uint16_t)
+define_test_col_find_first_interp(uint32_t)
+define_test_col_find_first_interp(uint64_t)
+
+#define define_test_col_find_last_interp(T) \
+int test_col_find_last_interp_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_last_interp_##T(src, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_last_interp(uint8_t)
+define_test_col_find_last_interp(uint16_t)
+define_test_col_find_last_interp(uint32_t)
+define_test_col_find_last_interp(uint64_t)
+
+#define define_test_col_find_first_interp_seq(T) \
+int test_col_find_first_interp_seq_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_first_interp_seq_##T(src, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_first_interp_seq(uint8_t)
+define_test_col_find_first_interp_seq(uint16_t)
+define_test_col_find_first_interp_seq(uint32_t)
+define_test_col_find_first_interp_seq(uint64_t)
+
+#define define_test_col_find_last_interp_seq(T) \
+int test_col_find_last_interp_seq_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_last_interp_seq_##T(src, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_last_interp_seq(uint8_t)
+define_test_col_find_last_interp_seq(uint16_t)
+define_test_col_find_last_interp_seq(uint32_t)
+define_test_col_find_last_interp_seq(uint64_t)
+
+#define define_test_col_find_first_kary(T) \
+int test_col_find_first_kary_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_first_kary_##T(src, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_first_kary(uint32_t)
+define_test_col_find_first_kary(uint64_t)
+
+#define define_test_col_find_last_kary(T) \
+int test_col_find_last_kary_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_last_kary_##T(src, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_last_kary(uint32_t)
+define_test_col_find_last_kary(uint64_t)
+
+#define define_test_col_find_first_eytzinger(T) \
+int test_col_find_first_eytzinger_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    T eyt[TEST_DATA_ITEMS + 1]; \
+    col_build_eytzinger_##T(src, TEST_DATA_ITEMS, eyt); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_first_eytzinger_##T(src, eyt, TEST_DATA_ITEMS, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_first_eytzinger(uint8_t)
+define_test_col_find_first_eytzinger(uint16_t)
+define_test_col_find_first_eytzinger(uint32_t)
+define_test_col_find_first_eytzinger(uint64_t)
+
+#define define_test_col_find_last_eytzinger(T) \
+int test_col_find_last_eytzinger_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    T eyt[TEST_DATA_ITEMS + 1]; \
+    col_build_eytzinger_##T(src, TEST_DATA_ITEMS, eyt); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_last_eytzinger_##T(src, eyt, TEST_DATA_ITEMS, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_last_eytzinger(uint8_t)
+define_test_col_find_last_eytzinger(uint16_t)
+define_test_col_find_last_eytzinger(uint32_t)
+define_test_col_find_last_eytzinger(uint64_t)
+
+#define define_test_col_find_first_from_hint(T) \
+int test_col_find_first_from_hint_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i, h; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        const uint64_t hints[] = {0, test_col_data_##T[i].first, ((test_col_data_##T[i].first + test_col_data_##T[i].last) / 2), test_col_data_##T[i].last, UINT64_MAX}; \
+        for (h=0 ; h < (int)(sizeof(hints) / sizeof(hints[0])); h++) \
+        { \
+            first = test_col_data_##T[i].first; \
+            last = test_col_data_##T[i].last; \
+            ffound = col_find_first_from_hint_##T(src, &first, &last, hints[h], test_col_data_##T[i].search); \
+            if (ffound != test_col_data_##T[i].foundFirst) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d:%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, h, test_col_data_##T[i].foundFirst, ffound); \
+                ++errors; \
+            } \
+            if (first != test_col_data_##T[i].foundFFirst) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d:%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, h, test_col_data_##T[i].foundFFirst, first); \
+                ++errors; \
+            } \
+            if (last != test_col_data_##T[i].foundFLast) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d:%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, h, test_col_data_##T[i].foundFLast, last); \
+                ++errors; \
+            } \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_first_from_hint(uint8_t)
+define_test_col_find_first_from_hint(uint16_t)
+define_test_col_find_first_from_hint(uint32_t)
+define_test_col_find_first_from_hint(uint64_t)
+
+#define define_test_col_find_last_from_hint(T) \
+int test_col_find_last_from_hint_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i, h; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        const uint64_t hints[] = {0, test_col_data_##T[i].first, ((test_col_data_##T[i].first + test_col_data_##T[i].last) / 2), test_col_data_##T[i].last, UINT64_MAX}; \
+        for (h=0 ; h < (int)(sizeof(hints) / sizeof(hints[0])); h++) \
+        { \
+            first = test_col_data_##T[i].first; \
+            last = test_col_data_##T[i].last; \
+            ffound = col_find_last_from_hint_##T(src, &first, &last, hints[h], test_col_data_##T[i].search); \
+            if (ffound != test_col_data_##T[i].foundLast) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d:%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, h, test_col_data_##T[i].foundLast, ffound); \
+                ++errors; \
+            } \
+            if (first != test_col_data_##T[i].foundLFirst) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d:%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, h, test_col_data_##T[i].foundLFirst, first); \
+                ++errors; \
+            } \
+            if (last != test_col_data_##T[i].foundLLast) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d:%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, h, test_col_data_##T[i].foundLLast, last); \
+                ++errors; \
+            } \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_last_from_hint(uint8_t)
+define_test_col_find_last_from_hint(uint16_t)
+define_test_col_find_last_from_hint(uint32_t)
+define_test_col_find_last_from_hint(uint64_t)
+
+#define define_test_col_find_range(T) \
+int test_col_find_range_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last, efirst, elast, count; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        efirst = test_col_data_##T[i].foundFLast; \
+        elast = test_col_data_##T[i].foundFLast; \
+        if (test_col_data_##T[i].foundFirst != test_col_data_##T[i].last) \
+        { \
+            efirst = test_col_data_##T[i].foundFirst; \
+            elast = (test_col_data_##T[i].foundLast + 1); \
+        } \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_range_##T(src, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != efirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, efirst, first); \
+            ++errors; \
+        } \
+        if (last != elast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, elast, last); \
+            ++errors; \
+        } \
+        count = col_count_##T(src, test_col_data_##T[i].first, test_col_data_##T[i].last, test_col_data_##T[i].search); \
+        if (count != (elast - efirst)) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected count %" PRIu64 ", got %" PRIu64 "\n", __func__, i, (elast - efirst), count); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_range(uint8_t)
+define_test_col_find_range(uint16_t)
+define_test_col_find_range(uint32_t)
+define_test_col_find_range(uint64_t)
+
+#define define_test_col_find_first_stree(T) \
+int test_col_find_first_stree_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    T tree[TEST_DATA_ITEMS] __attribute__((aligned(64))); \
+    col_build_stree_##T(src, TEST_DATA_ITEMS, tree); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_first_stree_##T(src, tree, TEST_DATA_ITEMS, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_first_stree(uint32_t)
+define_test_col_find_first_stree(uint64_t)
+
+#define define_test_col_find_last_stree(T) \
+int test_col_find_last_stree_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    T tree[TEST_DATA_ITEMS] __attribute__((aligned(64))); \
+    col_build_stree_##T(src, TEST_DATA_ITEMS, tree); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_last_stree_##T(src, tree, TEST_DATA_ITEMS, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_last_stree(uint32_t)
+define_test_col_find_last_stree(uint64_t)
+
+#define TEST_CACHE_LEVELS 4
+
+#define define_test_col_find_first_cached(T) \
+int test_col_find_first_cached_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    T cache[1 << TEST_CACHE_LEVELS] __attribute__((aligned(64))); \
+    col_build_toplevel_cache_##T(src, TEST_DATA_ITEMS, TEST_CACHE_LEVELS, cache); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_first_cached_##T(src, cache, TEST_CACHE_LEVELS, TEST_DATA_ITEMS, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_first_cached(uint8_t)
+define_test_col_find_first_cached(uint16_t)
+define_test_col_find_first_cached(uint32_t)
+define_test_col_find_first_cached(uint64_t)
+
+#define define_test_col_find_last_cached(T) \
+int test_col_find_last_cached_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    T cache[1 << TEST_CACHE_LEVELS] __attribute__((aligned(64))); \
+    col_build_toplevel_cache_##T(src, TEST_DATA_ITEMS, TEST_CACHE_LEVELS, cache); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_last_cached_##T(src, cache, TEST_CACHE_LEVELS, TEST_DATA_ITEMS, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_last_cached(uint8_t)
+define_test_col_find_last_cached(uint16_t)
+define_test_col_find_last_cached(uint32_t)
+define_test_col_find_last_cached(uint64_t)
+
+#define TEST_HYBRID_SCANS 4
+static const uint64_t test_hybrid_scan[TEST_HYBRID_SCANS] = {0, 7, 32, 1000};
+
+#define define_test_col_find_first_hybrid(T) \
+int test_col_find_first_hybrid_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    uint64_t s; \
+    for (s=0 ; s < TEST_HYBRID_SCANS; s++) \
+    { \
+        for (i=0 ; i < TEST_DATA_SIZE; i++) \
+        { \
+            first = test_col_data_##T[i].first; \
+            last = test_col_data_##T[i].last; \
+            ffound = col_find_first_hybrid_##T(src, test_hybrid_scan[s], &first, &last, test_col_data_##T[i].search); \
+            if (ffound != test_col_data_##T[i].foundFirst) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ffound); \
+                ++errors; \
+            } \
+            if (first != test_col_data_##T[i].foundFFirst) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFFirst, first); \
+                ++errors; \
+            } \
+            if (last != test_col_data_##T[i].foundFLast) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFLast, last); \
+                ++errors; \
+            } \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_first_hybrid(uint8_t)
+define_test_col_find_first_hybrid(uint16_t)
+define_test_col_find_first_hybrid(uint32_t)
+define_test_col_find_first_hybrid(uint64_t)
+
+#define define_test_col_find_last_hybrid(T) \
+int test_col_find_last_hybrid_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    uint64_t s; \
+    for (s=0 ; s < TEST_HYBRID_SCANS; s++) \
+    { \
+        for (i=0 ; i < TEST_DATA_SIZE; i++) \
+        { \
+            first = test_col_data_##T[i].first; \
+            last = test_col_data_##T[i].last; \
+            ffound = col_find_last_hybrid_##T(src, test_hybrid_scan[s], &first, &last, test_col_data_##T[i].search); \
+            if (ffound != test_col_data_##T[i].foundLast) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLast, ffound); \
+                ++errors; \
+            } \
+            if (first != test_col_data_##T[i].foundLFirst) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLFirst, first); \
+                ++errors; \
+            } \
+            if (last != test_col_data_##T[i].foundLLast) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLLast, last); \
+                ++errors; \
+            } \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_last_hybrid(uint8_t)
+define_test_col_find_last_hybrid(uint16_t)
+define_test_col_find_last_hybrid(uint32_t)
+define_test_col_find_last_hybrid(uint64_t)
+
+#define define_test_col_scan_equal_run(T) \
+int test_col_scan_equal_run_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint8_t nbytes = (uint8_t)sizeof(T); \
+    uint8_t bitstart = ((nbytes >> 2) * 8); \
+    uint8_t bitend = ((8 * nbytes) - 1 - bitstart); \
+    uint64_t numitems, run; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        if (test_col_data_##T[i].foundFirst < test_col_data_##T[i].last) \
+        { \
+            numitems = (test_col_data_##T[i].foundLast - test_col_data_##T[i].foundFirst + 1); \
+            run = col_scan_equal_run_##T(src, test_col_data_##T[i].foundFirst, test_col_data_##T[i].last, test_col_data_##T[i].search); \
+            if (run != numitems) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Expected %" PRIu64 ", got %" PRIu64 "\n", __func__, i, numitems, run); \
+                ++errors; \
+            } \
+        } \
+        if (test_col_data_sub_##T[i].foundFirst < test_col_data_sub_##T[i].last) \
+        { \
+            numitems = (test_col_data_sub_##T[i].foundLast - test_col_data_sub_##T[i].foundFirst + 1); \
+            run = col_scan_equal_run_sub_##T(src, bitstart, bitend, test_col_data_sub_##T[i].foundFirst, test_col_data_sub_##T[i].last, test_col_data_sub_##T[i].search); \
+            if (run != numitems) \
+            { \
+                (void)fprintf_s(stderr, "%s SUB (%d) Expected %" PRIu64 ", got %" PRIu64 "\n", __func__, i, numitems, run); \
+                ++errors; \
+            } \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_scan_equal_run(uint8_t)
+define_test_col_scan_equal_run(uint16_t)
+define_test_col_scan_equal_run(uint32_t)
+define_test_col_scan_equal_run(uint64_t)
+
+#define TEST_BLOOM_BITS 16
+#define TEST_BLOOM_WORDS 64 // (bloom_nblocks(TEST_DATA_ITEMS, TEST_BLOOM_BITS) * 8)
+
+#define define_test_col_find_first_filtered(T) \
+int test_col_find_first_filtered_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t nblocks = bloom_nblocks(TEST_DATA_ITEMS, TEST_BLOOM_BITS); \
+    uint64_t filter[TEST_BLOOM_WORDS]; \
+    col_build_bloom_##T(src, TEST_DATA_ITEMS, nblocks, filter); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_first_filtered_##T(src, filter, nblocks, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (test_col_data_##T[i].foundFirst == test_col_data_##T[i].last) \
+        { \
+            continue; /* first and last are not updated when the filter excludes the value */ \
+        } \
+        if (!maybe_contains(filter, nblocks, (uint64_t)test_col_data_##T[i].search)) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Unexpected false negative\n", __func__, i); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_first_filtered(uint8_t)
+define_test_col_find_first_filtered(uint16_t)
+define_test_col_find_first_filtered(uint32_t)
+define_test_col_find_first_filtered(uint64_t)
+
+#define define_test_col_find_last_filtered(T) \
+int test_col_find_last_filtered_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, first, last; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t nblocks = bloom_nblocks(TEST_DATA_ITEMS, TEST_BLOOM_BITS); \
+    uint64_t filter[TEST_BLOOM_WORDS]; \
+    col_build_bloom_##T(src, TEST_DATA_ITEMS, nblocks, filter); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_last_filtered_##T(src, filter, nblocks, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (test_col_data_##T[i].foundLast == test_col_data_##T[i].last) \
+        { \
+            continue; /* first and last are not updated when the filter excludes the value */ \
+        } \
+        if (!maybe_contains(filter, nblocks, (uint64_t)test_col_data_##T[i].search)) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Unexpected false negative\n", __func__, i); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_last_filtered(uint8_t)
+define_test_col_find_last_filtered(uint16_t)
+define_test_col_find_last_filtered(uint32_t)
+define_test_col_find_last_filtered(uint64_t)
+
+#define TEST_RANGE_FILTER_STRIDE 2
+#define TEST_RANGE_FILTER_LEVELS 4
+#define TEST_RANGE_FILTER_WORDS 264 // (RANGE_FILTER_HEADER_WORDS + (bloom_nblocks((TEST_DATA_ITEMS * TEST_RANGE_FILTER_LEVELS), TEST_BLOOM_BITS) * 8))
+
+static const uint64_t test_range_filter_width[] = {0, 1, 7, 100};
+
+#define define_test_col_range_maybe_nonempty(T) \
+int test_col_range_maybe_nonempty_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i, j; \
+    uint64_t k, lo, hi, n; \
+    bool exact; \
+    uint64_t rf[TEST_RANGE_FILTER_WORDS]; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    n = col_build_range_filter_##T(src, TEST_DATA_ITEMS, TEST_RANGE_FILTER_STRIDE, TEST_RANGE_FILTER_LEVELS, 0, NULL); \
+    col_build_range_filter_##T(src, TEST_DATA_ITEMS, TEST_RANGE_FILTER_STRIDE, TEST_RANGE_FILTER_LEVELS, bloom_nblocks(n, TEST_BLOOM_BITS), rf); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        for (j=0 ; j < 4; j++) \
+        { \
+            lo = (uint64_t)test_col_data_##T[i].search; \
+            hi = lo + test_range_filter_width[j]; \
+            exact = false; \
+            for (k=0 ; k < TEST_DATA_ITEMS; k++) \
+            { \
+                exact |= (((uint64_t)src[k] >= lo) && ((uint64_t)src[k] <= hi)); \
+            } \
+            if (exact && !range_maybe_nonempty(rf, lo, hi)) \
+            { \
+                (void)fprintf_s(stderr, "%s (%d) Unexpected false negative for [%" PRIx64 ", %" PRIx64 "]\n", __func__, i, lo, hi); \
+                ++errors; \
+            } \
+        } \
+        if (range_maybe_nonempty(rf, 1, 0)) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected empty range\n", __func__, i); \
+            ++errors; \
+        } \
+        if ((rf[4] < UINT64_MAX) && range_maybe_nonempty(rf, (rf[4] + 1), UINT64_MAX)) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected empty range after the last key\n", __func__, i); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_range_maybe_nonempty(uint8_t)
+define_test_col_range_maybe_nonempty(uint16_t)
+define_test_col_range_maybe_nonempty(uint32_t)
+define_test_col_range_maybe_nonempty(uint64_t)
+
+#define TEST_HASH_INDEX_WORDS 2056 // (HASH_INDEX_HEADER_WORDS + (hash_index_nslots(TEST_DATA_ITEMS) * HASH_INDEX_SLOT_WORDS))
+
+#define define_test_col_find_hash(T) \
+int test_col_find_hash_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, lfound, first, last, nkeys, rfirst, rlast; \
+    bool found; \
+    uint64_t ht[TEST_HASH_INDEX_WORDS]; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    nkeys = col_build_hash_index_##T(src, TEST_DATA_ITEMS, 0, NULL); \
+    if (col_build_hash_index_##T(src, TEST_DATA_ITEMS, 6, ht) != 0) \
+    { \
+        (void)fprintf_s(stderr, "%s Expected a non power of two number of slots to be rejected\n", __func__); \
+        ++errors; \
+    } \
+    if (col_build_hash_index_##T(src, TEST_DATA_ITEMS, (hash_index_nslots(nkeys) >> 1), ht) != 0) \
+    { \
+        (void)fprintf_s(stderr, "%s Expected too few slots to be rejected\n", __func__); \
+        ++errors; \
+    } \
+    if (find_first_hash(ht, 0, TEST_DATA_ITEMS, (uint64_t)src[0]) != TEST_DATA_ITEMS) \
+    { \
+        (void)fprintf_s(stderr, "%s Expected no keys in a rejected hash index\n", __func__); \
+        ++errors; \
+    } \
+    if (col_build_hash_index_##T(src, TEST_DATA_ITEMS, hash_index_nslots(nkeys), ht) != nkeys) \
+    { \
+        (void)fprintf_s(stderr, "%s Expected %" PRIu64 " keys\n", __func__, nkeys); \
+        ++errors; \
+    } \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = find_first_hash(ht, first, last, (uint64_t)test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        lfound = find_last_hash(ht, first, last, (uint64_t)test_col_data_##T[i].search); \
+        if (lfound != test_col_data_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLast, lfound); \
+            ++errors; \
+        } \
+        found = find_range_hash(ht, first, last, (uint64_t)test_col_data_##T[i].search, &rfirst, &rlast); \
+        if ((found != (ffound < last)) || (found && ((rfirst != ffound) || (rlast != (lfound + 1)))) || (!found && ((rfirst != last) || (rlast != last)))) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected range [%" PRIx64 ", %" PRIx64 "), got [%" PRIx64 ", %" PRIx64 ")\n", __func__, i, ffound, (lfound + 1), rfirst, rlast); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_hash(uint8_t)
+define_test_col_find_hash(uint16_t)
+define_test_col_find_hash(uint32_t)
+define_test_col_find_hash(uint64_t)
+
+#define define_test_col_find_range_runs(T) \
+int test_col_find_range_runs_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last, efirst, elast, nkeys; \
+    T keys[TEST_DATA_ITEMS + 1]; \
+    uint64_t rows[TEST_DATA_ITEMS + 1]; \
+    nkeys = col_build_run_index_##T(src, TEST_DATA_ITEMS, keys, rows); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        efirst = test_col_data_##T[i].foundFLast; \
+        elast = test_col_data_##T[i].foundFLast; \
+        if (test_col_data_##T[i].foundFirst != test_col_data_##T[i].last) \
+        { \
+            efirst = test_col_data_##T[i].foundFirst; \
+            elast = (test_col_data_##T[i].foundLast + 1); \
+        } \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = find_range_runs_##T(keys, rows, nkeys, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != efirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, efirst, first); \
+            ++errors; \
+        } \
+        if (last != elast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, elast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_range_runs(uint8_t)
+define_test_col_find_range_runs(uint16_t)
+define_test_col_find_range_runs(uint32_t)
+define_test_col_find_range_runs(uint64_t)
+
+#define TEST_CURSOR_BLOCK 3
+
+#define define_test_col_cursor(T) \
+int test_col_cursor_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint8_t nbytes = (uint8_t)sizeof(T); \
+    uint8_t bitstart = ((nbytes >> 2) * 8); \
+    uint8_t bitend = ((8 * nbytes) - 1 - bitstart); \
+    uint64_t numitems, count, n, k, j, start; \
+    uint64_t rows[TEST_CURSOR_BLOCK]; \
+    T values[TEST_CURSOR_BLOCK], lo, hi; \
+    col_cursor_t cur; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        numitems = 0; \
+        start = test_col_data_##T[i].foundFirst; \
+        if (start < test_col_data_##T[i].last) \
+        { \
+            numitems = (test_col_data_##T[i].foundLast - start + 1); \
+        } \
+        count = col_cursor_##T(src, test_col_data_##T[i].first, test_col_data_##T[i].last, test_col_data_##T[i].search, &cur); \
+        if (count != numitems) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected count %" PRIu64 ", got %" PRIu64 "\n", __func__, i, numitems, count); \
+            ++errors; \
+        } \
+        k = 0; \
+        while ((n = col_cursor_next_rows(&cur, rows, TEST_CURSOR_BLOCK)) > 0) \
+        { \
+            for (j = 0; j < n; j++, k++) \
+            { \
+                if (rows[j] != (start + k)) \
+                { \
+                    (void)fprintf_s(stderr, "%s (%d) Expected row %" PRIu64 ", got %" PRIu64 "\n", __func__, i, (start + k), rows[j]); \
+                    ++errors; \
+                } \
+            } \
+        } \
+        if (k != numitems) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected %" PRIu64 " rows, got %" PRIu64 "\n", __func__, i, numitems, k); \
+            ++errors; \
+        } \
+        numitems = 0; \
+        start = test_col_data_sub_##T[i].foundFirst; \
+        if (start < test_col_data_sub_##T[i].last) \
+        { \
+            numitems = (test_col_data_sub_##T[i].foundLast - start + 1); \
+        } \
+        count = col_cursor_sub_##T(src, bitstart, bitend, test_col_data_sub_##T[i].first, test_col_data_sub_##T[i].last, test_col_data_sub_##T[i].search, &cur); \
+        if (count != numitems) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected count %" PRIu64 ", got %" PRIu64 "\n", __func__, i, numitems, count); \
+            ++errors; \
+        } \
+        k = 0; \
+        while ((n = col_cursor_next_values_##T(&cur, values, TEST_CURSOR_BLOCK)) > 0) \
+        { \
+            for (j = 0; j < n; j++, k++) \
+            { \
+                if (values[j] != src[start + k]) \
+                { \
+                    (void)fprintf_s(stderr, "%s SUB (%d) Expected value %" PRIx64 ", got %" PRIx64 "\n", __func__, i, (uint64_t)src[start + k], (uint64_t)values[j]); \
+                    ++errors; \
+                } \
+            } \
+        } \
+        if (k != numitems) \
+        { \
+            (void)fprintf_s(stderr, "%s SUB (%d) Expected %" PRIu64 " values, got %" PRIu64 "\n", __func__, i, numitems, k); \
+            ++errors; \
+        } \
+        lo = test_col_data_##T[i].search; \
+        hi = (T)(lo + (T)(i * 17)); \
+        numitems = 0; \
+        start = test_col_data_##T[i].last; \
+        for (j = test_col_data_##T[i].last; j > test_col_data_##T[i].first; j--) \
+        { \
+            if ((src[j - 1] >= lo) && (src[j - 1] <= hi)) \
+            { \
+                start = (j - 1); \
+                ++numitems; \
+            } \
+        } \
+        count = col_cursor_range_##T(src, test_col_data_##T[i].first, test_col_data_##T[i].last, lo, hi, &cur); \
+        if (count != numitems) \
+        { \
+            (void)fprintf_s(stderr, "%s RANGE (%d) Expected count %" PRIu64 ", got %" PRIu64 "\n", __func__, i, numitems, count); \
+            ++errors; \
+        } \
+        k = 0; \
+        while ((n = col_cursor_next_values_##T(&cur, values, TEST_CURSOR_BLOCK)) > 0) \
+        { \
+            for (j = 0; j < n; j++, k++) \
+            { \
+                if (values[j] != src[start + k]) \
+                { \
+                    (void)fprintf_s(stderr, "%s RANGE (%d) Expected value %" PRIx64 ", got %" PRIx64 "\n", __func__, i, (uint64_t)src[start + k], (uint64_t)values[j]); \
+                    ++errors; \
+                } \
+            } \
+        } \
+        if (k != numitems) \
+        { \
+            (void)fprintf_s(stderr, "%s RANGE (%d) Expected %" PRIu64 " values, got %" PRIu64 "\n", __func__, i, numitems, k); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_cursor(uint8_t)
+define_test_col_cursor(uint16_t)
+define_test_col_cursor(uint32_t)
+define_test_col_cursor(uint64_t)
+
+#define define_test_col_gather(T) \
+int test_col_gather_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    uint64_t i; \
+    uint64_t rows[TEST_DATA_ITEMS]; \
+    T dst[TEST_DATA_ITEMS]; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    for (i = 0; i < TEST_DATA_ITEMS; i++) \
+    { \
+        rows[i] = ((i * 97) % TEST_DATA_ITEMS); \
+    } \
+    col_gather_rows_##T(src, rows, TEST_DATA_ITEMS, dst); \
+    for (i = 0; i < TEST_DATA_ITEMS; i++) \
+    { \
+        if (dst[i] != src[rows[i]]) \
+        { \
+            (void)fprintf_s(stderr, "%s ROWS (%" PRIu64 ") Expected %" PRIu64 ", got %" PRIu64 "\n", __func__, i, (uint64_t)src[rows[i]], (uint64_t)dst[i]); \
+            ++errors; \
+        } \
+    } \
+    col_gather_range_##T(src, 7, (TEST_DATA_ITEMS - 3), dst); \
+    for (i = 7; i < (TEST_DATA_ITEMS - 3); i++) \
+    { \
+        if (dst[(i - 7)] != src[i]) \
+        { \
+            (void)fprintf_s(stderr, "%s RANGE (%" PRIu64 ") Expected %" PRIu64 ", got %" PRIu64 "\n", __func__, i, (uint64_t)src[i], (uint64_t)dst[(i - 7)]); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_gather(uint8_t)
+define_test_col_gather(uint16_t)
+define_test_col_gather(uint32_t)
+define_test_col_gather(uint64_t)
+
+int test_col_gather(mmfile_t mf)
+{
+    int errors = 0;
+    uint64_t i;
+    const uint8_t cols[4] = {3, 0, 2, 1};
+    const uint8_t badcol[1] = {4};
+    uint64_t rows[TEST_DATA_ITEMS];
+    uint8_t d8[TEST_DATA_ITEMS];
+    uint16_t d16[TEST_DATA_ITEMS];
+    uint32_t d32[TEST_DATA_ITEMS];
+    uint64_t d64[TEST_DATA_ITEMS];
+    void *const dst[4] = {d64, d8, d32, d16};
+    const uint8_t *s8 = get_src_offset_uint8_t(mf.src, mf.index[0]);
+    const uint16_t *s16 = get_src_offset_uint16_t(mf.src, mf.index[1]);
+    const uint32_t *s32 = get_src_offset_uint32_t(mf.src, mf.index[2]);
+    const uint64_t *s64 = get_src_offset_uint64_t(mf.src, mf.index[3]);
+    for (i = 0; i < TEST_DATA_ITEMS; i++)
+    {
+        rows[i] = (TEST_DATA_ITEMS - 1 - i);
+    }
+    if (col_gather_rows(mf, cols, 4, rows, TEST_DATA_ITEMS, dst) != 0)
+    {
+        (void)fprintf_s(stderr, "%s ROWS Unexpected error\n", __func__);
+        return 1;
+    }
+    for (i = 0; i < TEST_DATA_ITEMS; i++)
+    {
+        if ((d8[i] != s8[rows[i]]) || (d16[i] != s16[rows[i]]) || (d32[i] != s32[rows[i]]) || (d64[i] != s64[rows[i]]))
+        {
+            (void)fprintf_s(stderr, "%s ROWS (%" PRIu64 ") Unexpected values\n", __func__, i);
+            ++errors;
+        }
+    }
+    if (col_gather_range(mf, cols, 4, 1, TEST_DATA_ITEMS, dst) != 0)
+    {
+        (void)fprintf_s(stderr, "%s RANGE Unexpected error\n", __func__);
+        return 1;
+    }
+    for (i = 1; i < TEST_DATA_ITEMS; i++)
+    {
+        if ((d8[(i - 1)] != s8[i]) || (d16[(i - 1)] != s16[i]) || (d32[(i - 1)] != s32[i]) || (d64[(i - 1)] != s64[i]))
+        {
+            (void)fprintf_s(stderr, "%s RANGE (%" PRIu64 ") Unexpected values\n", __func__, i);
+            ++errors;
+        }
+    }
+    if (col_gather_range(mf, cols, 4, 0, (TEST_DATA_ITEMS + 1), dst) == 0)
+    {
+        (void)fprintf_s(stderr, "%s Expected an error for a range past the last row\n", __func__);
+        ++errors;
+    }
+    if ((col_gather_range(mf, badcol, 1, 0, 1, dst) == 0) || (col_gather_rows(mf, badcol, 1, rows, 1, dst) == 0))
+    {
+        (void)fprintf_s(stderr, "%s Expected an error for an invalid column\n", __func__);
+        ++errors;
+    }
+    return errors;
+}
+
+#define TEST_LEARNED_EPS 2
+
+#define define_test_col_find_first_learned(T) \
+int test_col_find_first_learned_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    uint64_t kkeys[(2 * TEST_DATA_ITEMS) + 1], kpos[(2 * TEST_DATA_ITEMS) + 1]; \
+    uint64_t nknots = col_build_learned_##T(src, TEST_DATA_ITEMS, TEST_LEARNED_EPS, kkeys, kpos); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_first_learned_##T(src, kkeys, kpos, nknots, TEST_LEARNED_EPS, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundFFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundFLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundFLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_first_learned(uint8_t)
+define_test_col_find_first_learned(uint16_t)
+define_test_col_find_first_learned(uint32_t)
+define_test_col_find_first_learned(uint64_t)
+
+#define define_test_col_find_last_learned(T) \
+int test_col_find_last_learned_##T(mmfile_t mf) \
+{ \
+    int errors = 0; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    uint64_t ffound, first, last; \
+    uint64_t kkeys[(2 * TEST_DATA_ITEMS) + 1], kpos[(2 * TEST_DATA_ITEMS) + 1]; \
+    uint64_t nknots = col_build_learned_##T(src, TEST_DATA_ITEMS, TEST_LEARNED_EPS, kkeys, kpos); \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_##T[i].first; \
+        last = test_col_data_##T[i].last; \
+        ffound = col_find_last_learned_##T(src, kkeys, kpos, nknots, TEST_LEARNED_EPS, &first, &last, test_col_data_##T[i].search); \
+        if (ffound != test_col_data_##T[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLast, ffound); \
+            ++errors; \
+        } \
+        if (first != test_col_data_##T[i].foundLFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLFirst, first); \
+            ++errors; \
+        } \
+        if (last != test_col_data_##T[i].foundLLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_##T[i].foundLLast, last); \
+            ++errors; \
+        } \
+    } \
+    return errors; \
+}
+
+define_test_col_find_last_learned(uint8_t)
+define_test_col_find_last_learned(uint16_t)
+define_test_col_find_last_learned(uint32_t)
+define_test_col_find_last_learned(uint64_t)
+
+// Checks the content of a sidecar file (smf) built from the source file (mf), returns the number of errors.
+typedef int (*test_sidecar_check_t)(mmfile_t mf, mmfile_t smf);
+
+// Maps the sidecar file created by a save function, checks its format and content, then unmaps and removes it.
+// The sidecar must contain ncols uint64_t columns of nrows items (0 = any number of items).
+int test_sidecar(const char *func, const char *file, int saved, mmfile_t mf, uint8_t ncols, uint64_t nrows, test_sidecar_check_t check)
+{
+    int errors = 0;
+    uint8_t c;
+    if (saved != 0)
+    {
+        (void)fprintf_s(stderr, "%s can't create %s [%s]\n", func, file, strerror(errno));
+        (void)unlink(file);
+        return 1;
+    }
+    mmfile_t smf = {0};
+    mmap_binfile(file, &smf);
+    if ((smf.fd < 0) || (smf.src == MAP_FAILED))
+    {
+        (void)fprintf_s(stderr, "%s can't open %s for reading\n", func, file);
+        (void)unlink(file);
+        return 1;
+    }
+    bool valid = ((smf.nrows > 0) && ((nrows == 0) || (smf.nrows == nrows)) && (smf.ncols == ncols));
+    for (c = 0; valid && (c < ncols); c++)
+    {
+        valid = (smf.ctbytes[c] == 8);
+    }
+    if (!valid)
+    {
+        (void)fprintf_s(stderr, "%s Unexpected sidecar format: %" PRIu64 " rows, %" PRIu8 " columns\n", func, smf.nrows, smf.ncols);
+        ++errors;
+    }
+    else
+    {
+        errors += check(mf, smf);
+    }
+    int e = munmap_binfile(smf);
+    if (e != 0)
+    {
+        (void)fprintf_s(stderr, "%s Got %d error while unmapping the file\n", func, e);
+        errors++;
+    }
+    (void)unlink(file);
+    return errors;
+}
+
+// Compares the results of a pair of find_first/find_last functions with the test data of the uint64_t column.
+#define TEST_SIDECAR_FIND_BLOCK(FIND_FIRST, FIND_LAST) \
+    int errors = 0; \
+    int i; \
+    uint64_t ffound, lfound, first, last; \
+    for (i=0 ; i < TEST_DATA_SIZE; i++) \
+    { \
+        first = test_col_data_uint64_t[i].first; \
+        last = test_col_data_uint64_t[i].last; \
+        ffound = FIND_FIRST; \
+        if (ffound != test_col_data_uint64_t[i].foundFirst) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected first found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_uint64_t[i].foundFirst, ffound); \
+            ++errors; \
+        } \
+        first = test_col_data_uint64_t[i].first; \
+        last = test_col_data_uint64_t[i].last; \
+        lfound = FIND_LAST; \
+        if (lfound != test_col_data_uint64_t[i].foundLast) \
+        { \
+            (void)fprintf_s(stderr, "%s (%d) Expected last found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_uint64_t[i].foundLast, lfound); \
+            ++errors; \
+        } \
+    } \
+    return errors;
+
+int test_check_eytzinger(mmfile_t mf, mmfile_t smf)
+{
+    const uint64_t *src = get_src_offset_uint64_t(mf.src, mf.index[3]);
+    const uint64_t *eyt = get_src_offset_uint64_t(smf.src, smf.index[0]);
+    TEST_SIDECAR_FIND_BLOCK(col_find_first_eytzinger_uint64_t(src, eyt, TEST_DATA_ITEMS, &first, &last, test_col_data_uint64_t[i].search),
+                            col_find_last_eytzinger_uint64_t(src, eyt, TEST_DATA_ITEMS, &first, &last, test_col_data_uint64_t[i].search))
+}
+
+int test_save_eytzinger(mmfile_t mf)
+{
+    const char *file = "test_eytzinger.bin"; // sidecar file created by the test
+    return test_sidecar(__func__, file, save_eytzinger(file, mf, 3), mf, 1, (TEST_DATA_ITEMS + 1), test_check_eytzinger);
+}
+
+int test_check_learned(mmfile_t mf, mmfile_t smf)
+{
+    const uint64_t *src = get_src_offset_uint64_t(mf.src, mf.index[3]);
+    const uint64_t *kkeys = get_src_offset_uint64_t(smf.src, smf.index[0]);
+    const uint64_t *kpos = get_src_offset_uint64_t(smf.src, smf.index[1]);
+    TEST_SIDECAR_FIND_BLOCK(col_find_first_learned_uint64_t(src, kkeys, kpos, smf.nrows, TEST_LEARNED_EPS, &first, &last, test_col_data_uint64_t[i].search),
+                            col_find_last_learned_uint64_t(src, kkeys, kpos, smf.nrows, TEST_LEARNED_EPS, &first, &last, test_col_data_uint64_t[i].search))
+}
+
+int test_save_learned(mmfile_t mf)
+{
+    const char *file = "test_learned.bin"; // sidecar file created by the test
+    return test_sidecar(__func__, file, save_learned(file, mf, 3, TEST_LEARNED_EPS), mf, 2, 0, test_check_learned);
+}
+
+int test_check_stree(mmfile_t mf, mmfile_t smf)
+{
+    const uint64_t *src = get_src_offset_uint64_t(mf.src, mf.index[3]);
+    const uint64_t *tree = get_src_offset_uint64_t(smf.src, smf.index[0]);
+    TEST_SIDECAR_FIND_BLOCK(col_find_first_stree_uint64_t(src, tree, TEST_DATA_ITEMS, &first, &last, test_col_data_uint64_t[i].search),
+                            col_find_last_stree_uint64_t(src, tree, TEST_DATA_ITEMS, &first, &last, test_col_data_uint64_t[i].search))
+}
+
+int test_save_stree(mmfile_t mf)
+{
+    const char *file = "test_stree.bin"; // sidecar file created by the test
+    return test_sidecar(__func__, file, save_stree(file, mf, 3), mf, 1, stree_size_uint64_t(TEST_DATA_ITEMS), test_check_stree);
+}
+
+int test_check_bloom(mmfile_t mf, mmfile_t smf)
+{
+    int errors = 0;
+    int i;
+    const uint64_t *src = get_src_offset_uint64_t(mf.src, mf.index[3]);
+    const uint64_t *filter = get_src_offset_uint64_t(smf.src, smf.index[0]);
+    uint64_t nblocks = (smf.nrows / 8);
+    for (i=0 ; i < TEST_DATA_ITEMS; i++)
+    {
+        if (!maybe_contains(filter, nblocks, src[i]))
+        {
+            (void)fprintf_s(stderr, "%s (%d) Unexpected false negative for %" PRIx64 "\n", __func__, i, src[i]);
+            ++errors;
+        }
+    }
+    return errors;
+}
+
+int test_save_bloom(mmfile_t mf)
+{
+    const char *file = "test_bloom.bin"; // sidecar file created by the test
+    const uint64_t *src = get_src_offset_uint64_t(mf.src, mf.index[3]);
+    uint64_t nblocks = bloom_nblocks(col_count_distinct_uint64_t(src, TEST_DATA_ITEMS), TEST_BLOOM_BITS);
+    return test_sidecar(__func__, file, save_bloom(file, mf, 3, TEST_BLOOM_BITS), mf, 1, (nblocks * 8), test_check_bloom);
+}
+
+int test_check_range_filter(mmfile_t mf, mmfile_t smf)
+{
+    int errors = 0;
+    int i;
+    const uint64_t *src = get_src_offset_uint64_t(mf.src, mf.index[3]);
+    const uint64_t *rf = get_src_offset_uint64_t(smf.src, smf.index[0]);
+    if ((smf.nrows != (RANGE_FILTER_HEADER_WORDS + (rf[2] * 8))) || (rf[3] != src[0]) || (rf[4] != src[TEST_DATA_ITEMS - 1]))
+    {
+        (void)fprintf_s(stderr, "%s Unexpected range filter header\n", __func__);
+        return 1;
+    }
+    for (i=0 ; i < TEST_DATA_ITEMS; i++)
+    {
+        if (!range_maybe_nonempty(rf, src[i], src[i]))
+        {
+            (void)fprintf_s(stderr, "%s (%d) Unexpected false negative for %" PRIx64 "\n", __func__, i, src[i]);
+            ++errors;
+        }
+    }
+    return errors;
+}
+
+int test_save_range_filter(mmfile_t mf)
+{
+    const char *file = "test_range_filter.bin"; // sidecar file created by the test
+    return test_sidecar(__func__, file, save_range_filter(file, mf, 3, TEST_RANGE_FILTER_STRIDE, TEST_RANGE_FILTER_LEVELS, TEST_BLOOM_BITS), mf, 1, 0, test_check_range_filter);
+}
+
+int test_check_hash_index(mmfile_t mf, mmfile_t smf)
+{
+    int errors = 0;
+    int i;
+    const uint64_t *src = get_src_offset_uint64_t(mf.src, mf.index[3]);
+    const uint64_t *ht = get_src_offset_uint64_t(smf.src, smf.index[0]);
+    uint64_t first, last, kfirst, klast;
+    if ((smf.nrows != (HASH_INDEX_HEADER_WORDS + (ht[0] * HASH_INDEX_SLOT_WORDS))) || (ht[1] != TEST_DATA_ITEMS))
+    {
+        (void)fprintf_s(stderr, "%s Unexpected hash index header\n", __func__);
+        return 1;
+    }
+    for (i=0 ; i < TEST_DATA_ITEMS; i++)
+    {
+        first = 0;
+        last = TEST_DATA_ITEMS;
+        uint64_t ffound = col_find_first_uint64_t(src, &first, &last, src[i]);
+        first = 0;
+        last = TEST_DATA_ITEMS;
+        uint64_t lfound = col_find_last_uint64_t(src, &first, &last, src[i]);
+        if (!hash_index_lookup(ht, src[i], &kfirst, &klast) || (kfirst != ffound) || (klast != (lfound + 1)))
+        {
+            (void)fprintf_s(stderr, "%s (%d) Unexpected range for %" PRIx64 "\n", __func__, i, src[i]);
+            ++errors;
+        }
+    }
+    return errors;
+}
+
+int test_save_hash_index(mmfile_t mf)
+{
+    const char *file = "test_hash_index.bin"; // sidecar file created by the test
+    return test_sidecar(__func__, file, save_hash_index(file, mf, 3), mf, 1, 0, test_check_hash_index);
+}
+
+int test_check_run_index(mmfile_t mf, mmfile_t smf)
+{
+    int errors = 0;
+    int i;
+    const uint64_t *keys = get_src_offset_uint64_t(smf.src, smf.index[0]);
+    const uint64_t *rows = get_src_offset_uint64_t(smf.src, smf.index[1]);
+    uint64_t ffound, first, last;
+    (void)mf;
+    for (i=0 ; i < TEST_DATA_SIZE; i++)
+    {
+        first = test_col_data_uint64_t[i].first;
+        last = test_col_data_uint64_t[i].last;
+        ffound = find_range_runs_uint64_t(keys, rows, (smf.nrows - 1), &first, &last, test_col_data_uint64_t[i].search);
+        if (ffound != test_col_data_uint64_t[i].foundFirst)
+        {
+            (void)fprintf_s(stderr, "%s (%d) Expected found %" PRIx64 ", got %" PRIx64 "\n", __func__, i, test_col_data_uint64_t[i].foundFirst, ffound);
+            ++errors;
+        }
+    }
+    return errors;
+}
+
+int test_save_run_index(mmfile_t mf)
+{
+    const char *file = "test_run_index.bin"; // sidecar file created by the test
+    const uint64_t *src = get_src_offset_uint64_t(mf.src, mf.index[3]);
+    return test_sidecar(__func__, file, save_run_index(file, mf, 3), mf, 2, (col_count_distinct_uint64_t(src, TEST_DATA_ITEMS) + 1), test_check_run_index);
+}
+
 // returns current time in nanoseconds
 uint64_t get_time()
 {
@@ -719,6 +2494,162 @@ define_benchmark_col_find_last_sub(uint16_t)
 define_benchmark_col_find_last_sub(uint32_t)
 define_benchmark_col_find_last_sub(uint64_t)
 
+#define define_benchmark_col_find_first_branchless(T) \
+void benchmark_col_find_first_branchless_##T(mmfile_t mf) \
+{ \
+    uint64_t tstart, tend; \
+    uint64_t first = 0; \
+    uint64_t last = TEST_DATA_ITEMS; \
+    uint64_t found; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    int size = 10000; \
+    tstart = get_time(); \
+    for (i=0 ; i < size; i++) \
+    { \
+        first = 0; \
+        last = TEST_DATA_ITEMS; \
+        found = col_find_first_branchless_##T(src, &first, &last, test_col_data_##T[4].search); \
+    } \
+    tend = get_time(); \
+    (void)fprintf_s(stdout, " * %s : %lu ns/op (%" PRIx64 ")\n", __func__, (tend - tstart)/(uint64_t)(size*4), found); \
+}
+
+define_benchmark_col_find_first_branchless(uint8_t)
+define_benchmark_col_find_first_branchless(uint16_t)
+define_benchmark_col_find_first_branchless(uint32_t)
+define_benchmark_col_find_first_branchless(uint64_t)
+
+#define define_benchmark_col_find_last_branchless(T) \
+void benchmark_col_find_last_branchless_##T(mmfile_t mf) \
+{ \
+    uint64_t tstart, tend; \
+    uint64_t first = 0; \
+    uint64_t last = TEST_DATA_ITEMS; \
+    uint64_t found; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    int size = 10000; \
+    tstart = get_time(); \
+    for (i=0 ; i < size; i++) \
+    { \
+        first = 0; \
+        last = TEST_DATA_ITEMS; \
+        found = col_find_last_branchless_##T(src, &first, &last, test_col_data_##T[4].search); \
+    } \
+    tend = get_time(); \
+    (void)fprintf_s(stdout, " * %s : %lu ns/op (%" PRIx64 ")\n", __func__, (tend - tstart)/(uint64_t)(size*4), found); \
+}
+
+define_benchmark_col_find_last_branchless(uint8_t)
+define_benchmark_col_find_last_branchless(uint16_t)
+define_benchmark_col_find_last_branchless(uint32_t)
+define_benchmark_col_find_last_branchless(uint64_t)
+
+#define define_benchmark_col_find_first_kary(T) \
+void benchmark_col_find_first_kary_##T(mmfile_t mf) \
+{ \
+    uint64_t tstart, tend; \
+    uint64_t first = 0; \
+    uint64_t last = TEST_DATA_ITEMS; \
+    uint64_t found; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    int size = 10000; \
+    tstart = get_time(); \
+    for (i=0 ; i < size; i++) \
+    { \
+        first = 0; \
+        last = TEST_DATA_ITEMS; \
+        found = col_find_first_kary_##T(src, &first, &last, test_col_data_##T[4].search); \
+    } \
+    tend = get_time(); \
+    (void)fprintf_s(stdout, " * %s : %lu ns/op (%" PRIx64 ")\n", __func__, (tend - tstart)/(uint64_t)(size*4), found); \
+}
+
+define_benchmark_col_find_first_kary(uint32_t)
+define_benchmark_col_find_first_kary(uint64_t)
+
+#define define_benchmark_col_find_last_kary(T) \
+void benchmark_col_find_last_kary_##T(mmfile_t mf) \
+{ \
+    uint64_t tstart, tend; \
+    uint64_t first = 0; \
+    uint64_t last = TEST_DATA_ITEMS; \
+    uint64_t found; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    int size = 10000; \
+    tstart = get_time(); \
+    for (i=0 ; i < size; i++) \
+    { \
+        first = 0; \
+        last = TEST_DATA_ITEMS; \
+        found = col_find_last_kary_##T(src, &first, &last, test_col_data_##T[4].search); \
+    } \
+    tend = get_time(); \
+    (void)fprintf_s(stdout, " * %s : %lu ns/op (%" PRIx64 ")\n", __func__, (tend - tstart)/(uint64_t)(size*4), found); \
+}
+
+define_benchmark_col_find_last_kary(uint32_t)
+define_benchmark_col_find_last_kary(uint64_t)
+
+#define define_benchmark_col_find_first_eytzinger(T) \
+void benchmark_col_find_first_eytzinger_##T(mmfile_t mf) \
+{ \
+    uint64_t tstart, tend; \
+    uint64_t first = 0; \
+    uint64_t last = TEST_DATA_ITEMS; \
+    uint64_t found; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    T eyt[TEST_DATA_ITEMS + 1]; \
+    col_build_eytzinger_##T(src, TEST_DATA_ITEMS, eyt); \
+    int size = 10000; \
+    tstart = get_time(); \
+    for (i=0 ; i < size; i++) \
+    { \
+        first = 0; \
+        last = TEST_DATA_ITEMS; \
+        found = col_find_first_eytzinger_##T(src, eyt, TEST_DATA_ITEMS, &first, &last, test_col_data_##T[4].search); \
+    } \
+    tend = get_time(); \
+    (void)fprintf_s(stdout, " * %s : %lu ns/op (%" PRIx64 ")\n", __func__, (tend - tstart)/(uint64_t)(size*4), found); \
+}
+
+define_benchmark_col_find_first_eytzinger(uint8_t)
+define_benchmark_col_find_first_eytzinger(uint16_t)
+define_benchmark_col_find_first_eytzinger(uint32_t)
+define_benchmark_col_find_first_eytzinger(uint64_t)
+
+#define define_benchmark_col_find_last_eytzinger(T) \
+void benchmark_col_find_last_eytzinger_##T(mmfile_t mf) \
+{ \
+    uint64_t tstart, tend; \
+    uint64_t first = 0; \
+    uint64_t last = TEST_DATA_ITEMS; \
+    uint64_t found; \
+    int i; \
+    const T *src = get_src_offset_##T(mf.src, mf.index[typecolmap[sizeof(T)]]); \
+    T eyt[TEST_DATA_ITEMS + 1]; \
+    col_build_eytzinger_##T(src, TEST_DATA_ITEMS, eyt); \
+    int size = 10000; \
+    tstart = get_time(); \
+    for (i=0 ; i < size; i++) \
+    { \
+        first = 0; \
+        last = TEST_DATA_ITEMS; \
+        found = col_find_last_eytzinger_##T(src, eyt, TEST_DATA_ITEMS, &first, &last, test_col_data_##T[4].search); \
+    } \
+    tend = get_time(); \
+    (void)fprintf_s(stdout, " * %s : %lu ns/op (%" PRIx64 ")\n", __func__, (tend - tstart)/(uint64_t)(size*4), found); \
+}
+
+define_benchmark_col_find_last_eytzinger(uint8_t)
+define_benchmark_col_find_last_eytzinger(uint16_t)
+define_benchmark_col_find_last_eytzinger(uint32_t)
+define_benchmark_col_find_last_eytzinger(uint64_t)
+
 int main()
 {
     int errors = 0;
@@ -764,6 +2695,157 @@ int main()
     errors += test_col_find_first_uint64_t(mf);
     errors += test_col_find_last_uint64_t(mf);
 
+    errors += test_col_find_first_branchless_uint8_t(mf);
+    errors += test_col_find_last_branchless_uint8_t(mf);
+    errors += test_col_find_first_branchless_uint16_t(mf);
+    errors += test_col_find_last_branchless_uint16_t(mf);
+    errors += test_col_find_first_branchless_uint32_t(mf);
+    errors += test_col_find_last_branchless_uint32_t(mf);
+    errors += test_col_find_first_branchless_uint64_t(mf);
+    errors += test_col_find_last_branchless_uint64_t(mf);
+
+    errors += test_col_find_first_kary_uint32_t(mf);
+    errors += test_col_find_last_kary_uint32_t(mf);
+    errors += test_col_find_first_kary_uint64_t(mf);
+    errors += test_col_find_last_kary_uint64_t(mf);
+
+    errors += test_col_find_first_eytzinger_uint8_t(mf);
+    errors += test_col_find_last_eytzinger_uint8_t(mf);
+    errors += test_col_find_first_eytzinger_uint16_t(mf);
+    errors += test_col_find_last_eytzinger_uint16_t(mf);
+    errors += test_col_find_first_eytzinger_uint32_t(mf);
+    errors += test_col_find_last_eytzinger_uint32_t(mf);
+    errors += test_col_find_first_eytzinger_uint64_t(mf);
+    errors += test_col_find_last_eytzinger_uint64_t(mf);
+    errors += test_save_eytzinger(mf);
+
+    errors += test_col_find_first_batch_uint8_t(mf);
+    errors += test_col_find_last_batch_uint8_t(mf);
+    errors += test_col_find_first_batch_uint16_t(mf);
+    errors += test_col_find_last_batch_uint16_t(mf);
+    errors += test_col_find_first_batch_uint32_t(mf);
+    errors += test_col_find_last_batch_uint32_t(mf);
+    errors += test_col_find_first_batch_uint64_t(mf);
+    errors += test_col_find_last_batch_uint64_t(mf);
+    errors += test_col_find_batch_bounds_uint8_t();
+    errors += test_col_find_batch_bounds_uint16_t();
+    errors += test_col_find_batch_bounds_uint32_t();
+    errors += test_col_find_batch_bounds_uint64_t();
+
+    errors += test_col_find_sorted_batch_uint8_t(mf);
+    errors += test_col_find_sorted_batch_uint16_t(mf);
+    errors += test_col_find_sorted_batch_uint32_t(mf);
+    errors += test_col_find_sorted_batch_uint64_t(mf);
+
+    errors += test_col_find_first_interp_uint8_t(mf);
+    errors += test_col_find_last_interp_uint8_t(mf);
+    errors += test_col_find_first_interp_uint16_t(mf);
+    errors += test_col_find_last_interp_uint16_t(mf);
+    errors += test_col_find_first_interp_uint32_t(mf);
+    errors += test_col_find_last_interp_uint32_t(mf);
+    errors += test_col_find_first_interp_uint64_t(mf);
+    errors += test_col_find_last_interp_uint64_t(mf);
+    errors += test_col_find_first_interp_seq_uint8_t(mf);
+    errors += test_col_find_last_interp_seq_uint8_t(mf);
+    errors += test_col_find_first_interp_seq_uint16_t(mf);
+    errors += test_col_find_last_interp_seq_uint16_t(mf);
+    errors += test_col_find_first_interp_seq_uint32_t(mf);
+    errors += test_col_find_last_interp_seq_uint32_t(mf);
+    errors += test_col_find_first_interp_seq_uint64_t(mf);
+    errors += test_col_find_last_interp_seq_uint64_t(mf);
+
+    errors += test_col_find_first_learned_uint8_t(mf);
+    errors += test_col_find_last_learned_uint8_t(mf);
+    errors += test_col_find_first_learned_uint16_t(mf);
+    errors += test_col_find_last_learned_uint16_t(mf);
+    errors += test_col_find_first_learned_uint32_t(mf);
+    errors += test_col_find_last_learned_uint32_t(mf);
+    errors += test_col_find_first_learned_uint64_t(mf);
+    errors += test_col_find_last_learned_uint64_t(mf);
+    errors += test_save_learned(mf);
+
+    errors += test_col_find_first_from_hint_uint8_t(mf);
+    errors += test_col_find_last_from_hint_uint8_t(mf);
+    errors += test_col_find_first_from_hint_uint16_t(mf);
+    errors += test_col_find_last_from_hint_uint16_t(mf);
+    errors += test_col_find_first_from_hint_uint32_t(mf);
+    errors += test_col_find_last_from_hint_uint32_t(mf);
+    errors += test_col_find_first_from_hint_uint64_t(mf);
+    errors += test_col_find_last_from_hint_uint64_t(mf);
+
+    errors += test_col_find_range_uint8_t(mf);
+    errors += test_col_find_range_uint16_t(mf);
+    errors += test_col_find_range_uint32_t(mf);
+    errors += test_col_find_range_uint64_t(mf);
+
+    errors += test_col_find_first_stree_uint32_t(mf);
+    errors += test_col_find_last_stree_uint32_t(mf);
+    errors += test_col_find_first_stree_uint64_t(mf);
+    errors += test_col_find_last_stree_uint64_t(mf);
+    errors += test_save_stree(mf);
+
+    errors += test_col_find_first_cached_uint8_t(mf);
+    errors += test_col_find_last_cached_uint8_t(mf);
+    errors += test_col_find_first_cached_uint16_t(mf);
+    errors += test_col_find_last_cached_uint16_t(mf);
+    errors += test_col_find_first_cached_uint32_t(mf);
+    errors += test_col_find_last_cached_uint32_t(mf);
+    errors += test_col_find_first_cached_uint64_t(mf);
+    errors += test_col_find_last_cached_uint64_t(mf);
+
+    errors += test_col_find_first_hybrid_uint8_t(mf);
+    errors += test_col_find_last_hybrid_uint8_t(mf);
+    errors += test_col_find_first_hybrid_uint16_t(mf);
+    errors += test_col_find_last_hybrid_uint16_t(mf);
+    errors += test_col_find_first_hybrid_uint32_t(mf);
+    errors += test_col_find_last_hybrid_uint32_t(mf);
+    errors += test_col_find_first_hybrid_uint64_t(mf);
+    errors += test_col_find_last_hybrid_uint64_t(mf);
+
+    errors += test_col_scan_equal_run_uint8_t(mf);
+    errors += test_col_scan_equal_run_uint16_t(mf);
+    errors += test_col_scan_equal_run_uint32_t(mf);
+    errors += test_col_scan_equal_run_uint64_t(mf);
+
+    errors += test_col_find_first_filtered_uint8_t(mf);
+    errors += test_col_find_last_filtered_uint8_t(mf);
+    errors += test_col_find_first_filtered_uint16_t(mf);
+    errors += test_col_find_last_filtered_uint16_t(mf);
+    errors += test_col_find_first_filtered_uint32_t(mf);
+    errors += test_col_find_last_filtered_uint32_t(mf);
+    errors += test_col_find_first_filtered_uint64_t(mf);
+    errors += test_col_find_last_filtered_uint64_t(mf);
+    errors += test_save_bloom(mf);
+
+    errors += test_col_range_maybe_nonempty_uint8_t(mf);
+    errors += test_col_range_maybe_nonempty_uint16_t(mf);
+    errors += test_col_range_maybe_nonempty_uint32_t(mf);
+    errors += test_col_range_maybe_nonempty_uint64_t(mf);
+    errors += test_save_range_filter(mf);
+
+    errors += test_col_find_hash_uint8_t(mf);
+    errors += test_col_find_hash_uint16_t(mf);
+    errors += test_col_find_hash_uint32_t(mf);
+    errors += test_col_find_hash_uint64_t(mf);
+    errors += test_save_hash_index(mf);
+
+    errors += test_col_find_range_runs_uint8_t(mf);
+    errors += test_col_find_range_runs_uint16_t(mf);
+    errors += test_col_find_range_runs_uint32_t(mf);
+    errors += test_col_find_range_runs_uint64_t(mf);
+    errors += test_save_run_index(mf);
+
+    errors += test_col_cursor_uint8_t(mf);
+    errors += test_col_cursor_uint16_t(mf);
+    errors += test_col_cursor_uint32_t(mf);
+    errors += test_col_cursor_uint64_t(mf);
+
+    errors += test_col_gather_uint8_t(mf);
+    errors += test_col_gather_uint16_t(mf);
+    errors += test_col_gather_uint32_t(mf);
+    errors += test_col_gather_uint64_t(mf);
+    errors += test_col_gather(mf);
+
     benchmark_col_find_first_uint8_t(mf);
     benchmark_col_find_last_uint8_t(mf);
     benchmark_col_find_first_uint16_t(mf);
@@ -782,6 +2864,29 @@ int main()
     benchmark_col_find_first_sub_uint64_t(mf);
     benchmark_col_find_last_sub_uint64_t(mf);
 
+    benchmark_col_find_first_branchless_uint8_t(mf);
+    benchmark_col_find_last_branchless_uint8_t(mf);
+    benchmark_col_find_first_branchless_uint16_t(mf);
+    benchmark_col_find_last_branchless_uint16_t(mf);
+    benchmark_col_find_first_branchless_uint32_t(mf);
+    benchmark_col_find_last_branchless_uint32_t(mf);
+    benchmark_col_find_first_branchless_uint64_t(mf);
+    benchmark_col_find_last_branchless_uint64_t(mf);
+
+    benchmark_col_find_first_kary_uint32_t(mf);
+    benchmark_col_find_last_kary_uint32_t(mf);
+    benchmark_col_find_first_kary_uint64_t(mf);
+    benchmark_col_find_last_kary_uint64_t(mf);
+
+    benchmark_col_find_first_eytzinger_uint8_t(mf);
+    benchmark_col_find_last_eytzinger_uint8_t(mf);
+    benchmark_col_find_first_eytzinger_uint16_t(mf);
+    benchmark_col_find_last_eytzinger_uint16_t(mf);
+    benchmark_col_find_first_eytzinger_uint32_t(mf);
+    benchmark_col_find_last_eytzinger_uint32_t(mf);
+    benchmark_col_find_first_eytzinger_uint64_t(mf);
+    benchmark_col_find_last_eytzinger_uint64_t(mf);
+
     int e = munmap_binfile(mf);
     if (e != 0)
     {
@@ -8,6 +8,8 @@
 // @license    MIT (see LICENSE file)
 // @copyright  (c) 2017-2026 Nicola Asuni - Tecnick.com
 
+#define _DEFAULT_SOURCE // madvise and huge pages for mmap_binfile_ex
+
 #ifdef __STDC__LIB_EXT1__
 #define __STDC_WANT_LIB_EXT1__ 1
 #else
@@ -21,6 +23,7 @@
 #include <inttypes.h>
 #include <string.h>
 #include <errno.h>
+#include <unistd.h>
 #include <sys/mman.h>
 #include "../src/binsearch/binsearch.h"
 
@@ -304,6 +307,169 @@ int test_map_file_col()
     return errors;
 }
 
+int test_create_binsrc()
+{
+    int errors = 0;
+    char *file = "test_create_binsrc.bin"; // file created by the test
+    uint8_t ctbytes[2] = {4, 8};
+    uint64_t i;
+    mmfile_t mf = {0};
+    create_binsrc(file, 2, ctbytes, 11, &mf);
+    if ((mf.fd < 0) || (mf.src == MAP_FAILED))
+    {
+        (void)fprintf_s(stderr, "%s can't create %s [%s]\n", __func__, file, strerror(errno));
+        return 1;
+    }
+    uint32_t *c0 = (uint32_t *)(mf.src + mf.index[0]);
+    uint64_t *c1 = (uint64_t *)(mf.src + mf.index[1]);
+    for (i = 0; i < 11; i++)
+    {
+        c0[i] = (uint32_t)(i * 3);
+        c1[i] = (i << 40);
+    }
+    int e = munmap_binfile(mf);
+    if (e != 0)
+    {
+        (void)fprintf_s(stderr, "%s Got %d error while unmapping the created file\n", __func__, e);
+        (void)unlink(file);
+        return 1;
+    }
+    mmfile_t rmf = {0};
+    mmap_binfile(file, &rmf);
+    if ((rmf.fd < 0) || (rmf.src == MAP_FAILED))
+    {
+        (void)fprintf_s(stderr, "%s can't open %s for reading\n", __func__, file);
+        (void)unlink(file);
+        return 1;
+    }
+    if (rmf.size != 216)
+    {
+        (void)fprintf_s(stderr, "%s rmf.size : Expecting 216 bytes, got instead: %" PRIu64 "\n", __func__, rmf.size);
+        errors++;
+    }
+    if (rmf.doffset != 40)
+    {
+        (void)fprintf_s(stderr, "%s rmf.doffset : Expecting 40 bytes, got instead: %" PRIu64 "\n", __func__, rmf.doffset);
+        errors++;
+    }
+    if (rmf.dlength != 176)
+    {
+        (void)fprintf_s(stderr, "%s rmf.dlength : Expecting 176 bytes, got instead: %" PRIu64 "\n", __func__, rmf.dlength);
+        errors++;
+    }
+    if (rmf.nrows != 11)
+    {
+        (void)fprintf_s(stderr, "%s rmf.nrows : Expecting 11 items, got instead: %" PRIu64 "\n", __func__, rmf.nrows);
+        errors++;
+    }
+    if ((rmf.ncols != 2) || (rmf.ctbytes[0] != 4) || (rmf.ctbytes[1] != 8))
+    {
+        (void)fprintf_s(stderr, "%s rmf.ncols : Expecting 2 columns of 4 and 8 bytes, got instead: %" PRIu8 "\n", __func__, rmf.ncols);
+        errors++;
+    }
+    if ((rmf.index[0] != 64) || (rmf.index[1] != 128))
+    {
+        (void)fprintf_s(stderr, "%s rmf.index : Expecting 64 and 128 bytes, got instead: %" PRIu64 " and %" PRIu64 "\n", __func__, rmf.index[0], rmf.index[1]);
+        errors++;
+    }
+    const uint32_t *r0 = get_src_offset_uint32_t(rmf.src, rmf.index[0]);
+    const uint64_t *r1 = get_src_offset_uint64_t(rmf.src, rmf.index[1]);
+    for (i = 0; i < 11; i++)
+    {
+        if ((r0[i] != (uint32_t)(i * 3)) || (r1[i] != (i << 40)))
+        {
+            (void)fprintf_s(stderr, "%s (%" PRIu64 ") Unexpected values: %" PRIu32 " %" PRIx64 "\n", __func__, i, r0[i], r1[i]);
+            errors++;
+        }
+    }
+    e = munmap_binfile(rmf);
+    if (e != 0)
+    {
+        (void)fprintf_s(stderr, "%s Got %d error while unmapping the file\n", __func__, e);
+        errors++;
+    }
+    (void)unlink(file);
+    return errors;
+}
+
+// Map the file with the specified options and compare it with the plain mapping.
+// The expected return value 2 accepts both 0 and 1, for the options depending on the system configuration.
+int test_mmap_binfile_ex_opts(const char *name, const mmap_opts_t *opts, int expret, bool hugetlb)
+{
+    int errors = 0;
+    char *file = "test_data_col.bin"; // file containing test data
+    mmfile_t mf = {0};
+    mmfile_t xmf = {0};
+    mmap_binfile(file, &mf);
+    if ((mf.fd < 0) || (mf.src == MAP_FAILED))
+    {
+        (void)fprintf_s(stderr, "%s %s can't map %s\n", __func__, name, file);
+        return 1;
+    }
+    int ret = mmap_binfile_ex(file, &xmf, opts);
+    if ((ret != expret) && !((expret == 2) && ((ret == 0) || (ret == 1))))
+    {
+        (void)fprintf_s(stderr, "%s %s Expected return value %d, got %d\n", __func__, name, expret, ret);
+        errors++;
+    }
+    if ((xmf.fd < 0) || (xmf.src == MAP_FAILED))
+    {
+        (void)fprintf_s(stderr, "%s %s mmap error! [%s]\n", __func__, name, strerror(errno));
+        (void)munmap_binfile(mf);
+        return (errors + 1);
+    }
+    if ((xmf.size != mf.size) || (xmf.doffset != mf.doffset) || (xmf.dlength != mf.dlength) || (xmf.nrows != mf.nrows) || (xmf.ncols != mf.ncols) || (memcmp(xmf.index, mf.index, sizeof(mf.index)) != 0))
+    {
+        (void)fprintf_s(stderr, "%s %s Unexpected file info\n", __func__, name);
+        errors++;
+    }
+    if (memcmp(xmf.src, mf.src, mf.size) != 0)
+    {
+        (void)fprintf_s(stderr, "%s %s Unexpected file content\n", __func__, name);
+        errors++;
+    }
+    if ((hugetlb && ((xmf.mapsize % MMAP_HUGETLB_SIZE) != 0 || (xmf.mapsize < xmf.size))) || (!hugetlb && (xmf.mapsize != 0)))
+    {
+        (void)fprintf_s(stderr, "%s %s Unexpected map size %" PRIu64 "\n", __func__, name, xmf.mapsize);
+        errors++;
+    }
+    int e = munmap_binfile(xmf);
+    if (e != 0)
+    {
+        (void)fprintf_s(stderr, "%s %s Got %d error while unmapping the file\n", __func__, name, e);
+        errors++;
+    }
+    (void)munmap_binfile(mf);
+    return errors;
+}
+
+int test_mmap_binfile_ex()
+{
+    int errors = 0;
+    mmap_opts_t opts = {0};
+    mmfile_t mf = {0};
+    if (mmap_binfile_ex("ERROR", &mf, &opts) != -1)
+    {
+        (void)fprintf_s(stderr, "%s An mmap error was expected\n", __func__);
+        errors++;
+    }
+    errors += test_mmap_binfile_ex_opts("default", &opts, 0, false);
+    opts.advice = MMAP_ADVICE_RANDOM;
+    opts.col_advice[1] = MMAP_ADVICE_SEQUENTIAL;
+    opts.col_advice[3] = MMAP_ADVICE_WILLNEED;
+    errors += test_mmap_binfile_ex_opts("advice", &opts, 0, false);
+    opts.flags = (MMAP_OPT_POPULATE | MMAP_OPT_HUGEPAGE);
+    opts.col_lock[2] = true;
+    errors += test_mmap_binfile_ex_opts("populate", &opts, 2, false); // transparent huge pages and mlock may not be available
+    opts.flags = (MMAP_OPT_HUGETLB | MMAP_OPT_POPULATE | MMAP_OPT_LOCK);
+    errors += test_mmap_binfile_ex_opts("hugetlb", &opts, 2, true);
+    opts.flags = 0;
+    opts.col_lock[2] = false;
+    opts.advice = 9; // invalid advice
+    errors += test_mmap_binfile_ex_opts("invalid", &opts, 1, false);
+    return errors;
+}
+
 int main()
 {
     int errors = 0;
@@ -315,6 +481,8 @@ int main()
     errors += test_map_file_feather();
     errors += test_map_file_binsrc();
     errors += test_map_file_col();
+    errors += test_create_binsrc();
+    errors += test_mmap_binfile_ex();
 
     return errors;
 }
@@ -0,0 +1,236 @@
+// BinSearch
+//
+// test_binsearch_hpp.cpp
+//
+// @category   Test
+// @author     Nicola Asuni <info@tecnick.com>
+// @link       https://github.com/tecnickcom/binsearch
+// @license    MIT (see LICENSE file)
+// @copyright  (c) 2017-2026 Nicola Asuni - Tecnick.com
+
+#ifdef __STDC__LIB_EXT1__
+#define __STDC_WANT_LIB_EXT1__ 1
+#else
+// Ignore clang-tidy warning for deprecated or unsafe buffer handling
+// NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+#define fprintf_s fprintf
+#endif
+
+#include <cstdio>
+#include <cstdint>
+#include <cinttypes>
+#include <cstring>
+#include <cerrno>
+#include <sys/mman.h>
+#include "../src/binsearch/binsearch.hpp"
+
+#define TEST_DATA_ITEMS 251
+#define TEST_BLKLEN 16
+
+// Compare the template searches with the C functions on every key of the file and on a set of sub-ranges.
+template <typename K, typename FF, typename FL, typename HN, typename HP>
+static int check_key(const char *name, const K &key, uint64_t nrows, FF cfind_first, FL cfind_last, HN chas_next, HP chas_prev)
+{
+    using T = typename K::value_type;
+    int errors = 0;
+    uint64_t i, r, k, cfound, tfound, cfirst, clast, tfirst, tlast, cpos, tpos;
+    bool cnext, tnext;
+    for (r = 0; r < nrows; r += 7)
+    {
+        for (i = 0; i < nrows; i++)
+        {
+            for (k = 0; k < 2; k++)
+            {
+                T search = static_cast<T>(key(i) + k);
+                cfirst = tfirst = (r < i) ? r : 0;
+                clast = tlast = (r > i) ? r : nrows;
+                cfound = cfind_first(&cfirst, &clast, search);
+                tfound = binsearch::find_first(key, &tfirst, &tlast, search);
+                if ((tfound != cfound) || (tfirst != cfirst) || (tlast != clast))
+                {
+                    (void)fprintf_s(stderr, "%s find_first (%" PRIu64 ", %" PRIu64 ") Expected %" PRIu64 " [%" PRIu64 ", %" PRIu64 "], got %" PRIu64 " [%" PRIu64 ", %" PRIu64 "]\n", name, r, i, cfound, cfirst, clast, tfound, tfirst, tlast);
+                    ++errors;
+                }
+                if (cfound < clast)
+                {
+                    cpos = tpos = cfound;
+                    do
+                    {
+                        cnext = chas_next(&cpos, nrows, search);
+                        tnext = binsearch::has_next(key, &tpos, nrows, search);
+                    } while (cnext && tnext);
+                    if ((cnext != tnext) || (tpos != cpos))
+                    {
+                        (void)fprintf_s(stderr, "%s has_next (%" PRIu64 ") Expected %" PRIu64 ", got %" PRIu64 "\n", name, i, cpos, tpos);
+                        ++errors;
+                    }
+                }
+                cfirst = tfirst = (r < i) ? r : 0;
+                clast = tlast = (r > i) ? r : nrows;
+                if ((cfirst == 0) && (search < key(0)))
+                {
+                    continue; // avoid reading before the start of the data
+                }
+                cfound = cfind_last(&cfirst, &clast, search);
+                tfound = binsearch::find_last(key, &tfirst, &tlast, search);
+                if ((tfound != cfound) || (tfirst != cfirst) || (tlast != clast))
+                {
+                    (void)fprintf_s(stderr, "%s find_last (%" PRIu64 ", %" PRIu64 ") Expected %" PRIu64 " [%" PRIu64 ", %" PRIu64 "], got %" PRIu64 " [%" PRIu64 ", %" PRIu64 "]\n", name, r, i, cfound, cfirst, clast, tfound, tfirst, tlast);
+                    ++errors;
+                }
+                if (cfound < clast)
+                {
+                    cpos = tpos = cfound;
+                    do
+                    {
+                        cnext = chas_prev(0, &cpos, search);
+                        tnext = binsearch::has_prev(key, 0, &tpos, search);
+                    } while (cnext && tnext);
+                    if ((cnext != tnext) || (tpos != cpos))
+                    {
+                        (void)fprintf_s(stderr, "%s has_prev (%" PRIu64 ") Expected %" PRIu64 ", got %" PRIu64 "\n", name, i, cpos, tpos);
+                        ++errors;
+                    }
+                }
+            }
+        }
+    }
+    return errors;
+}
+
+#define define_test_hpp_row(O, T) \
+template <uint64_t BLKPOS> \
+int test_hpp_row_##O##_##T(const mmfile_t &mf, uint64_t nrows) \
+{ \
+    int errors = 0; \
+    const uint8_t *src = mf.src; \
+    uint8_t bitstart = static_cast<uint8_t>((sizeof(T) >> 2) * 8); \
+    uint8_t bitend = static_cast<uint8_t>((8 * sizeof(T)) - 1 - bitstart); \
+    auto ff = [&](uint64_t *first, uint64_t *last, T search) { return find_first_##O##_##T(src, TEST_BLKLEN, BLKPOS, first, last, search); }; \
+    auto fl = [&](uint64_t *first, uint64_t *last, T search) { return find_last_##O##_##T(src, TEST_BLKLEN, BLKPOS, first, last, search); }; \
+    auto hn = [&](uint64_t *pos, uint64_t last, T search) { return has_next_##O##_##T(src, TEST_BLKLEN, BLKPOS, pos, last, search); }; \
+    auto hp = [&](uint64_t first, uint64_t *pos, T search) { return has_prev_##O##_##T(src, TEST_BLKLEN, BLKPOS, first, pos, search); }; \
+    auto sff = [&](uint64_t *first, uint64_t *last, T search) { return find_first_sub_##O##_##T(src, TEST_BLKLEN, BLKPOS, bitstart, bitend, first, last, search); }; \
+    auto sfl = [&](uint64_t *first, uint64_t *last, T search) { return find_last_sub_##O##_##T(src, TEST_BLKLEN, BLKPOS, bitstart, bitend, first, last, search); }; \
+    auto shn = [&](uint64_t *pos, uint64_t last, T search) { return has_next_sub_##O##_##T(src, TEST_BLKLEN, BLKPOS, bitstart, bitend, pos, last, search); }; \
+    auto shp = [&](uint64_t first, uint64_t *pos, T search) { return has_prev_sub_##O##_##T(src, TEST_BLKLEN, BLKPOS, bitstart, bitend, first, pos, search); }; \
+    binsearch::row_key<binsearch::order::O, T, TEST_BLKLEN, BLKPOS> skey(mf); \
+    binsearch::row_key<binsearch::order::O, T> dkey(mf, TEST_BLKLEN, BLKPOS); \
+    errors += check_key(__func__, skey, nrows, ff, fl, hn, hp); \
+    errors += check_key(__func__, dkey, nrows, ff, fl, hn, hp); \
+    binsearch::sub_key<decltype(skey), ((sizeof(T) >> 2) * 8), ((8 * sizeof(T)) - 1 - ((sizeof(T) >> 2) * 8))> sskey(skey); \
+    binsearch::sub_key<decltype(dkey)> sdkey(dkey, bitstart, bitend); \
+    errors += check_key(__func__, sskey, nrows, sff, sfl, shn, shp); \
+    errors += check_key(__func__, sdkey, nrows, sff, sfl, shn, shp); \
+    return errors; \
+}
+
+define_test_hpp_row(be, uint8_t)
+define_test_hpp_row(be, uint16_t)
+define_test_hpp_row(be, uint32_t)
+define_test_hpp_row(be, uint64_t)
+define_test_hpp_row(le, uint8_t)
+define_test_hpp_row(le, uint16_t)
+define_test_hpp_row(le, uint32_t)
+define_test_hpp_row(le, uint64_t)
+
+#define define_test_hpp_col(T) \
+int test_hpp_col_##T(const mmfile_t &mf, uint8_t col) \
+{ \
+    int errors = 0; \
+    const T *src = reinterpret_cast<const T *>(mf.src + mf.index[col]); \
+    uint8_t bitstart = static_cast<uint8_t>((sizeof(T) >> 2) * 8); \
+    uint8_t bitend = static_cast<uint8_t>((8 * sizeof(T)) - 1 - bitstart); \
+    auto ff = [&](uint64_t *first, uint64_t *last, T search) { return col_find_first_##T(src, first, last, search); }; \
+    auto fl = [&](uint64_t *first, uint64_t *last, T search) { return col_find_last_##T(src, first, last, search); }; \
+    auto hn = [&](uint64_t *pos, uint64_t last, T search) { return col_has_next_##T(src, pos, last, search); }; \
+    auto hp = [&](uint64_t first, uint64_t *pos, T search) { return col_has_prev_##T(src, first, pos, search); }; \
+    auto sff = [&](uint64_t *first, uint64_t *last, T search) { return col_find_first_sub_##T(src, bitstart, bitend, first, last, search); }; \
+    auto sfl = [&](uint64_t *first, uint64_t *last, T search) { return col_find_last_sub_##T(src, bitstart, bitend, first, last, search); }; \
+    auto shn = [&](uint64_t *pos, uint64_t last, T search) { return col_has_next_sub_##T(src, bitstart, bitend, pos, last, search); }; \
+    auto shp = [&](uint64_t first, uint64_t *pos, T search) { return col_has_prev_sub_##T(src, bitstart, bitend, first, pos, search); }; \
+    binsearch::col_key<T> key(mf, col); \
+    binsearch::sub_key<decltype(key)> skey(key, bitstart, bitend); \
+    errors += check_key(__func__, key, mf.nrows, ff, fl, hn, hp); \
+    errors += check_key(__func__, skey, mf.nrows, sff, sfl, shn, shp); \
+    return errors; \
+}
+
+define_test_hpp_col(uint8_t)
+define_test_hpp_col(uint16_t)
+define_test_hpp_col(uint32_t)
+define_test_hpp_col(uint64_t)
+
+static int map_file(const char *file, mmfile_t *mf)
+{
+    mmap_binfile(file, mf);
+    if (mf->fd < 0)
+    {
+        (void)fprintf_s(stderr, "can't open %s for reading\n", file);
+        return 1;
+    }
+    if (mf->size == 0)
+    {
+        (void)fprintf_s(stderr, "fstat error! [%s]\n", strerror(errno));
+        return 1;
+    }
+    if (mf->src == MAP_FAILED)
+    {
+        (void)fprintf_s(stderr, "mmap error! [%s]\n", strerror(errno));
+        return 1;
+    }
+    return 0;
+}
+
+int main()
+{
+    int errors = 0;
+
+    mmfile_t mf = {};
+    mf.ncols = 1;
+    mf.ctbytes[0] = 12;
+    if (map_file("test_data.bin", &mf) != 0)
+    {
+        return 1;
+    }
+    uint64_t nrows = (mf.size / TEST_BLKLEN);
+    if (nrows != TEST_DATA_ITEMS)
+    {
+        (void)fprintf_s(stderr, "Expecting %d items, got instead: %" PRIu64 "\n", TEST_DATA_ITEMS, nrows);
+        return 1;
+    }
+
+    errors += test_hpp_row_be_uint8_t<0>(mf, nrows);
+    errors += test_hpp_row_be_uint16_t<2>(mf, nrows);
+    errors += test_hpp_row_be_uint32_t<4>(mf, nrows);
+    errors += test_hpp_row_be_uint64_t<8>(mf, nrows);
+    errors += test_hpp_row_le_uint8_t<1>(mf, nrows);
+    errors += test_hpp_row_le_uint16_t<6>(mf, nrows);
+    errors += test_hpp_row_le_uint32_t<8>(mf, nrows);
+    errors += test_hpp_row_le_uint64_t<0>(mf, nrows);
+
+    if (munmap_binfile(mf) != 0)
+    {
+        (void)fprintf_s(stderr, "Error while unmapping the file\n");
+        return 1;
+    }
+
+    mmfile_t mfc = {};
+    if (map_file("test_data_col.bin", &mfc) != 0)
+    {
+        return 1;
+    }
+
+    errors += test_hpp_col_uint8_t(mfc, 0);
+    errors += test_hpp_col_uint16_t(mfc, 1);
+    errors += test_hpp_col_uint32_t(mfc, 2);
+    errors += test_hpp_col_uint64_t(mfc, 3);
+
+    if (munmap_binfile(mfc) != 0)
+    {
+        (void)fprintf_s(stderr, "Error while unmapping the file\n");
+        return 1;
+    }
+
+    return errors;
+}
@@ -0,0 +1,557 @@
+// BinSearch
+//
+// test_binsearch_pool.c
+//
+// @category   Test
+// @author     Nicola Asuni <info@tecnick.com>
+// @link       https://github.com/tecnickcom/binsearch
+// @license    MIT (see LICENSE file)
+// @copyright  (c) 2017-2026 Nicola Asuni - Tecnick.com
+
+#define _GNU_SOURCE // CPU affinity
+
+#ifdef __STDC__LIB_EXT1__
+#define __STDC_WANT_LIB_EXT1__ 1
+#else
+// Ignore clang-tidy warning for deprecated or unsafe buffer handling
+// NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+#define fprintf_s fprintf
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include "../src/binsearch/binsearch_pool.h"
+
+#define TEST_DATA_ITEMS 251
+#define TEST_BLKLEN 16
+#define TEST_POOL_ITEMS 100003 // column items
+#define TEST_POOL_KEYS 30011 // keys per batch (8 chunks of BATCH_POOL_CHUNK)
+
+static const uint32_t test_pool_threads[] = {1, 2, 3, 8};
+static const uint64_t test_pool_div[] = {0, 782, 4, 0, 1, 0, 0, 0, 1}; // keep (2 * TEST_POOL_ITEMS / div) in the range of each type
+#define TEST_POOL_NTHREADS (sizeof(test_pool_threads) / sizeof(test_pool_threads[0]))
+
+static void test_pool_count_task(void *ctx, uint32_t node, uint64_t start, uint64_t end)
+{
+    uint32_t *count = (uint32_t *)ctx;
+    (void)node;
+    uint64_t i;
+    for (i = start; i < end; i++)
+    {
+        __atomic_add_fetch(&count[i], 1, __ATOMIC_RELAXED);
+    }
+}
+
+// Each item must be processed exactly once, for any number of threads and chunk size.
+int test_batch_pool_run(void)
+{
+    int errors = 0;
+    uint64_t i, c;
+    const uint64_t chunks[] = {1, 7, 1000, TEST_POOL_KEYS};
+    uint32_t *count = (uint32_t *)malloc(TEST_POOL_KEYS * sizeof(uint32_t));
+    batch_pool_t pool;
+    uint32_t t;
+    for (t = 0; t < TEST_POOL_NTHREADS; t++)
+    {
+        if (batch_pool_init(&pool, test_pool_threads[t], true) != 0)
+        {
+            (void)fprintf_s(stderr, "%s Unable to start %" PRIu32 " threads\n", __func__, test_pool_threads[t]);
+            free(count);
+            return 1;
+        }
+        for (c = 0; c < (sizeof(chunks) / sizeof(chunks[0])); c++)
+        {
+            memset(count, 0, (TEST_POOL_KEYS * sizeof(uint32_t)));
+            batch_pool_run(&pool, test_pool_count_task, count, TEST_POOL_KEYS, chunks[c]);
+            for (i = 0; i < TEST_POOL_KEYS; i++)
+            {
+                if (count[i] != 1)
+                {
+                    (void)fprintf_s(stderr, "%s (%" PRIu32 " threads, chunk %" PRIu64 ") item %" PRIu64 " processed %" PRIu32 " times\n", __func__, test_pool_threads[t], chunks[c], i, count[i]);
+                    ++errors;
+                    break;
+                }
+            }
+        }
+        batch_pool_destroy(&pool);
+    }
+    free(count);
+    return errors;
+}
+
+#ifdef BATCH_POOL_NUMA
+typedef struct test_pool_node_t
+{
+    const batch_pool_t *pool;
+    const uint32_t *src;
+    uint32_t errors;
+} test_pool_node_t;
+
+// Check that the workers get the forced node and its replica.
+static void test_pool_node_task(void *ctx, uint32_t node, uint64_t start, uint64_t end)
+{
+    test_pool_node_t *c = (test_pool_node_t *)ctx;
+    (void)start;
+    (void)end;
+    if ((node != 1) || (batch_pool_local(c->pool, node, c->src, (TEST_POOL_ITEMS * sizeof(uint32_t))) != (const void *)c->pool->replicas[0].copy[1]))
+    {
+        __atomic_add_fetch(&c->errors, 1, __ATOMIC_RELAXED);
+    }
+}
+#endif
+
+// The pool searches must read the node replicas of the replicated columns and return the same results.
+int test_batch_pool_replicate(void)
+{
+    int errors = 0;
+    uint64_t i;
+    uint32_t n;
+    batch_pool_t pool;
+    uint32_t *src = (uint32_t *)malloc(TEST_POOL_ITEMS * sizeof(uint32_t));
+    uint32_t *keys = (uint32_t *)malloc(TEST_POOL_KEYS * sizeof(uint32_t));
+    uint64_t *exp = (uint64_t *)malloc(TEST_POOL_KEYS * sizeof(uint64_t));
+    uint64_t *out = (uint64_t *)malloc(TEST_POOL_KEYS * sizeof(uint64_t));
+    for (i = 0; i < TEST_POOL_ITEMS; i++)
+    {
+        src[i] = (uint32_t)(i * 2);
+    }
+    for (i = 0; i < TEST_POOL_KEYS; i++)
+    {
+        keys[i] = (uint32_t)(((i * 7919) % TEST_POOL_ITEMS) * 2 + (i & 1));
+    }
+    mmfile_t mf = {0};
+    mf.src = (uint8_t *)src;
+    mf.nrows = TEST_POOL_ITEMS;
+    mf.ncols = 1;
+    mf.ctbytes[0] = 4;
+    mf.index[0] = 0;
+    const uint8_t cols[] = {0, 1};
+    if (batch_pool_init(&pool, 3, false) != 0)
+    {
+        (void)fprintf_s(stderr, "%s Unable to start the threads\n", __func__);
+        free(src);
+        free(keys);
+        free(exp);
+        free(out);
+        return 1;
+    }
+    if (pool.nnodes < 2)
+    {
+        pool.nnodes = 2; // emulate a NUMA host
+    }
+    if (batch_pool_replicate_cols(&pool, mf, &cols[1], 1) == 0)
+    {
+        (void)fprintf_s(stderr, "%s Expected an error for an invalid column\n", __func__);
+        ++errors;
+    }
+    if (batch_pool_replicate_cols(&pool, mf, cols, 1) != 0)
+    {
+        (void)fprintf_s(stderr, "%s Unable to replicate the column\n", __func__);
+        ++errors;
+    }
+#ifdef BATCH_POOL_NUMA
+    for (n = 0; n < pool.nnodes; n++)
+    {
+        if (batch_pool_node_bytes(&pool, n) < (TEST_POOL_ITEMS * sizeof(uint32_t)))
+        {
+            (void)fprintf_s(stderr, "%s Expected a replica on node %" PRIu32 ", got %" PRIu64 " bytes\n", __func__, n, batch_pool_node_bytes(&pool, n));
+            ++errors;
+        }
+        const void *local = batch_pool_local(&pool, n, (src + 5), (TEST_POOL_ITEMS - 5) * sizeof(uint32_t));
+        if ((local == (void *)(src + 5)) || (memcmp(local, (src + 5), (TEST_POOL_ITEMS - 5) * sizeof(uint32_t)) != 0))
+        {
+            (void)fprintf_s(stderr, "%s Expected the replica of node %" PRIu32 "\n", __func__, n);
+            ++errors;
+        }
+        if (batch_pool_local(&pool, n, (src + 5), (TEST_POOL_ITEMS - 4) * sizeof(uint32_t)) != (void *)(src + 5))
+        {
+            (void)fprintf_s(stderr, "%s Expected the original data outside the replica\n", __func__);
+            ++errors;
+        }
+    }
+#endif
+    col_find_first_batch_uint32_t(src, 0, TEST_POOL_ITEMS, keys, TEST_POOL_KEYS, exp);
+    col_find_first_batch_pool_uint32_t(&pool, src, 0, TEST_POOL_ITEMS, keys, TEST_POOL_KEYS, out);
+    if (memcmp(exp, out, (TEST_POOL_KEYS * sizeof(uint64_t))) != 0)
+    {
+        (void)fprintf_s(stderr, "%s FIRST Unexpected results\n", __func__);
+        ++errors;
+    }
+    col_find_last_batch_uint32_t(src, 0, TEST_POOL_ITEMS, keys, TEST_POOL_KEYS, exp);
+    col_find_last_batch_pool_uint32_t(&pool, src, 0, TEST_POOL_ITEMS, keys, TEST_POOL_KEYS, out);
+    if (memcmp(exp, out, (TEST_POOL_KEYS * sizeof(uint64_t))) != 0)
+    {
+        (void)fprintf_s(stderr, "%s LAST Unexpected results\n", __func__);
+        ++errors;
+    }
+#ifdef BATCH_POOL_NUMA
+    pool.node = 1; // emulate the workers running on the second node
+    test_pool_node_t nctx = {&pool, src, 0};
+    batch_pool_run(&pool, test_pool_node_task, &nctx, TEST_POOL_KEYS, 0);
+    if (nctx.errors != 0)
+    {
+        (void)fprintf_s(stderr, "%s Expected the replica of node 1 in %" PRIu32 " chunks\n", __func__, nctx.errors);
+        ++errors;
+    }
+    memset(src, 0, (TEST_POOL_ITEMS * sizeof(uint32_t))); // only the replicas still hold the column
+    col_find_last_batch_pool_uint32_t(&pool, src, 0, TEST_POOL_ITEMS, keys, TEST_POOL_KEYS, out);
+    if (memcmp(exp, out, (TEST_POOL_KEYS * sizeof(uint64_t))) != 0)
+    {
+        (void)fprintf_s(stderr, "%s NODE Unexpected results\n", __func__);
+        ++errors;
+    }
+    pool.node = -1;
+#endif
+    batch_pool_release_replicas(&pool);
+    for (n = 0; n < pool.nnodes; n++)
+    {
+        if (batch_pool_node_bytes(&pool, n) != 0)
+        {
+            (void)fprintf_s(stderr, "%s Expected no replicas on node %" PRIu32 "\n", __func__, n);
+            ++errors;
+        }
+    }
+    batch_pool_destroy(&pool);
+    free(src);
+    free(keys);
+    free(exp);
+    free(out);
+    return errors;
+}
+
+// The replicas are mapped exactly from the first byte of the region, so the searches
+// for keys below the minimum and above the maximum must not read outside the column.
+int test_batch_pool_replica_bounds(void)
+{
+    int errors = 0;
+    uint64_t i;
+    batch_pool_t pool;
+    long pagesize = sysconf(_SC_PAGESIZE);
+    uint64_t nrows = (pagesize > 0) ? ((uint64_t)pagesize / sizeof(uint32_t)) : 1024;
+    uint32_t *src = (uint32_t *)malloc(nrows * sizeof(uint32_t));
+    const uint32_t keys[] = {0, 5, (uint32_t)(nrows * 2 + 10), UINT32_MAX};
+    const uint64_t nkeys = (sizeof(keys) / sizeof(keys[0]));
+    uint64_t out[sizeof(keys) / sizeof(keys[0])];
+    for (i = 0; i < nrows; i++)
+    {
+        src[i] = (uint32_t)((i * 2) + 10);
+    }
+    if (batch_pool_init(&pool, 2, false) != 0)
+    {
+        (void)fprintf_s(stderr, "%s Unable to start the threads\n", __func__);
+        free(src);
+        return 1;
+    }
+    if (pool.nnodes < 2)
+    {
+        pool.nnodes = 2; // emulate a NUMA host
+    }
+    if (batch_pool_replicate(&pool, src, (nrows * sizeof(uint32_t))) != 0)
+    {
+        (void)fprintf_s(stderr, "%s Unable to replicate the column\n", __func__);
+        ++errors;
+    }
+    pool.node = 1; // emulate the workers running on the second node
+    col_find_first_batch_pool_uint32_t(&pool, src, 0, nrows, keys, nkeys, out);
+    for (i = 0; i < nkeys; i++)
+    {
+        if (out[i] != nrows)
+        {
+            (void)fprintf_s(stderr, "%s FIRST (%" PRIu64 ") Expected %" PRIu64 ", got %" PRIu64 "\n", __func__, i, nrows, out[i]);
+            ++errors;
+        }
+    }
+    col_find_last_batch_pool_uint32_t(&pool, src, 0, nrows, keys, nkeys, out);
+    for (i = 0; i < nkeys; i++)
+    {
+        if (out[i] != nrows)
+        {
+            (void)fprintf_s(stderr, "%s LAST (%" PRIu64 ") Expected %" PRIu64 ", got %" PRIu64 "\n", __func__, i, nrows, out[i]);
+            ++errors;
+        }
+    }
+    pool.node = -1;
+    batch_pool_destroy(&pool);
+    free(src);
+    return errors;
+}
+
+#define TEST_POOL_CALLERS 4 // threads sharing the same pool
+#define TEST_POOL_CALLS 20 // batches per calling thread
+
+typedef struct test_pool_caller_t
+{
+    batch_pool_t *pool;
+    const uint64_t *src;
+    const uint64_t *keys;
+    const uint64_t *exp;
+    int errors;
+} test_pool_caller_t;
+
+static void *test_pool_caller(void *arg)
+{
+    test_pool_caller_t *c = (test_pool_caller_t *)arg;
+    uint64_t *out = (uint64_t *)malloc(TEST_POOL_KEYS * sizeof(uint64_t));
+    int k;
+    for (k = 0; k < TEST_POOL_CALLS; k++)
+    {
+        memset(out, 0xFF, (TEST_POOL_KEYS * sizeof(uint64_t)));
+        col_find_first_batch_pool_uint64_t(c->pool, c->src, 0, TEST_POOL_ITEMS, c->keys, TEST_POOL_KEYS, out);
+        if (memcmp(c->exp, out, (TEST_POOL_KEYS * sizeof(uint64_t))) != 0)
+        {
+            c->errors++;
+        }
+    }
+    free(out);
+    return NULL;
+}
+
+// Concurrent callers sharing a pool must get their own results, without deadlocks.
+int test_batch_pool_concurrent(void)
+{
+    int errors = 0;
+    uint64_t i, first, last;
+    int c;
+    batch_pool_t pool;
+    pthread_t callers[TEST_POOL_CALLERS];
+    test_pool_caller_t args[TEST_POOL_CALLERS];
+    uint64_t *src = (uint64_t *)malloc(TEST_POOL_ITEMS * sizeof(uint64_t));
+    uint64_t *keys = (uint64_t *)malloc(TEST_POOL_CALLERS * TEST_POOL_KEYS * sizeof(uint64_t));
+    uint64_t *exp = (uint64_t *)malloc(TEST_POOL_CALLERS * TEST_POOL_KEYS * sizeof(uint64_t));
+    for (i = 0; i < TEST_POOL_ITEMS; i++)
+    {
+        src[i] = ((i * 2) + 1);
+    }
+    // the keys include values below the minimum and above the maximum
+    for (i = 0; i < (TEST_POOL_CALLERS * TEST_POOL_KEYS); i++)
+    {
+        keys[i] = (((i * 7919) % TEST_POOL_ITEMS) * 2 + (i & 1));
+        first = 0;
+        last = TEST_POOL_ITEMS;
+        exp[i] = col_find_first_uint64_t(src, &first, &last, keys[i]);
+    }
+    keys[TEST_POOL_KEYS - 1] = UINT64_MAX;
+    exp[TEST_POOL_KEYS - 1] = TEST_POOL_ITEMS;
+    if (batch_pool_init(&pool, 4, false) != 0)
+    {
+        (void)fprintf_s(stderr, "%s Unable to start the threads\n", __func__);
+        free(src);
+        free(keys);
+        free(exp);
+        return 1;
+    }
+    for (c = 0; c < TEST_POOL_CALLERS; c++)
+    {
+        args[c].pool = &pool;
+        args[c].src = src;
+        args[c].keys = (keys + ((uint64_t)c * TEST_POOL_KEYS));
+        args[c].exp = (exp + ((uint64_t)c * TEST_POOL_KEYS));
+        args[c].errors = 0;
+        if (pthread_create(&callers[c], NULL, test_pool_caller, &args[c]) != 0)
+        {
+            (void)fprintf_s(stderr, "%s Unable to start the caller %d\n", __func__, c);
+            args[c].errors = 1;
+            callers[c] = pthread_self();
+        }
+    }
+#ifdef BATCH_POOL_NUMA
+    if (pool.nnodes < 2)
+    {
+        pool.nnodes = 2; // emulate a NUMA host
+    }
+    // the replicas can be changed while the other threads run their batches
+    for (c = 0; c < TEST_POOL_CALLS; c++)
+    {
+        if (batch_pool_replicate(&pool, src, (TEST_POOL_ITEMS * sizeof(uint64_t))) != 0)
+        {
+            (void)fprintf_s(stderr, "%s Unable to replicate the column\n", __func__);
+            ++errors;
+        }
+        batch_pool_release_replicas(&pool);
+    }
+#endif
+    for (c = 0; c < TEST_POOL_CALLERS; c++)
+    {
+        if (!pthread_equal(callers[c], pthread_self()))
+        {
+            pthread_join(callers[c], NULL);
+        }
+        if (args[c].errors != 0)
+        {
+            (void)fprintf_s(stderr, "%s Caller %d got %d unexpected batches\n", __func__, c, args[c].errors);
+            errors += args[c].errors;
+        }
+    }
+    batch_pool_destroy(&pool);
+    free(src);
+    free(keys);
+    free(exp);
+    return errors;
+}
+
+#define define_test_col_find_batch_pool(T) \
+int test_col_find_batch_pool_##T(void) \
+{ \
+    int errors = 0; \
+    uint64_t i, first, last; \
+    uint32_t t; \
+    batch_pool_t pool; \
+    T *src = (T *)malloc(TEST_POOL_ITEMS * sizeof(T)); \
+    T *keys = (T *)malloc(TEST_POOL_KEYS * sizeof(T)); \
+    uint64_t *exp = (uint64_t *)malloc(TEST_POOL_KEYS * sizeof(uint64_t)); \
+    uint64_t *out = (uint64_t *)malloc(TEST_POOL_KEYS * sizeof(uint64_t)); \
+    for (i = 0; i < TEST_POOL_ITEMS; i++) \
+    { \
+        src[i] = (T)((i * 2) / test_pool_div[sizeof(T)]); \
+    } \
+    for (i = 0; i < TEST_POOL_KEYS; i++) \
+    { \
+        keys[i] = (T)((((i * 7919) % TEST_POOL_ITEMS) * 2 + (i & 1)) / test_pool_div[sizeof(T)]); \
+    } \
+    first = 11; \
+    last = (TEST_POOL_ITEMS - 13); \
+    for (t = 0; t < TEST_POOL_NTHREADS; t++) \
+    { \
+        if (batch_pool_init(&pool, test_pool_threads[t], (t & 1)) != 0) \
+        { \
+            (void)fprintf_s(stderr, "%s Unable to start %" PRIu32 " threads\n", __func__, test_pool_threads[t]); \
+            ++errors; \
+            break; \
+        } \
+        col_find_first_batch_##T(src, first, last, keys, TEST_POOL_KEYS, exp); \
+        col_find_first_batch_pool_##T(&pool, src, first, last, keys, TEST_POOL_KEYS, out); \
+        if (memcmp(exp, out, (TEST_POOL_KEYS * sizeof(uint64_t))) != 0) \
+        { \
+            (void)fprintf_s(stderr, "%s FIRST (%" PRIu32 " threads) Unexpected results\n", __func__, test_pool_threads[t]); \
+            ++errors; \
+        } \
+        col_find_last_batch_##T(src, first, last, keys, TEST_POOL_KEYS, exp); \
+        col_find_last_batch_pool_##T(&pool, src, first, last, keys, TEST_POOL_KEYS, out); \
+        if (memcmp(exp, out, (TEST_POOL_KEYS * sizeof(uint64_t))) != 0) \
+        { \
+            (void)fprintf_s(stderr, "%s LAST (%" PRIu32 " threads) Unexpected results\n", __func__, test_pool_threads[t]); \
+            ++errors; \
+        } \
+        batch_pool_destroy(&pool); \
+    } \
+    free(src); \
+    free(keys); \
+    free(exp); \
+    free(out); \
+    return errors; \
+}
+
+define_test_col_find_batch_pool(uint8_t)
+define_test_col_find_batch_pool(uint16_t)
+define_test_col_find_batch_pool(uint32_t)
+define_test_col_find_batch_pool(uint64_t)
+
+#define define_test_find_batch_pool(O, T) \
+int test_find_batch_pool_##O##_##T(mmfile_t mf, uint64_t blkpos) \
+{ \
+    int errors = 0; \
+    uint64_t i; \
+    uint32_t t; \
+    batch_pool_t pool; \
+    T *keys = (T *)malloc(TEST_POOL_KEYS * sizeof(T)); \
+    uint64_t *exp = (uint64_t *)malloc(TEST_POOL_KEYS * sizeof(uint64_t)); \
+    uint64_t *out = (uint64_t *)malloc(TEST_POOL_KEYS * sizeof(uint64_t)); \
+    for (i = 0; i < TEST_POOL_KEYS; i++) \
+    { \
+        keys[i] = (T)(bytes_##O##_to_##T(mf.src, get_address(TEST_BLKLEN, blkpos, ((i * 97) % TEST_DATA_ITEMS))) + (i & 1)); \
+    } \
+    for (t = 0; t < TEST_POOL_NTHREADS; t++) \
+    { \
+        if (batch_pool_init(&pool, test_pool_threads[t], false) != 0) \
+        { \
+            (void)fprintf_s(stderr, "%s Unable to start %" PRIu32 " threads\n", __func__, test_pool_threads[t]); \
+            ++errors; \
+            break; \
+        } \
+        find_first_batch_##O##_##T(mf.src, TEST_BLKLEN, blkpos, 0, TEST_DATA_ITEMS, keys, TEST_POOL_KEYS, exp); \
+        find_first_batch_pool_##O##_##T(&pool, mf.src, TEST_BLKLEN, blkpos, 0, TEST_DATA_ITEMS, keys, TEST_POOL_KEYS, out); \
+        if (memcmp(exp, out, (TEST_POOL_KEYS * sizeof(uint64_t))) != 0) \
+        { \
+            (void)fprintf_s(stderr, "%s FIRST (%" PRIu32 " threads) Unexpected results\n", __func__, test_pool_threads[t]); \
+            ++errors; \
+        } \
+        find_last_batch_##O##_##T(mf.src, TEST_BLKLEN, blkpos, 0, TEST_DATA_ITEMS, keys, TEST_POOL_KEYS, exp); \
+        find_last_batch_pool_##O##_##T(&pool, mf.src, TEST_BLKLEN, blkpos, 0, TEST_DATA_ITEMS, keys, TEST_POOL_KEYS, out); \
+        if (memcmp(exp, out, (TEST_POOL_KEYS * sizeof(uint64_t))) != 0) \
+        { \
+            (void)fprintf_s(stderr, "%s LAST (%" PRIu32 " threads) Unexpected results\n", __func__, test_pool_threads[t]); \
+            ++errors; \
+        } \
+        batch_pool_destroy(&pool); \
+    } \
+    free(keys); \
+    free(exp); \
+    free(out); \
+    return errors; \
+}
+
+define_test_find_batch_pool(be, uint8_t)
+define_test_find_batch_pool(be, uint16_t)
+define_test_find_batch_pool(be, uint32_t)
+define_test_find_batch_pool(be, uint64_t)
+define_test_find_batch_pool(le, uint8_t)
+define_test_find_batch_pool(le, uint16_t)
+define_test_find_batch_pool(le, uint32_t)
+define_test_find_batch_pool(le, uint64_t)
+
+int main()
+{
+    int errors = 0;
+
+    errors += test_batch_pool_run();
+    errors += test_batch_pool_concurrent();
+    errors += test_batch_pool_replicate();
+    errors += test_batch_pool_replica_bounds();
+
+    errors += test_col_find_batch_pool_uint8_t();
+    errors += test_col_find_batch_pool_uint16_t();
+    errors += test_col_find_batch_pool_uint32_t();
+    errors += test_col_find_batch_pool_uint64_t();
+
+    mmfile_t mf = {0};
+    mf.ncols = 1;
+    mf.ctbytes[0] = 12;
+    mmap_binfile("test_data.bin", &mf);
+    if (mf.fd < 0)
+    {
+        (void)fprintf_s(stderr, "can't open test_data.bin for reading\n");
+        return 1;
+    }
+    if (mf.src == MAP_FAILED)
+    {
+        (void)fprintf_s(stderr, "mmap error! [%s]\n", strerror(errno));
+        return 1;
+    }
+    if ((mf.size / TEST_BLKLEN) != TEST_DATA_ITEMS)
+    {
+        (void)fprintf_s(stderr, "Expecting %d items, got instead: %" PRIu64 "\n", TEST_DATA_ITEMS, (mf.size / TEST_BLKLEN));
+        return 1;
+    }
+
+    errors += test_find_batch_pool_be_uint8_t(mf, 0);
+    errors += test_find_batch_pool_be_uint16_t(mf, 2);
+    errors += test_find_batch_pool_be_uint32_t(mf, 4);
+    errors += test_find_batch_pool_be_uint64_t(mf, 8);
+    errors += test_find_batch_pool_le_uint8_t(mf, 1);
+    errors += test_find_batch_pool_le_uint16_t(mf, 6);
+    errors += test_find_batch_pool_le_uint32_t(mf, 8);
+    errors += test_find_batch_pool_le_uint64_t(mf, 0);
+
+    int e = munmap_binfile(mf);
+    if (e != 0)
+    {
+        (void)fprintf_s(stderr, "Error while unmapping the file\n");
+        return 1;
+    }
+
+    return errors;
+}
@@ -4,7 +4,10 @@ package binsearch
 
 /*
 #cgo CFLAGS: -O3 -pedantic -std=c2x -Wextra -Wno-strict-prototypes -Wcast-align -Wundef -Wformat -Wformat-security -Wshadow
-#include "../../c/src/binsearch/binsearch.h"
+#cgo LDFLAGS: -pthread
+#define _GNU_SOURCE // CPU affinity of the batch pool threads
+#include <stdlib.h>
+#include "../../c/src/binsearch/binsearch_pool.h"
 */
 import "C" //nolint:nolintlint,gci,typecheck
 
@@ -1327,3 +1330,379 @@ func (mf TMMFile) ColHasPrevSubUint64(offset uint64, bitstart, bitend uint8, fir
 
 	return ret, uint64(cpos)
 }
+
+// ColCursorUint8 initializes a cursor over the items equal to a 8 bit unsigned integer
+// on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+// The values must be sorted in ascending order.
+// Return the position of the first matching item and the position after the last one.
+func (mf TMMFile) ColCursorUint8(offset, first, last uint64, search uint8) (uint64, uint64) {
+	var cur C.col_cursor_t
+
+	C.col_cursor_uint8_t((*C.uint8_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), C.uint8_t(search), &cur)
+
+	return uint64(cur.pos), uint64(cur.end)
+}
+
+// ColCursorSubUint8 initializes a cursor over the items where the bits between bitstart and bitend
+// are equal to a 8 bit unsigned integer, on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+// The values must be sorted in ascending order by the selected bits.
+// Return the position of the first matching item and the position after the last one.
+func (mf TMMFile) ColCursorSubUint8(offset uint64, bitstart, bitend uint8, first, last uint64, search uint8) (uint64, uint64) {
+	var cur C.col_cursor_t
+
+	C.col_cursor_sub_uint8_t((*C.uint8_t)(unsafe.Add(mf.Src, offset)), C.uint8_t(bitstart), C.uint8_t(bitend), C.uint64_t(first), C.uint64_t(last), C.uint8_t(search), &cur)
+
+	return uint64(cur.pos), uint64(cur.end)
+}
+
+// ColCursorRangeUint8 initializes a cursor over the items between lo and hi (inclusive)
+// on a memory buffer containing contiguos blocks of 8 bit unsigned integers.
+// The values must be sorted in ascending order.
+// Return the position of the first matching item and the position after the last one.
+func (mf TMMFile) ColCursorRangeUint8(offset, first, last uint64, lo, hi uint8) (uint64, uint64) {
+	var cur C.col_cursor_t
+
+	C.col_cursor_range_uint8_t((*C.uint8_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), C.uint8_t(lo), C.uint8_t(hi), &cur)
+
+	return uint64(cur.pos), uint64(cur.end)
+}
+
+// ColCursorNextValuesUint8 returns the values of at most nmax items of a cursor
+// returned by ColCursorUint8, ColCursorSubUint8 or ColCursorRangeUint8,
+// plus the position of the next item (pos is advanced by the number of values).
+// An empty slice is returned when the cursor is exhausted (pos >= end).
+func (mf TMMFile) ColCursorNextValuesUint8(offset, pos, end, nmax uint64) ([]uint8, uint64) {
+	if (end <= pos) || (nmax == 0) {
+		return []uint8{}, pos
+	}
+
+	values := make([]uint8, min(end-pos, nmax))
+	cur := C.col_cursor_t{src: unsafe.Add(mf.Src, offset), pos: C.uint64_t(pos), end: C.uint64_t(end)}
+
+	n := C.col_cursor_next_values_uint8_t(&cur, (*C.uint8_t)(unsafe.Pointer(&values[0])), C.uint64_t(len(values)))
+
+	return values[:n], uint64(cur.pos)
+}
+
+// ColCursorUint16 initializes a cursor over the items equal to a 16 bit unsigned integer
+// on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+// The values must be sorted in ascending order.
+// Return the position of the first matching item and the position after the last one.
+func (mf TMMFile) ColCursorUint16(offset, first, last uint64, search uint16) (uint64, uint64) {
+	var cur C.col_cursor_t
+
+	C.col_cursor_uint16_t((*C.uint16_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), C.uint16_t(search), &cur)
+
+	return uint64(cur.pos), uint64(cur.end)
+}
+
+// ColCursorSubUint16 initializes a cursor over the items where the bits between bitstart and bitend
+// are equal to a 16 bit unsigned integer, on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+// The values must be sorted in ascending order by the selected bits.
+// Return the position of the first matching item and the position after the last one.
+func (mf TMMFile) ColCursorSubUint16(offset uint64, bitstart, bitend uint8, first, last uint64, search uint16) (uint64, uint64) {
+	var cur C.col_cursor_t
+
+	C.col_cursor_sub_uint16_t((*C.uint16_t)(unsafe.Add(mf.Src, offset)), C.uint8_t(bitstart), C.uint8_t(bitend), C.uint64_t(first), C.uint64_t(last), C.uint16_t(search), &cur)
+
+	return uint64(cur.pos), uint64(cur.end)
+}
+
+// ColCursorRangeUint16 initializes a cursor over the items between lo and hi (inclusive)
+// on a memory buffer containing contiguos blocks of 16 bit unsigned integers.
+// The values must be sorted in ascending order.
+// Return the position of the first matching item and the position after the last one.
+func (mf TMMFile) ColCursorRangeUint16(offset, first, last uint64, lo, hi uint16) (uint64, uint64) {
+	var cur C.col_cursor_t
+
+	C.col_cursor_range_uint16_t((*C.uint16_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), C.uint16_t(lo), C.uint16_t(hi), &cur)
+
+	return uint64(cur.pos), uint64(cur.end)
+}
+
+// ColCursorNextValuesUint16 returns the values of at most nmax items of a cursor
+// returned by ColCursorUint16, ColCursorSubUint16 or ColCursorRangeUint16,
+// plus the position of the next item (pos is advanced by the number of values).
+// An empty slice is returned when the cursor is exhausted (pos >= end).
+func (mf TMMFile) ColCursorNextValuesUint16(offset, pos, end, nmax uint64) ([]uint16, uint64) {
+	if (end <= pos) || (nmax == 0) {
+		return []uint16{}, pos
+	}
+
+	values := make([]uint16, min(end-pos, nmax))
+	cur := C.col_cursor_t{src: unsafe.Add(mf.Src, offset), pos: C.uint64_t(pos), end: C.uint64_t(end)}
+
+	n := C.col_cursor_next_values_uint16_t(&cur, (*C.uint16_t)(unsafe.Pointer(&values[0])), C.uint64_t(len(values)))
+
+	return values[:n], uint64(cur.pos)
+}
+
+// ColCursorUint32 initializes a cursor over the items equal to a 32 bit unsigned integer
+// on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+// The values must be sorted in ascending order.
+// Return the position of the first matching item and the position after the last one.
+func (mf TMMFile) ColCursorUint32(offset, first, last uint64, search uint32) (uint64, uint64) {
+	var cur C.col_cursor_t
+
+	C.col_cursor_uint32_t((*C.uint32_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), C.uint32_t(search), &cur)
+
+	return uint64(cur.pos), uint64(cur.end)
+}
+
+// ColCursorSubUint32 initializes a cursor over the items where the bits between bitstart and bitend
+// are equal to a 32 bit unsigned integer, on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+// The values must be sorted in ascending order by the selected bits.
+// Return the position of the first matching item and the position after the last one.
+func (mf TMMFile) ColCursorSubUint32(offset uint64, bitstart, bitend uint8, first, last uint64, search uint32) (uint64, uint64) {
+	var cur C.col_cursor_t
+
+	C.col_cursor_sub_uint32_t((*C.uint32_t)(unsafe.Add(mf.Src, offset)), C.uint8_t(bitstart), C.uint8_t(bitend), C.uint64_t(first), C.uint64_t(last), C.uint32_t(search), &cur)
+
+	return uint64(cur.pos), uint64(cur.end)
+}
+
+// ColCursorRangeUint32 initializes a cursor over the items between lo and hi (inclusive)
+// on a memory buffer containing contiguos blocks of 32 bit unsigned integers.
+// The values must be sorted in ascending order.
+// Return the position of the first matching item and the position after the last one.
+func (mf TMMFile) ColCursorRangeUint32(offset, first, last uint64, lo, hi uint32) (uint64, uint64) {
+	var cur C.col_cursor_t
+
+	C.col_cursor_range_uint32_t((*C.uint32_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), C.uint32_t(lo), C.uint32_t(hi), &cur)
+
+	return uint64(cur.pos), uint64(cur.end)
+}
+
+// ColCursorNextValuesUint32 returns the values of at most nmax items of a cursor
+// returned by ColCursorUint32, ColCursorSubUint32 or ColCursorRangeUint32,
+// plus the position of the next item (pos is advanced by the number of values).
+// An empty slice is returned when the cursor is exhausted (pos >= end).
+func (mf TMMFile) ColCursorNextValuesUint32(offset, pos, end, nmax uint64) ([]uint32, uint64) {
+	if (end <= pos) || (nmax == 0) {
+		return []uint32{}, pos
+	}
+
+	values := make([]uint32, min(end-pos, nmax))
+	cur := C.col_cursor_t{src: unsafe.Add(mf.Src, offset), pos: C.uint64_t(pos), end: C.uint64_t(end)}
+
+	n := C.col_cursor_next_values_uint32_t(&cur, (*C.uint32_t)(unsafe.Pointer(&values[0])), C.uint64_t(len(values)))
+
+	return values[:n], uint64(cur.pos)
+}
+
+// ColCursorUint64 initializes a cursor over the items equal to a 64 bit unsigned integer
+// on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+// The values must be sorted in ascending order.
+// Return the position of the first matching item and the position after the last one.
+func (mf TMMFile) ColCursorUint64(offset, first, last uint64, search uint64) (uint64, uint64) {
+	var cur C.col_cursor_t
+
+	C.col_cursor_uint64_t((*C.uint64_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), C.uint64_t(search), &cur)
+
+	return uint64(cur.pos), uint64(cur.end)
+}
+
+// ColCursorSubUint64 initializes a cursor over the items where the bits between bitstart and bitend
+// are equal to a 64 bit unsigned integer, on a memory buffer containing contiguos blocks of unsigned integers of the same type.
+// The values must be sorted in ascending order by the selected bits.
+// Return the position of the first matching item and the position after the last one.
+func (mf TMMFile) ColCursorSubUint64(offset uint64, bitstart, bitend uint8, first, last uint64, search uint64) (uint64, uint64) {
+	var cur C.col_cursor_t
+
+	C.col_cursor_sub_uint64_t((*C.uint64_t)(unsafe.Add(mf.Src, offset)), C.uint8_t(bitstart), C.uint8_t(bitend), C.uint64_t(first), C.uint64_t(last), C.uint64_t(search), &cur)
+
+	return uint64(cur.pos), uint64(cur.end)
+}
+
+// ColCursorRangeUint64 initializes a cursor over the items between lo and hi (inclusive)
+// on a memory buffer containing contiguos blocks of 64 bit unsigned integers.
+// The values must be sorted in ascending order.
+// Return the position of the first matching item and the position after the last one.
+func (mf TMMFile) ColCursorRangeUint64(offset, first, last uint64, lo, hi uint64) (uint64, uint64) {
+	var cur C.col_cursor_t
+
+	C.col_cursor_range_uint64_t((*C.uint64_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), C.uint64_t(lo), C.uint64_t(hi), &cur)
+
+	return uint64(cur.pos), uint64(cur.end)
+}
+
+// ColCursorNextValuesUint64 returns the values of at most nmax items of a cursor
+// returned by ColCursorUint64, ColCursorSubUint64 or ColCursorRangeUint64,
+// plus the position of the next item (pos is advanced by the number of values).
+// An empty slice is returned when the cursor is exhausted (pos >= end).
+func (mf TMMFile) ColCursorNextValuesUint64(offset, pos, end, nmax uint64) ([]uint64, uint64) {
+	if (end <= pos) || (nmax == 0) {
+		return []uint64{}, pos
+	}
+
+	values := make([]uint64, min(end-pos, nmax))
+	cur := C.col_cursor_t{src: unsafe.Add(mf.Src, offset), pos: C.uint64_t(pos), end: C.uint64_t(end)}
+
+	n := C.col_cursor_next_values_uint64_t(&cur, (*C.uint64_t)(unsafe.Pointer(&values[0])), C.uint64_t(len(values)))
+
+	return values[:n], uint64(cur.pos)
+}
+
+// TBatchPool is a pool of worker threads for the batch searches.
+// The batches of concurrent callers sharing the same pool are serialized.
+type TBatchPool struct {
+	pool *C.batch_pool_t
+}
+
+// NewBatchPool starts a pool of worker threads for the batch searches.
+// The number of workers includes the calling thread (0 = one per online CPU).
+// If pin is true the worker threads are pinned to one CPU each.
+// The pool must be released with Close.
+func NewBatchPool(nthreads uint32, pin bool) (*TBatchPool, error) {
+	p := (*C.batch_pool_t)(C.malloc(C.sizeof_batch_pool_t))
+	if p == nil {
+		return nil, fmt.Errorf("unable to allocate the batch pool")
+	}
+
+	if C.batch_pool_init(p, C.uint32_t(nthreads), C.bool(pin)) != 0 {
+		C.free(unsafe.Pointer(p))
+
+		return nil, fmt.Errorf("unable to start the batch pool threads")
+	}
+
+	return &TBatchPool{pool: p}, nil
+}
+
+// Close stops the worker threads and releases the pool.
+func (bp *TBatchPool) Close() {
+	if bp.pool == nil {
+		return
+	}
+
+	C.batch_pool_destroy(bp.pool)
+	C.free(unsafe.Pointer(bp.pool))
+	bp.pool = nil
+}
+
+// ColFindFirstBatchPoolUint8 search for the first occurrence of multiple 8 bit unsigned integers
+// on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+// using all the workers of the pool with a single call to the C library.
+// The values must be sorted in ascending order.
+// Return the item number of each key if found or last if not found.
+func (mf TMMFile) ColFindFirstBatchPoolUint8(bp *TBatchPool, offset, first, last uint64, keys []uint8) []uint64 {
+	out := make([]uint64, len(keys))
+	if len(keys) == 0 {
+		return out
+	}
+
+	C.col_find_first_batch_pool_uint8_t(bp.pool, (*C.uint8_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), (*C.uint8_t)(unsafe.Pointer(&keys[0])), C.uint64_t(len(keys)), (*C.uint64_t)(unsafe.Pointer(&out[0])))
+
+	return out
+}
+
+// ColFindFirstBatchPoolUint16 search for the first occurrence of multiple 16 bit unsigned integers
+// on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+// using all the workers of the pool with a single call to the C library.
+// The values must be sorted in ascending order.
+// Return the item number of each key if found or last if not found.
+func (mf TMMFile) ColFindFirstBatchPoolUint16(bp *TBatchPool, offset, first, last uint64, keys []uint16) []uint64 {
+	out := make([]uint64, len(keys))
+	if len(keys) == 0 {
+		return out
+	}
+
+	C.col_find_first_batch_pool_uint16_t(bp.pool, (*C.uint16_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), (*C.uint16_t)(unsafe.Pointer(&keys[0])), C.uint64_t(len(keys)), (*C.uint64_t)(unsafe.Pointer(&out[0])))
+
+	return out
+}
+
+// ColFindFirstBatchPoolUint32 search for the first occurrence of multiple 32 bit unsigned integers
+// on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+// using all the workers of the pool with a single call to the C library.
+// The values must be sorted in ascending order.
+// Return the item number of each key if found or last if not found.
+func (mf TMMFile) ColFindFirstBatchPoolUint32(bp *TBatchPool, offset, first, last uint64, keys []uint32) []uint64 {
+	out := make([]uint64, len(keys))
+	if len(keys) == 0 {
+		return out
+	}
+
+	C.col_find_first_batch_pool_uint32_t(bp.pool, (*C.uint32_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), (*C.uint32_t)(unsafe.Pointer(&keys[0])), C.uint64_t(len(keys)), (*C.uint64_t)(unsafe.Pointer(&out[0])))
+
+	return out
+}
+
+// ColFindFirstBatchPoolUint64 search for the first occurrence of multiple 64 bit unsigned integers
+// on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+// using all the workers of the pool with a single call to the C library.
+// The values must be sorted in ascending order.
+// Return the item number of each key if found or last if not found.
+func (mf TMMFile) ColFindFirstBatchPoolUint64(bp *TBatchPool, offset, first, last uint64, keys []uint64) []uint64 {
+	out := make([]uint64, len(keys))
+	if len(keys) == 0 {
+		return out
+	}
+
+	C.col_find_first_batch_pool_uint64_t(bp.pool, (*C.uint64_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), (*C.uint64_t)(unsafe.Pointer(&keys[0])), C.uint64_t(len(keys)), (*C.uint64_t)(unsafe.Pointer(&out[0])))
+
+	return out
+}
+
+// ColFindLastBatchPoolUint8 search for the last occurrence of multiple 8 bit unsigned integers
+// on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+// using all the workers of the pool with a single call to the C library.
+// The values must be sorted in ascending order.
+// Return the item number of each key if found or last if not found.
+func (mf TMMFile) ColFindLastBatchPoolUint8(bp *TBatchPool, offset, first, last uint64, keys []uint8) []uint64 {
+	out := make([]uint64, len(keys))
+	if len(keys) == 0 {
+		return out
+	}
+
+	C.col_find_last_batch_pool_uint8_t(bp.pool, (*C.uint8_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), (*C.uint8_t)(unsafe.Pointer(&keys[0])), C.uint64_t(len(keys)), (*C.uint64_t)(unsafe.Pointer(&out[0])))
+
+	return out
+}
+
+// ColFindLastBatchPoolUint16 search for the last occurrence of multiple 16 bit unsigned integers
+// on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+// using all the workers of the pool with a single call to the C library.
+// The values must be sorted in ascending order.
+// Return the item number of each key if found or last if not found.
+func (mf TMMFile) ColFindLastBatchPoolUint16(bp *TBatchPool, offset, first, last uint64, keys []uint16) []uint64 {
+	out := make([]uint64, len(keys))
+	if len(keys) == 0 {
+		return out
+	}
+
+	C.col_find_last_batch_pool_uint16_t(bp.pool, (*C.uint16_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), (*C.uint16_t)(unsafe.Pointer(&keys[0])), C.uint64_t(len(keys)), (*C.uint64_t)(unsafe.Pointer(&out[0])))
+
+	return out
+}
+
+// ColFindLastBatchPoolUint32 search for the last occurrence of multiple 32 bit unsigned integers
+// on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+// using all the workers of the pool with a single call to the C library.
+// The values must be sorted in ascending order.
+// Return the item number of each key if found or last if not found.
+func (mf TMMFile) ColFindLastBatchPoolUint32(bp *TBatchPool, offset, first, last uint64, keys []uint32) []uint64 {
+	out := make([]uint64, len(keys))
+	if len(keys) == 0 {
+		return out
+	}
+
+	C.col_find_last_batch_pool_uint32_t(bp.pool, (*C.uint32_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), (*C.uint32_t)(unsafe.Pointer(&keys[0])), C.uint64_t(len(keys)), (*C.uint64_t)(unsafe.Pointer(&out[0])))
+
+	return out
+}
+
+// ColFindLastBatchPoolUint64 search for the last occurrence of multiple 64 bit unsigned integers
+// on a memory buffer containing contiguos blocks of unsigned integers of the same type,
+// using all the workers of the pool with a single call to the C library.
+// The values must be sorted in ascending order.
+// Return the item number of each key if found or last if not found.
+func (mf TMMFile) ColFindLastBatchPoolUint64(bp *TBatchPool, offset, first, last uint64, keys []uint64) []uint64 {
+	out := make([]uint64, len(keys))
+	if len(keys) == 0 {
+		return out
+	}
+
+	C.col_find_last_batch_pool_uint64_t(bp.pool, (*C.uint64_t)(unsafe.Add(mf.Src, offset)), C.uint64_t(first), C.uint64_t(last), (*C.uint64_t)(unsafe.Pointer(&keys[0])), C.uint64_t(len(keys)), (*C.uint64_t)(unsafe.Pointer(&out[0])))
+
+	return out
+}
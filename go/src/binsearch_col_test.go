@@ -1154,3 +1154,409 @@ func BenchmarkColFindLastSubUint64(b *testing.B) {
 		cmf.ColFindLastSubUint64(cmf.Index[3], 16, 47, testDataColSub64[4].first, testDataColSub64[4].last, testDataColSub64[4].search)
 	}
 }
+
+func TestColCursorUint8(t *testing.T) {
+	for _, tt := range testDataCol8 {
+		t.Run("", func(t *testing.T) {
+			t.Parallel()
+
+			var numitems uint64
+			if tt.foundFirst < tt.last {
+				numitems = tt.foundLast - tt.foundFirst + 1
+			}
+
+			pos, end := cmf.ColCursorUint8(cmf.Index[0], tt.first, tt.last, tt.search)
+			if (end - pos) != numitems {
+				t.Errorf("Expected items %d, got %d", numitems, end-pos)
+			}
+
+			rpos, rend := cmf.ColCursorRangeUint8(cmf.Index[0], tt.first, tt.last, tt.search, tt.search)
+			if (rend - rpos) != numitems {
+				t.Errorf("Expected range items %d, got %d", numitems, rend-rpos)
+			}
+
+			var counter uint64
+
+			for {
+				var values []uint8
+
+				values, pos = cmf.ColCursorNextValuesUint8(cmf.Index[0], pos, end, 3)
+				if len(values) == 0 {
+					break
+				}
+
+				for _, v := range values {
+					if v != tt.search {
+						t.Errorf("Expected value 0x%x, got 0x%x", tt.search, v)
+					}
+				}
+
+				counter += uint64(len(values))
+			}
+
+			if counter != numitems {
+				t.Errorf("Expected next values %d, got %d", numitems, counter)
+			}
+		})
+	}
+}
+
+func TestColCursorSubUint8(t *testing.T) {
+	for _, tt := range testDataColSub8 {
+		t.Run("", func(t *testing.T) {
+			t.Parallel()
+
+			var numitems uint64
+			if tt.foundFirst < tt.last {
+				numitems = tt.foundLast - tt.foundFirst + 1
+			}
+
+			pos, end := cmf.ColCursorSubUint8(cmf.Index[0], 0, 7, tt.first, tt.last, tt.search)
+			if (end - pos) != numitems {
+				t.Errorf("Expected items %d, got %d", numitems, end-pos)
+			}
+
+			if (numitems > 0) && (pos != tt.foundFirst) {
+				t.Errorf("Expected first 0x%x, got 0x%x", tt.foundFirst, pos)
+			}
+		})
+	}
+}
+
+func TestColCursorUint16(t *testing.T) {
+	for _, tt := range testDataCol16 {
+		t.Run("", func(t *testing.T) {
+			t.Parallel()
+
+			var numitems uint64
+			if tt.foundFirst < tt.last {
+				numitems = tt.foundLast - tt.foundFirst + 1
+			}
+
+			pos, end := cmf.ColCursorUint16(cmf.Index[1], tt.first, tt.last, tt.search)
+			if (end - pos) != numitems {
+				t.Errorf("Expected items %d, got %d", numitems, end-pos)
+			}
+
+			rpos, rend := cmf.ColCursorRangeUint16(cmf.Index[1], tt.first, tt.last, tt.search, tt.search)
+			if (rend - rpos) != numitems {
+				t.Errorf("Expected range items %d, got %d", numitems, rend-rpos)
+			}
+
+			var counter uint64
+
+			for {
+				var values []uint16
+
+				values, pos = cmf.ColCursorNextValuesUint16(cmf.Index[1], pos, end, 3)
+				if len(values) == 0 {
+					break
+				}
+
+				for _, v := range values {
+					if v != tt.search {
+						t.Errorf("Expected value 0x%x, got 0x%x", tt.search, v)
+					}
+				}
+
+				counter += uint64(len(values))
+			}
+
+			if counter != numitems {
+				t.Errorf("Expected next values %d, got %d", numitems, counter)
+			}
+		})
+	}
+}
+
+func TestColCursorSubUint16(t *testing.T) {
+	for _, tt := range testDataColSub16 {
+		t.Run("", func(t *testing.T) {
+			t.Parallel()
+
+			var numitems uint64
+			if tt.foundFirst < tt.last {
+				numitems = tt.foundLast - tt.foundFirst + 1
+			}
+
+			pos, end := cmf.ColCursorSubUint16(cmf.Index[1], 0, 15, tt.first, tt.last, tt.search)
+			if (end - pos) != numitems {
+				t.Errorf("Expected items %d, got %d", numitems, end-pos)
+			}
+
+			if (numitems > 0) && (pos != tt.foundFirst) {
+				t.Errorf("Expected first 0x%x, got 0x%x", tt.foundFirst, pos)
+			}
+		})
+	}
+}
+
+func TestColCursorUint32(t *testing.T) {
+	for _, tt := range testDataCol32 {
+		t.Run("", func(t *testing.T) {
+			t.Parallel()
+
+			var numitems uint64
+			if tt.foundFirst < tt.last {
+				numitems = tt.foundLast - tt.foundFirst + 1
+			}
+
+			pos, end := cmf.ColCursorUint32(cmf.Index[2], tt.first, tt.last, tt.search)
+			if (end - pos) != numitems {
+				t.Errorf("Expected items %d, got %d", numitems, end-pos)
+			}
+
+			rpos, rend := cmf.ColCursorRangeUint32(cmf.Index[2], tt.first, tt.last, tt.search, tt.search)
+			if (rend - rpos) != numitems {
+				t.Errorf("Expected range items %d, got %d", numitems, rend-rpos)
+			}
+
+			var counter uint64
+
+			for {
+				var values []uint32
+
+				values, pos = cmf.ColCursorNextValuesUint32(cmf.Index[2], pos, end, 3)
+				if len(values) == 0 {
+					break
+				}
+
+				for _, v := range values {
+					if v != tt.search {
+						t.Errorf("Expected value 0x%x, got 0x%x", tt.search, v)
+					}
+				}
+
+				counter += uint64(len(values))
+			}
+
+			if counter != numitems {
+				t.Errorf("Expected next values %d, got %d", numitems, counter)
+			}
+		})
+	}
+}
+
+func TestColCursorSubUint32(t *testing.T) {
+	for _, tt := range testDataColSub32 {
+		t.Run("", func(t *testing.T) {
+			t.Parallel()
+
+			var numitems uint64
+			if tt.foundFirst < tt.last {
+				numitems = tt.foundLast - tt.foundFirst + 1
+			}
+
+			pos, end := cmf.ColCursorSubUint32(cmf.Index[2], 8, 23, tt.first, tt.last, tt.search)
+			if (end - pos) != numitems {
+				t.Errorf("Expected items %d, got %d", numitems, end-pos)
+			}
+
+			if (numitems > 0) && (pos != tt.foundFirst) {
+				t.Errorf("Expected first 0x%x, got 0x%x", tt.foundFirst, pos)
+			}
+		})
+	}
+}
+
+func TestColCursorUint64(t *testing.T) {
+	for _, tt := range testDataCol64 {
+		t.Run("", func(t *testing.T) {
+			t.Parallel()
+
+			var numitems uint64
+			if tt.foundFirst < tt.last {
+				numitems = tt.foundLast - tt.foundFirst + 1
+			}
+
+			pos, end := cmf.ColCursorUint64(cmf.Index[3], tt.first, tt.last, tt.search)
+			if (end - pos) != numitems {
+				t.Errorf("Expected items %d, got %d", numitems, end-pos)
+			}
+
+			rpos, rend := cmf.ColCursorRangeUint64(cmf.Index[3], tt.first, tt.last, tt.search, tt.search)
+			if (rend - rpos) != numitems {
+				t.Errorf("Expected range items %d, got %d", numitems, rend-rpos)
+			}
+
+			var counter uint64
+
+			for {
+				var values []uint64
+
+				values, pos = cmf.ColCursorNextValuesUint64(cmf.Index[3], pos, end, 3)
+				if len(values) == 0 {
+					break
+				}
+
+				for _, v := range values {
+					if v != tt.search {
+						t.Errorf("Expected value 0x%x, got 0x%x", tt.search, v)
+					}
+				}
+
+				counter += uint64(len(values))
+			}
+
+			if counter != numitems {
+				t.Errorf("Expected next values %d, got %d", numitems, counter)
+			}
+		})
+	}
+}
+
+func TestColCursorSubUint64(t *testing.T) {
+	for _, tt := range testDataColSub64 {
+		t.Run("", func(t *testing.T) {
+			t.Parallel()
+
+			var numitems uint64
+			if tt.foundFirst < tt.last {
+				numitems = tt.foundLast - tt.foundFirst + 1
+			}
+
+			pos, end := cmf.ColCursorSubUint64(cmf.Index[3], 16, 47, tt.first, tt.last, tt.search)
+			if (end - pos) != numitems {
+				t.Errorf("Expected items %d, got %d", numitems, end-pos)
+			}
+
+			if (numitems > 0) && (pos != tt.foundFirst) {
+				t.Errorf("Expected first 0x%x, got 0x%x", tt.foundFirst, pos)
+			}
+		})
+	}
+}
+
+func TestColFindBatchPoolUint8(t *testing.T) {
+	bp, err := NewBatchPool(2, false)
+	if err != nil {
+		t.Fatalf("Unexpected error: %v", err)
+	}
+
+	defer bp.Close()
+
+	keys := make([]uint8, 0, len(testDataCol8))
+	for _, tt := range testDataCol8 {
+		keys = append(keys, tt.search)
+	}
+
+	rf := cmf.ColFindFirstBatchPoolUint8(bp, cmf.Index[0], 0, cmf.NRows, keys)
+	rl := cmf.ColFindLastBatchPoolUint8(bp, cmf.Index[0], 0, cmf.NRows, keys)
+
+	for k, search := range keys {
+		h, _, _ := cmf.ColFindFirstUint8(cmf.Index[0], 0, cmf.NRows, search)
+		if rf[k] != h {
+			t.Errorf("Expected first 0x%x, got 0x%x", h, rf[k])
+		}
+
+		h, _, _ = cmf.ColFindLastUint8(cmf.Index[0], 0, cmf.NRows, search)
+		if rl[k] != h {
+			t.Errorf("Expected last 0x%x, got 0x%x", h, rl[k])
+		}
+	}
+}
+
+func TestColFindBatchPoolUint16(t *testing.T) {
+	bp, err := NewBatchPool(2, false)
+	if err != nil {
+		t.Fatalf("Unexpected error: %v", err)
+	}
+
+	defer bp.Close()
+
+	keys := make([]uint16, 0, len(testDataCol16))
+	for _, tt := range testDataCol16 {
+		keys = append(keys, tt.search)
+	}
+
+	rf := cmf.ColFindFirstBatchPoolUint16(bp, cmf.Index[1], 0, cmf.NRows, keys)
+	rl := cmf.ColFindLastBatchPoolUint16(bp, cmf.Index[1], 0, cmf.NRows, keys)
+
+	for k, search := range keys {
+		h, _, _ := cmf.ColFindFirstUint16(cmf.Index[1], 0, cmf.NRows, search)
+		if rf[k] != h {
+			t.Errorf("Expected first 0x%x, got 0x%x", h, rf[k])
+		}
+
+		h, _, _ = cmf.ColFindLastUint16(cmf.Index[1], 0, cmf.NRows, search)
+		if rl[k] != h {
+			t.Errorf("Expected last 0x%x, got 0x%x", h, rl[k])
+		}
+	}
+}
+
+func TestColFindBatchPoolUint32(t *testing.T) {
+	bp, err := NewBatchPool(2, false)
+	if err != nil {
+		t.Fatalf("Unexpected error: %v", err)
+	}
+
+	defer bp.Close()
+
+	keys := make([]uint32, 0, len(testDataCol32))
+	for _, tt := range testDataCol32 {
+		keys = append(keys, tt.search)
+	}
+
+	rf := cmf.ColFindFirstBatchPoolUint32(bp, cmf.Index[2], 0, cmf.NRows, keys)
+	rl := cmf.ColFindLastBatchPoolUint32(bp, cmf.Index[2], 0, cmf.NRows, keys)
+
+	for k, search := range keys {
+		h, _, _ := cmf.ColFindFirstUint32(cmf.Index[2], 0, cmf.NRows, search)
+		if rf[k] != h {
+			t.Errorf("Expected first 0x%x, got 0x%x", h, rf[k])
+		}
+
+		h, _, _ = cmf.ColFindLastUint32(cmf.Index[2], 0, cmf.NRows, search)
+		if rl[k] != h {
+			t.Errorf("Expected last 0x%x, got 0x%x", h, rl[k])
+		}
+	}
+}
+
+func TestColFindBatchPoolUint64(t *testing.T) {
+	bp, err := NewBatchPool(2, false)
+	if err != nil {
+		t.Fatalf("Unexpected error: %v", err)
+	}
+
+	defer bp.Close()
+
+	keys := make([]uint64, 0, len(testDataCol64))
+	for _, tt := range testDataCol64 {
+		keys = append(keys, tt.search)
+	}
+
+	rf := cmf.ColFindFirstBatchPoolUint64(bp, cmf.Index[3], 0, cmf.NRows, keys)
+	rl := cmf.ColFindLastBatchPoolUint64(bp, cmf.Index[3], 0, cmf.NRows, keys)
+
+	for k, search := range keys {
+		h, _, _ := cmf.ColFindFirstUint64(cmf.Index[3], 0, cmf.NRows, search)
+		if rf[k] != h {
+			t.Errorf("Expected first 0x%x, got 0x%x", h, rf[k])
+		}
+
+		h, _, _ = cmf.ColFindLastUint64(cmf.Index[3], 0, cmf.NRows, search)
+		if rl[k] != h {
+			t.Errorf("Expected last 0x%x, got 0x%x", h, rl[k])
+		}
+	}
+}
+
+func BenchmarkColFindFirstBatchPoolUint32(b *testing.B) {
+	bp, err := NewBatchPool(0, true)
+	if err != nil {
+		b.Fatalf("Unexpected error: %v", err)
+	}
+
+	defer bp.Close()
+
+	keys := make([]uint32, 0, len(testDataCol32))
+	for _, tt := range testDataCol32 {
+		keys = append(keys, tt.search)
+	}
+
+	for b.Loop() {
+		cmf.ColFindFirstBatchPoolUint32(bp, cmf.Index[2], 0, cmf.NRows, keys)
+	}
+}
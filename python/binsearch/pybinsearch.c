@@ -8,7 +8,7 @@
 #define MODULE_NAME "binsearch"
 
 #include <Python.h>
-#include "../../c/src/binsearch/binsearch.h"
+#include "../../c/src/binsearch/binsearch_pool.h"
 #include "pybinsearch.h"
 
 #ifndef Py_UNUSED // This is already defined for Python 3.4 onwards
@@ -73,13 +73,88 @@ static PyObject* py_mmap_binfile(PyObject *Py_UNUSED(ignored), PyObject *args, P
     return result;
 }
 
+// Copy the items of an optional sequence of small unsigned integers in the array dst of MAXCOLS elements.
+static int py_parse_uint8_seq(PyObject *obj, uint8_t *dst)
+{
+    if ((obj == NULL) || (obj == Py_None))
+    {
+        return 0;
+    }
+    PyObject *seq = PySequence_Fast(obj, "argument must be iterable");
+    if (!seq)
+    {
+        return -1;
+    }
+    Py_ssize_t i, n = PySequence_Fast_GET_SIZE(seq);
+    for (i = 0; (i < n) && (i < MAXCOLS); i++)
+    {
+        dst[i] = (uint8_t)PyLong_AsUnsignedLong(PySequence_Fast_GET_ITEM(seq, i));
+    }
+    Py_DECREF(seq);
+    return (PyErr_Occurred() ? -1 : 0);
+}
+
+static PyObject* py_mmap_binfile_ex(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result;
+    const char *file;
+    PyObject *ctbytes = NULL;
+    PyObject *col_advice = NULL;
+    PyObject *col_lock = NULL;
+    uint8_t lock[MAXCOLS] = {0};
+    mmap_opts_t opts = {0};
+    static char *kwlist[] = {"file", "ctbytes", "flags", "advice", "col_advice", "col_lock", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "sO|IbOO", kwlist, &file, &ctbytes, &opts.flags, &opts.advice, &col_advice, &col_lock))
+        return NULL;
+    mmfile_t h = {0};
+    PyObject *seq = PySequence_Fast(ctbytes, "argument must be iterable");
+    if (!seq)
+    {
+        return NULL;
+    }
+    h.ncols = (uint8_t)PySequence_Fast_GET_SIZE(seq);
+    Py_DECREF(seq);
+    if ((py_parse_uint8_seq(ctbytes, h.ctbytes) != 0) || (py_parse_uint8_seq(col_advice, opts.col_advice) != 0) || (py_parse_uint8_seq(col_lock, lock) != 0))
+    {
+        return NULL;
+    }
+    int i;
+    for (i = 0; i < MAXCOLS; i++)
+    {
+        opts.col_lock[i] = (lock[i] != 0);
+    }
+    int ret;
+    Py_BEGIN_ALLOW_THREADS
+    ret = mmap_binfile_ex(file, &h, &opts);
+    Py_END_ALLOW_THREADS
+    PyObject* index = PyList_New(0);
+    for (i = 0; i < h.ncols; i++)
+    {
+        PyList_Append(index, Py_BuildValue("K", h.index[i]));
+    }
+    result = PyTuple_New(11);
+    PyTuple_SetItem(result, 0, PyCapsule_New((void*)h.src, "src", NULL));
+    PyTuple_SetItem(result, 1, Py_BuildValue("i", h.fd));
+    PyTuple_SetItem(result, 2, Py_BuildValue("K", h.size));
+    PyTuple_SetItem(result, 3, Py_BuildValue("K", h.doffset));
+    PyTuple_SetItem(result, 4, Py_BuildValue("K", h.dlength));
+    PyTuple_SetItem(result, 5, Py_BuildValue("K", h.nrows));
+    PyTuple_SetItem(result, 6, Py_BuildValue("B", h.ncols));
+    PyTuple_SetItem(result, 7, index);
+    PyTuple_SetItem(result, 8, PyCapsule_New((void*)h.index, "index", NULL));
+    PyTuple_SetItem(result, 9, Py_BuildValue("K", h.mapsize));
+    PyTuple_SetItem(result, 10, Py_BuildValue("i", ret));
+    return result;
+}
+
 static PyObject* py_munmap_binfile(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
 {
     mmfile_t mf;
     PyObject *result;
     PyObject* mfsrc = NULL;
-    static char *kwlist[] = {"mfsrc", "fd", "size", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OiK", kwlist, &mfsrc, &mf.fd, &mf.size))
+    static char *kwlist[] = {"mfsrc", "fd", "size", "mapsize", NULL};
+    mf.mapsize = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OiK|K", kwlist, &mfsrc, &mf.fd, &mf.size, &mf.mapsize))
         return NULL;
     mf.src = (uint8_t *)PyCapsule_GetPointer(mfsrc, "src");
     int h = munmap_binfile(mf);
@@ -1977,9 +2052,1204 @@ static PyObject* py_col_has_prev_sub_uint64(PyObject *Py_UNUSED(ignored), PyObje
 
 // ----------
 
+static PyObject* py_col_cursor_uint8(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result;
+    uint64_t first, last;
+    uint8_t search;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "first", "last", "search", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKKB", kwlist, &mfsrc, &offset, &first, &last, &search))
+        return NULL;
+    const uint8_t *src = (const uint8_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_cursor_uint8_t(src, first, last, search, &cur);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, Py_BuildValue("K", cur.pos));
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.end));
+    return result;
+}
+
+static PyObject* py_col_cursor_uint16(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result;
+    uint64_t first, last;
+    uint16_t search;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "first", "last", "search", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKKH", kwlist, &mfsrc, &offset, &first, &last, &search))
+        return NULL;
+    const uint16_t *src = (const uint16_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_cursor_uint16_t(src, first, last, search, &cur);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, Py_BuildValue("K", cur.pos));
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.end));
+    return result;
+}
+
+static PyObject* py_col_cursor_uint32(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result;
+    uint64_t first, last;
+    uint32_t search;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "first", "last", "search", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKKI", kwlist, &mfsrc, &offset, &first, &last, &search))
+        return NULL;
+    const uint32_t *src = (const uint32_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_cursor_uint32_t(src, first, last, search, &cur);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, Py_BuildValue("K", cur.pos));
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.end));
+    return result;
+}
+
+static PyObject* py_col_cursor_uint64(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result;
+    uint64_t first, last;
+    uint64_t search;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "first", "last", "search", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKKK", kwlist, &mfsrc, &offset, &first, &last, &search))
+        return NULL;
+    const uint64_t *src = (const uint64_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_cursor_uint64_t(src, first, last, search, &cur);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, Py_BuildValue("K", cur.pos));
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.end));
+    return result;
+}
+
+// ----------
+
+static PyObject* py_col_cursor_sub_uint8(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result;
+    uint64_t first, last;
+    uint8_t bitstart, bitend;
+    uint8_t search;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "bitstart", "bitend", "first", "last", "search", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKBBKKB", kwlist, &mfsrc, &offset, &bitstart, &bitend, &first, &last, &search))
+        return NULL;
+    const uint8_t *src = (const uint8_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_cursor_sub_uint8_t(src, bitstart, bitend, first, last, search, &cur);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, Py_BuildValue("K", cur.pos));
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.end));
+    return result;
+}
+
+static PyObject* py_col_cursor_sub_uint16(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result;
+    uint64_t first, last;
+    uint8_t bitstart, bitend;
+    uint16_t search;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "bitstart", "bitend", "first", "last", "search", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKBBKKH", kwlist, &mfsrc, &offset, &bitstart, &bitend, &first, &last, &search))
+        return NULL;
+    const uint16_t *src = (const uint16_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_cursor_sub_uint16_t(src, bitstart, bitend, first, last, search, &cur);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, Py_BuildValue("K", cur.pos));
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.end));
+    return result;
+}
+
+static PyObject* py_col_cursor_sub_uint32(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result;
+    uint64_t first, last;
+    uint8_t bitstart, bitend;
+    uint32_t search;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "bitstart", "bitend", "first", "last", "search", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKBBKKI", kwlist, &mfsrc, &offset, &bitstart, &bitend, &first, &last, &search))
+        return NULL;
+    const uint32_t *src = (const uint32_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_cursor_sub_uint32_t(src, bitstart, bitend, first, last, search, &cur);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, Py_BuildValue("K", cur.pos));
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.end));
+    return result;
+}
+
+static PyObject* py_col_cursor_sub_uint64(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result;
+    uint64_t first, last;
+    uint8_t bitstart, bitend;
+    uint64_t search;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "bitstart", "bitend", "first", "last", "search", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKBBKKK", kwlist, &mfsrc, &offset, &bitstart, &bitend, &first, &last, &search))
+        return NULL;
+    const uint64_t *src = (const uint64_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_cursor_sub_uint64_t(src, bitstart, bitend, first, last, search, &cur);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, Py_BuildValue("K", cur.pos));
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.end));
+    return result;
+}
+
+// ----------
+
+static PyObject* py_col_cursor_range_uint8(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result;
+    uint64_t first, last;
+    uint8_t lo, hi;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "first", "last", "lo", "hi", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKKBB", kwlist, &mfsrc, &offset, &first, &last, &lo, &hi))
+        return NULL;
+    const uint8_t *src = (const uint8_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_cursor_range_uint8_t(src, first, last, lo, hi, &cur);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, Py_BuildValue("K", cur.pos));
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.end));
+    return result;
+}
+
+static PyObject* py_col_cursor_range_uint16(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result;
+    uint64_t first, last;
+    uint16_t lo, hi;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "first", "last", "lo", "hi", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKKHH", kwlist, &mfsrc, &offset, &first, &last, &lo, &hi))
+        return NULL;
+    const uint16_t *src = (const uint16_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_cursor_range_uint16_t(src, first, last, lo, hi, &cur);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, Py_BuildValue("K", cur.pos));
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.end));
+    return result;
+}
+
+static PyObject* py_col_cursor_range_uint32(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result;
+    uint64_t first, last;
+    uint32_t lo, hi;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "first", "last", "lo", "hi", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKKII", kwlist, &mfsrc, &offset, &first, &last, &lo, &hi))
+        return NULL;
+    const uint32_t *src = (const uint32_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_cursor_range_uint32_t(src, first, last, lo, hi, &cur);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, Py_BuildValue("K", cur.pos));
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.end));
+    return result;
+}
+
+static PyObject* py_col_cursor_range_uint64(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result;
+    uint64_t first, last;
+    uint64_t lo, hi;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "first", "last", "lo", "hi", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKKKK", kwlist, &mfsrc, &offset, &first, &last, &lo, &hi))
+        return NULL;
+    const uint64_t *src = (const uint64_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_cursor_range_uint64_t(src, first, last, lo, hi, &cur);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, Py_BuildValue("K", cur.pos));
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.end));
+    return result;
+}
+
+// ----------
+
+static PyObject* py_col_cursor_next_values_uint8(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result, *values;
+    uint64_t pos, end, nmax, i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "pos", "end", "nmax", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKKK", kwlist, &mfsrc, &offset, &pos, &end, &nmax))
+        return NULL;
+    cur.src = (const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset;
+    cur.pos = pos;
+    cur.end = (end > pos) ? end : pos;
+    n = (cur.end - cur.pos);
+    if (n > nmax)
+    {
+        n = nmax;
+    }
+    uint8_t *dst = (uint8_t *)PyMem_Malloc((n + 1) * sizeof(uint8_t));
+    if (dst == NULL)
+        return PyErr_NoMemory();
+    n = col_cursor_next_values_uint8_t(&cur, dst, n);
+    values = PyList_New((Py_ssize_t)n);
+    if (values == NULL)
+    {
+        PyMem_Free(dst);
+        return NULL;
+    }
+    for (i = 0; i < n; i++)
+    {
+        PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("B", dst[i]));
+    }
+    PyMem_Free(dst);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, values);
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.pos));
+    return result;
+}
+
+static PyObject* py_col_cursor_next_values_uint16(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result, *values;
+    uint64_t pos, end, nmax, i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "pos", "end", "nmax", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKKK", kwlist, &mfsrc, &offset, &pos, &end, &nmax))
+        return NULL;
+    cur.src = (const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset;
+    cur.pos = pos;
+    cur.end = (end > pos) ? end : pos;
+    n = (cur.end - cur.pos);
+    if (n > nmax)
+    {
+        n = nmax;
+    }
+    uint16_t *dst = (uint16_t *)PyMem_Malloc((n + 1) * sizeof(uint16_t));
+    if (dst == NULL)
+        return PyErr_NoMemory();
+    n = col_cursor_next_values_uint16_t(&cur, dst, n);
+    values = PyList_New((Py_ssize_t)n);
+    if (values == NULL)
+    {
+        PyMem_Free(dst);
+        return NULL;
+    }
+    for (i = 0; i < n; i++)
+    {
+        PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("H", dst[i]));
+    }
+    PyMem_Free(dst);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, values);
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.pos));
+    return result;
+}
+
+static PyObject* py_col_cursor_next_values_uint32(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result, *values;
+    uint64_t pos, end, nmax, i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "pos", "end", "nmax", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKKK", kwlist, &mfsrc, &offset, &pos, &end, &nmax))
+        return NULL;
+    cur.src = (const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset;
+    cur.pos = pos;
+    cur.end = (end > pos) ? end : pos;
+    n = (cur.end - cur.pos);
+    if (n > nmax)
+    {
+        n = nmax;
+    }
+    uint32_t *dst = (uint32_t *)PyMem_Malloc((n + 1) * sizeof(uint32_t));
+    if (dst == NULL)
+        return PyErr_NoMemory();
+    n = col_cursor_next_values_uint32_t(&cur, dst, n);
+    values = PyList_New((Py_ssize_t)n);
+    if (values == NULL)
+    {
+        PyMem_Free(dst);
+        return NULL;
+    }
+    for (i = 0; i < n; i++)
+    {
+        PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("I", dst[i]));
+    }
+    PyMem_Free(dst);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, values);
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.pos));
+    return result;
+}
+
+static PyObject* py_col_cursor_next_values_uint64(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *result, *values;
+    uint64_t pos, end, nmax, i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    col_cursor_t cur;
+    static char *kwlist[] = {"mfsrc", "offset", "pos", "end", "nmax", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKKK", kwlist, &mfsrc, &offset, &pos, &end, &nmax))
+        return NULL;
+    cur.src = (const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset;
+    cur.pos = pos;
+    cur.end = (end > pos) ? end : pos;
+    n = (cur.end - cur.pos);
+    if (n > nmax)
+    {
+        n = nmax;
+    }
+    uint64_t *dst = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    if (dst == NULL)
+        return PyErr_NoMemory();
+    n = col_cursor_next_values_uint64_t(&cur, dst, n);
+    values = PyList_New((Py_ssize_t)n);
+    if (values == NULL)
+    {
+        PyMem_Free(dst);
+        return NULL;
+    }
+    for (i = 0; i < n; i++)
+    {
+        PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("K", dst[i]));
+    }
+    PyMem_Free(dst);
+    result = PyTuple_New(2);
+    PyTuple_SetItem(result, 0, values);
+    PyTuple_SetItem(result, 1, Py_BuildValue("K", cur.pos));
+    return result;
+}
+
+// ----------
+
+static PyObject* py_col_gather_range_uint8(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values;
+    uint64_t first, last, i;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"mfsrc", "offset", "first", "last", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKK", kwlist, &mfsrc, &offset, &first, &last))
+        return NULL;
+    const uint8_t *src = (const uint8_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    uint64_t n = (last > first) ? (last - first) : 0;
+    values = PyList_New((Py_ssize_t)n);
+    if (values == NULL)
+        return NULL;
+    for (i = 0; i < n; i++)
+    {
+        PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("B", src[(first + i)]));
+    }
+    return values;
+}
+
+static PyObject* py_col_gather_range_uint16(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values;
+    uint64_t first, last, i;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"mfsrc", "offset", "first", "last", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKK", kwlist, &mfsrc, &offset, &first, &last))
+        return NULL;
+    const uint16_t *src = (const uint16_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    uint64_t n = (last > first) ? (last - first) : 0;
+    values = PyList_New((Py_ssize_t)n);
+    if (values == NULL)
+        return NULL;
+    for (i = 0; i < n; i++)
+    {
+        PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("H", src[(first + i)]));
+    }
+    return values;
+}
+
+static PyObject* py_col_gather_range_uint32(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values;
+    uint64_t first, last, i;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"mfsrc", "offset", "first", "last", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKK", kwlist, &mfsrc, &offset, &first, &last))
+        return NULL;
+    const uint32_t *src = (const uint32_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    uint64_t n = (last > first) ? (last - first) : 0;
+    values = PyList_New((Py_ssize_t)n);
+    if (values == NULL)
+        return NULL;
+    for (i = 0; i < n; i++)
+    {
+        PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("I", src[(first + i)]));
+    }
+    return values;
+}
+
+static PyObject* py_col_gather_range_uint64(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values;
+    uint64_t first, last, i;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"mfsrc", "offset", "first", "last", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKKK", kwlist, &mfsrc, &offset, &first, &last))
+        return NULL;
+    const uint64_t *src = (const uint64_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    uint64_t n = (last > first) ? (last - first) : 0;
+    values = PyList_New((Py_ssize_t)n);
+    if (values == NULL)
+        return NULL;
+    for (i = 0; i < n; i++)
+    {
+        PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("K", src[(first + i)]));
+    }
+    return values;
+}
+
+// ----------
+
+static PyObject* py_col_gather_rows_uint8(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values, *seq;
+    PyObject *rowlist = NULL;
+    uint64_t i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"mfsrc", "offset", "rows", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKO", kwlist, &mfsrc, &offset, &rowlist))
+        return NULL;
+    seq = PySequence_Fast(rowlist, "rows must be a sequence");
+    if (seq == NULL)
+        return NULL;
+    n = (uint64_t)PySequence_Fast_GET_SIZE(seq);
+    uint64_t *rows = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    uint8_t *dst = (uint8_t *)PyMem_Malloc((n + 1) * sizeof(uint8_t));
+    if ((rows == NULL) || (dst == NULL))
+    {
+        PyMem_Free(rows);
+        PyMem_Free(dst);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++)
+    {
+        rows[i] = PyLong_AsUnsignedLongLong(PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i));
+    }
+    Py_DECREF(seq);
+    if (PyErr_Occurred())
+    {
+        PyMem_Free(rows);
+        PyMem_Free(dst);
+        return NULL;
+    }
+    const uint8_t *src = (const uint8_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_gather_rows_uint8_t(src, rows, n, dst);
+    values = PyList_New((Py_ssize_t)n);
+    if (values != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("B", dst[i]));
+        }
+    }
+    PyMem_Free(rows);
+    PyMem_Free(dst);
+    return values;
+}
+
+static PyObject* py_col_gather_rows_uint16(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values, *seq;
+    PyObject *rowlist = NULL;
+    uint64_t i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"mfsrc", "offset", "rows", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKO", kwlist, &mfsrc, &offset, &rowlist))
+        return NULL;
+    seq = PySequence_Fast(rowlist, "rows must be a sequence");
+    if (seq == NULL)
+        return NULL;
+    n = (uint64_t)PySequence_Fast_GET_SIZE(seq);
+    uint64_t *rows = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    uint16_t *dst = (uint16_t *)PyMem_Malloc((n + 1) * sizeof(uint16_t));
+    if ((rows == NULL) || (dst == NULL))
+    {
+        PyMem_Free(rows);
+        PyMem_Free(dst);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++)
+    {
+        rows[i] = PyLong_AsUnsignedLongLong(PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i));
+    }
+    Py_DECREF(seq);
+    if (PyErr_Occurred())
+    {
+        PyMem_Free(rows);
+        PyMem_Free(dst);
+        return NULL;
+    }
+    const uint16_t *src = (const uint16_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_gather_rows_uint16_t(src, rows, n, dst);
+    values = PyList_New((Py_ssize_t)n);
+    if (values != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("H", dst[i]));
+        }
+    }
+    PyMem_Free(rows);
+    PyMem_Free(dst);
+    return values;
+}
+
+static PyObject* py_col_gather_rows_uint32(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values, *seq;
+    PyObject *rowlist = NULL;
+    uint64_t i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"mfsrc", "offset", "rows", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKO", kwlist, &mfsrc, &offset, &rowlist))
+        return NULL;
+    seq = PySequence_Fast(rowlist, "rows must be a sequence");
+    if (seq == NULL)
+        return NULL;
+    n = (uint64_t)PySequence_Fast_GET_SIZE(seq);
+    uint64_t *rows = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    uint32_t *dst = (uint32_t *)PyMem_Malloc((n + 1) * sizeof(uint32_t));
+    if ((rows == NULL) || (dst == NULL))
+    {
+        PyMem_Free(rows);
+        PyMem_Free(dst);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++)
+    {
+        rows[i] = PyLong_AsUnsignedLongLong(PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i));
+    }
+    Py_DECREF(seq);
+    if (PyErr_Occurred())
+    {
+        PyMem_Free(rows);
+        PyMem_Free(dst);
+        return NULL;
+    }
+    const uint32_t *src = (const uint32_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_gather_rows_uint32_t(src, rows, n, dst);
+    values = PyList_New((Py_ssize_t)n);
+    if (values != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("I", dst[i]));
+        }
+    }
+    PyMem_Free(rows);
+    PyMem_Free(dst);
+    return values;
+}
+
+static PyObject* py_col_gather_rows_uint64(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values, *seq;
+    PyObject *rowlist = NULL;
+    uint64_t i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"mfsrc", "offset", "rows", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OKO", kwlist, &mfsrc, &offset, &rowlist))
+        return NULL;
+    seq = PySequence_Fast(rowlist, "rows must be a sequence");
+    if (seq == NULL)
+        return NULL;
+    n = (uint64_t)PySequence_Fast_GET_SIZE(seq);
+    uint64_t *rows = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    uint64_t *dst = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    if ((rows == NULL) || (dst == NULL))
+    {
+        PyMem_Free(rows);
+        PyMem_Free(dst);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++)
+    {
+        rows[i] = PyLong_AsUnsignedLongLong(PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i));
+    }
+    Py_DECREF(seq);
+    if (PyErr_Occurred())
+    {
+        PyMem_Free(rows);
+        PyMem_Free(dst);
+        return NULL;
+    }
+    const uint64_t *src = (const uint64_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    col_gather_rows_uint64_t(src, rows, n, dst);
+    values = PyList_New((Py_ssize_t)n);
+    if (values != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("K", dst[i]));
+        }
+    }
+    PyMem_Free(rows);
+    PyMem_Free(dst);
+    return values;
+}
+
+// ----------
+
+static void py_batch_pool_destructor(PyObject *capsule)
+{
+    batch_pool_t *pool = (batch_pool_t *)PyCapsule_GetPointer(capsule, "pool");
+    if (pool != NULL)
+    {
+        batch_pool_destroy(pool);
+        PyMem_Free(pool);
+    }
+}
+
+static PyObject* py_batch_pool_new(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    uint32_t nthreads = 0;
+    int pin = 1;
+    static char *kwlist[] = {"nthreads", "pin", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "|Ip", kwlist, &nthreads, &pin))
+        return NULL;
+    batch_pool_t *pool = (batch_pool_t *)PyMem_Malloc(sizeof(batch_pool_t));
+    if (pool == NULL)
+        return PyErr_NoMemory();
+    if (batch_pool_init(pool, nthreads, (pin != 0)) != 0)
+    {
+        PyMem_Free(pool);
+        PyErr_SetString(PyExc_RuntimeError, "unable to start the batch pool threads");
+        return NULL;
+    }
+    return PyCapsule_New((void*)pool, "pool", py_batch_pool_destructor);
+}
+
+static PyObject* py_batch_pool_replicate(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *mfpool = NULL;
+    PyObject *mfsrc = NULL;
+    uint64_t offset, size;
+    static char *kwlist[] = {"pool", "mfsrc", "offset", "size", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OOKK", kwlist, &mfpool, &mfsrc, &offset, &size))
+        return NULL;
+    batch_pool_t *pool = (batch_pool_t *)PyCapsule_GetPointer(mfpool, "pool");
+    if (pool == NULL)
+        return NULL;
+    const uint8_t *src = (const uint8_t *)PyCapsule_GetPointer(mfsrc, "src");
+    int ret;
+    Py_BEGIN_ALLOW_THREADS
+    ret = batch_pool_replicate(pool, (src + offset), size);
+    Py_END_ALLOW_THREADS
+    return Py_BuildValue("i", ret);
+}
+
+static PyObject* py_batch_pool_node_bytes(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *mfpool = NULL;
+    uint32_t n;
+    static char *kwlist[] = {"pool", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O", kwlist, &mfpool))
+        return NULL;
+    const batch_pool_t *pool = (const batch_pool_t *)PyCapsule_GetPointer(mfpool, "pool");
+    if (pool == NULL)
+        return NULL;
+    PyObject *values = PyList_New((Py_ssize_t)pool->nnodes);
+    if (values == NULL)
+        return NULL;
+    for (n = 0; n < pool->nnodes; n++)
+    {
+        PyList_SET_ITEM(values, (Py_ssize_t)n, Py_BuildValue("K", batch_pool_node_bytes(pool, n)));
+    }
+    return values;
+}
+
+// ----------
+
+static PyObject* py_col_find_first_batch_pool_uint8(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values, *seq;
+    PyObject *keylist = NULL;
+    PyObject *mfpool = NULL;
+    uint64_t first, last, i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"pool", "mfsrc", "offset", "first", "last", "keys", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OOKKKO", kwlist, &mfpool, &mfsrc, &offset, &first, &last, &keylist))
+        return NULL;
+    batch_pool_t *pool = (batch_pool_t *)PyCapsule_GetPointer(mfpool, "pool");
+    if (pool == NULL)
+        return NULL;
+    seq = PySequence_Fast(keylist, "keys must be a sequence");
+    if (seq == NULL)
+        return NULL;
+    n = (uint64_t)PySequence_Fast_GET_SIZE(seq);
+    uint8_t *keys = (uint8_t *)PyMem_Malloc((n + 1) * sizeof(uint8_t));
+    uint64_t *out = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    if ((keys == NULL) || (out == NULL))
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++)
+    {
+        keys[i] = (uint8_t)PyLong_AsUnsignedLongLong(PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i));
+    }
+    Py_DECREF(seq);
+    if (PyErr_Occurred())
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        return NULL;
+    }
+    const uint8_t *src = (const uint8_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    Py_BEGIN_ALLOW_THREADS
+    col_find_first_batch_pool_uint8_t(pool, src, first, last, keys, n, out);
+    Py_END_ALLOW_THREADS
+    values = PyList_New((Py_ssize_t)n);
+    if (values != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("K", out[i]));
+        }
+    }
+    PyMem_Free(keys);
+    PyMem_Free(out);
+    return values;
+}
+
+static PyObject* py_col_find_first_batch_pool_uint16(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values, *seq;
+    PyObject *keylist = NULL;
+    PyObject *mfpool = NULL;
+    uint64_t first, last, i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"pool", "mfsrc", "offset", "first", "last", "keys", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OOKKKO", kwlist, &mfpool, &mfsrc, &offset, &first, &last, &keylist))
+        return NULL;
+    batch_pool_t *pool = (batch_pool_t *)PyCapsule_GetPointer(mfpool, "pool");
+    if (pool == NULL)
+        return NULL;
+    seq = PySequence_Fast(keylist, "keys must be a sequence");
+    if (seq == NULL)
+        return NULL;
+    n = (uint64_t)PySequence_Fast_GET_SIZE(seq);
+    uint16_t *keys = (uint16_t *)PyMem_Malloc((n + 1) * sizeof(uint16_t));
+    uint64_t *out = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    if ((keys == NULL) || (out == NULL))
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++)
+    {
+        keys[i] = (uint16_t)PyLong_AsUnsignedLongLong(PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i));
+    }
+    Py_DECREF(seq);
+    if (PyErr_Occurred())
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        return NULL;
+    }
+    const uint16_t *src = (const uint16_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    Py_BEGIN_ALLOW_THREADS
+    col_find_first_batch_pool_uint16_t(pool, src, first, last, keys, n, out);
+    Py_END_ALLOW_THREADS
+    values = PyList_New((Py_ssize_t)n);
+    if (values != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("K", out[i]));
+        }
+    }
+    PyMem_Free(keys);
+    PyMem_Free(out);
+    return values;
+}
+
+static PyObject* py_col_find_first_batch_pool_uint32(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values, *seq;
+    PyObject *keylist = NULL;
+    PyObject *mfpool = NULL;
+    uint64_t first, last, i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"pool", "mfsrc", "offset", "first", "last", "keys", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OOKKKO", kwlist, &mfpool, &mfsrc, &offset, &first, &last, &keylist))
+        return NULL;
+    batch_pool_t *pool = (batch_pool_t *)PyCapsule_GetPointer(mfpool, "pool");
+    if (pool == NULL)
+        return NULL;
+    seq = PySequence_Fast(keylist, "keys must be a sequence");
+    if (seq == NULL)
+        return NULL;
+    n = (uint64_t)PySequence_Fast_GET_SIZE(seq);
+    uint32_t *keys = (uint32_t *)PyMem_Malloc((n + 1) * sizeof(uint32_t));
+    uint64_t *out = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    if ((keys == NULL) || (out == NULL))
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++)
+    {
+        keys[i] = (uint32_t)PyLong_AsUnsignedLongLong(PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i));
+    }
+    Py_DECREF(seq);
+    if (PyErr_Occurred())
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        return NULL;
+    }
+    const uint32_t *src = (const uint32_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    Py_BEGIN_ALLOW_THREADS
+    col_find_first_batch_pool_uint32_t(pool, src, first, last, keys, n, out);
+    Py_END_ALLOW_THREADS
+    values = PyList_New((Py_ssize_t)n);
+    if (values != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("K", out[i]));
+        }
+    }
+    PyMem_Free(keys);
+    PyMem_Free(out);
+    return values;
+}
+
+static PyObject* py_col_find_first_batch_pool_uint64(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values, *seq;
+    PyObject *keylist = NULL;
+    PyObject *mfpool = NULL;
+    uint64_t first, last, i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"pool", "mfsrc", "offset", "first", "last", "keys", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OOKKKO", kwlist, &mfpool, &mfsrc, &offset, &first, &last, &keylist))
+        return NULL;
+    batch_pool_t *pool = (batch_pool_t *)PyCapsule_GetPointer(mfpool, "pool");
+    if (pool == NULL)
+        return NULL;
+    seq = PySequence_Fast(keylist, "keys must be a sequence");
+    if (seq == NULL)
+        return NULL;
+    n = (uint64_t)PySequence_Fast_GET_SIZE(seq);
+    uint64_t *keys = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    uint64_t *out = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    if ((keys == NULL) || (out == NULL))
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++)
+    {
+        keys[i] = (uint64_t)PyLong_AsUnsignedLongLong(PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i));
+    }
+    Py_DECREF(seq);
+    if (PyErr_Occurred())
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        return NULL;
+    }
+    const uint64_t *src = (const uint64_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    Py_BEGIN_ALLOW_THREADS
+    col_find_first_batch_pool_uint64_t(pool, src, first, last, keys, n, out);
+    Py_END_ALLOW_THREADS
+    values = PyList_New((Py_ssize_t)n);
+    if (values != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("K", out[i]));
+        }
+    }
+    PyMem_Free(keys);
+    PyMem_Free(out);
+    return values;
+}
+
+// ----------
+
+static PyObject* py_col_find_last_batch_pool_uint8(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values, *seq;
+    PyObject *keylist = NULL;
+    PyObject *mfpool = NULL;
+    uint64_t first, last, i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"pool", "mfsrc", "offset", "first", "last", "keys", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OOKKKO", kwlist, &mfpool, &mfsrc, &offset, &first, &last, &keylist))
+        return NULL;
+    batch_pool_t *pool = (batch_pool_t *)PyCapsule_GetPointer(mfpool, "pool");
+    if (pool == NULL)
+        return NULL;
+    seq = PySequence_Fast(keylist, "keys must be a sequence");
+    if (seq == NULL)
+        return NULL;
+    n = (uint64_t)PySequence_Fast_GET_SIZE(seq);
+    uint8_t *keys = (uint8_t *)PyMem_Malloc((n + 1) * sizeof(uint8_t));
+    uint64_t *out = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    if ((keys == NULL) || (out == NULL))
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++)
+    {
+        keys[i] = (uint8_t)PyLong_AsUnsignedLongLong(PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i));
+    }
+    Py_DECREF(seq);
+    if (PyErr_Occurred())
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        return NULL;
+    }
+    const uint8_t *src = (const uint8_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    Py_BEGIN_ALLOW_THREADS
+    col_find_last_batch_pool_uint8_t(pool, src, first, last, keys, n, out);
+    Py_END_ALLOW_THREADS
+    values = PyList_New((Py_ssize_t)n);
+    if (values != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("K", out[i]));
+        }
+    }
+    PyMem_Free(keys);
+    PyMem_Free(out);
+    return values;
+}
+
+static PyObject* py_col_find_last_batch_pool_uint16(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values, *seq;
+    PyObject *keylist = NULL;
+    PyObject *mfpool = NULL;
+    uint64_t first, last, i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"pool", "mfsrc", "offset", "first", "last", "keys", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OOKKKO", kwlist, &mfpool, &mfsrc, &offset, &first, &last, &keylist))
+        return NULL;
+    batch_pool_t *pool = (batch_pool_t *)PyCapsule_GetPointer(mfpool, "pool");
+    if (pool == NULL)
+        return NULL;
+    seq = PySequence_Fast(keylist, "keys must be a sequence");
+    if (seq == NULL)
+        return NULL;
+    n = (uint64_t)PySequence_Fast_GET_SIZE(seq);
+    uint16_t *keys = (uint16_t *)PyMem_Malloc((n + 1) * sizeof(uint16_t));
+    uint64_t *out = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    if ((keys == NULL) || (out == NULL))
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++)
+    {
+        keys[i] = (uint16_t)PyLong_AsUnsignedLongLong(PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i));
+    }
+    Py_DECREF(seq);
+    if (PyErr_Occurred())
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        return NULL;
+    }
+    const uint16_t *src = (const uint16_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    Py_BEGIN_ALLOW_THREADS
+    col_find_last_batch_pool_uint16_t(pool, src, first, last, keys, n, out);
+    Py_END_ALLOW_THREADS
+    values = PyList_New((Py_ssize_t)n);
+    if (values != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("K", out[i]));
+        }
+    }
+    PyMem_Free(keys);
+    PyMem_Free(out);
+    return values;
+}
+
+static PyObject* py_col_find_last_batch_pool_uint32(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values, *seq;
+    PyObject *keylist = NULL;
+    PyObject *mfpool = NULL;
+    uint64_t first, last, i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"pool", "mfsrc", "offset", "first", "last", "keys", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OOKKKO", kwlist, &mfpool, &mfsrc, &offset, &first, &last, &keylist))
+        return NULL;
+    batch_pool_t *pool = (batch_pool_t *)PyCapsule_GetPointer(mfpool, "pool");
+    if (pool == NULL)
+        return NULL;
+    seq = PySequence_Fast(keylist, "keys must be a sequence");
+    if (seq == NULL)
+        return NULL;
+    n = (uint64_t)PySequence_Fast_GET_SIZE(seq);
+    uint32_t *keys = (uint32_t *)PyMem_Malloc((n + 1) * sizeof(uint32_t));
+    uint64_t *out = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    if ((keys == NULL) || (out == NULL))
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++)
+    {
+        keys[i] = (uint32_t)PyLong_AsUnsignedLongLong(PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i));
+    }
+    Py_DECREF(seq);
+    if (PyErr_Occurred())
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        return NULL;
+    }
+    const uint32_t *src = (const uint32_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    Py_BEGIN_ALLOW_THREADS
+    col_find_last_batch_pool_uint32_t(pool, src, first, last, keys, n, out);
+    Py_END_ALLOW_THREADS
+    values = PyList_New((Py_ssize_t)n);
+    if (values != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("K", out[i]));
+        }
+    }
+    PyMem_Free(keys);
+    PyMem_Free(out);
+    return values;
+}
+
+static PyObject* py_col_find_last_batch_pool_uint64(PyObject *Py_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *values, *seq;
+    PyObject *keylist = NULL;
+    PyObject *mfpool = NULL;
+    uint64_t first, last, i, n;
+    uint64_t offset;
+    PyObject* mfsrc = NULL;
+    static char *kwlist[] = {"pool", "mfsrc", "offset", "first", "last", "keys", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OOKKKO", kwlist, &mfpool, &mfsrc, &offset, &first, &last, &keylist))
+        return NULL;
+    batch_pool_t *pool = (batch_pool_t *)PyCapsule_GetPointer(mfpool, "pool");
+    if (pool == NULL)
+        return NULL;
+    seq = PySequence_Fast(keylist, "keys must be a sequence");
+    if (seq == NULL)
+        return NULL;
+    n = (uint64_t)PySequence_Fast_GET_SIZE(seq);
+    uint64_t *keys = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    uint64_t *out = (uint64_t *)PyMem_Malloc((n + 1) * sizeof(uint64_t));
+    if ((keys == NULL) || (out == NULL))
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++)
+    {
+        keys[i] = (uint64_t)PyLong_AsUnsignedLongLong(PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i));
+    }
+    Py_DECREF(seq);
+    if (PyErr_Occurred())
+    {
+        PyMem_Free(keys);
+        PyMem_Free(out);
+        return NULL;
+    }
+    const uint64_t *src = (const uint64_t *)((const uint8_t *)PyCapsule_GetPointer(mfsrc, "src") + offset);
+    Py_BEGIN_ALLOW_THREADS
+    col_find_last_batch_pool_uint64_t(pool, src, first, last, keys, n, out);
+    Py_END_ALLOW_THREADS
+    values = PyList_New((Py_ssize_t)n);
+    if (values != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            PyList_SET_ITEM(values, (Py_ssize_t)i, Py_BuildValue("K", out[i]));
+        }
+    }
+    PyMem_Free(keys);
+    PyMem_Free(out);
+    return values;
+}
+
+// ----------
+
 static PyMethodDef PyBinsearchMethods[] =
 {
     {"mmap_binfile", (PyCFunction)(void(*)(void))py_mmap_binfile, METH_VARARGS|METH_KEYWORDS, PYMMAPBINFILE_DOCSTRING},
+    {"mmap_binfile_ex", (PyCFunction)(void(*)(void))py_mmap_binfile_ex, METH_VARARGS|METH_KEYWORDS, PYMMAPBINFILEEX_DOCSTRING},
     {"munmap_binfile", (PyCFunction)(void(*)(void))py_munmap_binfile, METH_VARARGS|METH_KEYWORDS, PYMUNMAPBINFILE_DOCSTRING},
     {"get_address", (PyCFunction)(void(*)(void))py_get_address, METH_VARARGS|METH_KEYWORDS, PYGETADDRESS_DOCSTRING},
     {"find_first_be_uint8", (PyCFunction)(void(*)(void))py_find_first_be_uint8, METH_VARARGS|METH_KEYWORDS, PYFINDFIRSTUINT8_DOCSTRING},
@@ -2078,6 +3348,41 @@ static PyMethodDef PyBinsearchMethods[] =
     {"col_has_prev_sub_uint16", (PyCFunction)(void(*)(void))py_col_has_prev_sub_uint16, METH_VARARGS|METH_KEYWORDS, PYCOLHASPREVSUBUINT16_DOCSTRING},
     {"col_has_prev_sub_uint32", (PyCFunction)(void(*)(void))py_col_has_prev_sub_uint32, METH_VARARGS|METH_KEYWORDS, PYCOLHASPREVSUBUINT32_DOCSTRING},
     {"col_has_prev_sub_uint64", (PyCFunction)(void(*)(void))py_col_has_prev_sub_uint64, METH_VARARGS|METH_KEYWORDS, PYCOLHASPREVSUBUINT64_DOCSTRING},
+    {"col_cursor_uint8", (PyCFunction)(void(*)(void))py_col_cursor_uint8, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORUINT8_DOCSTRING},
+    {"col_cursor_uint16", (PyCFunction)(void(*)(void))py_col_cursor_uint16, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORUINT16_DOCSTRING},
+    {"col_cursor_uint32", (PyCFunction)(void(*)(void))py_col_cursor_uint32, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORUINT32_DOCSTRING},
+    {"col_cursor_uint64", (PyCFunction)(void(*)(void))py_col_cursor_uint64, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORUINT64_DOCSTRING},
+    {"col_cursor_sub_uint8", (PyCFunction)(void(*)(void))py_col_cursor_sub_uint8, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORSUBUINT8_DOCSTRING},
+    {"col_cursor_sub_uint16", (PyCFunction)(void(*)(void))py_col_cursor_sub_uint16, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORSUBUINT16_DOCSTRING},
+    {"col_cursor_sub_uint32", (PyCFunction)(void(*)(void))py_col_cursor_sub_uint32, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORSUBUINT32_DOCSTRING},
+    {"col_cursor_sub_uint64", (PyCFunction)(void(*)(void))py_col_cursor_sub_uint64, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORSUBUINT64_DOCSTRING},
+    {"col_cursor_range_uint8", (PyCFunction)(void(*)(void))py_col_cursor_range_uint8, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORRANGEUINT8_DOCSTRING},
+    {"col_cursor_range_uint16", (PyCFunction)(void(*)(void))py_col_cursor_range_uint16, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORRANGEUINT16_DOCSTRING},
+    {"col_cursor_range_uint32", (PyCFunction)(void(*)(void))py_col_cursor_range_uint32, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORRANGEUINT32_DOCSTRING},
+    {"col_cursor_range_uint64", (PyCFunction)(void(*)(void))py_col_cursor_range_uint64, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORRANGEUINT64_DOCSTRING},
+    {"col_cursor_next_values_uint8", (PyCFunction)(void(*)(void))py_col_cursor_next_values_uint8, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORNEXTVALUESUINT8_DOCSTRING},
+    {"col_cursor_next_values_uint16", (PyCFunction)(void(*)(void))py_col_cursor_next_values_uint16, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORNEXTVALUESUINT16_DOCSTRING},
+    {"col_cursor_next_values_uint32", (PyCFunction)(void(*)(void))py_col_cursor_next_values_uint32, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORNEXTVALUESUINT32_DOCSTRING},
+    {"col_cursor_next_values_uint64", (PyCFunction)(void(*)(void))py_col_cursor_next_values_uint64, METH_VARARGS|METH_KEYWORDS, PYCOLCURSORNEXTVALUESUINT64_DOCSTRING},
+    {"col_gather_range_uint8", (PyCFunction)(void(*)(void))py_col_gather_range_uint8, METH_VARARGS|METH_KEYWORDS, PYCOLGATHERRANGEUINT8_DOCSTRING},
+    {"col_gather_range_uint16", (PyCFunction)(void(*)(void))py_col_gather_range_uint16, METH_VARARGS|METH_KEYWORDS, PYCOLGATHERRANGEUINT16_DOCSTRING},
+    {"col_gather_range_uint32", (PyCFunction)(void(*)(void))py_col_gather_range_uint32, METH_VARARGS|METH_KEYWORDS, PYCOLGATHERRANGEUINT32_DOCSTRING},
+    {"col_gather_range_uint64", (PyCFunction)(void(*)(void))py_col_gather_range_uint64, METH_VARARGS|METH_KEYWORDS, PYCOLGATHERRANGEUINT64_DOCSTRING},
+    {"col_gather_rows_uint8", (PyCFunction)(void(*)(void))py_col_gather_rows_uint8, METH_VARARGS|METH_KEYWORDS, PYCOLGATHERROWSUINT8_DOCSTRING},
+    {"col_gather_rows_uint16", (PyCFunction)(void(*)(void))py_col_gather_rows_uint16, METH_VARARGS|METH_KEYWORDS, PYCOLGATHERROWSUINT16_DOCSTRING},
+    {"col_gather_rows_uint32", (PyCFunction)(void(*)(void))py_col_gather_rows_uint32, METH_VARARGS|METH_KEYWORDS, PYCOLGATHERROWSUINT32_DOCSTRING},
+    {"col_gather_rows_uint64", (PyCFunction)(void(*)(void))py_col_gather_rows_uint64, METH_VARARGS|METH_KEYWORDS, PYCOLGATHERROWSUINT64_DOCSTRING},
+    {"batch_pool_new", (PyCFunction)(void(*)(void))py_batch_pool_new, METH_VARARGS|METH_KEYWORDS, PYBATCHPOOLNEW_DOCSTRING},
+    {"batch_pool_replicate", (PyCFunction)(void(*)(void))py_batch_pool_replicate, METH_VARARGS|METH_KEYWORDS, PYBATCHPOOLREPLICATE_DOCSTRING},
+    {"batch_pool_node_bytes", (PyCFunction)(void(*)(void))py_batch_pool_node_bytes, METH_VARARGS|METH_KEYWORDS, PYBATCHPOOLNODEBYTES_DOCSTRING},
+    {"col_find_first_batch_pool_uint8", (PyCFunction)(void(*)(void))py_col_find_first_batch_pool_uint8, METH_VARARGS|METH_KEYWORDS, PYCOLFINDFIRSTBATCHPOOLUINT8_DOCSTRING},
+    {"col_find_first_batch_pool_uint16", (PyCFunction)(void(*)(void))py_col_find_first_batch_pool_uint16, METH_VARARGS|METH_KEYWORDS, PYCOLFINDFIRSTBATCHPOOLUINT16_DOCSTRING},
+    {"col_find_first_batch_pool_uint32", (PyCFunction)(void(*)(void))py_col_find_first_batch_pool_uint32, METH_VARARGS|METH_KEYWORDS, PYCOLFINDFIRSTBATCHPOOLUINT32_DOCSTRING},
+    {"col_find_first_batch_pool_uint64", (PyCFunction)(void(*)(void))py_col_find_first_batch_pool_uint64, METH_VARARGS|METH_KEYWORDS, PYCOLFINDFIRSTBATCHPOOLUINT64_DOCSTRING},
+    {"col_find_last_batch_pool_uint8", (PyCFunction)(void(*)(void))py_col_find_last_batch_pool_uint8, METH_VARARGS|METH_KEYWORDS, PYCOLFINDLASTBATCHPOOLUINT8_DOCSTRING},
+    {"col_find_last_batch_pool_uint16", (PyCFunction)(void(*)(void))py_col_find_last_batch_pool_uint16, METH_VARARGS|METH_KEYWORDS, PYCOLFINDLASTBATCHPOOLUINT16_DOCSTRING},
+    {"col_find_last_batch_pool_uint32", (PyCFunction)(void(*)(void))py_col_find_last_batch_pool_uint32, METH_VARARGS|METH_KEYWORDS, PYCOLFINDLASTBATCHPOOLUINT32_DOCSTRING},
+    {"col_find_last_batch_pool_uint64", (PyCFunction)(void(*)(void))py_col_find_last_batch_pool_uint64, METH_VARARGS|METH_KEYWORDS, PYCOLFINDLASTBATCHPOOLUINT64_DOCSTRING},
     {NULL, NULL, 0, NULL}
 };
 
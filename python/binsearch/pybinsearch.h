@@ -158,6 +158,38 @@ PyMODINIT_FUNC initbinsearch(void);
 "    - List of offset positions for each column.\n"\
 "    - Pointer to the list of offset positions for each column."
 
+#define PYMMAPBINFILEEX_DOCSTRING "Memory map the specified file with options to control the page size, the readahead and the residency of the mapped pages.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"file : str\n"\
+"    Path to the file to map.\n"\
+"ctbytes : int array\n"\
+"    Array containing the number of bytes for each column type (i.e. 1 for uint8, 2 for uint16, 4 for uint32, 8 for uint64).\n"\
+"flags : int\n"\
+"    Combination of: 1 = prefault the pages (MAP_POPULATE), 2 = transparent huge pages (MADV_HUGEPAGE), 4 = copy in huge pages (MAP_HUGETLB), 8 = lock the file in memory (mlock).\n"\
+"advice : int\n"\
+"    Access advice for the whole file: 0 = normal, 1 = random, 2 = sequential, 3 = will need.\n"\
+"col_advice : int array\n"\
+"    Access advice for each column.\n"\
+"col_lock : int array\n"\
+"    Lock the pages of each column with a non-zero value.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - Pointer to the memory map.\n"\
+"    - File descriptor.\n"\
+"    - File size in bytes.\n"\
+"    - Offset to the beginning of the data block (address of the first byte of the first item in the first column).\n"\
+"    - Length in bytes of the data block.\n"\
+"    - Number of rows.\n"\
+"    - Number of columns.\n"\
+"    - List of offset positions for each column.\n"\
+"    - Pointer to the list of offset positions for each column.\n"\
+"    - Length of the memory map (0 = file size), to pass to munmap_binfile.\n"\
+"    - 0 on success, -1 if the file can't be mapped, 1 if at least one option could not be applied."
+
 #define PYMUNMAPBINFILE_DOCSTRING "Unmap and close the memory-mapped file.\n"\
 "\n"\
 "Parameters\n"\
@@ -168,6 +200,8 @@ PyMODINIT_FUNC initbinsearch(void);
 "    File descriptor.\n"\
 "size : int\n"\
 "    File size.\n"\
+"mapsize : int\n"\
+"    Length of the memory map returned by mmap_binfile_ex (0 = size).\n"\
 "\n"\
 "Returns\n"\
 "-------\n"\
@@ -1858,6 +1892,728 @@ PyMODINIT_FUNC initbinsearch(void);
 
 // ----------
 
+#define PYCOLCURSORUINT8_DOCSTRING "Initialize a cursor over the items equal to a 8 bit unsigned integer on a memory buffer containing contiguos blocks of sorted binary data. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"search : int\n"\
+"    Unsigned 8 bit number to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - Position of the first matching item.\n"\
+"    - Position after the last matching item (row numbers are range(pos, end))."
+
+#define PYCOLCURSORUINT16_DOCSTRING "Initialize a cursor over the items equal to a 16 bit unsigned integer on a memory buffer containing contiguos blocks of sorted binary data. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"search : int\n"\
+"    Unsigned 16 bit number to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - Position of the first matching item.\n"\
+"    - Position after the last matching item (row numbers are range(pos, end))."
+
+#define PYCOLCURSORUINT32_DOCSTRING "Initialize a cursor over the items equal to a 32 bit unsigned integer on a memory buffer containing contiguos blocks of sorted binary data. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"search : int\n"\
+"    Unsigned 32 bit number to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - Position of the first matching item.\n"\
+"    - Position after the last matching item (row numbers are range(pos, end))."
+
+#define PYCOLCURSORUINT64_DOCSTRING "Initialize a cursor over the items equal to a 64 bit unsigned integer on a memory buffer containing contiguos blocks of sorted binary data. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"search : int\n"\
+"    Unsigned 64 bit number to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - Position of the first matching item.\n"\
+"    - Position after the last matching item (row numbers are range(pos, end))."
+
+#define PYCOLCURSORSUBUINT8_DOCSTRING "Initialize a cursor over the items where a bit set contained in a 8 bit unsigned integer is equal to the search value, on a memory buffer containing contiguos blocks of sorted binary data. The values must be encoded in Little-Endian format and sorted in ascending order by the selected bits.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"bitstart : int\n"\
+"    First bit position to consider (min 0).\n"\
+"bitend : int\n"\
+"    Last bit position to consider (max 7).\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"search : int\n"\
+"    Unsigned 8 bit number to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - Position of the first matching item.\n"\
+"    - Position after the last matching item (row numbers are range(pos, end))."
+
+#define PYCOLCURSORSUBUINT16_DOCSTRING "Initialize a cursor over the items where a bit set contained in a 16 bit unsigned integer is equal to the search value, on a memory buffer containing contiguos blocks of sorted binary data. The values must be encoded in Little-Endian format and sorted in ascending order by the selected bits.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"bitstart : int\n"\
+"    First bit position to consider (min 0).\n"\
+"bitend : int\n"\
+"    Last bit position to consider (max 15).\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"search : int\n"\
+"    Unsigned 16 bit number to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - Position of the first matching item.\n"\
+"    - Position after the last matching item (row numbers are range(pos, end))."
+
+#define PYCOLCURSORSUBUINT32_DOCSTRING "Initialize a cursor over the items where a bit set contained in a 32 bit unsigned integer is equal to the search value, on a memory buffer containing contiguos blocks of sorted binary data. The values must be encoded in Little-Endian format and sorted in ascending order by the selected bits.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"bitstart : int\n"\
+"    First bit position to consider (min 0).\n"\
+"bitend : int\n"\
+"    Last bit position to consider (max 31).\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"search : int\n"\
+"    Unsigned 32 bit number to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - Position of the first matching item.\n"\
+"    - Position after the last matching item (row numbers are range(pos, end))."
+
+#define PYCOLCURSORSUBUINT64_DOCSTRING "Initialize a cursor over the items where a bit set contained in a 64 bit unsigned integer is equal to the search value, on a memory buffer containing contiguos blocks of sorted binary data. The values must be encoded in Little-Endian format and sorted in ascending order by the selected bits.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"bitstart : int\n"\
+"    First bit position to consider (min 0).\n"\
+"bitend : int\n"\
+"    Last bit position to consider (max 63).\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"search : int\n"\
+"    Unsigned 64 bit number to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - Position of the first matching item.\n"\
+"    - Position after the last matching item (row numbers are range(pos, end))."
+
+#define PYCOLCURSORRANGEUINT8_DOCSTRING "Initialize a cursor over the items between two 8 bit unsigned integers (included) on a memory buffer containing contiguos blocks of sorted binary data. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"lo : int\n"\
+"    Lowest unsigned 8 bit value to match.\n"\
+"hi : int\n"\
+"    Highest unsigned 8 bit value to match.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - Position of the first matching item.\n"\
+"    - Position after the last matching item (row numbers are range(pos, end))."
+
+#define PYCOLCURSORRANGEUINT16_DOCSTRING "Initialize a cursor over the items between two 16 bit unsigned integers (included) on a memory buffer containing contiguos blocks of sorted binary data. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"lo : int\n"\
+"    Lowest unsigned 16 bit value to match.\n"\
+"hi : int\n"\
+"    Highest unsigned 16 bit value to match.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - Position of the first matching item.\n"\
+"    - Position after the last matching item (row numbers are range(pos, end))."
+
+#define PYCOLCURSORRANGEUINT32_DOCSTRING "Initialize a cursor over the items between two 32 bit unsigned integers (included) on a memory buffer containing contiguos blocks of sorted binary data. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"lo : int\n"\
+"    Lowest unsigned 32 bit value to match.\n"\
+"hi : int\n"\
+"    Highest unsigned 32 bit value to match.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - Position of the first matching item.\n"\
+"    - Position after the last matching item (row numbers are range(pos, end))."
+
+#define PYCOLCURSORRANGEUINT64_DOCSTRING "Initialize a cursor over the items between two 64 bit unsigned integers (included) on a memory buffer containing contiguos blocks of sorted binary data. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"lo : int\n"\
+"    Lowest unsigned 64 bit value to match.\n"\
+"hi : int\n"\
+"    Highest unsigned 64 bit value to match.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - Position of the first matching item.\n"\
+"    - Position after the last matching item (row numbers are range(pos, end))."
+
+#define PYCOLCURSORNEXTVALUESUINT8_DOCSTRING "Return a block of values from a cursor over a memory buffer containing contiguos blocks of 8 bit unsigned integers.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"pos : int\n"\
+"    Current cursor position.\n"\
+"end : int\n"\
+"    Position after the last matching item, as returned by the cursor initialization.\n"\
+"nmax : int\n"\
+"    Maximum number of values to return.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - List of at most nmax values (empty when the cursor is exhausted).\n"\
+"    - Next cursor position."
+
+#define PYCOLCURSORNEXTVALUESUINT16_DOCSTRING "Return a block of values from a cursor over a memory buffer containing contiguos blocks of 16 bit unsigned integers.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"pos : int\n"\
+"    Current cursor position.\n"\
+"end : int\n"\
+"    Position after the last matching item, as returned by the cursor initialization.\n"\
+"nmax : int\n"\
+"    Maximum number of values to return.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - List of at most nmax values (empty when the cursor is exhausted).\n"\
+"    - Next cursor position."
+
+#define PYCOLCURSORNEXTVALUESUINT32_DOCSTRING "Return a block of values from a cursor over a memory buffer containing contiguos blocks of 32 bit unsigned integers.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"pos : int\n"\
+"    Current cursor position.\n"\
+"end : int\n"\
+"    Position after the last matching item, as returned by the cursor initialization.\n"\
+"nmax : int\n"\
+"    Maximum number of values to return.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - List of at most nmax values (empty when the cursor is exhausted).\n"\
+"    - Next cursor position."
+
+#define PYCOLCURSORNEXTVALUESUINT64_DOCSTRING "Return a block of values from a cursor over a memory buffer containing contiguos blocks of 64 bit unsigned integers.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"pos : int\n"\
+"    Current cursor position.\n"\
+"end : int\n"\
+"    Position after the last matching item, as returned by the cursor initialization.\n"\
+"nmax : int\n"\
+"    Maximum number of values to return.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"tuple :\n"\
+"    - List of at most nmax values (empty when the cursor is exhausted).\n"\
+"    - Next cursor position."
+
+// ----------
+
+#define PYCOLGATHERRANGEUINT8_DOCSTRING "Return the values of the contiguous rows [first, last) of a column of 8 bit unsigned integers.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    First row to copy.\n"\
+"last : int\n"\
+"    Row (up to but not including) where to end the copy (max value = nrows).\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Values of the rows."
+
+#define PYCOLGATHERRANGEUINT16_DOCSTRING "Return the values of the contiguous rows [first, last) of a column of 16 bit unsigned integers.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    First row to copy.\n"\
+"last : int\n"\
+"    Row (up to but not including) where to end the copy (max value = nrows).\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Values of the rows."
+
+#define PYCOLGATHERRANGEUINT32_DOCSTRING "Return the values of the contiguous rows [first, last) of a column of 32 bit unsigned integers.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    First row to copy.\n"\
+"last : int\n"\
+"    Row (up to but not including) where to end the copy (max value = nrows).\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Values of the rows."
+
+#define PYCOLGATHERRANGEUINT64_DOCSTRING "Return the values of the contiguous rows [first, last) of a column of 64 bit unsigned integers.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    First row to copy.\n"\
+"last : int\n"\
+"    Row (up to but not including) where to end the copy (max value = nrows).\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Values of the rows."
+
+#define PYCOLGATHERROWSUINT8_DOCSTRING "Return the values of a column of 8 bit unsigned integers at the specified row numbers.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"rows : list\n"\
+"    Row numbers to copy (each must be less than nrows).\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Values of the rows."
+
+#define PYCOLGATHERROWSUINT16_DOCSTRING "Return the values of a column of 16 bit unsigned integers at the specified row numbers.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"rows : list\n"\
+"    Row numbers to copy (each must be less than nrows).\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Values of the rows."
+
+#define PYCOLGATHERROWSUINT32_DOCSTRING "Return the values of a column of 32 bit unsigned integers at the specified row numbers.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"rows : list\n"\
+"    Row numbers to copy (each must be less than nrows).\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Values of the rows."
+
+#define PYCOLGATHERROWSUINT64_DOCSTRING "Return the values of a column of 64 bit unsigned integers at the specified row numbers.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"rows : list\n"\
+"    Row numbers to copy (each must be less than nrows).\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Values of the rows."
+
+// ----------
+
+#define PYBATCHPOOLNEW_DOCSTRING "Start a pool of worker threads for the batch searches. The threads are stopped when the returned object is released.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"nthreads : int\n"\
+"    Number of workers, including the calling thread (0 = one per online CPU).\n"\
+"pin : bool\n"\
+"    Pin each worker thread to a CPU.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"pool : obj\n"\
+"    Pointer to the pool."
+
+#define PYBATCHPOOLREPLICATE_DOCSTRING "Replicate a read-only region of the memory mapped file (i.e. a column) in the memory of each NUMA node. The pool searches on the region transparently read the replica on the node of each worker thread. It does nothing on hosts with a single NUMA node.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"pool : obj\n"\
+"    Pointer to the pool returned by batch_pool_new.\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the region starts.\n"\
+"size : int\n"\
+"    Size of the region in bytes.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"int :\n"\
+"    0 on success, -1 on failure."
+
+#define PYBATCHPOOLNODEBYTES_DOCSTRING "Return the memory allocated for the replicas on each NUMA node.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"pool : obj\n"\
+"    Pointer to the pool returned by batch_pool_new.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Number of bytes allocated on each node."
+
+#define PYCOLFINDFIRSTBATCHPOOLUINT8_DOCSTRING "Search for the first occurrence of multiple 8 bit unsigned integers on a memory buffer containing contiguos blocks of sorted binary data, using all the threads of a pool. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"pool : obj\n"\
+"    Pointer to the pool returned by batch_pool_new.\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"keys : list\n"\
+"    Unsigned 8 bit numbers to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Item number of each key if found or (last) if not found."
+
+#define PYCOLFINDFIRSTBATCHPOOLUINT16_DOCSTRING "Search for the first occurrence of multiple 16 bit unsigned integers on a memory buffer containing contiguos blocks of sorted binary data, using all the threads of a pool. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"pool : obj\n"\
+"    Pointer to the pool returned by batch_pool_new.\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"keys : list\n"\
+"    Unsigned 16 bit numbers to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Item number of each key if found or (last) if not found."
+
+#define PYCOLFINDFIRSTBATCHPOOLUINT32_DOCSTRING "Search for the first occurrence of multiple 32 bit unsigned integers on a memory buffer containing contiguos blocks of sorted binary data, using all the threads of a pool. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"pool : obj\n"\
+"    Pointer to the pool returned by batch_pool_new.\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"keys : list\n"\
+"    Unsigned 32 bit numbers to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Item number of each key if found or (last) if not found."
+
+#define PYCOLFINDFIRSTBATCHPOOLUINT64_DOCSTRING "Search for the first occurrence of multiple 64 bit unsigned integers on a memory buffer containing contiguos blocks of sorted binary data, using all the threads of a pool. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"pool : obj\n"\
+"    Pointer to the pool returned by batch_pool_new.\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"keys : list\n"\
+"    Unsigned 64 bit numbers to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Item number of each key if found or (last) if not found."
+
+#define PYCOLFINDLASTBATCHPOOLUINT8_DOCSTRING "Search for the last occurrence of multiple 8 bit unsigned integers on a memory buffer containing contiguos blocks of sorted binary data, using all the threads of a pool. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"pool : obj\n"\
+"    Pointer to the pool returned by batch_pool_new.\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"keys : list\n"\
+"    Unsigned 8 bit numbers to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Item number of each key if found or (last) if not found."
+
+#define PYCOLFINDLASTBATCHPOOLUINT16_DOCSTRING "Search for the last occurrence of multiple 16 bit unsigned integers on a memory buffer containing contiguos blocks of sorted binary data, using all the threads of a pool. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"pool : obj\n"\
+"    Pointer to the pool returned by batch_pool_new.\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"keys : list\n"\
+"    Unsigned 16 bit numbers to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Item number of each key if found or (last) if not found."
+
+#define PYCOLFINDLASTBATCHPOOLUINT32_DOCSTRING "Search for the last occurrence of multiple 32 bit unsigned integers on a memory buffer containing contiguos blocks of sorted binary data, using all the threads of a pool. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"pool : obj\n"\
+"    Pointer to the pool returned by batch_pool_new.\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"keys : list\n"\
+"    Unsigned 32 bit numbers to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Item number of each key if found or (last) if not found."
+
+#define PYCOLFINDLASTBATCHPOOLUINT64_DOCSTRING "Search for the last occurrence of multiple 64 bit unsigned integers on a memory buffer containing contiguos blocks of sorted binary data, using all the threads of a pool. The values must be encoded in Little-Endian format and sorted in ascending order.\n"\
+"\n"\
+"Parameters\n"\
+"----------\n"\
+"pool : obj\n"\
+"    Pointer to the pool returned by batch_pool_new.\n"\
+"mfsrc : obj\n"\
+"    Pointer to the memory mapped file.\n"\
+"offset : int\n"\
+"    Byte offset from where the first item starts.\n"\
+"first : int\n"\
+"    Element from where to start the search (min value = 0).\n"\
+"last : int\n"\
+"    Element (up to but not including) where to end the search (max value = nrows).\n"\
+"keys : list\n"\
+"    Unsigned 64 bit numbers to search.\n"\
+"\n"\
+"Returns\n"\
+"-------\n"\
+"list :\n"\
+"    Item number of each key if found or (last) if not found."
+
+// ----------
+
 #if defined(__SUNPRO_C) || defined(__hpux) || defined(_AIX)
 #define inline
 #endif
@@ -60,6 +60,7 @@ setup(
                 "-Wshadow",
                 "-I../src/binsearch",
             ],
+            extra_link_args=["-pthread"],
         )
     ],
     classifiers=[
@@ -3,6 +3,7 @@
 
 import binsearch as bs
 import os
+import threading
 from unittest import TestCase
 
 nrows = 251
@@ -645,6 +646,277 @@ class TestFunctions(TestCase):
                     counter = counter + 1
                 self.assertEqual(counter, numitems)
 
+    def test_col_cursor_uint8(self):
+        for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol8:
+            numitems = (fL - fF + 1) if (fF < last) else 0
+            pos, end = bs.col_cursor_uint8(src, index[0], first, last, search)
+            self.assertEqual(end - pos, numitems)
+            if numitems > 0:
+                self.assertEqual(pos, fF)
+            rpos, rend = bs.col_cursor_range_uint8(
+                src, index[0], first, last, search, search
+            )
+            self.assertEqual(rend - rpos, numitems)
+            counter = 0
+            while True:
+                values, pos = bs.col_cursor_next_values_uint8(
+                    src, index[0], pos, end, 3
+                )
+                if not values:
+                    break
+                self.assertTrue(len(values) <= 3)
+                self.assertEqual(values, [search] * len(values))
+                counter = counter + len(values)
+            self.assertEqual(counter, numitems)
+
+    def test_col_cursor_uint16(self):
+        for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol16:
+            numitems = (fL - fF + 1) if (fF < last) else 0
+            pos, end = bs.col_cursor_uint16(src, index[1], first, last, search)
+            self.assertEqual(end - pos, numitems)
+            if numitems > 0:
+                self.assertEqual(pos, fF)
+            rpos, rend = bs.col_cursor_range_uint16(
+                src, index[1], first, last, search, search
+            )
+            self.assertEqual(rend - rpos, numitems)
+            counter = 0
+            while True:
+                values, pos = bs.col_cursor_next_values_uint16(
+                    src, index[1], pos, end, 3
+                )
+                if not values:
+                    break
+                self.assertTrue(len(values) <= 3)
+                self.assertEqual(values, [search] * len(values))
+                counter = counter + len(values)
+            self.assertEqual(counter, numitems)
+
+    def test_col_cursor_uint32(self):
+        for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol32:
+            numitems = (fL - fF + 1) if (fF < last) else 0
+            pos, end = bs.col_cursor_uint32(src, index[2], first, last, search)
+            self.assertEqual(end - pos, numitems)
+            if numitems > 0:
+                self.assertEqual(pos, fF)
+            rpos, rend = bs.col_cursor_range_uint32(
+                src, index[2], first, last, search, search
+            )
+            self.assertEqual(rend - rpos, numitems)
+            counter = 0
+            while True:
+                values, pos = bs.col_cursor_next_values_uint32(
+                    src, index[2], pos, end, 3
+                )
+                if not values:
+                    break
+                self.assertTrue(len(values) <= 3)
+                self.assertEqual(values, [search] * len(values))
+                counter = counter + len(values)
+            self.assertEqual(counter, numitems)
+
+    def test_col_cursor_uint64(self):
+        for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol64:
+            numitems = (fL - fF + 1) if (fF < last) else 0
+            pos, end = bs.col_cursor_uint64(src, index[3], first, last, search)
+            self.assertEqual(end - pos, numitems)
+            if numitems > 0:
+                self.assertEqual(pos, fF)
+            rpos, rend = bs.col_cursor_range_uint64(
+                src, index[3], first, last, search, search
+            )
+            self.assertEqual(rend - rpos, numitems)
+            counter = 0
+            while True:
+                values, pos = bs.col_cursor_next_values_uint64(
+                    src, index[3], pos, end, 3
+                )
+                if not values:
+                    break
+                self.assertTrue(len(values) <= 3)
+                self.assertEqual(values, [search] * len(values))
+                counter = counter + len(values)
+            self.assertEqual(counter, numitems)
+
+    def test_col_cursor_sub_uint8(self):
+        for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataColSub8:
+            numitems = (fL - fF + 1) if (fF < last) else 0
+            pos, end = bs.col_cursor_sub_uint8(
+                src, index[0], 0, 7, first, last, search
+            )
+            self.assertEqual(end - pos, numitems)
+            if numitems > 0:
+                self.assertEqual(pos, fF)
+
+    def test_col_cursor_sub_uint16(self):
+        for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataColSub16:
+            numitems = (fL - fF + 1) if (fF < last) else 0
+            pos, end = bs.col_cursor_sub_uint16(
+                src, index[1], 0, 15, first, last, search
+            )
+            self.assertEqual(end - pos, numitems)
+            if numitems > 0:
+                self.assertEqual(pos, fF)
+
+    def test_col_cursor_sub_uint32(self):
+        for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataColSub32:
+            numitems = (fL - fF + 1) if (fF < last) else 0
+            pos, end = bs.col_cursor_sub_uint32(
+                src, index[2], 8, 23, first, last, search
+            )
+            self.assertEqual(end - pos, numitems)
+            if numitems > 0:
+                self.assertEqual(pos, fF)
+
+    def test_col_cursor_sub_uint64(self):
+        for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataColSub64:
+            numitems = (fL - fF + 1) if (fF < last) else 0
+            pos, end = bs.col_cursor_sub_uint64(
+                src, index[3], 16, 47, first, last, search
+            )
+            self.assertEqual(end - pos, numitems)
+            if numitems > 0:
+                self.assertEqual(pos, fF)
+
+    def test_col_gather_uint8(self):
+        rows = []
+        expected = []
+        for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol8:
+            if fF < last:
+                values = bs.col_gather_range_uint8(src, index[0], fF, fL + 1)
+                self.assertEqual(values, [search] * (fL - fF + 1))
+                rows.append(fL)
+                expected.append(search)
+        rows.reverse()
+        expected.reverse()
+        self.assertEqual(bs.col_gather_rows_uint8(src, index[0], rows), expected)
+
+    def test_col_gather_uint16(self):
+        rows = []
+        expected = []
+        for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol16:
+            if fF < last:
+                values = bs.col_gather_range_uint16(src, index[1], fF, fL + 1)
+                self.assertEqual(values, [search] * (fL - fF + 1))
+                rows.append(fL)
+                expected.append(search)
+        rows.reverse()
+        expected.reverse()
+        self.assertEqual(bs.col_gather_rows_uint16(src, index[1], rows), expected)
+
+    def test_col_gather_uint32(self):
+        rows = []
+        expected = []
+        for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol32:
+            if fF < last:
+                values = bs.col_gather_range_uint32(src, index[2], fF, fL + 1)
+                self.assertEqual(values, [search] * (fL - fF + 1))
+                rows.append(fL)
+                expected.append(search)
+        rows.reverse()
+        expected.reverse()
+        self.assertEqual(bs.col_gather_rows_uint32(src, index[2], rows), expected)
+
+    def test_col_gather_uint64(self):
+        rows = []
+        expected = []
+        for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol64:
+            if fF < last:
+                values = bs.col_gather_range_uint64(src, index[3], fF, fL + 1)
+                self.assertEqual(values, [search] * (fL - fF + 1))
+                rows.append(fL)
+                expected.append(search)
+        rows.reverse()
+        expected.reverse()
+        self.assertEqual(bs.col_gather_rows_uint64(src, index[3], rows), expected)
+
+    def test_col_find_batch_pool_uint8(self):
+        pool = bs.batch_pool_new(2)
+        keys = [search for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol8]
+        rf = bs.col_find_first_batch_pool_uint8(pool, src, index[0], 0, nrows, keys)
+        rl = bs.col_find_last_batch_pool_uint8(pool, src, index[0], 0, nrows, keys)
+        for k, search in enumerate(keys):
+            self.assertEqual(rf[k], bs.col_find_first_uint8(src, index[0], 0, nrows, search)[0])
+            self.assertEqual(rl[k], bs.col_find_last_uint8(src, index[0], 0, nrows, search)[0])
+
+    def test_col_find_batch_pool_uint16(self):
+        pool = bs.batch_pool_new(2)
+        keys = [search for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol16]
+        rf = bs.col_find_first_batch_pool_uint16(pool, src, index[1], 0, nrows, keys)
+        rl = bs.col_find_last_batch_pool_uint16(pool, src, index[1], 0, nrows, keys)
+        for k, search in enumerate(keys):
+            self.assertEqual(rf[k], bs.col_find_first_uint16(src, index[1], 0, nrows, search)[0])
+            self.assertEqual(rl[k], bs.col_find_last_uint16(src, index[1], 0, nrows, search)[0])
+
+    def test_col_find_batch_pool_uint32(self):
+        pool = bs.batch_pool_new(2)
+        keys = [search for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol32]
+        rf = bs.col_find_first_batch_pool_uint32(pool, src, index[2], 0, nrows, keys)
+        rl = bs.col_find_last_batch_pool_uint32(pool, src, index[2], 0, nrows, keys)
+        for k, search in enumerate(keys):
+            self.assertEqual(rf[k], bs.col_find_first_uint32(src, index[2], 0, nrows, search)[0])
+            self.assertEqual(rl[k], bs.col_find_last_uint32(src, index[2], 0, nrows, search)[0])
+
+    def test_col_find_batch_pool_uint64(self):
+        pool = bs.batch_pool_new(2)
+        keys = [search for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol64]
+        rf = bs.col_find_first_batch_pool_uint64(pool, src, index[3], 0, nrows, keys)
+        rl = bs.col_find_last_batch_pool_uint64(pool, src, index[3], 0, nrows, keys)
+        for k, search in enumerate(keys):
+            self.assertEqual(rf[k], bs.col_find_first_uint64(src, index[3], 0, nrows, search)[0])
+            self.assertEqual(rl[k], bs.col_find_last_uint64(src, index[3], 0, nrows, search)[0])
+
+    def test_batch_pool_threads(self):
+        pool = bs.batch_pool_new(4)
+        keys = [search for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol64] * 200
+        expected = bs.col_find_first_batch_pool_uint64(pool, src, index[3], 0, nrows, keys)
+        results = []
+
+        def run():
+            for _ in range(20):
+                results.append(bs.col_find_first_batch_pool_uint64(pool, src, index[3], 0, nrows, keys))
+
+        threads = [threading.Thread(target=run) for _ in range(4)]
+        for th in threads:
+            th.start()
+        for th in threads:
+            th.join()
+        self.assertEqual(len(results), 80)
+        for r in results:
+            self.assertEqual(r, expected)
+
+    def test_batch_pool_replicate(self):
+        pool = bs.batch_pool_new(2)
+        keys = [search for first, last, search, fF, fFF, fFL, fL, fLF, fLL in testDataCol32]
+        expected = bs.col_find_first_batch_pool_uint32(pool, src, index[2], 0, nrows, keys)
+        self.assertEqual(bs.batch_pool_replicate(pool, src, index[2], nrows * 4), 0)
+        usage = bs.batch_pool_node_bytes(pool)
+        self.assertGreaterEqual(len(usage), 1)
+        if len(usage) > 1:
+            self.assertTrue(all(b >= nrows * 4 for b in usage))
+        rf = bs.col_find_first_batch_pool_uint32(pool, src, index[2], 0, nrows, keys)
+        self.assertEqual(rf, expected)
+
+    def test_mmap_binfile_ex(self):
+        inputfile = os.path.realpath(
+            os.path.dirname(os.path.realpath(__file__))
+            + "/../../c/test/data/test_data_col.bin"
+        )
+        for flags, advice in ((0, 1), (1 | 2, 2), (4, 3)):
+            xsrc, xfd, xsize, xdoffset, xdlength, xnrows, xncols, xindex, xidx, xmapsize, ret = bs.mmap_binfile_ex(
+                inputfile, [1, 2, 4, 8], flags, advice, [1, 2, 3], [0, 1]
+            )
+            self.assertGreaterEqual(xfd, 0)
+            self.assertIn(ret, (0, 1))
+            self.assertEqual(xsize, size)
+            self.assertEqual(xnrows, nrows)
+            self.assertEqual(xindex, index)
+            self.assertEqual(
+                bs.col_gather_range_uint32(xsrc, xindex[2], 0, xnrows),
+                bs.col_gather_range_uint32(src, index[2], 0, nrows),
+            )
+            self.assertEqual(bs.munmap_binfile(xsrc, xfd, xsize, xmapsize), 0)
+
 
 class TestBenchmark(object):
 
@@ -703,6 +975,34 @@ class TestBenchmark(object):
             rounds=10000,
         )
 
+    def test_col_cursor_next_values_uint32_benchmark(self, benchmark):
+        benchmark.pedantic(
+            bs.col_cursor_next_values_uint32,
+            args=[src, index[2], 0, 251, 251],
+            setup=setup,
+            iterations=1,
+            rounds=10000,
+        )
+
+    def test_col_gather_rows_uint32_benchmark(self, benchmark):
+        benchmark.pedantic(
+            bs.col_gather_rows_uint32,
+            args=[src, index[2], list(range(250, 0, -3))],
+            setup=setup,
+            iterations=1,
+            rounds=10000,
+        )
+
+    def test_col_find_first_batch_pool_uint32_benchmark(self, benchmark):
+        pool = bs.batch_pool_new(2)
+        benchmark.pedantic(
+            bs.col_find_first_batch_pool_uint32,
+            args=[pool, src, index[2], 0, 251, list(range(0, 0x00002000, 7))],
+            setup=setup,
+            iterations=1,
+            rounds=10000,
+        )
+
     def test_col_find_last_uint8_benchmark(self, benchmark):
         benchmark.pedantic(
             bs.col_find_last_uint8,